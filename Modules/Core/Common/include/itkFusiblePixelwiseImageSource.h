@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusiblePixelwiseImageSource_h
+#define itkFusiblePixelwiseImageSource_h
+
+#include "itkFusiblePixelwiseImageSourceBase.h"
+#include "itkTotalProgressReporter.h"
+#include <memory>
+
+namespace itk
+{
+/** \class FusiblePixelwiseImageSource
+ * \brief Interface of the pixel-wise filters that can compute their output
+ * line by line, for the filter that consumes it.
+ *
+ * A pixel-wise filter that derives from this interface (besides deriving
+ * from InPlaceImageFilter) implements GenerateFusedOutputLine, and reads the
+ * lines of its own inputs with a LineReader, so that it can both be fused
+ * into its consumer, and consume fused inputs.
+ *
+ * \tparam TOutputImage The type of the output image of the filter.
+ *
+ * \sa FusiblePixelwiseImageSourceBase
+ * \ingroup ITKCommon
+ */
+template <typename TOutputImage>
+class ITK_TEMPLATE_EXPORT FusiblePixelwiseImageSource : public FusiblePixelwiseImageSourceBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FusiblePixelwiseImageSource);
+
+  using FusedImageType = TOutputImage;
+  using FusedRegionType = typename TOutputImage::RegionType;
+  using FusedPixelType = typename TOutputImage::PixelType;
+
+  /** Compute the pixels of the output in outputLineRegion, a region of a
+   * single line along the first dimension, into buffer. This method is
+   * called concurrently by the threads of the consumer. */
+  virtual void
+  GenerateFusedOutputLine(const FusedRegionType & outputLineRegion, FusedPixelType * buffer) = 0;
+
+  /** \class LineReader
+   * \brief Reads lines of an input of a pixel-wise filter.
+   *
+   * The lines are copied from the buffer of the input image or, when the
+   * input is fused, computed by the source of the input. A LineReader may
+   * only be used by a single thread.
+   *
+   * \ingroup ITKCommon
+   */
+  class LineReader
+  {
+  public:
+    explicit LineReader(const TOutputImage * image);
+
+    /** Returns the pixels of lineRegion, a region of a single line along the
+     * first dimension. The pixels remain valid until the next call. */
+    const FusedPixelType *
+    Read(const FusedRegionType & lineRegion);
+
+  private:
+    const TOutputImage *              m_Image;
+    FusiblePixelwiseImageSource *     m_FusedSource{};
+    std::unique_ptr<FusedPixelType[]> m_Buffer{};
+    SizeValueType                     m_BufferSize{ 0 };
+  };
+
+protected:
+  FusiblePixelwiseImageSource() = default;
+  ~FusiblePixelwiseImageSource() override = default;
+
+  /** Generate the output in outputRegionForThread, one line at a time, by
+   * GenerateFusedOutputLine. Used instead of the normal pixel loop by
+   * filters that consume fused inputs. */
+  void
+  GenerateOutputRegionLineByLine(TOutputImage *          outputPtr,
+                                 const FusedRegionType & outputRegionForThread,
+                                 TotalProgressReporter & progress);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFusiblePixelwiseImageSource.hxx"
+#endif
+
+#endif
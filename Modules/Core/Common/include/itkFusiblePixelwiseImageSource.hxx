@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusiblePixelwiseImageSource_hxx
+#define itkFusiblePixelwiseImageSource_hxx
+
+#include "itkImageScanlineIterator.h"
+
+namespace itk
+{
+
+template <typename TOutputImage>
+FusiblePixelwiseImageSource<TOutputImage>::LineReader::LineReader(const TOutputImage * image)
+  : m_Image(image)
+{
+  FusiblePixelwiseImageSourceBase * const fusedSource = GetFusedSource(image);
+  if (fusedSource != nullptr)
+  {
+    m_FusedSource = dynamic_cast<FusiblePixelwiseImageSource *>(fusedSource);
+    if (m_FusedSource == nullptr)
+    {
+      itkGenericExceptionMacro("The source of a fused input does not produce images of the type of the input.");
+    }
+  }
+}
+
+template <typename TOutputImage>
+auto
+FusiblePixelwiseImageSource<TOutputImage>::LineReader::Read(const FusedRegionType & lineRegion)
+  -> const FusedPixelType *
+{
+  const SizeValueType lineLength = lineRegion.GetSize(0);
+  if (lineLength > m_BufferSize)
+  {
+    m_Buffer = std::make_unique<FusedPixelType[]>(lineLength);
+    m_BufferSize = lineLength;
+  }
+
+  if (m_FusedSource != nullptr)
+  {
+    m_FusedSource->GenerateFusedOutputLine(lineRegion, m_Buffer.get());
+  }
+  else
+  {
+    ImageScanlineConstIterator inputIt(m_Image, lineRegion);
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      m_Buffer[i] = inputIt.Get();
+      ++inputIt;
+    }
+  }
+  return m_Buffer.get();
+}
+
+template <typename TOutputImage>
+void
+FusiblePixelwiseImageSource<TOutputImage>::GenerateOutputRegionLineByLine(
+  TOutputImage *          outputPtr,
+  const FusedRegionType & outputRegionForThread,
+  TotalProgressReporter & progress)
+{
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  auto lineSize = outputRegionForThread.GetSize();
+  lineSize.Fill(1);
+  lineSize[0] = lineLength;
+
+  const auto            buffer = std::make_unique<FusedPixelType[]>(lineLength);
+  ImageScanlineIterator outputIt(outputPtr, outputRegionForThread);
+
+  while (!outputIt.IsAtEnd())
+  {
+    this->GenerateFusedOutputLine(FusedRegionType(outputIt.GetIndex(), lineSize), buffer.get());
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      outputIt.Set(buffer[i]);
+      ++outputIt;
+    }
+    outputIt.NextLine();
+    progress.Completed(lineLength);
+  }
+}
+} // end namespace itk
+
+#endif
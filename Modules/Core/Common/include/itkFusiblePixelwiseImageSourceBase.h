@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFusiblePixelwiseImageSourceBase_h
+#define itkFusiblePixelwiseImageSourceBase_h
+
+#include "itkMacro.h" // for ITKCommon_EXPORT
+#include "itkSingletonMacro.h"
+
+namespace itk
+{
+class DataObject;
+class ProcessObject;
+
+/** \class FusiblePixelwiseImageSourceBase
+ * \brief Non-templated base of the pixel-wise filters that can be fused
+ * into the filter that consumes their output.
+ *
+ * A chain of pixel-wise filters (like the UnaryFunctorImageFilter,
+ * BinaryGeneratorImageFilter and TernaryFunctorImageFilter families)
+ * normally generates a full intermediate image at each step. When pixel-wise
+ * fusion is enabled, a pixel-wise filter that consumes the output of another
+ * pixel-wise filter computes that output itself, one line at a time, while
+ * it generates its own output. The intermediate image is then never
+ * allocated, and the whole chain is computed in a single pass over the
+ * requested region.
+ *
+ * Fusion is an explicit opt-in on the intermediate: an output is only
+ * fused when its source has PixelwiseFusion enabled, when its consumer can
+ * compute fused inputs (see CanComputeFusedInputs()), and when it would
+ * have to be generated anyway. After the consumer has generated its output,
+ * a fused output is released, as if its ReleaseDataFlag was on: a later
+ * request for it, including by another consumer, generates it again.
+ * Therefore only enable PixelwiseFusion on a filter whose output has a
+ * single consumer, and is not used otherwise.
+ *
+ * Only enable PixelwiseFusion on filters that compute each output pixel
+ * from the input pixels at the same index. Filters that preprocess their
+ * whole input, like RescaleIntensityImageFilter, override
+ * CanComputeFusedInputs() to return false: their inputs are then always
+ * generated as images, while their own output may still be fused.
+ *
+ * \sa FusiblePixelwiseImageSource
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT FusiblePixelwiseImageSourceBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FusiblePixelwiseImageSourceBase);
+
+  /** Set/Get the default value of the PixelwiseFusion flag of the filters
+   * that are created afterwards. Off by default. */
+  static void
+  SetGlobalDefaultPixelwiseFusion(bool val);
+  static bool
+  GetGlobalDefaultPixelwiseFusion();
+
+  /** Whether the output of this filter may be fused into its consumer. */
+  virtual bool
+  CanFuseOutput() const = 0;
+
+  /** Whether this filter, as a consumer, can compute its fusible inputs line
+   * by line, instead of reading them from their buffers. True by default. */
+  virtual bool
+  CanComputeFusedInputs() const
+  {
+    return true;
+  }
+
+  /** Whether the output of this filter is currently fused into its consumer,
+   * which then computes it, instead of this filter. */
+  bool
+  IsOutputFused() const
+  {
+    return m_OutputFused;
+  }
+
+  /** Called by ReleaseFusedInputs of the consumer, after it has generated
+   * its output: releases the inputs of this filter, according to their
+   * ReleaseDataFlag, and recursively its fused inputs. */
+  virtual void
+  ReleaseInputsOfFusedOutput() = 0;
+
+  /** Helpers for pixel-wise filters, as consumers. FuseInputs, called while
+   * propagating the requested region, decides which inputs of the consumer
+   * are fused, given whether the consumer can compute fused inputs,
+   * HasFusedInputs tells whether any are, and ReleaseFusedInputs, called
+   * after the consumer has generated its output, releases them. */
+  static void
+  FuseInputs(ProcessObject * consumer, bool computeFusedInputs);
+  static bool
+  HasFusedInputs(const ProcessObject * consumer);
+  static void
+  ReleaseFusedInputs(ProcessObject * consumer);
+
+  /** Returns the source of input if the input is fused, and nullptr
+   * otherwise. */
+  static FusiblePixelwiseImageSourceBase *
+  GetFusedSource(const DataObject * input);
+
+protected:
+  FusiblePixelwiseImageSourceBase() = default;
+  virtual ~FusiblePixelwiseImageSourceBase() = default;
+
+private:
+  bool m_OutputFused{ false };
+
+  itkGetGlobalDeclarationMacro(bool, GlobalDefaultPixelwiseFusion);
+  static bool * m_GlobalDefaultPixelwiseFusion;
+};
+} // end namespace itk
+
+#endif
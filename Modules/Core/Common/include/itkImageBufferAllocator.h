@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkMacro.h" // for ITKCommon_EXPORT
+#include "itkSingletonMacro.h"
+
+#include <cstddef>
+#include <string>
+
+namespace itk
+{
+/** \class ImageBufferAllocatorEnums
+ * \brief Contains all enum classes used by ImageBufferAllocator class.
+ * \ingroup ITKCommon
+ */
+class ImageBufferAllocatorEnums
+{
+public:
+  /**
+   * \ingroup ITKCommon
+   * Defines how the memory of image buffers is allocated. */
+  enum class Policy : uint8_t
+  {
+    /** Allocate the elements with new[], as ITK always did. */
+    New,
+    /** Align the buffers to a cache line (64 bytes). */
+    Aligned,
+    /** Align the buffers like Aligned, and back buffers of at least one huge
+     * page (2 MiB) with transparent huge pages, where the system supports
+     * them. This reduces the TLB misses of large images. */
+    HugePages,
+    /** Align the buffers like Aligned, and zero them in parallel, using the
+     * threads of the global default threader, before use. On NUMA systems,
+     * each page is then placed close to the thread that processes the same
+     * part of the image when the image is later processed in parallel. */
+    ParallelFirstTouch,
+    Unknown
+  };
+};
+// Define how to print enumeration
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & out, const ImageBufferAllocatorEnums::Policy value);
+
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ * \brief Allocates the memory of image buffers, according to a policy.
+ *
+ * ImportImageContainer, and therefore Image and VectorImage, allocate their
+ * buffers according to the allocation policy of the container, which is
+ * initialized with the global default policy when the container is created.
+ *
+ * The global default policy is New, unless it is specified by the
+ * environment variable ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATION (one of
+ * "New", "Aligned", "HugePages", or "ParallelFirstTouch"), or by calling
+ * SetGlobalDefaultPolicy(), which takes precedence over the environment.
+ *
+ * Allocate() and Deallocate() manage raw memory only; constructing and
+ * destroying the elements is the responsibility of the caller.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+
+  using PolicyEnum = ImageBufferAllocatorEnums::Policy;
+
+  /** Alignment of the buffers allocated with any policy other than New. */
+  static constexpr size_t CacheLineSize = 64;
+
+  /** Size (and alignment) of a transparent huge page. */
+  static constexpr size_t HugePageSize = size_t{ 2 } << 20;
+
+  /** Set/Get the policy that is used by default to allocate image buffers. */
+  static void
+  SetGlobalDefaultPolicy(PolicyEnum policy);
+  static PolicyEnum
+  GetGlobalDefaultPolicy();
+
+  /** Convert a policy from/to its name. PolicyFromString is case insensitive
+   * and returns Unknown for an unknown name. */
+  static PolicyEnum
+  PolicyFromString(std::string policyString);
+  static std::string
+  PolicyToString(PolicyEnum policy);
+
+  /** Allocate numberOfBytes bytes of memory, with the specified policy,
+   * which may not be New. If zeroInitialize is true, the memory is set to
+   * zero. Memory allocated with the ParallelFirstTouch policy is always set
+   * to zero. Throws a MemoryAllocationError if the memory can not be
+   * allocated. */
+  static void *
+  Allocate(size_t numberOfBytes, PolicyEnum policy, bool zeroInitialize);
+
+  /** Deallocate memory that was allocated by Allocate(), with the same
+   * number of bytes and policy. */
+  static void
+  Deallocate(void * memory, size_t numberOfBytes, PolicyEnum policy) noexcept;
+
+  /** Return the alignment of the memory allocated for numberOfBytes bytes
+   * with the specified policy, which may not be New. */
+  static size_t
+  GetAlignment(size_t numberOfBytes, PolicyEnum policy);
+
+private:
+  ImageBufferAllocator() = default;
+
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkImageBufferAllocator.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+struct ImageBufferPoolGlobals;
+
+/** \class ImageBufferPool
+ * \brief Recycles the memory of image buffers that are released.
+ *
+ * When the pool is enabled, the memory of an image buffer that is released
+ * (for example by DataObject::ReleaseData, or when the image is destroyed)
+ * is kept in the pool, instead of being returned to the system. A later
+ * allocation of a buffer of the same size, with the same allocation policy,
+ * reuses that memory, which avoids both the allocation and the page faults
+ * of touching new memory. This mostly benefits pipelines that are updated
+ * repeatedly, like the ones in an iterative registration, or per frame of a
+ * video.
+ *
+ * The pool has a bucket for each combination of allocation policy and size,
+ * rounded up to a multiple of ImageBufferAllocator::CacheLineSize. The
+ * number of buffers per bucket, and the total number of bytes kept in the
+ * pool, are limited by MaximumNumberOfBuffersPerBucket and
+ * MaximumNumberOfPooledBytes. A released buffer that does not fit in the
+ * pool is deallocated.
+ *
+ * ImportImageContainer, and therefore Image and VectorImage, use the pool
+ * for all the buffers that they allocate while the pool is enabled: those
+ * of the default New policy are then allocated with the Aligned policy.
+ * The pool is disabled by default.
+ *
+ * \sa ImageBufferAllocator
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferPool
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferPool);
+
+  using PolicyEnum = ImageBufferAllocatorEnums::Policy;
+
+  /** Enable/Disable the pool. Disabling the pool deallocates the buffers in
+   * the pool. */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+
+  /** Set/Get the maximum number of buffers in a bucket. Defaults to 4. */
+  static void
+  SetMaximumNumberOfBuffersPerBucket(SizeValueType numberOfBuffers);
+  static SizeValueType
+  GetMaximumNumberOfBuffersPerBucket();
+
+  /** Set/Get the maximum number of bytes of all buffers in the pool.
+   * Defaults to 1 GiB. Reducing the maximum deallocates buffers, when
+   * necessary. */
+  static void
+  SetMaximumNumberOfPooledBytes(SizeValueType numberOfBytes);
+  static SizeValueType
+  GetMaximumNumberOfPooledBytes();
+
+  /** Get the number of buffers, and the total number of bytes, that are in
+   * the pool. */
+  static SizeValueType
+  GetNumberOfPooledBuffers();
+  static SizeValueType
+  GetNumberOfPooledBytes();
+
+  /** Statistics: the number of acquired buffers that were taken from the
+   * pool (hits) or newly allocated (misses), and the number of released
+   * buffers that were kept in the pool or deallocated, since the last call
+   * to ResetStatistics(). Buffers that are acquired or released while the
+   * pool is disabled are not counted. */
+  static SizeValueType
+  GetNumberOfHits();
+  static SizeValueType
+  GetNumberOfMisses();
+  static SizeValueType
+  GetNumberOfRecycledBuffers();
+  static SizeValueType
+  GetNumberOfDiscardedBuffers();
+  static void
+  ResetStatistics();
+
+  /** Deallocate all the buffers in the pool. */
+  static void
+  Clear();
+
+  /** Acquire numberOfBytes bytes of memory, allocated with the specified
+   * policy, which may not be New. Takes the memory from the pool when the
+   * pool is enabled and has a buffer of the same size and policy, and
+   * allocates it by ImageBufferAllocator::Allocate otherwise. If
+   * zeroInitialize is true, the memory is set to zero. */
+  static void *
+  Acquire(size_t numberOfBytes, PolicyEnum policy, bool zeroInitialize);
+
+  /** Release memory that was acquired by Acquire(), with the same number of
+   * bytes and policy. Keeps the memory in the pool when the pool is enabled
+   * and not full, and deallocates it otherwise. */
+  static void
+  Release(void * memory, size_t numberOfBytes, PolicyEnum policy) noexcept;
+
+private:
+  ImageBufferPool() = default;
+
+  itkGetGlobalDeclarationMacro(ImageBufferPoolGlobals, PimplGlobals);
+  static ImageBufferPoolGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
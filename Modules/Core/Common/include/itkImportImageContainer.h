@@ -20,6 +20,8 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferPool.h"
+#include <memory>
 #include <utility>
 
 namespace itk
@@ -31,6 +33,13 @@ namespace itk
  * conforms to the ImageContainerInterface. This is a full-fledged Object,
  * so there is modification time, debug, and reference count information.
  *
+ * The memory that the container allocates itself is allocated according
+ * to its AllocationPolicy, which is initialized with the global default
+ * policy of ImageBufferAllocator. Memory that is allocated with any policy
+ * other than New is acquired from, and released to, the ImageBufferPool.
+ * While the ImageBufferPool is enabled, memory of the New policy is
+ * allocated with the Aligned policy, so that it is pooled as well.
+ *
  * \tparam TElementIdentifier An INTEGRAL type for use in indexing the
  * imported buffer.
  *
@@ -57,6 +66,8 @@ public:
   using ElementIdentifier = TElementIdentifier;
   using Element = TElement;
 
+  using AllocationPolicyEnum = ImageBufferAllocatorEnums::Policy;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
@@ -79,6 +90,14 @@ public:
   void
   SetImportPointer(TElement * ptr, TElementIdentifier num, bool LetContainerManageMemory = false);
 
+  /** Set the pointer from which the image data is imported, sharing the
+   * ownership of the memory with "memoryOwner". Instead of freeing the
+   * memory itself, this container releases its reference to "memoryOwner"
+   * when the memory is no longer needed. This allows to wrap memory that
+   * is managed by another object, for example a memory-mapped file. */
+  void
+  SetImportPointer(TElement * ptr, TElementIdentifier num, std::shared_ptr<void> memoryOwner);
+
   /** Index operator. This version can be an lvalue. */
   TElement &
   operator[](const ElementIdentifier id)
@@ -159,6 +178,16 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the policy used to allocate the memory of the container (New,
+   * Aligned, HugePages or ParallelFirstTouch). A new policy only affects the
+   * memory allocated afterwards, by Reserve() or Squeeze(). Memory that is
+   * allocated with any policy other than New, or with the New policy while
+   * the ImageBufferPool is enabled, can not be released with delete[], so it
+   * should not be taken over by turning ContainerManageMemory off.
+   * \sa ImageBufferAllocator */
+  itkSetEnumMacro(AllocationPolicy, AllocationPolicyEnum);
+  itkGetEnumMacro(AllocationPolicy, AllocationPolicyEnum);
+
 protected:
   ImportImageContainer() = default;
   ~ImportImageContainer() override;
@@ -170,12 +199,22 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   /**
-   * Allocates elements of the array.  If UseValueInitialization is true, then
-   * POD types will be zero-initialized.
+   * Allocates elements of the array with new[].  If UseValueInitialization is
+   * true, then POD types will be zero-initialized. It is called by Reserve()
+   * and Squeeze() when GetElementsAllocationPolicy() returns the New policy.
    */
   virtual TElement *
   AllocateElements(ElementIdentifier size, bool UseValueInitialization = false) const;
 
+  /** Returns the policy with which Reserve() and Squeeze() allocate the
+   * elements: the AllocationPolicy, except that the New policy is replaced
+   * by the Aligned policy while the ImageBufferPool is enabled, so that the
+   * memory is recycled. Only the elements of the New policy are allocated by
+   * AllocateElements(), so a subclass that overrides AllocateElements() may
+   * override this method to always return the New policy. */
+  virtual AllocationPolicyEnum
+  GetElementsAllocationPolicy() const;
+
   virtual void
   DeallocateManagedMemory();
 
@@ -206,10 +245,21 @@ protected:
   }
 
 private:
-  TElement *         m_ImportPointer{};
-  TElementIdentifier m_Size{};
-  TElementIdentifier m_Capacity{};
-  bool               m_ContainerManageMemory{ true };
+  /** Allocates the elements with the given policy: by AllocateElements() for
+   * the New policy, and by the ImageBufferPool otherwise. */
+  TElement *
+  AllocateElementsWithPolicy(ElementIdentifier size, bool UseValueInitialization, AllocationPolicyEnum policy) const;
+
+  TElement *            m_ImportPointer{};
+  TElementIdentifier    m_Size{};
+  TElementIdentifier    m_Capacity{};
+  bool                  m_ContainerManageMemory{ true };
+  std::shared_ptr<void> m_MemoryOwner{};
+
+  AllocationPolicyEnum m_AllocationPolicy{ ImageBufferAllocator::GetGlobalDefaultPolicy() };
+
+  /** The policy used to allocate m_ImportPointer, when it is managed by the container. */
+  AllocationPolicyEnum m_ImportPointerAllocationPolicy{ AllocationPolicyEnum::New };
 };
 } // end namespace itk
 
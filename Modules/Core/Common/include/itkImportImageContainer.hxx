@@ -29,6 +29,9 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <memory>    // For uninitialized_value_construct_n and destroy_n.
+#include <type_traits>
 
 namespace itk
 {
@@ -53,13 +56,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseValueInitialization);
+      const AllocationPolicyEnum policy = this->GetElementsAllocationPolicy();
+      TElement * const           temp = this->AllocateElementsWithPolicy(size, UseValueInitialization, policy);
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocationPolicy = policy;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -73,7 +78,9 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseValueInitialization);
+    const AllocationPolicyEnum policy = this->GetElementsAllocationPolicy();
+    m_ImportPointer = this->AllocateElementsWithPolicy(size, UseValueInitialization, policy);
+    m_ImportPointerAllocationPolicy = policy;
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -93,13 +100,15 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
   {
     if (m_Size < m_Capacity)
     {
-      const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      const TElementIdentifier   size = m_Size;
+      const AllocationPolicyEnum policy = this->GetElementsAllocationPolicy();
+      TElement * const           temp = this->AllocateElementsWithPolicy(size, false, policy);
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_ImportPointerAllocationPolicy = policy;
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -143,6 +152,8 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
 {
   DeallocateManagedMemory();
   m_ImportPointer = ptr;
+  // A pointer that is passed to the container is assumed to be allocated with new[].
+  m_ImportPointerAllocationPolicy = AllocationPolicyEnum::New;
   m_ContainerManageMemory = LetContainerManageMemory;
   m_Capacity = num;
   m_Size = num;
@@ -150,6 +161,74 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *            ptr,
+                                                                     TElementIdentifier    num,
+                                                                     std::shared_ptr<void> memoryOwner)
+{
+  DeallocateManagedMemory();
+  m_ImportPointer = ptr;
+  m_MemoryOwner = std::move(memoryOwner);
+  m_ContainerManageMemory = false;
+  m_Capacity = num;
+  m_Size = num;
+
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+auto
+ImportImageContainer<TElementIdentifier, TElement>::GetElementsAllocationPolicy() const -> AllocationPolicyEnum
+{
+  if (m_AllocationPolicy == AllocationPolicyEnum::New || m_AllocationPolicy == AllocationPolicyEnum::Unknown)
+  {
+    // While the pool is enabled, the elements of the New policy are allocated like those of the Aligned policy, whose
+    // alignment is at least that of new[], so that their memory is also recycled.
+    return ImageBufferPool::GetEnabled() ? AllocationPolicyEnum::Aligned : AllocationPolicyEnum::New;
+  }
+  return m_AllocationPolicy;
+}
+
+template <typename TElementIdentifier, typename TElement>
+TElement *
+ImportImageContainer<TElementIdentifier, TElement>::AllocateElementsWithPolicy(
+  ElementIdentifier    size,
+  bool                 UseValueInitialization,
+  AllocationPolicyEnum policy) const
+{
+  if (policy != AllocationPolicyEnum::New)
+  {
+    // Zeroed memory is value-initialized memory for trivial types, so these do not need to be constructed.
+    constexpr bool isTrivial = std::is_trivial_v<TElement>;
+    if (static_cast<size_t>(size) > std::numeric_limits<size_t>::max() / sizeof(TElement))
+    {
+      throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+    }
+    const size_t numberOfBytes = static_cast<size_t>(size) * sizeof(TElement);
+    auto * const data = static_cast<TElement *>(
+      ImageBufferPool::Acquire(numberOfBytes, policy, UseValueInitialization && isTrivial));
+    try
+    {
+      if (UseValueInitialization && !isTrivial)
+      {
+        std::uninitialized_value_construct_n(data, size);
+      }
+      else
+      {
+        std::uninitialized_default_construct_n(data, size);
+      }
+    }
+    catch (...)
+    {
+      ImageBufferPool::Release(data, numberOfBytes, policy);
+      throw;
+    }
+    return data;
+  }
+  return this->AllocateElements(size, UseValueInitialization);
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -188,8 +267,18 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_ImportPointerAllocationPolicy == AllocationPolicyEnum::New)
+    {
+      delete[] m_ImportPointer;
+    }
+    else if (m_ImportPointer)
+    {
+      std::destroy_n(m_ImportPointer, m_Capacity);
+      ImageBufferPool::Release(
+        m_ImportPointer, static_cast<size_t>(m_Capacity) * sizeof(TElement), m_ImportPointerAllocationPolicy);
+    }
   }
+  m_MemoryOwner.reset();
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -203,8 +292,10 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
 
   os << indent << "Pointer: " << static_cast<void *>(m_ImportPointer) << std::endl;
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
+  os << indent << "Memory owner: " << m_MemoryOwner.get() << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
+  os << indent << "AllocationPolicy: " << m_AllocationPolicy << std::endl;
 }
 } // end namespace itk
 
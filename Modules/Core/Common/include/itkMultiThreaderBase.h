@@ -64,7 +64,8 @@ public:
     First = Platform,
     Pool,
     TBB,
-    Last = TBB,
+    WorkStealing,
+    Last = WorkStealing,
     Unknown = -1
   };
 
@@ -164,6 +165,7 @@ public:
   static constexpr ThreaderEnum First = ThreaderEnum::First;
   static constexpr ThreaderEnum Pool = ThreaderEnum::Pool;
   static constexpr ThreaderEnum TBB = ThreaderEnum::TBB;
+  static constexpr ThreaderEnum WorkStealing = ThreaderEnum::WorkStealing;
   static constexpr ThreaderEnum Last = ThreaderEnum::Last;
   static constexpr ThreaderEnum Unknown = ThreaderEnum::Unknown;
 #endif
@@ -184,6 +186,8 @@ public:
         return "Pool";
       case ThreaderEnum::TBB:
         return "TBB";
+      case ThreaderEnum::WorkStealing:
+        return "WorkStealing";
       case ThreaderEnum::Unknown:
       default:
         return "Unknown";
@@ -194,6 +198,7 @@ public:
    *
    * The default multi-threader type is picked up from ITK_GLOBAL_DEFAULT_THREADER
    * environment variable. Example ITK_GLOBAL_DEFAULT_THREADER=TBB
+   * or ITK_GLOBAL_DEFAULT_THREADER=WorkStealing
    * A deprecated ITK_USE_THREADPOOL environment variable is also examined,
    * but it can only choose Pool or Platform multi-threader.
    * Platform multi-threader should be avoided,
@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelizeOnDedicatedThreads_h
+#define itkParallelizeOnDedicatedThreads_h
+
+#include "itkIntTypes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+/** Calls function(taskIndex, threadIndex) once for each task index in [0, numberOfTasks), on at most numberOfThreads
+ * threads, each of which takes the next task when it is done with the previous one. The calling thread is the thread of
+ * index 0, and the other threads are created for this call. An exception thrown by a task is stored at the index of the
+ * task in the returned list, while the other tasks still run.
+ *
+ * This is meant for coarse tasks that wait for work units of their own, such as metric evaluations or registrations:
+ * running them on the pool of the multi-threader could leave no thread to run these work units.
+ */
+template <typename TFunction>
+std::vector<std::exception_ptr>
+ParallelizeOnDedicatedThreads(SizeValueType numberOfTasks, SizeValueType numberOfThreads, const TFunction & function)
+{
+  std::vector<std::exception_ptr> exceptions(numberOfTasks);
+  std::atomic<SizeValueType>      nextTask{ 0 };
+
+  const auto runTasks = [numberOfTasks, &function, &exceptions, &nextTask](SizeValueType threadIndex) {
+    for (SizeValueType i = nextTask++; i < numberOfTasks; i = nextTask++)
+    {
+      try
+      {
+        function(i, threadIndex);
+      }
+      catch (...)
+      {
+        exceptions[i] = std::current_exception();
+      }
+    }
+  };
+
+  numberOfThreads = std::max<SizeValueType>(1, std::min(numberOfThreads, numberOfTasks));
+  std::vector<std::thread> threads;
+  threads.reserve(numberOfThreads - 1);
+  for (SizeValueType i = 1; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back(runTasks, i);
+  }
+  runTasks(0);
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  return exceptions;
+}
+} // namespace itk
+
+#endif // itkParallelizeOnDedicatedThreads_h
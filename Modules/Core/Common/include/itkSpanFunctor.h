@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSpanFunctor_h
+#define itkSpanFunctor_h
+
+#include "itkImage.h"
+
+#include <type_traits>
+#include <utility> // For declval.
+
+namespace itk
+{
+/** Whether the pixels of each scanline of an image of type TImage are contiguous in memory, and can be accessed
+ * directly, so that pixel-wise filters can process whole scanlines as spans of pixels. True for itk::Image, false
+ * for image adaptors and VectorImage. */
+template <typename TImage>
+constexpr bool HasContiguousScanlines =
+  std::is_same_v<TImage, Image<typename TImage::PixelType, TImage::ImageDimension>>;
+
+namespace Functor
+{
+/* Helpers to apply a pixel functor to a span of contiguous pixels.
+ *
+ * The pixel-wise filters pass whole scanlines to ApplyToSpan. By default,
+ * ApplyToSpan calls the functor for each pixel, in a plain loop over the
+ * span, that compilers can vectorize when the functor is inlined. A functor
+ * can instead process the whole span itself, by providing a member function
+ *
+ * \code
+ * void ProcessSpan(const TInput * input, TOutput * output, SizeValueType length) const;
+ * \endcode
+ *
+ * for a unary functor, or, for a binary functor,
+ *
+ * \code
+ * template <typename TSpan1, typename TSpan2>
+ * void ProcessSpan(TSpan1 input1, TSpan2 input2, TOutput * output, SizeValueType length) const;
+ * \endcode
+ *
+ * where each input is either a pointer to the input pixels, or a constant
+ * input value, and the pixels are accessed by SpanElement. This lets the
+ * functor copy its parameters into local variables before the loop: the
+ * compiler cannot keep a member of the functor in a register while it
+ * writes output pixels of the same type, which would prevent vectorization.
+ */
+
+/** Returns the i-th pixel of a span of input pixels. */
+template <typename TPixel>
+inline const TPixel &
+SpanElement(TPixel * span, SizeValueType i)
+{
+  return span[i];
+}
+
+/** Returns the value of a constant input, for any i. */
+template <typename TPixel>
+inline const TPixel &
+SpanElement(const TPixel & value, SizeValueType itkNotUsed(i))
+{
+  return value;
+}
+
+template <typename TFunctor, typename TInput, typename TOutput, typename = void>
+struct HasUnaryProcessSpan : std::false_type
+{};
+
+template <typename TFunctor, typename TInput, typename TOutput>
+struct HasUnaryProcessSpan<TFunctor,
+                           TInput,
+                           TOutput,
+                           std::void_t<decltype(std::declval<const TFunctor &>().ProcessSpan(
+                             std::declval<const TInput *>(), std::declval<TOutput *>(), SizeValueType{}))>>
+  : std::true_type
+{};
+
+template <typename TFunctor, typename TSpan1, typename TSpan2, typename TOutput, typename = void>
+struct HasBinaryProcessSpan : std::false_type
+{};
+
+template <typename TFunctor, typename TSpan1, typename TSpan2, typename TOutput>
+struct HasBinaryProcessSpan<TFunctor,
+                            TSpan1,
+                            TSpan2,
+                            TOutput,
+                            std::void_t<decltype(std::declval<const TFunctor &>().ProcessSpan(std::declval<TSpan1>(),
+                                                                                              std::declval<TSpan2>(),
+                                                                                              std::declval<TOutput *>(),
+                                                                                              SizeValueType{}))>>
+  : std::true_type
+{};
+
+/** Sets output[i] = functor(input[i]) for each i in [0, length). The output may be the input (in-place). */
+template <typename TFunctor, typename TInput, typename TOutput>
+inline void
+ApplyToSpan(const TFunctor & functor, const TInput * input, TOutput * output, SizeValueType length)
+{
+  if constexpr (HasUnaryProcessSpan<TFunctor, TInput, TOutput>::value)
+  {
+    functor.ProcessSpan(input, output, length);
+  }
+  else
+  {
+    for (SizeValueType i = 0; i < length; ++i)
+    {
+      output[i] = functor(input[i]);
+    }
+  }
+}
+
+/** Sets output[i] = functor(input1[i], input2[i]) for each i in [0, length), where either input may be a constant
+ * value instead of a pointer to the input pixels. The output may be one of the inputs (in-place). */
+template <typename TFunctor, typename TSpan1, typename TSpan2, typename TOutput>
+inline void
+ApplyToSpan(const TFunctor & functor,
+            const TSpan1 &   input1,
+            const TSpan2 &   input2,
+            TOutput *        output,
+            SizeValueType    length)
+{
+  if constexpr (HasBinaryProcessSpan<TFunctor, TSpan1, TSpan2, TOutput>::value)
+  {
+    functor.ProcessSpan(input1, input2, output, length);
+  }
+  else
+  {
+    // A constant input is copied, as the output pixels could otherwise alias it.
+    const TSpan1 span1 = input1;
+    const TSpan2 span2 = input2;
+    for (SizeValueType i = 0; i < length; ++i)
+    {
+      output[i] = functor(SpanElement(span1, i), SpanElement(span2, i));
+    }
+  }
+}
+} // end namespace Functor
+} // end namespace itk
+
+#endif
@@ -20,6 +20,8 @@
 
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
+#include "itkFusiblePixelwiseImageSource.h"
+#include "itkSpanFunctor.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
 namespace itk
@@ -36,8 +38,12 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * With PixelwiseFusion on, chains of pixel-wise filters are computed in a
+ * single pass, without intermediate images.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
+ * \sa FusiblePixelwiseImageSourceBase
  *
  * \ingroup   IntensityImageFilters     MultiThreaded
  * \ingroup ITKCommon
@@ -47,7 +53,9 @@ namespace itk
  * \endsphinx
  */
 template <typename TInputImage, typename TOutputImage, typename TFunction>
-class ITK_TEMPLATE_EXPORT UnaryFunctorImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+class ITK_TEMPLATE_EXPORT UnaryFunctorImageFilter
+  : public InPlaceImageFilter<TInputImage, TOutputImage>
+  , public FusiblePixelwiseImageSource<TOutputImage>
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(UnaryFunctorImageFilter);
@@ -108,6 +116,27 @@ public:
     }
   }
 
+  /** Set/Get whether the output of this filter may be fused: computed line
+   * by line by the pixel-wise filter that consumes it, and released after
+   * that filter has generated its output. Only enable it when the output
+   * has that single consumer, and is not used otherwise.
+   * Defaults to FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion(). */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  bool
+  CanFuseOutput() const override
+  {
+    return m_PixelwiseFusion;
+  }
+
+  void
+  GenerateFusedOutputLine(const OutputImageRegionType & outputLineRegion, OutputImagePixelType * buffer) override;
+
+  void
+  ReleaseInputsOfFusedOutput() override;
+
 protected:
   UnaryFunctorImageFilter();
   ~UnaryFunctorImageFilter() override = default;
@@ -136,8 +165,30 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Decide which inputs are fused. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Only prepares the functor when the output is fused, and releases the
+   * fused inputs afterwards otherwise. */
+  void
+  GenerateData() override;
+
+  /** The inputs of a fused output are released by ReleaseInputsOfFusedOutput. */
+  void
+  ReleaseInputs() override;
+
+  /** A fused input has no buffer to reuse. */
+  bool
+  CanRunInPlace() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
   FunctorType m_Functor{};
+
+  bool m_PixelwiseFusion{ FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion() };
 };
 } // end namespace itk
 
@@ -86,22 +86,118 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
+
   ImageScanlineConstIterator inputIt(inputPtr, inputRegionForThread);
   ImageScanlineIterator      outputIt(outputPtr, outputRegionForThread);
 
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
   while (!inputIt.IsAtEnd())
   {
-    while (!inputIt.IsAtEndOfLine())
+    if constexpr (HasContiguousScanlines<TInputImage> && HasContiguousScanlines<TOutputImage>)
+    {
+      Functor::ApplyToSpan(m_Functor, &inputIt.Value(), &outputIt.Value(), lineLength);
+    }
+    else
     {
-      outputIt.Set(m_Functor(inputIt.Get()));
-      ++inputIt;
-      ++outputIt;
+      while (!inputIt.IsAtEndOfLine())
+      {
+        outputIt.Set(m_Functor(inputIt.Get()));
+        ++inputIt;
+        ++outputIt;
+      }
     }
     inputIt.NextLine();
     outputIt.NextLine();
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(lineLength);
   }
 }
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  InputImageRegionType inputLineRegion;
+  this->CallCopyOutputRegionToInputRegion(inputLineRegion, outputLineRegion);
+
+  typename FusiblePixelwiseImageSource<TInputImage>::LineReader inputReader(this->GetInput());
+  const InputImagePixelType * const inputLine = inputReader.Read(inputLineRegion);
+
+  Functor::ApplyToSpan(m_Functor, inputLine, buffer, outputLineRegion.GetSize(0));
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+bool
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() && FusiblePixelwiseImageSourceBase::GetFusedSource(this->GetInput()) == nullptr;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingMultiThreader_h
+#define itkWorkStealingMultiThreader_h
+
+#include "itkMultiThreaderBase.h"
+
+namespace itk
+{
+/** \class WorkStealingMultiThreader
+ * \brief A class for performing multithreaded execution with a native
+ * work-stealing scheduler.
+ *
+ * Every worker thread owns a double-ended task queue. A worker pushes and
+ * pops its own tasks at the back of its queue, while idle workers steal the
+ * oldest (and therefore largest) tasks from the front of the other queues.
+ *
+ * ParallelizeImageRegion and ParallelizeArray do not split the work into a
+ * fixed set of chunks up front. Instead, the range is lazily halved: the
+ * thread processing a piece keeps splitting it, leaving the other halves
+ * available for stealing, until the piece is smaller than the grain size
+ * implied by the number of work units. A slow chunk therefore no longer
+ * stalls the whole operation.
+ *
+ * A thread that waits for its tasks to complete keeps executing pending
+ * tasks instead of blocking. Nested parallel calls, e.g. a filter updated
+ * inside the DynamicThreadedGenerateData of another filter, thus share the
+ * same set of worker threads instead of oversubscribing the machine.
+ *
+ * The worker threads are shared among all instances of this class.
+ * Like PoolMultiThreader, the number of worker threads can only grow.
+ *
+ * \ingroup OSSystemObjects
+ *
+ * \ingroup ITKCommon
+ */
+
+class ITKCommon_EXPORT WorkStealingMultiThreader : public MultiThreaderBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingMultiThreader);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingMultiThreader;
+  using Superclass = MultiThreaderBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(WorkStealingMultiThreader);
+
+  /** Get/Set the number of work units to create. WorkStealingMultiThreader
+   * does not limit the number of work units. SingleMethodExecute creates
+   * this many tasks, while ParallelizeArray and ParallelizeImageRegion use it
+   * to determine the smallest piece of work that is not split any further. */
+  void
+  SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits) override;
+
+  /** Execute the SingleMethod (as define by SetSingleMethod) using
+   * m_NumberOfWorkUnits work units. */
+  void
+  SingleMethodExecute() override;
+
+  /** Set the SingleMethod to f() and the UserData field of the
+   * WorkUnitInfo that is passed to it will be data.
+   * This method must be of type itkThreadFunctionType and
+   * must take a single argument of type void. */
+  void
+  SetSingleMethod(ThreadFunctionType, void * data) override;
+
+  /** Parallelize an operation over an array. If filter argument is not nullptr,
+   * this function will update its progress as each index is completed. */
+  void
+  ParallelizeArray(SizeValueType             firstIndex,
+                   SizeValueType             lastIndexPlus1,
+                   ArrayThreadingFunctorType aFunc,
+                   ProcessObject *           filter) override;
+
+  /** Recursively break up region into smaller chunks, and call the function
+   * with chunks as parameters. */
+  using Superclass::ParallelizeImageRegion;
+  void
+  ParallelizeImageRegion(unsigned int         dimension,
+                         const IndexValueType index[],
+                         const SizeValueType  size[],
+                         ThreadingFunctorType funcP,
+                         ProcessObject *      filter) override;
+
+  /** Set the number of threads to use. The worker threads are shared
+   * by all WorkStealingMultiThreader instances, so their number
+   * can only INCREASE. */
+  void
+  SetMaximumNumberOfThreads(ThreadIdType numberOfThreads) override;
+
+protected:
+  WorkStealingMultiThreader();
+  ~WorkStealingMultiThreader() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Friends of Multithreader.
+   * ProcessObject is a friend so that it can call PrintSelf() on its
+   * Multithreader. */
+  friend class ProcessObject;
+};
+
+} // end namespace itk
+#endif
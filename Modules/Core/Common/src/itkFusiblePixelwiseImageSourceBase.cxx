@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkFusiblePixelwiseImageSourceBase.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+
+namespace itk
+{
+
+itkGetGlobalValueMacro(FusiblePixelwiseImageSourceBase, bool, GlobalDefaultPixelwiseFusion, false);
+
+bool * FusiblePixelwiseImageSourceBase::m_GlobalDefaultPixelwiseFusion;
+
+namespace
+{
+FusiblePixelwiseImageSourceBase *
+GetFusibleSource(const DataObject * input)
+{
+  return input == nullptr ? nullptr : dynamic_cast<FusiblePixelwiseImageSourceBase *>(input->GetSource().GetPointer());
+}
+} // namespace
+
+void
+FusiblePixelwiseImageSourceBase::SetGlobalDefaultPixelwiseFusion(bool val)
+{
+  itkInitGlobalsMacro(GlobalDefaultPixelwiseFusion);
+  *m_GlobalDefaultPixelwiseFusion = val;
+}
+
+bool
+FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion()
+{
+  return *FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusionPointer();
+}
+
+void
+FusiblePixelwiseImageSourceBase::FuseInputs(ProcessObject * consumer, bool computeFusedInputs)
+{
+  for (const auto & input : consumer->GetInputs())
+  {
+    FusiblePixelwiseImageSourceBase * const source = GetFusibleSource(input);
+    if (source != nullptr)
+    {
+      // Like DataObject::UpdateOutputData, check whether the input must be generated.
+      const bool mustBeGenerated = input->GetUpdateMTime() < input->GetPipelineMTime() || input->GetDataReleased() ||
+                                   input->RequestedRegionIsOutsideOfTheBufferedRegion();
+
+      source->m_OutputFused = computeFusedInputs && source->CanFuseOutput() && mustBeGenerated;
+    }
+  }
+}
+
+bool
+FusiblePixelwiseImageSourceBase::HasFusedInputs(const ProcessObject * consumer)
+{
+  // ProcessObject::GetInputs() is not const-correct.
+  for (const auto & input : const_cast<ProcessObject *>(consumer)->GetInputs())
+  {
+    if (GetFusedSource(input) != nullptr)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(ProcessObject * consumer)
+{
+  for (const auto & input : consumer->GetInputs())
+  {
+    FusiblePixelwiseImageSourceBase * const source = GetFusedSource(input);
+    if (source != nullptr)
+    {
+      source->m_OutputFused = false;
+      source->ReleaseInputsOfFusedOutput();
+      input->ReleaseData();
+    }
+  }
+}
+
+FusiblePixelwiseImageSourceBase *
+FusiblePixelwiseImageSourceBase::GetFusedSource(const DataObject * input)
+{
+  FusiblePixelwiseImageSourceBase * const source = GetFusibleSource(input);
+  return (source != nullptr && source->m_OutputFused) ? source : nullptr;
+}
+
+} // end namespace itk
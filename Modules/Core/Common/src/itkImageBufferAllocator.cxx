@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm> // For min.
+#include <cstring>   // For memset.
+#include <mutex>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals
+{
+  ImageBufferAllocatorGlobals() = default;
+
+  // The environment variable ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATION is
+  // only used when SetGlobalDefaultPolicy was not called before the first
+  // GetGlobalDefaultPolicy call.
+  bool       m_GlobalDefaultPolicyIsInitialized{ false };
+  std::mutex m_GlobalDefaultPolicyMutex;
+
+  ImageBufferAllocator::PolicyEnum m_GlobalDefaultPolicy{ ImageBufferAllocator::PolicyEnum::New };
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+namespace
+{
+// Sets the memory to zero. With more than one work unit, each work unit zeroes a
+// contiguous part of the buffer, in the same way as ParallelizeArray splits a range.
+void
+ZeroMemoryInParallel(void * memory, size_t numberOfBytes)
+{
+  constexpr size_t minimumBytesPerWorkUnit = size_t{ 1 } << 16;
+
+  const MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const auto                       numberOfWorkUnits = static_cast<SizeValueType>(std::min<size_t>(
+    threader->GetNumberOfWorkUnits(), std::max<size_t>(1, numberOfBytes / minimumBytesPerWorkUnit)));
+  if (numberOfWorkUnits <= 1)
+  {
+    std::memset(memory, 0, numberOfBytes);
+    return;
+  }
+  threader->SetNumberOfWorkUnits(static_cast<ThreadIdType>(numberOfWorkUnits));
+
+  const size_t bytesPerWorkUnit = numberOfBytes / numberOfWorkUnits;
+  threader->ParallelizeArray(
+    0,
+    numberOfWorkUnits,
+    [memory, numberOfBytes, numberOfWorkUnits, bytesPerWorkUnit](SizeValueType workUnit) {
+      const size_t begin = workUnit * bytesPerWorkUnit;
+      const size_t end = (workUnit + 1 == numberOfWorkUnits) ? numberOfBytes : begin + bytesPerWorkUnit;
+      std::memset(static_cast<char *>(memory) + begin, 0, end - begin);
+    },
+    nullptr);
+}
+} // namespace
+
+void
+ImageBufferAllocator::SetGlobalDefaultPolicy(PolicyEnum policy)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_GlobalDefaultPolicyMutex);
+  m_PimplGlobals->m_GlobalDefaultPolicy = policy;
+  m_PimplGlobals->m_GlobalDefaultPolicyIsInitialized = true;
+}
+
+ImageBufferAllocator::PolicyEnum
+ImageBufferAllocator::GetGlobalDefaultPolicy()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_GlobalDefaultPolicyMutex);
+  if (!m_PimplGlobals->m_GlobalDefaultPolicyIsInitialized)
+  {
+    std::string envVar;
+    if (itksys::SystemTools::GetEnv("ITK_GLOBAL_DEFAULT_IMAGE_BUFFER_ALLOCATION", envVar))
+    {
+      const PolicyEnum policy = PolicyFromString(envVar);
+      if (policy != PolicyEnum::Unknown)
+      {
+        m_PimplGlobals->m_GlobalDefaultPolicy = policy;
+      }
+    }
+    m_PimplGlobals->m_GlobalDefaultPolicyIsInitialized = true;
+  }
+  return m_PimplGlobals->m_GlobalDefaultPolicy;
+}
+
+ImageBufferAllocator::PolicyEnum
+ImageBufferAllocator::PolicyFromString(std::string policyString)
+{
+  policyString = itksys::SystemTools::UpperCase(policyString);
+  if (policyString == "NEW")
+  {
+    return PolicyEnum::New;
+  }
+  if (policyString == "ALIGNED")
+  {
+    return PolicyEnum::Aligned;
+  }
+  if (policyString == "HUGEPAGES")
+  {
+    return PolicyEnum::HugePages;
+  }
+  if (policyString == "PARALLELFIRSTTOUCH")
+  {
+    return PolicyEnum::ParallelFirstTouch;
+  }
+  return PolicyEnum::Unknown;
+}
+
+std::string
+ImageBufferAllocator::PolicyToString(PolicyEnum policy)
+{
+  switch (policy)
+  {
+    case PolicyEnum::New:
+      return "New";
+    case PolicyEnum::Aligned:
+      return "Aligned";
+    case PolicyEnum::HugePages:
+      return "HugePages";
+    case PolicyEnum::ParallelFirstTouch:
+      return "ParallelFirstTouch";
+    case PolicyEnum::Unknown:
+    default:
+      return "Unknown";
+  }
+}
+
+size_t
+ImageBufferAllocator::GetAlignment(size_t numberOfBytes, PolicyEnum policy)
+{
+  if (policy == PolicyEnum::HugePages && numberOfBytes >= HugePageSize)
+  {
+    return HugePageSize;
+  }
+  return CacheLineSize;
+}
+
+void *
+ImageBufferAllocator::Allocate(size_t numberOfBytes, PolicyEnum policy, bool zeroInitialize)
+{
+  if (policy == PolicyEnum::New || policy == PolicyEnum::Unknown)
+  {
+    itkGenericExceptionMacro("ImageBufferAllocator can not allocate memory with the policy " << policy);
+  }
+
+  const size_t alignment = GetAlignment(numberOfBytes, policy);
+  // Round the size up to a multiple of the alignment, as required by aligned_alloc on some platforms.
+  const size_t allocatedBytes = std::max(alignment, (numberOfBytes + alignment - 1) / alignment * alignment);
+
+  void * const memory = (allocatedBytes >= numberOfBytes)
+                          ? ::operator new(allocatedBytes, std::align_val_t{ alignment }, std::nothrow)
+                          : nullptr;
+  if (memory == nullptr)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (alignment == HugePageSize)
+  {
+    // Only a hint: the buffer is still usable when the system does not support transparent huge pages.
+    madvise(memory, allocatedBytes, MADV_HUGEPAGE);
+  }
+#endif
+
+  if (policy == PolicyEnum::ParallelFirstTouch)
+  {
+    ZeroMemoryInParallel(memory, numberOfBytes);
+  }
+  else if (zeroInitialize)
+  {
+    std::memset(memory, 0, numberOfBytes);
+  }
+  return memory;
+}
+
+void
+ImageBufferAllocator::Deallocate(void * memory, size_t numberOfBytes, PolicyEnum policy) noexcept
+{
+  if (memory != nullptr)
+  {
+    ::operator delete(memory, std::align_val_t{ GetAlignment(numberOfBytes, policy) });
+  }
+}
+
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const ImageBufferAllocatorEnums::Policy value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case ImageBufferAllocatorEnums::Policy::New:
+        return "itk::ImageBufferAllocatorEnums::Policy::New";
+      case ImageBufferAllocatorEnums::Policy::Aligned:
+        return "itk::ImageBufferAllocatorEnums::Policy::Aligned";
+      case ImageBufferAllocatorEnums::Policy::HugePages:
+        return "itk::ImageBufferAllocatorEnums::Policy::HugePages";
+      case ImageBufferAllocatorEnums::Policy::ParallelFirstTouch:
+        return "itk::ImageBufferAllocatorEnums::Policy::ParallelFirstTouch";
+      case ImageBufferAllocatorEnums::Policy::Unknown:
+        return "itk::ImageBufferAllocatorEnums::Policy::Unknown";
+      default:
+        return "INVALID VALUE FOR itk::ImageBufferAllocatorEnums::Policy";
+    }
+  }();
+}
+
+} // end namespace itk
@@ -0,0 +1,311 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkSingleton.h"
+
+#include <atomic>
+#include <cstring> // For memset.
+#include <map>
+#include <mutex>
+#include <utility> // For pair.
+#include <vector>
+
+namespace itk
+{
+
+struct ImageBufferPoolGlobals
+{
+  using BucketKey = std::pair<ImageBufferPool::PolicyEnum, size_t>;
+
+  ImageBufferPoolGlobals() = default;
+  ~ImageBufferPoolGlobals() { this->DeallocateBuffers(0); }
+
+  // Deallocates buffers until the pool holds at most maximumNumberOfBytes bytes.
+  // The caller must hold m_Mutex (or be the destructor).
+  void
+  DeallocateBuffers(SizeValueType maximumNumberOfBytes)
+  {
+    for (auto bucket = m_Buckets.begin(); bucket != m_Buckets.end() && m_NumberOfPooledBytes > maximumNumberOfBytes;)
+    {
+      auto & buffers = bucket->second;
+      while (!buffers.empty() && m_NumberOfPooledBytes > maximumNumberOfBytes)
+      {
+        ImageBufferAllocator::Deallocate(buffers.back(), bucket->first.second, bucket->first.first);
+        buffers.pop_back();
+        m_NumberOfPooledBytes -= bucket->first.second;
+        --m_NumberOfPooledBuffers;
+      }
+      bucket = buffers.empty() ? m_Buckets.erase(bucket) : std::next(bucket);
+    }
+  }
+
+  std::atomic<bool> m_Enabled{ false };
+  std::mutex        m_Mutex;
+
+  std::map<BucketKey, std::vector<void *>> m_Buckets;
+
+  SizeValueType m_MaximumNumberOfBuffersPerBucket{ 4 };
+  SizeValueType m_MaximumNumberOfPooledBytes{ SizeValueType{ 1 } << 30 };
+  SizeValueType m_NumberOfPooledBuffers{ 0 };
+  SizeValueType m_NumberOfPooledBytes{ 0 };
+
+  SizeValueType m_NumberOfHits{ 0 };
+  SizeValueType m_NumberOfMisses{ 0 };
+  SizeValueType m_NumberOfRecycledBuffers{ 0 };
+  SizeValueType m_NumberOfDiscardedBuffers{ 0 };
+};
+
+itkGetGlobalSimpleMacro(ImageBufferPool, ImageBufferPoolGlobals, PimplGlobals);
+
+ImageBufferPoolGlobals * ImageBufferPool::m_PimplGlobals;
+
+namespace
+{
+// The size of the buffers in the bucket of a buffer of numberOfBytes bytes. ImageBufferAllocator
+// allocates memory in multiples of its alignment anyway, so rounding up does not waste memory.
+size_t
+GetBucketSize(size_t numberOfBytes)
+{
+  constexpr size_t cacheLineSize = ImageBufferAllocator::CacheLineSize;
+  return (numberOfBytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+}
+} // namespace
+
+void
+ImageBufferPool::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Enabled = enabled;
+  if (!enabled)
+  {
+    m_PimplGlobals->DeallocateBuffers(0);
+  }
+}
+
+bool
+ImageBufferPool::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+void
+ImageBufferPool::SetMaximumNumberOfBuffersPerBucket(SizeValueType numberOfBuffers)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumNumberOfBuffersPerBucket = numberOfBuffers;
+  for (auto & bucket : m_PimplGlobals->m_Buckets)
+  {
+    auto & buffers = bucket.second;
+    while (buffers.size() > numberOfBuffers)
+    {
+      ImageBufferAllocator::Deallocate(buffers.back(), bucket.first.second, bucket.first.first);
+      buffers.pop_back();
+      m_PimplGlobals->m_NumberOfPooledBytes -= bucket.first.second;
+      --m_PimplGlobals->m_NumberOfPooledBuffers;
+    }
+  }
+}
+
+SizeValueType
+ImageBufferPool::GetMaximumNumberOfBuffersPerBucket()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumNumberOfBuffersPerBucket;
+}
+
+void
+ImageBufferPool::SetMaximumNumberOfPooledBytes(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumNumberOfPooledBytes = numberOfBytes;
+  m_PimplGlobals->DeallocateBuffers(numberOfBytes);
+}
+
+SizeValueType
+ImageBufferPool::GetMaximumNumberOfPooledBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumNumberOfPooledBytes;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfPooledBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfPooledBuffers;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfPooledBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfPooledBytes;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfHits()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfHits;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfMisses()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfMisses;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfRecycledBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfRecycledBuffers;
+}
+
+SizeValueType
+ImageBufferPool::GetNumberOfDiscardedBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_NumberOfDiscardedBuffers;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_NumberOfHits = 0;
+  m_PimplGlobals->m_NumberOfMisses = 0;
+  m_PimplGlobals->m_NumberOfRecycledBuffers = 0;
+  m_PimplGlobals->m_NumberOfDiscardedBuffers = 0;
+}
+
+void
+ImageBufferPool::Clear()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->DeallocateBuffers(0);
+}
+
+void *
+ImageBufferPool::Acquire(size_t numberOfBytes, PolicyEnum policy, bool zeroInitialize)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const size_t bucketSize = GetBucketSize(numberOfBytes);
+
+  if (m_PimplGlobals->m_Enabled)
+  {
+    void * memory = nullptr;
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+
+      const auto bucket = m_PimplGlobals->m_Buckets.find({ policy, bucketSize });
+      if (bucket != m_PimplGlobals->m_Buckets.end() && !bucket->second.empty())
+      {
+        memory = bucket->second.back();
+        bucket->second.pop_back();
+        m_PimplGlobals->m_NumberOfPooledBytes -= bucketSize;
+        --m_PimplGlobals->m_NumberOfPooledBuffers;
+        ++m_PimplGlobals->m_NumberOfHits;
+      }
+      else
+      {
+        ++m_PimplGlobals->m_NumberOfMisses;
+      }
+    }
+    if (memory != nullptr)
+    {
+      if (zeroInitialize)
+      {
+        std::memset(memory, 0, numberOfBytes);
+      }
+      return memory;
+    }
+  }
+  return ImageBufferAllocator::Allocate(bucketSize, policy, zeroInitialize);
+}
+
+void
+ImageBufferPool::Release(void * memory, size_t numberOfBytes, PolicyEnum policy) noexcept
+{
+  if (memory == nullptr)
+  {
+    return;
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+
+  const size_t bucketSize = GetBucketSize(numberOfBytes);
+
+  // The globals are already destroyed when an image is released during the destruction of static objects.
+  if (m_PimplGlobals != nullptr && m_PimplGlobals->m_Enabled)
+  {
+    const std::lock_guard<std::mutex> lockGuard(m_PimplGlobals->m_Mutex);
+
+    if (m_PimplGlobals->m_NumberOfPooledBytes + bucketSize <= m_PimplGlobals->m_MaximumNumberOfPooledBytes)
+    {
+      try
+      {
+        auto & buffers = m_PimplGlobals->m_Buckets[{ policy, bucketSize }];
+        if (buffers.size() < m_PimplGlobals->m_MaximumNumberOfBuffersPerBucket)
+        {
+          buffers.push_back(memory);
+          m_PimplGlobals->m_NumberOfPooledBytes += bucketSize;
+          ++m_PimplGlobals->m_NumberOfPooledBuffers;
+          ++m_PimplGlobals->m_NumberOfRecycledBuffers;
+          return;
+        }
+      }
+      catch (const std::bad_alloc &)
+      {
+        // Deallocate the memory when the pool cannot hold it.
+      }
+    }
+    ++m_PimplGlobals->m_NumberOfDiscardedBuffers;
+  }
+  ImageBufferAllocator::Deallocate(memory, bucketSize, policy);
+}
+
+} // end namespace itk
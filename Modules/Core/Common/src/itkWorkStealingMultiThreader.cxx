@@ -0,0 +1,491 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkProcessObject.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+namespace
+{
+using TaskType = std::function<void()>;
+
+/** A double-ended queue of tasks. The owner pushes and pops at the back,
+ * thieves take from the front. */
+struct TaskQueue
+{
+  std::mutex            m_Mutex;
+  std::deque<TaskType> m_Tasks;
+};
+
+/** Index of the queue owned by the current thread. Queue 0 is shared by all
+ * threads which are not workers of the scheduler (e.g. the main thread). */
+thread_local unsigned int currentQueueIndex = 0;
+
+class WorkStealingScheduler
+{
+public:
+  static WorkStealingScheduler &
+  GetInstance()
+  {
+    static WorkStealingScheduler scheduler;
+    return scheduler;
+  }
+
+  /** Push a task onto the queue of the calling thread and wake up one idle thread. */
+  void
+  Submit(TaskType task)
+  {
+    TaskQueue & queue = *m_Queues[currentQueueIndex];
+    {
+      const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+      queue.m_Tasks.push_back(std::move(task));
+    }
+    this->Signal(false);
+  }
+
+  /** Signal that new work is available, or that a task group has completed. */
+  void
+  Signal(bool wakeAll)
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+      ++m_SignalCount;
+    }
+    if (wakeAll)
+    {
+      m_Condition.notify_all();
+    }
+    else
+    {
+      m_Condition.notify_one();
+    }
+  }
+
+  /** Execute a task taken from the own queue, or stolen from another one.
+   * Returns false if no task was found. */
+  bool
+  TryExecuteOneTask()
+  {
+    TaskType           task;
+    const unsigned int ownIndex = currentQueueIndex;
+    {
+      TaskQueue &                       queue = *m_Queues[ownIndex];
+      const std::lock_guard<std::mutex> lockGuard(queue.m_Mutex);
+      if (!queue.m_Tasks.empty())
+      {
+        task = std::move(queue.m_Tasks.back());
+        queue.m_Tasks.pop_back();
+      }
+    }
+    const unsigned int numberOfQueues = m_NumberOfQueues.load();
+    for (unsigned int k = 1; !task && k < numberOfQueues; ++k)
+    {
+      TaskQueue &                       victim = *m_Queues[(ownIndex + k) % numberOfQueues];
+      const std::lock_guard<std::mutex> lockGuard(victim.m_Mutex);
+      if (!victim.m_Tasks.empty())
+      {
+        task = std::move(victim.m_Tasks.front());
+        victim.m_Tasks.pop_front();
+      }
+    }
+    if (!task)
+    {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  /** Keep executing tasks until `isDone()` returns true. Sleeps only if there is no task to execute. */
+  template <typename TPredicate>
+  void
+  ExecuteTasksUntil(const TPredicate & isDone)
+  {
+    while (!isDone())
+    {
+      std::uint64_t signalCount;
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+        signalCount = m_SignalCount;
+      }
+      if (this->TryExecuteOneTask())
+      {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_SleepMutex);
+      m_Condition.wait(lock, [this, signalCount, &isDone] { return m_SignalCount != signalCount || isDone(); });
+    }
+  }
+
+  /** Total number of threads which can execute tasks, including the calling thread. */
+  ThreadIdType
+  GetNumberOfThreads() const
+  {
+    return m_NumberOfQueues.load();
+  }
+
+  /** Grow the number of worker threads, so that numberOfThreads threads
+   * (including the calling thread) can execute tasks. */
+  void
+  EnsureNumberOfThreads(ThreadIdType numberOfThreads)
+  {
+    numberOfThreads = std::clamp<ThreadIdType>(numberOfThreads, 1, ITK_MAX_THREADS);
+    const std::lock_guard<std::mutex> lockGuard(m_ThreadsMutex);
+    for (unsigned int index = m_NumberOfQueues.load(); index < numberOfThreads; ++index)
+    {
+      m_Queues[index] = std::make_unique<TaskQueue>();
+      m_NumberOfQueues.store(index + 1);
+      m_Threads.emplace_back(&WorkStealingScheduler::WorkerExecute, this, index);
+    }
+  }
+
+private:
+  WorkStealingScheduler()
+  {
+    m_Queues[0] = std::make_unique<TaskQueue>();
+    this->EnsureNumberOfThreads(MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  }
+
+  ~WorkStealingScheduler()
+  {
+    {
+      const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+      m_Stopping = true;
+    }
+    m_Condition.notify_all();
+    for (auto & thread : m_Threads)
+    {
+#if defined(_WIN32) && defined(ITKCommon_EXPORTS)
+      // Threads have already been terminated when the DLL is detached, see ThreadPool.
+      thread.detach();
+#else
+      thread.join();
+#endif
+    }
+  }
+
+  void
+  WorkerExecute(unsigned int queueIndex)
+  {
+    currentQueueIndex = queueIndex;
+    while (true)
+    {
+      std::uint64_t signalCount;
+      {
+        const std::lock_guard<std::mutex> lockGuard(m_SleepMutex);
+        if (m_Stopping)
+        {
+          return;
+        }
+        signalCount = m_SignalCount;
+      }
+      if (this->TryExecuteOneTask())
+      {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_SleepMutex);
+      m_Condition.wait(lock, [this, signalCount] { return m_Stopping || m_SignalCount != signalCount; });
+    }
+  }
+
+  // Queue 0 is shared by non-worker threads, queue i > 0 belongs to worker i.
+  std::unique_ptr<TaskQueue> m_Queues[ITK_MAX_THREADS]{};
+  std::atomic<unsigned int>  m_NumberOfQueues{ 1 };
+
+  std::mutex               m_ThreadsMutex;
+  std::vector<std::thread> m_Threads; // guarded by m_ThreadsMutex
+
+  std::mutex              m_SleepMutex;
+  std::condition_variable m_Condition;
+  std::uint64_t           m_SignalCount{ 0 }; // guarded by m_SleepMutex
+  bool                    m_Stopping{ false }; // guarded by m_SleepMutex
+};
+
+/** A set of tasks which can be waited for. The first exception thrown by any
+ * of the tasks is rethrown by Wait(), and the tasks which have not started
+ * yet are skipped. */
+class TaskGroup
+{
+public:
+  TaskGroup() = default;
+
+  template <typename TFunction>
+  void
+  Run(TFunction function)
+  {
+    ++m_NumberOfPendingTasks;
+    WorkStealingScheduler::GetInstance().Submit([this, function]() {
+      if (!m_Cancelled)
+      {
+        try
+        {
+          function();
+        }
+        catch (...)
+        {
+          const std::lock_guard<std::mutex> lockGuard(m_ExceptionMutex);
+          if (m_FirstCaughtException == nullptr)
+          {
+            m_FirstCaughtException = std::current_exception();
+          }
+          m_Cancelled = true;
+        }
+      }
+      // `this` may be destroyed as soon as the counter reaches zero
+      WorkStealingScheduler & scheduler = WorkStealingScheduler::GetInstance();
+      if (--m_NumberOfPendingTasks == 0)
+      {
+        scheduler.Signal(true);
+      }
+    });
+  }
+
+  /** Help executing tasks until all the tasks of this group are done. */
+  void
+  Wait()
+  {
+    WorkStealingScheduler::GetInstance().ExecuteTasksUntil([this] { return m_NumberOfPendingTasks == 0; });
+    if (m_FirstCaughtException != nullptr)
+    {
+      std::rethrow_exception(m_FirstCaughtException);
+    }
+  }
+
+private:
+  std::atomic<SizeValueType> m_NumberOfPendingTasks{ 0 };
+  std::atomic<bool>          m_Cancelled{ false };
+  std::mutex                 m_ExceptionMutex;
+  std::exception_ptr         m_FirstCaughtException;
+};
+
+/** Split region into two halves along its highest dimension that can be split.
+ * Region keeps the lower half, upperHalf receives the rest. */
+bool
+SplitRegionInHalf(ImageIORegion & region, ImageIORegion & upperHalf)
+{
+  for (int d = static_cast<int>(region.GetImageDimension()) - 1; d >= 0; --d)
+  {
+    const SizeValueType size = region.GetSize(d);
+    if (size > 1)
+    {
+      upperHalf = region;
+      region.SetSize(d, size / 2);
+      upperHalf.SetIndex(d, region.GetIndex(d) + static_cast<IndexValueType>(size / 2));
+      upperHalf.SetSize(d, size - size / 2);
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+ProcessRegionRecursively(TaskGroup &                                     group,
+                         ImageIORegion                                   region,
+                         SizeValueType                                   grainSize,
+                         const MultiThreaderBase::ThreadingFunctorType & funcP,
+                         ProcessObject *                                 filter,
+                         SizeValueType                                   totalCount)
+{
+  // Lazily split off the upper halves, so that idle threads can steal them.
+  ImageIORegion upperHalf;
+  while (region.GetNumberOfPixels() > grainSize && SplitRegionInHalf(region, upperHalf))
+  {
+    group.Run([&group, upperHalf, grainSize, &funcP, filter, totalCount] {
+      ProcessRegionRecursively(group, upperHalf, grainSize, funcP, filter, totalCount);
+    });
+  }
+
+  TotalProgressReporter progress(filter, totalCount, 100);
+  progress.CheckAbortGenerateData();
+
+  funcP(&region.GetIndex()[0], &region.GetSize()[0]);
+
+  progress.Completed(region.GetNumberOfPixels());
+}
+
+void
+ProcessRangeRecursively(TaskGroup &                                          group,
+                        SizeValueType                                        first,
+                        SizeValueType                                        afterLast,
+                        SizeValueType                                        grainSize,
+                        const MultiThreaderBase::ArrayThreadingFunctorType & aFunc,
+                        ProcessObject *                                      filter,
+                        SizeValueType                                        totalCount)
+{
+  while (afterLast - first > grainSize)
+  {
+    const SizeValueType middle = first + (afterLast - first) / 2;
+    group.Run([&group, middle, afterLast, grainSize, &aFunc, filter, totalCount] {
+      ProcessRangeRecursively(group, middle, afterLast, grainSize, aFunc, filter, totalCount);
+    });
+    afterLast = middle;
+  }
+
+  TotalProgressReporter progress(filter, totalCount, 100);
+  progress.CheckAbortGenerateData();
+  for (SizeValueType i = first; i < afterLast; ++i)
+  {
+    aFunc(i);
+    progress.CompletedPixel();
+  }
+}
+} // namespace
+
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+{
+  WorkStealingScheduler & scheduler = WorkStealingScheduler::GetInstance();
+
+  const ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    // Many more work units than threads, so that load can be balanced by stealing.
+    m_NumberOfWorkUnits = 16 * defaultThreads;
+  }
+  m_MaximumNumberOfThreads = scheduler.GetNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = std::move(f);
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits)
+{
+  m_NumberOfWorkUnits = std::max(1u, numberOfWorkUnits);
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  WorkStealingScheduler & scheduler = WorkStealingScheduler::GetInstance();
+  scheduler.EnsureNumberOfThreads(m_MaximumNumberOfThreads);
+  m_MaximumNumberOfThreads = scheduler.GetNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionMacro("No single method set!");
+  }
+
+  TaskGroup group;
+  for (ThreadIdType workUnit = 0; workUnit < m_NumberOfWorkUnits; ++workUnit)
+  {
+    group.Run([this, workUnit] {
+      WorkUnitInfo workUnitInfo{};
+      workUnitInfo.WorkUnitID = workUnit;
+      workUnitInfo.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      workUnitInfo.UserData = m_SingleData;
+      m_SingleMethod(&workUnitInfo);
+    });
+  }
+  group.Wait();
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType count = lastIndexPlus1 - firstIndex;
+    const SizeValueType grainSize = std::max<SizeValueType>(1, count / m_NumberOfWorkUnits);
+
+    TaskGroup group;
+    group.Run([&group, firstIndex, lastIndexPlus1, grainSize, &aFunc, filter, count] {
+      ProcessRangeRecursively(group, firstIndex, lastIndexPlus1, grainSize, aFunc, filter, count);
+    });
+    group.Wait();
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  const ProgressReporter progressStartEnd(filter, 0, 1);
+
+  ImageIORegion region(dimension);
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    region.SetIndex(d, index[d]);
+    region.SetSize(d, size[d]);
+  }
+  const SizeValueType totalCount = region.GetNumberOfPixels();
+
+  if (m_NumberOfWorkUnits == 1 || totalCount <= 1)
+  {
+    funcP(index, size); // process whole region
+  }
+  else
+  {
+    const SizeValueType grainSize =
+      std::max<SizeValueType>(1, (totalCount + m_NumberOfWorkUnits - 1) / m_NumberOfWorkUnits);
+
+    TaskGroup group;
+    group.Run([&group, &region, grainSize, &funcP, filter, totalCount] {
+      ProcessRegionRecursively(group, region, grainSize, funcP, filter, totalCount);
+    });
+    group.Wait();
+  }
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+} // namespace itk
@@ -0,0 +1,231 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace
+{
+template <typename TInput, typename TOutput>
+class AffineFunctor
+{
+public:
+  bool
+  operator==(const AffineFunctor & other) const
+  {
+    return m_Scale == other.m_Scale && m_Shift == other.m_Shift;
+  }
+  bool
+  operator!=(const AffineFunctor & other) const
+  {
+    return !(*this == other);
+  }
+
+  TOutput
+  operator()(const TInput & value) const
+  {
+    return static_cast<TOutput>(m_Scale * value + m_Shift);
+  }
+
+  double m_Scale{ 1.0 };
+  double m_Shift{ 0.0 };
+};
+
+using InputImageType = itk::Image<short, 3>;
+using RealImageType = itk::Image<float, 3>;
+using CastFilterType = itk::UnaryFunctorImageFilter<InputImageType, RealImageType, AffineFunctor<short, float>>;
+using RealFilterType = itk::UnaryFunctorImageFilter<RealImageType, RealImageType, AffineFunctor<float, float>>;
+
+// A pixel-wise filter that, like RescaleIntensityImageFilter, needs its whole input before generating its output.
+class WholeInputFilter : public RealFilterType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WholeInputFilter);
+
+  using Self = WholeInputFilter;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  bool
+  CanComputeFusedInputs() const override
+  {
+    return false;
+  }
+
+protected:
+  WholeInputFilter() = default;
+};
+
+InputImageType::Pointer
+MakeInputImage()
+{
+  const auto image = InputImageType::New();
+  image->SetRegions(InputImageType::SizeType{ { 13, 7, 5 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<short>(index[0] - 3 * index[1] + 7 * index[2]));
+  }
+  return image;
+}
+
+// A Cast -> Scale -> Shift chain.
+struct Chain
+{
+  explicit Chain(const InputImageType * input, bool pixelwiseFusion)
+  {
+    m_Cast->SetInput(input);
+    m_Cast->GetFunctor().m_Scale = 0.5;
+    m_Scale->SetInput(m_Cast->GetOutput());
+    m_Scale->GetFunctor().m_Scale = 3.0;
+    m_Shift->SetInput(m_Scale->GetOutput());
+    m_Shift->GetFunctor().m_Shift = -2.0;
+
+    m_Cast->SetPixelwiseFusion(pixelwiseFusion);
+    m_Scale->SetPixelwiseFusion(pixelwiseFusion);
+    m_Shift->SetPixelwiseFusion(pixelwiseFusion);
+  }
+
+  const CastFilterType::Pointer m_Cast{ CastFilterType::New() };
+  const RealFilterType::Pointer m_Scale{ RealFilterType::New() };
+  const RealFilterType::Pointer m_Shift{ RealFilterType::New() };
+};
+
+void
+ExpectEqualImages(const RealImageType * expected, const RealImageType * actual)
+{
+  ASSERT_EQ(expected->GetBufferedRegion(), actual->GetBufferedRegion());
+  for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_EQ(it.Get(), actual->GetPixel(it.GetIndex())) << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(FusiblePixelwiseImageSource, FusionIsOffByDefault)
+{
+  EXPECT_FALSE(itk::FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion());
+  EXPECT_FALSE(RealFilterType::New()->GetPixelwiseFusion());
+
+  itk::FusiblePixelwiseImageSourceBase::SetGlobalDefaultPixelwiseFusion(true);
+  EXPECT_TRUE(RealFilterType::New()->GetPixelwiseFusion());
+  itk::FusiblePixelwiseImageSourceBase::SetGlobalDefaultPixelwiseFusion(false);
+}
+
+
+TEST(FusiblePixelwiseImageSource, FusedChainProducesSameOutputWithoutIntermediateImages)
+{
+  const auto input = MakeInputImage();
+
+  Chain unfused(input, false);
+  unfused.m_Shift->Update();
+  EXPECT_NE(unfused.m_Scale->GetOutput()->GetBufferPointer(), nullptr);
+
+  Chain fused(input, true);
+  fused.m_Shift->Update();
+  ExpectEqualImages(unfused.m_Shift->GetOutput(), fused.m_Shift->GetOutput());
+
+  // The intermediate images were never allocated, and are released.
+  EXPECT_EQ(fused.m_Cast->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_EQ(fused.m_Scale->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_TRUE(fused.m_Scale->GetOutput()->GetDataReleased());
+  EXPECT_FALSE(fused.m_Scale->IsOutputFused());
+
+  // An intermediate output that is requested afterwards is generated normally.
+  fused.m_Scale->Update();
+  ExpectEqualImages(unfused.m_Scale->GetOutput(), fused.m_Scale->GetOutput());
+
+  // Updating the chain again after a modification fuses it again.
+  fused.m_Cast->GetFunctor().m_Shift = 1.0;
+  unfused.m_Cast->GetFunctor().m_Shift = 1.0;
+  fused.m_Cast->Modified();
+  unfused.m_Cast->Modified();
+  fused.m_Shift->Update();
+  unfused.m_Shift->Update();
+  ExpectEqualImages(unfused.m_Shift->GetOutput(), fused.m_Shift->GetOutput());
+  EXPECT_EQ(fused.m_Scale->GetOutput()->GetBufferPointer(), nullptr);
+}
+
+
+TEST(FusiblePixelwiseImageSource, OutputIsOnlyFusedWhenItsSourceOptsIn)
+{
+  const auto input = MakeInputImage();
+
+  Chain fused(input, true);
+  fused.m_Scale->PixelwiseFusionOff();
+  fused.m_Shift->Update();
+
+  // The output of Scale is kept for its other users, while the output of Cast is fused into Scale.
+  EXPECT_NE(fused.m_Scale->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_EQ(fused.m_Cast->GetOutput()->GetBufferPointer(), nullptr);
+
+  Chain unfused(input, false);
+  unfused.m_Shift->Update();
+  ExpectEqualImages(unfused.m_Shift->GetOutput(), fused.m_Shift->GetOutput());
+  ExpectEqualImages(unfused.m_Scale->GetOutput(), fused.m_Scale->GetOutput());
+}
+
+
+TEST(FusiblePixelwiseImageSource, ConsumerThatCannotComputeFusedInputsGetsImages)
+{
+  const auto input = MakeInputImage();
+
+  Chain fused(input, true);
+  const auto scale = WholeInputFilter::New();
+  scale->GetFunctor().m_Scale = 3.0;
+  scale->PixelwiseFusionOn();
+  scale->SetInput(fused.m_Cast->GetOutput());
+  fused.m_Shift->SetInput(scale->GetOutput());
+  fused.m_Shift->Update();
+
+  // The input of the WholeInputFilter is generated as an image, while its own output is fused.
+  EXPECT_NE(fused.m_Cast->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_EQ(scale->GetOutput()->GetBufferPointer(), nullptr);
+
+  Chain unfused(input, false);
+  unfused.m_Shift->Update();
+  ExpectEqualImages(unfused.m_Shift->GetOutput(), fused.m_Shift->GetOutput());
+}
+
+
+TEST(FusiblePixelwiseImageSource, FusesStreamedRequestedRegions)
+{
+  const auto input = MakeInputImage();
+
+  Chain unfused(input, false);
+  unfused.m_Shift->Update();
+
+  Chain fused(input, true);
+  RealImageType::RegionType requestedRegion({ { 2, 1, 1 } }, { { 9, 4, 3 } });
+  fused.m_Shift->GetOutput()->SetRequestedRegion(requestedRegion);
+  fused.m_Shift->Update();
+
+  const RealImageType * const output = fused.m_Shift->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<RealImageType> it(output, requestedRegion); !it.IsAtEnd(); ++it)
+  {
+    EXPECT_EQ(it.Get(), unfused.m_Shift->GetOutput()->GetPixel(it.GetIndex()));
+  }
+  EXPECT_EQ(fused.m_Scale->GetOutput()->GetBufferPointer(), nullptr);
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImageBufferAllocator.h"
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include "itkRGBPixel.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+using PolicyEnum = itk::ImageBufferAllocatorEnums::Policy;
+
+constexpr PolicyEnum allocatorPolicies[] = { PolicyEnum::Aligned,
+                                             PolicyEnum::HugePages,
+                                             PolicyEnum::ParallelFirstTouch };
+
+bool
+IsAligned(const void * pointer, size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+// Restores the global default policy at the end of a test.
+class GlobalDefaultPolicyGuard
+{
+public:
+  GlobalDefaultPolicyGuard() = default;
+  ~GlobalDefaultPolicyGuard() { itk::ImageBufferAllocator::SetGlobalDefaultPolicy(m_Policy); }
+
+private:
+  const PolicyEnum m_Policy{ itk::ImageBufferAllocator::GetGlobalDefaultPolicy() };
+};
+
+template <typename TImage>
+void
+ExpectAllocatedWithPolicy(TImage & image, PolicyEnum policy)
+{
+  image.GetPixelContainer()->SetAllocationPolicy(policy);
+  image.AllocateInitialized();
+  EXPECT_EQ(image.GetPixelContainer()->GetAllocationPolicy(), policy);
+
+  const auto * const bufferBegin = image.GetBufferPointer();
+  const auto * const bufferEnd = bufferBegin + image.GetPixelContainer()->Size();
+  EXPECT_TRUE(IsAligned(bufferBegin, itk::ImageBufferAllocator::CacheLineSize)) << policy;
+  EXPECT_TRUE(std::all_of(bufferBegin, bufferEnd, [](auto value) { return value == 0; })) << policy;
+}
+} // namespace
+
+
+TEST(ImageBufferAllocator, ConvertsPolicyFromAndToString)
+{
+  for (const auto policy :
+       { PolicyEnum::New, PolicyEnum::Aligned, PolicyEnum::HugePages, PolicyEnum::ParallelFirstTouch })
+  {
+    const std::string policyString = itk::ImageBufferAllocator::PolicyToString(policy);
+    EXPECT_EQ(itk::ImageBufferAllocator::PolicyFromString(policyString), policy);
+  }
+  EXPECT_EQ(itk::ImageBufferAllocator::PolicyFromString("hugepages"), PolicyEnum::HugePages);
+  EXPECT_EQ(itk::ImageBufferAllocator::PolicyFromString("NoSuchPolicy"), PolicyEnum::Unknown);
+}
+
+
+TEST(ImageBufferAllocator, AllocatesAlignedZeroedMemory)
+{
+  for (const auto policy : allocatorPolicies)
+  {
+    for (const size_t numberOfBytes : { size_t{ 0 }, size_t{ 1 }, size_t{ 1000 }, size_t{ 5 } << 20 })
+    {
+      auto * const memory =
+        static_cast<unsigned char *>(itk::ImageBufferAllocator::Allocate(numberOfBytes, policy, true));
+      ASSERT_NE(memory, nullptr);
+
+      const size_t alignment = itk::ImageBufferAllocator::GetAlignment(numberOfBytes, policy);
+      EXPECT_TRUE(IsAligned(memory, alignment)) << policy << ' ' << numberOfBytes;
+      EXPECT_TRUE(std::all_of(memory, memory + numberOfBytes, [](unsigned char value) { return value == 0; }));
+
+      itk::ImageBufferAllocator::Deallocate(memory, numberOfBytes, policy);
+    }
+  }
+  EXPECT_EQ(itk::ImageBufferAllocator::GetAlignment(size_t{ 4 } << 20, PolicyEnum::HugePages),
+            itk::ImageBufferAllocator::HugePageSize);
+  EXPECT_THROW(itk::ImageBufferAllocator::Allocate(16, PolicyEnum::New, false), itk::ExceptionObject);
+}
+
+
+TEST(ImageBufferAllocator, ImageUsesGlobalDefaultPolicy)
+{
+  const GlobalDefaultPolicyGuard guard;
+
+  using ImageType = itk::Image<float, 3>;
+  EXPECT_EQ(ImageType::New()->GetPixelContainer()->GetAllocationPolicy(),
+            itk::ImageBufferAllocator::GetGlobalDefaultPolicy());
+
+  for (const auto policy : allocatorPolicies)
+  {
+    itk::ImageBufferAllocator::SetGlobalDefaultPolicy(policy);
+    EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultPolicy(), policy);
+
+    const auto image = ImageType::New();
+    EXPECT_EQ(image->GetPixelContainer()->GetAllocationPolicy(), policy);
+    image->SetRegions(ImageType::SizeType{ { 17, 9, 5 } });
+    image->AllocateInitialized();
+    EXPECT_TRUE(IsAligned(image->GetBufferPointer(), itk::ImageBufferAllocator::CacheLineSize));
+    EXPECT_EQ(image->GetPixel({ { 16, 8, 4 } }), 0.0f);
+  }
+}
+
+
+TEST(ImageBufferAllocator, AllocatesImageAndVectorImageBuffers)
+{
+  for (const auto policy : allocatorPolicies)
+  {
+    const auto image = itk::Image<short, 2>::New();
+    image->SetRegions(itk::Size<2>{ { 1000, 700 } });
+    ExpectAllocatedWithPolicy(*image, policy);
+
+    const auto vectorImage = itk::VectorImage<double, 3>::New();
+    vectorImage->SetRegions(itk::Size<3>{ { 20, 30, 10 } });
+    vectorImage->SetNumberOfComponentsPerPixel(4);
+    ExpectAllocatedWithPolicy(*vectorImage, policy);
+
+    // Growing the buffer keeps the values that were already there.
+    const auto container = itk::ImportImageContainer<itk::SizeValueType, itk::RGBPixel<unsigned char>>::New();
+    container->SetAllocationPolicy(policy);
+    container->Reserve(10, true);
+    (*container)[9].Fill(42);
+    container->Reserve(100000, true);
+    EXPECT_EQ((*container)[9][2], 42);
+    EXPECT_EQ((*container)[99999][0], 0);
+    container->Reserve(10);
+    container->Squeeze();
+    EXPECT_EQ(container->Capacity(), 10u);
+    EXPECT_EQ((*container)[9][1], 42);
+    EXPECT_TRUE(IsAligned(container->GetBufferPointer(), itk::ImageBufferAllocator::CacheLineSize));
+
+    // The container may switch policies between allocations.
+    container->SetAllocationPolicy(PolicyEnum::New);
+    container->Reserve(1000);
+    EXPECT_EQ((*container)[9][0], 42);
+    container->Initialize();
+    EXPECT_EQ(container->GetBufferPointer(), nullptr);
+  }
+}
@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImageBufferPool.h"
+#include "itkImage.h"
+#include "itkImageSource.h"
+#include "itkImportImageContainer.h"
+
+#include <algorithm>
+
+namespace
+{
+using PolicyEnum = itk::ImageBufferAllocatorEnums::Policy;
+
+// Enables an empty pool with default limits, and disables it again at the end of a test.
+class EnabledPoolGuard
+{
+public:
+  EnabledPoolGuard()
+  {
+    itk::ImageBufferPool::SetEnabled(false);
+    itk::ImageBufferPool::SetMaximumNumberOfBuffersPerBucket(4);
+    itk::ImageBufferPool::SetMaximumNumberOfPooledBytes(itk::SizeValueType{ 1 } << 30);
+    itk::ImageBufferPool::ResetStatistics();
+    itk::ImageBufferPool::SetEnabled(true);
+  }
+  ~EnabledPoolGuard() { itk::ImageBufferPool::SetEnabled(false); }
+};
+
+// A source of an image filled with zeros.
+template <typename TImage>
+class ZeroImageSource : public itk::ImageSource<TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ZeroImageSource);
+
+  using Self = ZeroImageSource;
+  using Superclass = itk::ImageSource<TImage>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(ZeroImageSource);
+
+protected:
+  ZeroImageSource() = default;
+  ~ZeroImageSource() override = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    this->GetOutput()->SetLargestPossibleRegion(typename TImage::RegionType(TImage::SizeType::Filled(16)));
+  }
+
+  void
+  GenerateData() override
+  {
+    this->GetOutput()->SetBufferedRegion(this->GetOutput()->GetRequestedRegion());
+    this->GetOutput()->AllocateInitialized();
+  }
+};
+
+// A container that counts the calls of its AllocateElements override.
+class CountingImportImageContainer : public itk::ImportImageContainer<itk::SizeValueType, float>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingImportImageContainer);
+
+  using Self = CountingImportImageContainer;
+  using Superclass = itk::ImportImageContainer<itk::SizeValueType, float>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(CountingImportImageContainer);
+
+  mutable unsigned int m_NumberOfAllocations{ 0 };
+
+protected:
+  CountingImportImageContainer() = default;
+  ~CountingImportImageContainer() override = default;
+
+  float *
+  AllocateElements(ElementIdentifier size, bool UseValueInitialization) const override
+  {
+    ++m_NumberOfAllocations;
+    return Superclass::AllocateElements(size, UseValueInitialization);
+  }
+};
+} // namespace
+
+
+TEST(ImageBufferPool, IsDisabledByDefault)
+{
+  EXPECT_FALSE(itk::ImageBufferPool::GetEnabled());
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 0u);
+}
+
+
+TEST(ImageBufferPool, RecyclesBuffersOfMatchingSizeAndPolicy)
+{
+  const EnabledPoolGuard guard;
+
+  void * const memory = itk::ImageBufferPool::Acquire(1000, PolicyEnum::Aligned, false);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfMisses(), 1u);
+  itk::ImageBufferPool::Release(memory, 1000, PolicyEnum::Aligned);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfRecycledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBytes(), 1024u);
+
+  // Another policy, or a size in another bucket, does not reuse the buffer.
+  void * const otherPolicy = itk::ImageBufferPool::Acquire(1000, PolicyEnum::HugePages, false);
+  void * const otherSize = itk::ImageBufferPool::Acquire(1100, PolicyEnum::Aligned, false);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfMisses(), 3u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfHits(), 0u);
+
+  // A size in the same bucket does, and it is zeroed on request.
+  std::fill_n(static_cast<unsigned char *>(memory), 1000, 1);
+  auto * const reused = static_cast<unsigned char *>(itk::ImageBufferPool::Acquire(1020, PolicyEnum::Aligned, true));
+  EXPECT_EQ(reused, memory);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfHits(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 0u);
+  EXPECT_TRUE(std::all_of(reused, reused + 1020, [](unsigned char value) { return value == 0; }));
+
+  itk::ImageBufferPool::Release(reused, 1020, PolicyEnum::Aligned);
+  itk::ImageBufferPool::Release(otherPolicy, 1000, PolicyEnum::HugePages);
+  itk::ImageBufferPool::Release(otherSize, 1100, PolicyEnum::Aligned);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 3u);
+
+  itk::ImageBufferPool::Clear();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 0u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBytes(), 0u);
+}
+
+
+TEST(ImageBufferPool, RespectsLimits)
+{
+  const EnabledPoolGuard guard;
+
+  itk::ImageBufferPool::SetMaximumNumberOfBuffersPerBucket(2);
+  EXPECT_EQ(itk::ImageBufferPool::GetMaximumNumberOfBuffersPerBucket(), 2u);
+
+  void * buffers[3];
+  for (auto & buffer : buffers)
+  {
+    buffer = itk::ImageBufferPool::Acquire(4096, PolicyEnum::Aligned, false);
+  }
+  for (auto * const buffer : buffers)
+  {
+    itk::ImageBufferPool::Release(buffer, 4096, PolicyEnum::Aligned);
+  }
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 2u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfDiscardedBuffers(), 1u);
+
+  // Reducing the maximum number of bytes deallocates buffers.
+  itk::ImageBufferPool::SetMaximumNumberOfPooledBytes(5000);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBytes(), 4096u);
+
+  void * const large = itk::ImageBufferPool::Acquire(8192, PolicyEnum::Aligned, false);
+  itk::ImageBufferPool::Release(large, 8192, PolicyEnum::Aligned);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfDiscardedBuffers(), 2u);
+
+  // Disabling the pool deallocates all of its buffers.
+  itk::ImageBufferPool::SetEnabled(false);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 0u);
+}
+
+
+TEST(ImageBufferPool, RecyclesImageBuffersAcrossReleaseData)
+{
+  const EnabledPoolGuard guard;
+
+  // ReleaseData replaces the pixel container by a new one, which gets the global default policy.
+  const PolicyEnum defaultPolicy = itk::ImageBufferAllocator::GetGlobalDefaultPolicy();
+  itk::ImageBufferAllocator::SetGlobalDefaultPolicy(PolicyEnum::Aligned);
+
+  using ImageType = itk::Image<float, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 32, 16 } });
+  image->AllocateInitialized();
+  const float * const buffer = image->GetBufferPointer();
+
+  image->ReleaseData();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 1u);
+
+  image->SetRegions(ImageType::SizeType{ { 32, 32, 16 } });
+  image->AllocateInitialized();
+  EXPECT_EQ(image->GetBufferPointer(), buffer);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfHits(), 1u);
+  EXPECT_EQ(image->GetPixel({ { 31, 31, 15 } }), 0.0f);
+
+  // Buffers of the New policy are pooled as buffers of the Aligned policy.
+  const auto newImage = ImageType::New();
+  newImage->GetPixelContainer()->SetAllocationPolicy(PolicyEnum::New);
+  newImage->SetRegions(ImageType::SizeType{ { 32, 32, 16 } });
+  newImage->Allocate();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfMisses(), 2u);
+  newImage->ReleaseData();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfPooledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfRecycledBuffers(), 2u);
+
+  itk::ImageBufferAllocator::SetGlobalDefaultPolicy(defaultPolicy);
+}
+
+
+TEST(ImageBufferPool, RecyclesBuffersOfDefaultPolicyAcrossUpdates)
+{
+  const EnabledPoolGuard guard;
+  ASSERT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultPolicy(), PolicyEnum::New);
+
+  // The output is released before each update, so each update allocates a new buffer.
+  using ImageType = itk::Image<short, 3>;
+  const auto source = ZeroImageSource<ImageType>::New();
+  source->ReleaseDataBeforeUpdateFlagOn();
+  source->Update();
+  EXPECT_EQ(source->GetOutput()->GetPixelContainer()->GetAllocationPolicy(), PolicyEnum::New);
+  const short * const buffer = source->GetOutput()->GetBufferPointer();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfMisses(), 1u);
+
+  // The second update releases the buffer of the first one, and takes it back from the pool.
+  source->Modified();
+  source->Update();
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfRecycledBuffers(), 1u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfHits(), 1u);
+  EXPECT_EQ(source->GetOutput()->GetBufferPointer(), buffer);
+  EXPECT_EQ(source->GetOutput()->GetPixel({ { 15, 15, 15 } }), 0);
+}
+
+
+TEST(ImageBufferPool, KeepsOverriddenAllocateElementsWhenDisabled)
+{
+  // Without the pool, buffers of the New policy are still allocated by AllocateElements.
+  const auto container = CountingImportImageContainer::New();
+  container->Reserve(1000, true);
+  EXPECT_EQ(container->m_NumberOfAllocations, 1u);
+  EXPECT_EQ(container->GetBufferPointer()[999], 0.0f);
+  container->Squeeze();
+  EXPECT_EQ(container->m_NumberOfAllocations, 1u);
+
+  // With the pool, they are acquired from the pool instead.
+  const EnabledPoolGuard guard;
+  const auto             pooledContainer = CountingImportImageContainer::New();
+  pooledContainer->Reserve(1000, false);
+  EXPECT_EQ(pooledContainer->m_NumberOfAllocations, 0u);
+  EXPECT_EQ(itk::ImageBufferPool::GetNumberOfMisses(), 1u);
+}
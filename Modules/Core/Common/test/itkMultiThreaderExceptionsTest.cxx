@@ -88,6 +88,7 @@ itkMultiThreaderExceptionsTest(int, char *[])
   const std::set<ThreaderEnum> threadersToTest = {
     ThreaderEnum::Platform,
     ThreaderEnum::Pool,
+    ThreaderEnum::WorkStealing,
 #ifdef ITK_USE_TBB
     ThreaderEnum::TBB,
 #endif // ITK_USE_TBB
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkWorkStealingMultiThreader.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+ThrowInLastWorkUnit(void * arg)
+{
+  const auto * workUnitInfo = static_cast<itk::MultiThreaderBase::WorkUnitInfo *>(arg);
+  if (workUnitInfo->WorkUnitID == workUnitInfo->NumberOfWorkUnits - 1)
+  {
+    throw std::runtime_error("Exception from the last work unit");
+  }
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+} // namespace
+
+// Checks that every pixel of a region is visited exactly once, for various numbers of work units.
+TEST(WorkStealingMultiThreader, ParallelizeImageRegionVisitsEachPixelOnce)
+{
+  using ImageType = itk::Image<unsigned int, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType{ { { 3, -2, 1 } }, { { 37, 19, 11 } } });
+  image->AllocateInitialized();
+
+  const auto threader = itk::WorkStealingMultiThreader::New();
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1u, 2u, 7u, 64u, 1000u })
+  {
+    threader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    EXPECT_EQ(threader->GetNumberOfWorkUnits(), numberOfWorkUnits);
+
+    std::atomic<itk::SizeValueType> numberOfCalls{ 0 };
+    threader->ParallelizeImageRegion<3>(
+      image->GetBufferedRegion(),
+      [&image, &numberOfCalls](const ImageType::RegionType & region) {
+        ++numberOfCalls;
+        for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+        {
+          ++it.Value();
+        }
+      },
+      nullptr);
+
+    if (numberOfWorkUnits == 1)
+    {
+      EXPECT_EQ(numberOfCalls, 1u);
+    }
+    for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ASSERT_EQ(it.Get(), 1u);
+      it.Set(0);
+    }
+  }
+}
+
+
+// Checks that nested parallel calls complete and do not lose any work.
+TEST(WorkStealingMultiThreader, NestedParallelizeArray)
+{
+  constexpr itk::SizeValueType outerSize = 50;
+  constexpr itk::SizeValueType innerSize = 200;
+
+  const auto outerThreader = itk::WorkStealingMultiThreader::New();
+  outerThreader->SetNumberOfWorkUnits(8);
+
+  std::vector<std::atomic<unsigned int>> counts(outerSize * innerSize);
+  outerThreader->ParallelizeArray(
+    0,
+    outerSize,
+    [&counts](itk::SizeValueType i) {
+      const auto innerThreader = itk::WorkStealingMultiThreader::New();
+      innerThreader->ParallelizeArray(
+        0, innerSize, [&counts, i](itk::SizeValueType j) { ++counts[i * innerSize + j]; }, nullptr);
+    },
+    nullptr);
+
+  for (const auto & count : counts)
+  {
+    ASSERT_EQ(count, 1u);
+  }
+}
+
+
+// Checks that an exception thrown by one of the tasks is propagated to the caller.
+TEST(WorkStealingMultiThreader, PropagatesExceptions)
+{
+  const auto threader = itk::WorkStealingMultiThreader::New();
+  threader->SetNumberOfWorkUnits(16);
+
+  EXPECT_THROW(threader->ParallelizeArray(
+                 0,
+                 1000,
+                 [](itk::SizeValueType i) {
+                   if (i == 567)
+                   {
+                     itkGenericExceptionMacro("Exception for index " << i);
+                   }
+                 },
+                 nullptr),
+               itk::ExceptionObject);
+
+  threader->SetSingleMethod(ThrowInLastWorkUnit, nullptr);
+  EXPECT_THROW(threader->SingleMethodExecute(), std::runtime_error);
+}
@@ -35,6 +35,7 @@
 #include "itkConceptChecking.h"
 #include "itkCovariantVector.h"
 
+#include <array>
 #include <memory> // For unique_ptr.
 #include <vector>
 
@@ -59,6 +60,13 @@ namespace itk
  *               Spline is determined in all dimensions, cannot selectively
  *                  pick dimension for calculating spline.
  *
+ * The interpolated value is accumulated one line of the region of support at
+ * a time, reading the coefficients of each line from consecutive addresses of
+ * the coefficient buffer. The value and the derivatives at a position are
+ * computed by a single pass over the region of support, and
+ * EvaluateAtContinuousIndices() interpolates a batch of positions with a
+ * single virtual call.
+ *
  * \sa BSplineDecompositionImageFilter
  *
  * \ingroup ImageFunctions
@@ -94,6 +102,7 @@ public:
 
   /** Index type alias support */
   using typename Superclass::IndexType;
+  using typename Superclass::IndexValueType;
 
   /** Size type alias support */
   using typename Superclass::SizeType;
@@ -101,6 +110,9 @@ public:
   /** ContinuousIndex type alias support */
   using typename Superclass::ContinuousIndexType;
 
+  /** RealType type alias support */
+  using typename Superclass::RealType;
+
   /** PointType type alias support */
   using typename Superclass::PointType;
 
@@ -147,15 +159,20 @@ public:
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override
   {
     // Don't know thread information, make evaluateIndex, weights on the stack.
-    // Slower, but safer.
-    vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
-
-    // Pass evaluateIndex, weights by reference. They're only good as long
-    // as this method is in scope.
-    return this->EvaluateAtContinuousIndexInternal(index, evaluateIndex, weights);
+    // Their size is fixed, so that they do not require any allocation.
+    SupportIndexArrayType  evaluateIndex;
+    SupportWeightArrayType weights;
+    return this->ComputeValue(index, evaluateIndex, weights);
   }
 
+  /** Interpolate the image at a batch of continuous index positions: on
+   * return, \c values[i] is the interpolated value at \c indices[i]. No
+   * bounds checking is done. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   virtual OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & x, ThreadIdType threadId) const
   {
@@ -185,17 +202,14 @@ public:
   EvaluateDerivativeAtContinuousIndex(const ContinuousIndexType & x) const
   {
     // Don't know thread information, make evaluateIndex, weights,
-    // weightsDerivative
-    // on the stack.
-    // Slower, but safer.
-    vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weightsDerivative(ImageDimension, (m_SplineOrder + 1));
-
-    // Pass evaluateIndex, weights, weightsDerivative by reference. They're only
-    // good
-    // as long as this method is in scope.
-    return this->EvaluateDerivativeAtContinuousIndexInternal(x, evaluateIndex, weights, weightsDerivative);
+    // weightsDerivative on the stack.
+    SupportIndexArrayType  evaluateIndex;
+    SupportWeightArrayType weights;
+    SupportWeightArrayType weightsDerivative;
+    OutputType             value;
+    CovariantVectorType    derivativeValue;
+    this->ComputeValueAndDerivative(x, value, derivativeValue, evaluateIndex, weights, weightsDerivative);
+    return derivativeValue;
   }
 
   CovariantVectorType
@@ -232,18 +246,11 @@ public:
                                               CovariantVectorType &       deriv) const
   {
     // Don't know thread information, make evaluateIndex, weights,
-    // weightsDerivative
-    // on the stack.
-    // Slower, but safer.
-    vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weightsDerivative(ImageDimension, (m_SplineOrder + 1));
-
-    // Pass evaluateIndex, weights, weightsDerivative by reference. They're only
-    // good
-    // as long as this method is in scope.
-    this->EvaluateValueAndDerivativeAtContinuousIndexInternal(
-      x, value, deriv, evaluateIndex, weights, weightsDerivative);
+    // weightsDerivative on the stack.
+    SupportIndexArrayType  evaluateIndex;
+    SupportWeightArrayType weights;
+    SupportWeightArrayType weightsDerivative;
+    this->ComputeValueAndDerivative(x, value, deriv, evaluateIndex, weights, weightsDerivative);
   }
 
   void
@@ -296,6 +303,25 @@ public:
     return SizeType::Filled(m_SplineOrder + 1);
   }
 
+  /** The separable kernel is the B-spline of the order of the interpolator,
+   * weighting the B-spline coefficients, with mirror boundary conditions. It
+   * is only provided for spline orders up to 3: the radius is zero for higher
+   * orders. */
+  double
+  GetSeparableKernelRadius() const override;
+
+  double
+  EvaluateSeparableKernel(double distance) const override;
+
+  IndexValueType
+  ApplySeparableKernelBoundaryCondition(unsigned int dimension, IndexValueType index) const override;
+
+  RealType
+  GetSeparableKernelSample(const IndexType & index) const override
+  {
+    return static_cast<RealType>(m_Coefficients->GetPixel(index));
+  }
+
 protected:
   /** The following methods take working space (evaluateIndex, weights, weightsDerivative)
    *  that is managed by the caller. If threadId is known, the working variables are looked
@@ -314,6 +340,9 @@ protected:
    *  (hopefully) by looking up pre-allocated working space in arrays that are indexed by thread.
    *  The efficiency gain is likely dependent on the size of the working variables, which are
    *  in-turn dependent on the dimensionality of the image and the order of the spline.
+   *
+   *  The methods that do not take a threadId do not call these methods: their working space
+   *  has a fixed size, for the highest spline order, and does not need to be allocated.
    */
   virtual OutputType
   EvaluateAtContinuousIndexInternal(const ContinuousIndexType & x,
@@ -351,47 +380,70 @@ protected:
   typename CoefficientImageType::ConstPointer m_Coefficients{};
 
 private:
+  /** The highest spline order is 5, whose region of support has 6 points along each dimension. */
+  static constexpr unsigned int MaximumSupportSize = 6;
+
+  /** Fixed-size working space, indexed like the vnl_matrix working space. */
+  using SupportIndexArrayType = std::array<std::array<long, MaximumSupportSize>, ImageDimension>;
+  using SupportWeightArrayType = std::array<std::array<double, MaximumSupportSize>, ImageDimension>;
+  using SupportOffsetArrayType = std::array<std::array<OffsetValueType, MaximumSupportSize>, ImageDimension>;
+
+  /** Interpolates the value at x, using the working space (vnl_matrix or fixed-size arrays) passed in. */
+  template <typename TEvaluateIndex, typename TWeights>
+  OutputType
+  ComputeValue(const ContinuousIndexType & x, TEvaluateIndex & evaluateIndex, TWeights & weights) const;
+
+  /** Interpolates the value and the derivatives at x, with a single pass over the region of support. */
+  template <typename TEvaluateIndex, typename TWeights>
+  void
+  ComputeValueAndDerivative(const ContinuousIndexType & x,
+                            OutputType &                value,
+                            CovariantVectorType &       derivativeValue,
+                            TEvaluateIndex &            evaluateIndex,
+                            TWeights &                  weights,
+                            TWeights &                  weightsDerivative) const;
+
+  /** Computes the offsets, in the coefficient buffer, of the indices of the region of support. */
+  template <typename TEvaluateIndex>
+  void
+  ComputeSupportOffsets(const TEvaluateIndex & evaluateIndex, SupportOffsetArrayType & offsets) const;
+
   /** Determines the weights for interpolation of the value x */
+  template <typename TEvaluateIndex, typename TWeights>
   void
   SetInterpolationWeights(const ContinuousIndexType & x,
-                          const vnl_matrix<long> &    EvaluateIndex,
-                          vnl_matrix<double> &        weights,
+                          const TEvaluateIndex &      EvaluateIndex,
+                          TWeights &                  weights,
                           unsigned int                splineOrder) const;
 
   /** Determines the weights for the derivative portion of the value x */
+  template <typename TEvaluateIndex, typename TWeights>
   void
   SetDerivativeWeights(const ContinuousIndexType & x,
-                       const vnl_matrix<long> &    EvaluateIndex,
-                       vnl_matrix<double> &        weights,
+                       const TEvaluateIndex &      EvaluateIndex,
+                       TWeights &                  weights,
                        unsigned int                splineOrder) const;
 
-  /** Precomputation for converting the 1D index of the interpolation
-   *  neighborhood to an N-dimensional index. */
+  /** Allocates the working space of each thread. */
   void
-  GeneratePointsToIndex();
+  AllocateThreadedWorkingSpace();
 
   /** Determines the indices to use give the splines region of support */
+  template <typename TEvaluateIndex>
   void
-  DetermineRegionOfSupport(vnl_matrix<long> &          evaluateIndex,
+  DetermineRegionOfSupport(TEvaluateIndex &            evaluateIndex,
                            const ContinuousIndexType & x,
                            unsigned int                splineOrder) const;
 
   /** Set the indices in evaluateIndex at the boundaries based on mirror
    * boundary conditions. */
+  template <typename TEvaluateIndex>
   void
-  ApplyMirrorBoundaryConditions(vnl_matrix<long> & evaluateIndex, unsigned int splineOrder) const;
-
-  Iterator m_CIterator{};                         // Iterator for
-                                                  // traversing spline
-                                                  // coefficients.
-  unsigned long m_MaxNumberInterpolationPoints{}; // number of
-                                                  // neighborhood
-                                                  // points used for
-                                                  // interpolation
-  std::vector<IndexType> m_PointsToIndex{};       // Preallocation of
-                                                  // interpolation
-                                                  // neighborhood
-                                                  // indices
+  ApplyMirrorBoundaryConditions(TEvaluateIndex & evaluateIndex, unsigned int splineOrder) const;
+
+  Iterator m_CIterator{}; // Iterator for
+                          // traversing spline
+                          // coefficients.
 
   CoefficientFilterPointer m_CoefficientFilter{};
 
@@ -33,6 +33,7 @@
 #include "itkImageRegionIterator.h"
 
 #include "itkVector.h"
+#include "itkBSplineKernelFunction.h"
 
 #include "itkMatrix.h"
 #include "itkPrintHelper.h"
@@ -70,9 +71,6 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Prin
 
   itkPrintSelfObjectMacro(Coefficients);
 
-  os << indent << "MaxNumberInterpolationPoints: " << m_MaxNumberInterpolationPoints << std::endl;
-  os << indent << "PointsToIndex: " << m_PointsToIndex << std::endl;
-
   itkPrintSelfObjectMacro(CoefficientFilter);
 
   itkPrintSelfBooleanMacro(UseImageDirection);
@@ -146,13 +144,62 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetS
   m_SplineOrder = SplineOrder;
   m_CoefficientFilter->SetSplineOrder(SplineOrder);
 
-  // this->SetPoles();
-  m_MaxNumberInterpolationPoints = 1;
-  for (unsigned int n = 0; n < ImageDimension; ++n)
+  this->AllocateThreadedWorkingSpace();
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+double
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::GetSeparableKernelRadius() const
+{
+  // BSplineKernelFunction only implements the orders up to 3.
+  return m_SplineOrder <= 3 ? 0.5 * (m_SplineOrder + 1) : 0.0;
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+double
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateSeparableKernel(
+  double distance) const
+{
+  switch (m_SplineOrder)
+  {
+    case 0:
+      // A half-open box, so that a position halfway between two samples is the nearest neighbor selected by
+      // DetermineRegionOfSupport(), Math::Floor(x + 0.5), rather than the mean of both samples.
+      return (distance >= -0.5 && distance < 0.5) ? 1.0 : 0.0;
+    case 1:
+      return BSplineKernelFunction<1>::FastEvaluate(distance);
+    case 2:
+      return BSplineKernelFunction<2>::FastEvaluate(distance);
+    case 3:
+      return BSplineKernelFunction<3>::FastEvaluate(distance);
+    default:
+      itkExceptionMacro("The separable kernel is not implemented for the spline order " << m_SplineOrder);
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+auto
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::ApplySeparableKernelBoundaryCondition(
+  unsigned int   dimension,
+  IndexValueType index) const -> IndexValueType
+{
+  // The mirror boundary conditions of ApplyMirrorBoundaryConditions(), followed by clamping for the samples of
+  // kernels wider than the image.
+  const IndexValueType startIndex = this->GetStartIndex()[dimension];
+  const IndexValueType endIndex = this->GetEndIndex()[dimension];
+  if (m_DataLength[dimension] == 1)
   {
-    m_MaxNumberInterpolationPoints *= (m_SplineOrder + 1);
+    return startIndex;
   }
-  this->GeneratePointsToIndex();
+  if (index < startIndex)
+  {
+    index = startIndex + (startIndex - index);
+  }
+  if (index >= endIndex)
+  {
+    index = endIndex - (index - endIndex);
+  }
+  return std::clamp(index, startIndex, endIndex);
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
@@ -161,15 +208,16 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetN
   ThreadIdType numWorkUnits)
 {
   m_NumberOfWorkUnits = numWorkUnits;
-  this->GeneratePointsToIndex();
+  this->AllocateThreadedWorkingSpace();
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex, typename TWeights>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetInterpolationWeights(
   const ContinuousIndexType & x,
-  const vnl_matrix<long> &    EvaluateIndex,
-  vnl_matrix<double> &        weights,
+  const TEvaluateIndex &      EvaluateIndex,
+  TWeights &                  weights,
   unsigned int                splineOrder) const
 {
   // For speed improvements we could make each case a separate function and use
@@ -275,11 +323,12 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetI
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex, typename TWeights>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetDerivativeWeights(
   const ContinuousIndexType & x,
-  const vnl_matrix<long> &    EvaluateIndex,
-  vnl_matrix<double> &        weights,
+  const TEvaluateIndex &      EvaluateIndex,
+  TWeights &                  weights,
   unsigned int                splineOrder) const
 {
   // For speed improvements we could make each case a separate function and use
@@ -398,14 +447,10 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::SetD
   }
 }
 
-// Generates m_PointsToIndex;
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
 void
-BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::GeneratePointsToIndex()
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::AllocateThreadedWorkingSpace()
 {
-  // m_PointsToIndex is used to convert a sequential location to an N-dimension
-  // index vector.  This is precomputed to save time during the interpolation
-  // routine.
   m_ThreadedEvaluateIndex = std::make_unique<vnl_matrix<long>[]>(m_NumberOfWorkUnits);
   m_ThreadedWeights = std::make_unique<vnl_matrix<double>[]>(m_NumberOfWorkUnits);
   m_ThreadedWeightsDerivative = std::make_unique<vnl_matrix<double>[]>(m_NumberOfWorkUnits);
@@ -415,29 +460,13 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Gene
     m_ThreadedWeights[i].set_size(ImageDimension, m_SplineOrder + 1);
     m_ThreadedWeightsDerivative[i].set_size(ImageDimension, m_SplineOrder + 1);
   }
-
-  m_PointsToIndex.resize(m_MaxNumberInterpolationPoints);
-  for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
-  {
-    int           pp = p;
-    unsigned long indexFactor[ImageDimension];
-    indexFactor[0] = 1;
-    for (int j = 1; j < static_cast<int>(ImageDimension); ++j)
-    {
-      indexFactor[j] = indexFactor[j - 1] * (m_SplineOrder + 1);
-    }
-    for (int j = (static_cast<int>(ImageDimension) - 1); j >= 0; j--)
-    {
-      m_PointsToIndex[p][j] = pp / indexFactor[j];
-      pp = pp % indexFactor[j];
-    }
-  }
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::DetermineRegionOfSupport(
-  vnl_matrix<long> &          evaluateIndex,
+  TEvaluateIndex &            evaluateIndex,
   const ContinuousIndexType & x,
   unsigned int                splineOrder) const
 {
@@ -453,10 +482,11 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Dete
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::ApplyMirrorBoundaryConditions(
-  vnl_matrix<long> & evaluateIndex,
-  unsigned int       splineOrder) const
+  TEvaluateIndex & evaluateIndex,
+  unsigned int     splineOrder) const
 {
   const IndexType startIndex = this->GetStartIndex();
   const IndexType endIndex = this->GetEndIndex();
@@ -469,7 +499,7 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Appl
     {
       for (unsigned int k = 0; k <= splineOrder; ++k)
       {
-        evaluateIndex[n][k] = 0;
+        evaluateIndex[n][k] = startIndex[n];
       }
     }
     else
@@ -490,105 +520,168 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Appl
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::ComputeSupportOffsets(
+  const TEvaluateIndex &   evaluateIndex,
+  SupportOffsetArrayType & offsets) const
+{
+  const OffsetValueType * offsetTable = m_Coefficients->GetOffsetTable();
+  const IndexType &       bufferedIndex = m_Coefficients->GetBufferedRegion().GetIndex();
+
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    for (unsigned int k = 0; k <= m_SplineOrder; ++k)
+    {
+      offsets[n][k] = (evaluateIndex[n][k] - bufferedIndex[n]) * offsetTable[n];
+    }
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex, typename TWeights>
 auto
-BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndexInternal(
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::ComputeValue(
   const ContinuousIndexType & x,
-  vnl_matrix<long> &          evaluateIndex,
-  vnl_matrix<double> &        weights) const -> OutputType
+  TEvaluateIndex &            evaluateIndex,
+  TWeights &                  weights) const -> OutputType
 {
   // compute the interpolation indexes
-  this->DetermineRegionOfSupport((evaluateIndex), x, m_SplineOrder);
+  this->DetermineRegionOfSupport(evaluateIndex, x, m_SplineOrder);
 
   // Determine weights
-  SetInterpolationWeights(x, (evaluateIndex), (weights), m_SplineOrder);
+  this->SetInterpolationWeights(x, evaluateIndex, weights, m_SplineOrder);
 
   // Modify evaluateIndex at the boundaries using mirror boundary conditions
-  this->ApplyMirrorBoundaryConditions((evaluateIndex), m_SplineOrder);
-
-  // perform interpolation
-  double    interpolated = 0.0;
-  IndexType coefficientIndex;
-  // Step through each point in the n-dimensional interpolation cube.
-  for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
+  this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+
+  SupportOffsetArrayType offsets;
+  this->ComputeSupportOffsets(evaluateIndex, offsets);
+
+  // Step through the lines of the n-dimensional interpolation cube along the
+  // first dimension. The position of a line is given by its indices k[n] along
+  // the dimensions n > 0.
+  const unsigned int                       supportSize = m_SplineOrder + 1;
+  const CoefficientDataType * const        coefficients = m_Coefficients->GetBufferPointer();
+  std::array<unsigned int, ImageDimension> k{};
+  double                                   interpolated = 0.0;
+  while (true)
   {
-    double w = 1.0;
-    for (unsigned int n = 0; n < ImageDimension; ++n)
+    OffsetValueType lineOffset = 0;
+    double          lineWeight = 1.0;
+    for (unsigned int n = 1; n < ImageDimension; ++n)
+    {
+      lineOffset += offsets[n][k[n]];
+      lineWeight *= weights[n][k[n]];
+    }
+
+    const CoefficientDataType * const line = coefficients + lineOffset;
+    double                            lineValue = 0.0;
+    for (unsigned int i = 0; i < supportSize; ++i)
     {
-      const unsigned int indx = m_PointsToIndex[p][n];
-      w *= (weights)[n][indx];
-      coefficientIndex[n] = (evaluateIndex)[n][indx];
+      lineValue += weights[0][i] * line[offsets[0][i]];
+    }
+    interpolated += lineWeight * lineValue;
+
+    // Go to the next line
+    unsigned int n = 1;
+    for (; n < ImageDimension && ++k[n] == supportSize; ++n)
+    {
+      k[n] = 0;
+    }
+    if (n == ImageDimension)
+    {
+      break;
     }
-    interpolated += w * m_Coefficients->GetPixel(coefficientIndex);
   }
 
-  return (interpolated);
+  return interpolated;
 }
 
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+template <typename TEvaluateIndex, typename TWeights>
 void
-BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
-  EvaluateValueAndDerivativeAtContinuousIndexInternal(const ContinuousIndexType & x,
-                                                      OutputType &                value,
-                                                      CovariantVectorType &       derivativeValue,
-                                                      vnl_matrix<long> &          evaluateIndex,
-                                                      vnl_matrix<double> &        weights,
-                                                      vnl_matrix<double> &        weightsDerivative) const
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::ComputeValueAndDerivative(
+  const ContinuousIndexType & x,
+  OutputType &                value,
+  CovariantVectorType &       derivativeValue,
+  TEvaluateIndex &            evaluateIndex,
+  TWeights &                  weights,
+  TWeights &                  weightsDerivative) const
 {
-  this->DetermineRegionOfSupport((evaluateIndex), x, m_SplineOrder);
+  this->DetermineRegionOfSupport(evaluateIndex, x, m_SplineOrder);
 
-  SetInterpolationWeights(x, (evaluateIndex), (weights), m_SplineOrder);
+  this->SetInterpolationWeights(x, evaluateIndex, weights, m_SplineOrder);
 
-  SetDerivativeWeights(x, (evaluateIndex), (weightsDerivative), m_SplineOrder);
+  this->SetDerivativeWeights(x, evaluateIndex, weightsDerivative, m_SplineOrder);
 
   // Modify EvaluateIndex at the boundaries using mirror boundary conditions
-  this->ApplyMirrorBoundaryConditions((evaluateIndex), m_SplineOrder);
-
-  value = 0.0;
-  derivativeValue[0] = 0.0;
-  IndexType coefficientIndex;
-  for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
+  this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+
+  SupportOffsetArrayType offsets;
+  this->ComputeSupportOffsets(evaluateIndex, offsets);
+
+  // The value and the derivatives share the weighted sums of the lines along
+  // the first dimension: only the weight of a line depends on the derivative.
+  const unsigned int                       supportSize = m_SplineOrder + 1;
+  const CoefficientDataType * const        coefficients = m_Coefficients->GetBufferPointer();
+  std::array<unsigned int, ImageDimension> k{};
+  std::array<double, ImageDimension>       derivative{};
+  double                                   interpolated = 0.0;
+  while (true)
   {
-    unsigned int indx = m_PointsToIndex[p][0];
-    coefficientIndex[0] = (evaluateIndex)[0][indx];
-    double w = (weights)[0][indx];
-    double w1 = (weightsDerivative)[0][indx];
+    OffsetValueType lineOffset = 0;
+    double          lineWeight = 1.0;
     for (unsigned int n = 1; n < ImageDimension; ++n)
     {
-      indx = m_PointsToIndex[p][n];
-      coefficientIndex[n] = (evaluateIndex)[n][indx];
-      const double tmpW = (weights)[n][indx];
-      w *= tmpW;
-      w1 *= tmpW;
+      lineOffset += offsets[n][k[n]];
+      lineWeight *= weights[n][k[n]];
     }
-    const double tmpV = m_Coefficients->GetPixel(coefficientIndex);
-    value += w * tmpV;
-    derivativeValue[0] += w1 * tmpV;
-  }
-  derivativeValue[0] /= this->GetInputImage()->GetSpacing()[0];
-  for (unsigned int n = 1; n < ImageDimension; ++n)
-  {
-    derivativeValue[n] = 0.0;
-    for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
+
+    const CoefficientDataType * const line = coefficients + lineOffset;
+    double                            lineValue = 0.0;
+    double                            lineDerivative = 0.0;
+    for (unsigned int i = 0; i < supportSize; ++i)
     {
-      double w1 = 1.0;
-      for (unsigned int n1 = 0; n1 < ImageDimension; ++n1)
-      {
-        const unsigned int indx = m_PointsToIndex[p][n1];
-        coefficientIndex[n1] = (evaluateIndex)[n1][indx];
+      const double coefficient = line[offsets[0][i]];
+      lineValue += weights[0][i] * coefficient;
+      lineDerivative += weightsDerivative[0][i] * coefficient;
+    }
+    interpolated += lineWeight * lineValue;
+    derivative[0] += lineWeight * lineDerivative;
 
-        if (n1 == n)
-        {
-          w1 *= (weightsDerivative)[n1][indx];
-        }
-        else
+    for (unsigned int n = 1; n < ImageDimension; ++n)
+    {
+      double derivativeLineWeight = weightsDerivative[n][k[n]];
+      for (unsigned int n1 = 1; n1 < ImageDimension; ++n1)
+      {
+        if (n1 != n)
         {
-          w1 *= (weights)[n1][indx];
+          derivativeLineWeight *= weights[n1][k[n1]];
         }
       }
-      derivativeValue[n] += m_Coefficients->GetPixel(coefficientIndex) * w1;
+      derivative[n] += derivativeLineWeight * lineValue;
+    }
+
+    // Go to the next line
+    unsigned int n = 1;
+    for (; n < ImageDimension && ++k[n] == supportSize; ++n)
+    {
+      k[n] = 0;
+    }
+    if (n == ImageDimension)
+    {
+      break;
     }
-    // take spacing into account
-    derivativeValue[n] /= this->GetInputImage()->GetSpacing()[n];
+  }
+
+  value = interpolated;
+
+  // take spacing into account
+  const typename InputImageType::SpacingType & spacing = this->GetInputImage()->GetSpacing();
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    derivativeValue[n] = derivative[n] / spacing[n];
   }
 
   if (this->m_UseImageDirection)
@@ -597,6 +690,45 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
   }
 }
 
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  // The working space is shared by the positions of the batch.
+  SupportIndexArrayType  evaluateIndex;
+  SupportWeightArrayType weights;
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    values[i] = this->ComputeValue(indices[i], evaluateIndex, weights);
+  }
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+auto
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateAtContinuousIndexInternal(
+  const ContinuousIndexType & x,
+  vnl_matrix<long> &          evaluateIndex,
+  vnl_matrix<double> &        weights) const -> OutputType
+{
+  return this->ComputeValue(x, evaluateIndex, weights);
+}
+
+template <typename TImageType, typename TCoordinate, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::
+  EvaluateValueAndDerivativeAtContinuousIndexInternal(const ContinuousIndexType & x,
+                                                      OutputType &                value,
+                                                      CovariantVectorType &       derivativeValue,
+                                                      vnl_matrix<long> &          evaluateIndex,
+                                                      vnl_matrix<double> &        weights,
+                                                      vnl_matrix<double> &        weightsDerivative) const
+{
+  this->ComputeValueAndDerivative(x, value, derivativeValue, evaluateIndex, weights, weightsDerivative);
+}
+
 template <typename TImageType, typename TCoordinate, typename TCoefficientType>
 auto
 BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::EvaluateDerivativeAtContinuousIndexInternal(
@@ -605,53 +737,10 @@ BSplineInterpolateImageFunction<TImageType, TCoordinate, TCoefficientType>::Eval
   vnl_matrix<double> &        weights,
   vnl_matrix<double> &        weightsDerivative) const -> CovariantVectorType
 {
-  this->DetermineRegionOfSupport((evaluateIndex), x, m_SplineOrder);
-
-  SetInterpolationWeights(x, (evaluateIndex), (weights), m_SplineOrder);
-
-  SetDerivativeWeights(x, (evaluateIndex), (weightsDerivative), m_SplineOrder);
-
-  // Modify EvaluateIndex at the boundaries using mirror boundary conditions
-  this->ApplyMirrorBoundaryConditions((evaluateIndex), m_SplineOrder);
-
-  const InputImageType *                       inputImage = this->GetInputImage();
-  const typename InputImageType::SpacingType & spacing = inputImage->GetSpacing();
-
-  // Calculate derivative
+  OutputType          value;
   CovariantVectorType derivativeValue;
-
-  IndexType coefficientIndex;
-  for (unsigned int n = 0; n < ImageDimension; ++n)
-  {
-    derivativeValue[n] = 0.0;
-    for (unsigned int p = 0; p < m_MaxNumberInterpolationPoints; ++p)
-    {
-      double tempValue = 1.0;
-      for (unsigned int n1 = 0; n1 < ImageDimension; ++n1)
-      {
-        const unsigned int indx = m_PointsToIndex[p][n1];
-        coefficientIndex[n1] = (evaluateIndex)[n1][indx];
-
-        if (n1 == n)
-        {
-          tempValue *= (weightsDerivative)[n1][indx];
-        }
-        else
-        {
-          tempValue *= (weights)[n1][indx];
-        }
-      }
-      derivativeValue[n] += m_Coefficients->GetPixel(coefficientIndex) * tempValue;
-    }
-    derivativeValue[n] /= spacing[n];
-  }
-
-  if (this->m_UseImageDirection)
-  {
-    return inputImage->TransformLocalVectorToPhysicalVector(derivativeValue);
-  }
-
-  return (derivativeValue);
+  this->ComputeValueAndDerivative(x, value, derivativeValue, evaluateIndex, weights, weightsDerivative);
+  return derivativeValue;
 }
 } // namespace itk
 
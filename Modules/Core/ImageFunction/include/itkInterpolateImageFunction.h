@@ -20,6 +20,8 @@
 
 #include "itkImageFunction.h"
 
+#include <algorithm> // For clamp.
+
 namespace itk
 {
 /**
@@ -113,6 +115,26 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a batch of continuous index positions: on
+   * return, \c values[i] is the interpolated image intensity at \c indices[i].
+   * No bounds checking is done: all the positions are assumed to lie within
+   * the image buffer.
+   *
+   * Filters that interpolate many positions, e.g. ResampleImageFilter, call
+   * this rather than EvaluateAtContinuousIndex, so that interpolators can set
+   * up their evaluation once per batch. The default calls
+   * EvaluateAtContinuousIndex for each position. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -135,6 +157,49 @@ public:
   virtual SizeType
   GetRadius() const = 0;
 
+  /** Get the radius, in pixels, of the separable kernel of the interpolator.
+   *
+   * The value of some interpolators at a continuous index x is the sum of
+   * samples, weighted by the product over the dimensions d of
+   * EvaluateSeparableKernel(x[d] - k[d]), where k is the index of the sample,
+   * within the radius of the kernel. Samples outside of the buffer are
+   * mapped into it by ApplySeparableKernelBoundaryCondition(). Such
+   * interpolators override these methods, so that filters sampling the image
+   * on a grid aligned with its axes (see ResampleImageFilter) can compute the
+   * weights once per grid line and apply them one dimension at a time.
+   *
+   * Returns zero, the default, when the interpolator has no separable kernel.
+   */
+  virtual double
+  GetSeparableKernelRadius() const
+  {
+    return 0.0;
+  }
+
+  /** Evaluate the separable kernel at a distance, in pixels, from a sample. */
+  virtual double
+  EvaluateSeparableKernel(double itkNotUsed(distance)) const
+  {
+    itkExceptionMacro("The interpolator does not have a separable kernel.");
+  }
+
+  /** Map the index of a sample along a dimension into the buffer. The
+   * default implementation clamps the index, like
+   * ZeroFluxNeumannBoundaryCondition. */
+  virtual IndexValueType
+  ApplySeparableKernelBoundaryCondition(unsigned int dimension, IndexValueType index) const
+  {
+    return std::clamp(index, this->GetStartIndex()[dimension], this->GetEndIndex()[dimension]);
+  }
+
+  /** Get the sample at an index inside the buffer, weighted by the separable
+   * kernel. The default implementation returns the pixel of the image. */
+  virtual RealType
+  GetSeparableKernelSample(const IndexType & index) const
+  {
+    return static_cast<RealType>(this->GetInputImage()->GetPixel(index));
+  }
+
 protected:
   InterpolateImageFunction() = default;
   ~InterpolateImageFunction() override = default;
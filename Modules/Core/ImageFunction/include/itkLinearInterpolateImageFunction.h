@@ -21,6 +21,7 @@
 #include "itkInterpolateImageFunction.h"
 #include "itkVariableLengthVector.h"
 #include <algorithm> // For max.
+#include <cmath>     // For abs.
 
 namespace itk
 {
@@ -110,6 +111,19 @@ public:
     return SizeType::Filled(1);
   }
 
+  /** The separable kernel is the triangle function. */
+  double
+  GetSeparableKernelRadius() const override
+  {
+    return 1.0;
+  }
+
+  double
+  EvaluateSeparableKernel(double distance) const override
+  {
+    return std::max(1.0 - std::abs(distance), 0.0);
+  }
+
 protected:
   LinearInterpolateImageFunction() = default;
   ~LinearInterpolateImageFunction() override = default;
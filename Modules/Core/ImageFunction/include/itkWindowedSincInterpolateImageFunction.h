@@ -23,6 +23,8 @@
 #include "itkInterpolateImageFunction.h"
 #include "itkMath.h"
 
+#include <type_traits> // For is_same.
+
 namespace itk
 {
 // clang-format off
@@ -313,6 +315,23 @@ public:
     return radius;
   }
 
+  /** The separable kernel is the windowed sinc function. It is only provided
+   * for the default ZeroFluxNeumannBoundaryCondition: the radius is zero for
+   * the other boundary conditions. */
+  double
+  GetSeparableKernelRadius() const override
+  {
+    constexpr bool isZeroFluxNeumann =
+      std::is_same_v<TBoundaryCondition, ZeroFluxNeumannBoundaryCondition<TInputImage, TInputImage>>;
+    return isZeroFluxNeumann ? VRadius : 0.0;
+  }
+
+  double
+  EvaluateSeparableKernel(double distance) const override
+  {
+    return std::abs(distance) < VRadius ? m_WindowFunction(distance) * Sinc(distance) : 0.0;
+  }
+
 protected:
   WindowedSincInterpolateImageFunction() = default;
   ~WindowedSincInterpolateImageFunction() override = default;
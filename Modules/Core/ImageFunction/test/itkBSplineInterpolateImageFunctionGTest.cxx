@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBSplineInterpolateImageFunction.h"
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Creates an image with a smooth pattern, and a buffered region that does not start at the origin.
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::SizeType & imageSize)
+{
+  const auto                   image = TImage::New();
+  typename TImage::IndexType   imageIndex;
+  typename TImage::SpacingType spacing;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    imageIndex[d] = 3 - 2 * static_cast<itk::IndexValueType>(d);
+    spacing[d] = 0.5 + 0.25 * d;
+  }
+  image->SetRegions(typename TImage::RegionType(imageIndex, imageSize));
+  image->SetSpacing(spacing);
+  image->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<TImage::ImageDimension>(image->GetBufferedRegion()))
+  {
+    double value = 0.0;
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      value += std::sin(0.7 * (d + 1) * index[d]) + 0.1 * index[d] * index[(d + 1) % TImage::ImageDimension];
+    }
+    image->SetPixel(index, static_cast<typename TImage::PixelType>(value));
+  }
+  return image;
+}
+
+
+// Random continuous indices inside the buffer, including positions close to its borders.
+template <typename TInterpolator>
+std::vector<typename TInterpolator::ContinuousIndexType>
+CreateContinuousIndices(const TInterpolator & interpolator)
+{
+  std::mt19937                                             randomNumberEngine(42);
+  std::vector<typename TInterpolator::ContinuousIndexType> indices(200);
+  for (auto & index : indices)
+  {
+    for (unsigned int d = 0; d < TInterpolator::ImageDimension; ++d)
+    {
+      std::uniform_real_distribution<double> distribution(interpolator.GetStartContinuousIndex()[d],
+                                                          interpolator.GetEndContinuousIndex()[d]);
+      index[d] = distribution(randomNumberEngine);
+    }
+  }
+  return indices;
+}
+
+
+// Checks that the interpolant goes through the pixels, and that all the evaluation methods agree.
+template <unsigned int VDimension>
+void
+Expect_evaluations_are_consistent(const unsigned int splineOrder)
+{
+  using ImageType = itk::Image<float, VDimension>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType>;
+
+  const auto image = CreateImage<ImageType>(ImageType::SizeType::Filled(7));
+  const auto interpolator = InterpolatorType::New();
+  interpolator->SetSplineOrder(splineOrder);
+  interpolator->SetInputImage(image);
+
+  for (const auto & index : itk::ImageRegionIndexRange<VDimension>(image->GetBufferedRegion()))
+  {
+    const typename InterpolatorType::ContinuousIndexType continuousIndex(index);
+    EXPECT_NEAR(interpolator->EvaluateAtContinuousIndex(continuousIndex), image->GetPixel(index), 1e-4)
+      << "Spline order " << splineOrder << ", index " << index;
+  }
+
+  const auto                                         indices = CreateContinuousIndices(*interpolator);
+  std::vector<typename InterpolatorType::OutputType> values(indices.size());
+  interpolator->EvaluateAtContinuousIndices(indices.data(), values.data(), indices.size());
+
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    const auto & x = indices[i];
+    const auto   value = interpolator->EvaluateAtContinuousIndex(x);
+    EXPECT_EQ(values[i], value);
+    EXPECT_EQ(interpolator->EvaluateAtContinuousIndex(x, 0), value);
+
+    if (splineOrder == 0)
+    {
+      continue;
+    }
+    typename InterpolatorType::OutputType          valueWithDerivative;
+    typename InterpolatorType::CovariantVectorType derivative;
+    interpolator->EvaluateValueAndDerivativeAtContinuousIndex(x, valueWithDerivative, derivative);
+    EXPECT_EQ(valueWithDerivative, value);
+    EXPECT_EQ(interpolator->EvaluateDerivativeAtContinuousIndex(x), derivative);
+    EXPECT_EQ(interpolator->EvaluateDerivativeAtContinuousIndex(x, 0), derivative);
+
+    // Away from the borders, where the mirror boundary conditions make the interpolant not differentiable, the
+    // derivatives are the central differences of the values, with respect to the physical coordinates.
+    if (splineOrder < 2)
+    {
+      continue;
+    }
+    constexpr double h = 1e-4;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      if (x[d] < interpolator->GetStartIndex()[d] + 1 || x[d] > interpolator->GetEndIndex()[d] - 1)
+      {
+        continue;
+      }
+      auto xPlus = x;
+      auto xMinus = x;
+      xPlus[d] += h;
+      xMinus[d] -= h;
+      const double centralDifference =
+        (interpolator->EvaluateAtContinuousIndex(xPlus) - interpolator->EvaluateAtContinuousIndex(xMinus)) /
+        (2 * h * image->GetSpacing()[d]);
+      EXPECT_NEAR(derivative[d], centralDifference, 1e-4) << "Spline order " << splineOrder << ", position " << x;
+    }
+  }
+}
+} // namespace
+
+
+TEST(BSplineInterpolateImageFunction, EvaluationsAreConsistent)
+{
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    Expect_evaluations_are_consistent<1>(splineOrder);
+    Expect_evaluations_are_consistent<2>(splineOrder);
+    Expect_evaluations_are_consistent<3>(splineOrder);
+  }
+}
+
+
+// Checks that the interpolation along a dimension of size one, whose index does not start at zero, reads the pixels of
+// that index.
+TEST(BSplineInterpolateImageFunction, InterpolatesAlongSingletonDimension)
+{
+  using ImageType = itk::Image<float, 2>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::IndexType{ { 3, -5 } }, ImageType::SizeType{ { 8, 1 } }));
+  image->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<2>(image->GetBufferedRegion()))
+  {
+    image->SetPixel(index, static_cast<float>(index[0] * index[0]));
+  }
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    const auto interpolator = InterpolatorType::New();
+    interpolator->SetSplineOrder(splineOrder);
+    interpolator->SetInputImage(image);
+    for (const auto & index : itk::ImageRegionIndexRange<2>(image->GetBufferedRegion()))
+    {
+      EXPECT_NEAR(interpolator->EvaluateAtContinuousIndex(InterpolatorType::ContinuousIndexType(index)),
+                  image->GetPixel(index),
+                  1e-3)
+        << "Spline order " << splineOrder << ", index " << index;
+    }
+  }
+}
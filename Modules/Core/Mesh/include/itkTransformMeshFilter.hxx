@@ -20,6 +20,8 @@
 
 #include "itkMacro.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -88,12 +90,25 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
   typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
   typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
 
+  // The points are transformed in chunks, by a single call to the transform per chunk.
+  constexpr SizeValueType                              chunkSize = 1024;
+  std::vector<typename TransformType::InputPointType>  transformInputPoints(chunkSize);
+  std::vector<typename TransformType::OutputPointType> transformOutputPoints(chunkSize);
+
   while (inputPoint != inPoints->End())
   {
-    outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
-
-    ++inputPoint;
-    ++outputPoint;
+    SizeValueType numberOfPoints = 0;
+    for (; numberOfPoints < chunkSize && inputPoint != inPoints->End(); ++numberOfPoints, ++inputPoint)
+    {
+      transformInputPoints[numberOfPoints] = inputPoint.Value();
+    }
+
+    m_Transform->TransformPoints(transformInputPoints.data(), transformOutputPoints.data(), numberOfPoints);
+
+    for (SizeValueType i = 0; i < numberOfPoints; ++i, ++outputPoint)
+    {
+      outputPoint.Value() = transformOutputPoints[i];
+    }
   }
 
   // Create duplicate references to the rest of data on the mesh
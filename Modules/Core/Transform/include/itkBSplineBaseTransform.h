@@ -298,6 +298,14 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override = 0;
 
+  /** The jacobian is nonzero only for the coefficients of the support region of the point, along the dimension of
+   * each coefficient: this returns the SpaceDimension * NumberOfWeights corresponding columns, or none when the
+   * support region does not lie totally within the grid. */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &                point,
+                                               JacobianType &                        jacobian,
+                                               std::vector<NumberOfParametersType> & parameterIndices) const override;
+
   void
   ComputeJacobianWithRespectToPosition(const InputPointType &, JacobianPositionType &) const override
   {
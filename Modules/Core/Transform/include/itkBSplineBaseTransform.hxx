@@ -268,6 +268,42 @@ BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &                point,
+  JacobianType &                        jacobian,
+  std::vector<NumberOfParametersType> & parameterIndices) const
+{
+  ContinuousIndexType index =
+    this->m_CoefficientImages[0]->template TransformPhysicalPointToContinuousIndex<TParametersValueType>(point);
+  if (!this->InsideValidRegion(index))
+  {
+    jacobian.SetSize(SpaceDimension, 0);
+    parameterIndices.clear();
+    return;
+  }
+
+  WeightsType             weights;
+  ParameterIndexArrayType indexes;
+  this->ComputeJacobianFromBSplineWeightsWithRespectToPosition(point, weights, indexes);
+
+  // The parameters of the coefficients of each dimension follow those of the previous dimensions.
+  const NumberOfParametersType numberOfParametersPerDimension = this->GetNumberOfParametersPerDimension();
+  jacobian.SetSize(SpaceDimension, SpaceDimension * NumberOfWeights);
+  jacobian.Fill(0.0);
+  parameterIndices.resize(SpaceDimension * NumberOfWeights);
+  for (unsigned int d = 0; d < SpaceDimension; ++d)
+  {
+    for (unsigned int k = 0; k < NumberOfWeights; ++k)
+    {
+      const unsigned int column = d * NumberOfWeights + k;
+      jacobian(d, column) = weights[k];
+      parameterIndices[column] = indexes[k] + d * numberOfParametersPerDimension;
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 unsigned int
 BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::GetNumberOfAffectedWeights() const
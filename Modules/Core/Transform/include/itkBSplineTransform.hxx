@@ -592,6 +592,78 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  // Offsets of the coefficients of the support region from its first coefficient, in the order of the weights.
+  const typename ImageType::OffsetValueType * offsetTable = coefficientImage->GetOffsetTable();
+  OffsetValueType                             supportOffsets[Superclass::NumberOfWeights];
+  for (unsigned int k = 0; k < Superclass::NumberOfWeights; ++k)
+  {
+    supportOffsets[k] = 0;
+    unsigned int remainder = k;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      supportOffsets[k] += static_cast<OffsetValueType>(remainder % (SplineOrder + 1)) * offsetTable[d];
+      remainder /= SplineOrder + 1;
+    }
+  }
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // Copy the input point first, as the output array may be the input array.
+    const InputPointType point = inputPoints[i];
+
+    ContinuousIndexType index =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+        point);
+
+    // As in TransformPoint, a support region that does not lie totally within the grid gives a zero displacement.
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[i] = point;
+      continue;
+    }
+
+    this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+    const OffsetValueType supportStart = coefficientImage->ComputeOffset(supportIndex);
+
+    OutputPointType outputPoint;
+    outputPoint.Fill(ScalarType{});
+    for (unsigned int k = 0; k < Superclass::NumberOfWeights; ++k)
+    {
+      const OffsetValueType offset = supportStart + supportOffsets[k];
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        outputPoint[j] += static_cast<ScalarType>(weights[k] * coefficients[j][offset]);
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoint[j] += point[j];
+    }
+    outputPoints[i] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
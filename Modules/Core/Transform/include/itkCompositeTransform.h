@@ -258,6 +258,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform a batch of points. Each transform of the queue transforms the
+   * whole batch in place, in the same order as TransformPoint, so that the
+   * transforms use their own batched implementation. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -386,6 +394,22 @@ public:
   virtual void
   FlattenTransformQueue();
 
+  /** Get the transform queue as FlattenTransformQueue() would make it, i.e. with the transforms of nested composite
+   * transforms instead of these, without modifying this transform or the nested ones. */
+  TransformQueueType
+  GetFlattenedTransformQueue() const;
+
+  /** Create a composite transform that maps points as this one does, with fewer transforms to evaluate per point.
+   * Nested composite transforms are expanded, and each run of consecutive linear transforms is collapsed into a
+   * single AffineTransform, computed from their matrices and offsets at the time of the call. The transforms that
+   * are not collapsed are shared with this transform. When all the transforms are linear, the result has a single
+   * transform, so that consumers like ResampleImageFilter take their linear fast path.
+   *
+   * This transform is not modified, so that it can still be optimized: the result is meant for evaluation only, e.g.
+   * to resample images with a transform of several stages. */
+  Pointer
+  CreateLinearlyCollapsedTransform() const;
+
   /**
    * Compute the Jacobian with respect to the parameters for the composite
    * transform using Jacobian rule. See comments in the implementation.
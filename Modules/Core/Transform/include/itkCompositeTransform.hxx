@@ -18,6 +18,9 @@
 #ifndef itkCompositeTransform_hxx
 #define itkCompositeTransform_hxx
 
+#include "itkAffineTransform.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -70,6 +73,25 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                     OutputPointType *      outputPoints,
+                                                                     SizeValueType          numberOfPoints) const
+{
+  if (outputPoints != inputPoints)
+  {
+    std::copy_n(inputPoints, numberOfPoints, outputPoints);
+  }
+
+  /* Apply in reverse queue order.  */
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
@@ -938,6 +960,90 @@ CompositeTransform<TParametersValueType, VDimension>::FlattenTransformQueue()
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::GetFlattenedTransformQueue() const -> TransformQueueType
+{
+  TransformQueueType transformQueue;
+  for (const auto & transform : this->m_TransformQueue)
+  {
+    const auto * nestedCompositeTransform = dynamic_cast<const Self *>(transform.GetPointer());
+    if (nestedCompositeTransform)
+    {
+      const TransformQueueType nestedTransformQueue = nestedCompositeTransform->GetFlattenedTransformQueue();
+      transformQueue.insert(transformQueue.end(), nestedTransformQueue.begin(), nestedTransformQueue.end());
+    }
+    else
+    {
+      transformQueue.push_back(transform);
+    }
+  }
+  return transformQueue;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::CreateLinearlyCollapsedTransform() const -> Pointer
+{
+  using AffineTransformType = AffineTransform<TParametersValueType, VDimension>;
+  using AffineMatrixType = typename AffineTransformType::MatrixType;
+  using OffsetType = typename AffineTransformType::OutputVectorType;
+
+  const TransformQueueType transformQueue = this->GetFlattenedTransformQueue();
+  auto                     collapsedTransform = Self::New();
+
+  auto runBegin = transformQueue.begin();
+  while (runBegin != transformQueue.end())
+  {
+    auto runEnd = runBegin;
+    while (runEnd != transformQueue.end() && (*runEnd)->IsLinear())
+    {
+      ++runEnd;
+    }
+    if (runEnd - runBegin < 2)
+    {
+      // Not a run of linear transforms, or a run of a single one that would not be worth collapsing.
+      collapsedTransform->AddTransform(*runBegin);
+      ++runBegin;
+      continue;
+    }
+
+    // The transforms of the run are applied from its back to its front. A linear transform maps x to J x + T(0),
+    // where J is its jacobian with respect to the position, and T(0) the image of the origin.
+    const InputPointType origin{};
+    AffineMatrixType     matrix;
+    matrix.SetIdentity();
+    OffsetType offset{};
+    for (auto it = runEnd; it != runBegin;)
+    {
+      --it;
+      JacobianPositionType jacobian;
+      (*it)->ComputeJacobianWithRespectToPosition(origin, jacobian);
+      const OutputPointType image = (*it)->TransformPoint(origin);
+
+      AffineMatrixType transformMatrix;
+      for (unsigned int r = 0; r < VDimension; ++r)
+      {
+        for (unsigned int c = 0; c < VDimension; ++c)
+        {
+          transformMatrix[r][c] = jacobian(r, c);
+        }
+      }
+      matrix = transformMatrix * matrix;
+      offset = transformMatrix * offset + image.GetVectorFromOrigin();
+    }
+
+    auto affineTransform = AffineTransformType::New();
+    affineTransform->SetMatrix(matrix);
+    affineTransform->SetOffset(offset);
+    collapsedTransform->AddTransform(affineTransform);
+    runBegin = runEnd;
+  }
+  return collapsedTransform;
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 CompositeTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -394,6 +394,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform a batch of points, with the matrix and offset kept in registers across the points. A subclass
+   * whose category is not Linear is assumed to override TransformPoint, so its points are transformed one by one
+   * with TransformPoint instead. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
 
   OutputVectorType
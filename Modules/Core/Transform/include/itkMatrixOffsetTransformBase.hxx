@@ -128,6 +128,40 @@ MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimensio
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  if (this->GetTransformCategory() != Self::TransformCategoryEnum::Linear)
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  const MatrixType       matrix = m_Matrix;
+  const OutputVectorType offset = m_Offset;
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // Copy the input point first, as the output array may be the input array. The sums are accumulated in the same
+    // order as by TransformPoint, so that both give the same results.
+    const InputPointType point = inputPoints[i];
+    for (unsigned int r = 0; r < VOutputDimension; ++r)
+    {
+      TParametersValueType sum{};
+      for (unsigned int c = 0; c < VInputDimension; ++c)
+      {
+        sum += matrix[r][c] * point[c];
+      }
+      outputPoints[i][r] = sum + offset[r];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(
@@ -28,6 +28,9 @@
 #include "vnl/vnl_matrix_fixed.h"
 #include "itkMatrix.h"
 
+#include <numeric> // For iota.
+#include <vector>
+
 namespace itk
 {
 /**
@@ -180,6 +183,24 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a batch of points: on return, \c outputPoints[i] is
+   * the transform of \c inputPoints[i]. The output array may be the input
+   * array, to transform the points in place. Consumers that map many points,
+   * e.g. ResampleImageFilter, call this rather than TransformPoint, so that
+   * transforms can avoid the overhead of a virtual call per point. The default
+   * calls TransformPoint for each point.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+    }
+  }
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -515,6 +536,23 @@ public:
     this->ComputeJacobianWithRespectToParameters(p, jacobian);
   }
 
+  /** Computes the columns of the jacobian with respect to the parameters that
+   *  may be nonzero at a point: on return, the i-th column of \c jacobian holds
+   *  the derivatives with respect to the parameter \c parameterIndices[i].
+   *  Transforms whose parameters have a local support, e.g. BSplineTransform,
+   *  override this, so that the cost depends on the size of the support rather
+   *  than on the number of parameters. The default returns all the columns of
+   *  ComputeJacobianWithRespectToParameters. */
+  virtual void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &                p,
+                                               JacobianType &                        jacobian,
+                                               std::vector<NumberOfParametersType> & parameterIndices) const
+  {
+    this->ComputeJacobianWithRespectToParameters(p, jacobian);
+    parameterIndices.resize(jacobian.cols());
+    std::iota(parameterIndices.begin(), parameterIndices.end(), NumberOfParametersType{});
+  }
+
 
   /** This provides the ability to get a local jacobian value
    *  in a dense/local transform, e.g. DisplacementFieldTransform. For such
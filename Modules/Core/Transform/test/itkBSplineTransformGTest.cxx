@@ -205,3 +205,59 @@ TEST(ITKBSplineTransform, NumberOfWeights)
   testNumberOfWeights(*itk::BSplineTransform<float, 2>::New());
   testNumberOfWeights(*itk::BSplineTransform<float, 2, 2>::New());
 }
+
+
+TEST(ITKBSplineTransform, SparseJacobianHasTheNonzeroColumnsOfTheJacobian)
+{
+  using BSplineType = itk::BSplineTransform<double, 2, 3>;
+
+  auto bspline = BSplineType::New();
+  bspline->SetTransformDomainOrigin(itk::MakePoint(-1.0, 2.0));
+  bspline->SetTransformDomainPhysicalDimensions(itk::MakeVector(10.0, 8.0));
+  bspline->SetTransformDomainMeshSize(itk::MakeSize(5, 4));
+  BSplineType::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.01 * i;
+  }
+  bspline->SetParameters(parameters);
+
+  for (const auto & point : { itk::MakePoint(0.5, 3.0), itk::MakePoint(4.3, 7.7), itk::MakePoint(8.9, 9.9) })
+  {
+    BSplineType::JacobianType jacobian;
+    bspline->ComputeJacobianWithRespectToParameters(point, jacobian);
+
+    BSplineType::JacobianType                        sparseJacobian;
+    std::vector<BSplineType::NumberOfParametersType> parameterIndices;
+    bspline->ComputeSparseJacobianWithRespectToParameters(point, sparseJacobian, parameterIndices);
+
+    ASSERT_EQ(parameterIndices.size(), 2 * BSplineType::NumberOfWeights) << point;
+    ASSERT_EQ(sparseJacobian.cols(), parameterIndices.size()) << point;
+    std::vector<bool> isSparseColumn(bspline->GetNumberOfParameters());
+    for (unsigned int i = 0; i < parameterIndices.size(); ++i)
+    {
+      ASSERT_LT(parameterIndices[i], bspline->GetNumberOfParameters());
+      EXPECT_FALSE(isSparseColumn[parameterIndices[i]]) << "Duplicate parameter " << parameterIndices[i];
+      isSparseColumn[parameterIndices[i]] = true;
+      for (unsigned int d = 0; d < 2; ++d)
+      {
+        EXPECT_EQ(sparseJacobian(d, i), jacobian(d, parameterIndices[i])) << point;
+      }
+    }
+    for (unsigned int p = 0; p < bspline->GetNumberOfParameters(); ++p)
+    {
+      if (!isSparseColumn[p])
+      {
+        EXPECT_EQ(jacobian(0, p), 0.0) << point;
+        EXPECT_EQ(jacobian(1, p), 0.0) << point;
+      }
+    }
+  }
+
+  // Outside of the valid region, the jacobian is zero.
+  BSplineType::JacobianType                        sparseJacobian;
+  std::vector<BSplineType::NumberOfParametersType> parameterIndices;
+  bspline->ComputeSparseJacobianWithRespectToParameters(itk::MakePoint(-5.0, 3.0), sparseJacobian, parameterIndices);
+  EXPECT_TRUE(parameterIndices.empty());
+  EXPECT_EQ(sparseJacobian.cols(), 0u);
+}
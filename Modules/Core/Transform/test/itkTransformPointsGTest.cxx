@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+#include "itkAffineTransform.h"
+#include "itkAzimuthElevationToCartesianTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkScaleLogarithmicTransform.h"
+#include "itkScaleTransform.h"
+#include "itkTranslationTransform.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+using TransformType = itk::Transform<double, Dimension, Dimension>;
+using PointType = TransformType::InputPointType;
+
+
+// Points inside and outside of the domain of the BSpline transform of MakeBSplineTransform.
+std::vector<PointType>
+MakePoints()
+{
+  std::vector<PointType> points;
+  for (double x = -3.0; x <= 13.0; x += 1.7)
+  {
+    for (double y = -1.0; y <= 11.0; y += 2.3)
+    {
+      for (double z = 0.5; z <= 9.5; z += 3.1)
+      {
+        PointType point;
+        point[0] = x;
+        point[1] = y;
+        point[2] = z;
+        points.push_back(point);
+      }
+    }
+  }
+  return points;
+}
+
+
+itk::BSplineTransform<double, Dimension, 3>::Pointer
+MakeBSplineTransform()
+{
+  using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+  auto transform = BSplineTransformType::New();
+
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions.Fill(10.0);
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize[0] = 4;
+  meshSize[1] = 5;
+  meshSize[2] = 3;
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  transform->SetTransformDomainMeshSize(meshSize);
+
+  BSplineTransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.1 * std::sin(0.37 * i);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+
+itk::AffineTransform<double, Dimension>::Pointer
+MakeAffineTransform()
+{
+  auto transform = itk::AffineTransform<double, Dimension>::New();
+  auto parameters = transform->GetParameters();
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] += 0.03 * std::cos(1.3 * i);
+  }
+  transform->SetParameters(parameters);
+  return transform;
+}
+
+
+// Checks that TransformPoints gives exactly the results of TransformPoint, to a separate array and in place.
+void
+ExpectSameAsTransformPoint(const TransformType & transform)
+{
+  const std::vector<PointType> inputPoints = MakePoints();
+  const auto                   numberOfPoints = static_cast<itk::SizeValueType>(inputPoints.size());
+
+  std::vector<PointType> outputPoints(inputPoints.size());
+  transform.TransformPoints(inputPoints.data(), outputPoints.data(), numberOfPoints);
+
+  std::vector<PointType> inPlacePoints = inputPoints;
+  transform.TransformPoints(inPlacePoints.data(), inPlacePoints.data(), numberOfPoints);
+
+  for (size_t i = 0; i < inputPoints.size(); ++i)
+  {
+    const PointType expectedPoint = transform.TransformPoint(inputPoints[i]);
+    EXPECT_EQ(outputPoints[i], expectedPoint) << transform.GetNameOfClass() << " at " << inputPoints[i];
+    EXPECT_EQ(inPlacePoints[i], expectedPoint) << transform.GetNameOfClass() << " in place at " << inputPoints[i];
+  }
+}
+
+} // namespace
+
+
+TEST(TransformPoints, MatchesTransformPointOfAffineTransform)
+{
+  ExpectSameAsTransformPoint(*MakeAffineTransform());
+}
+
+
+TEST(TransformPoints, MatchesTransformPointOfScaleTransform)
+{
+  using ScaleTransformType = itk::ScaleTransform<double, Dimension>;
+  auto                          transform = ScaleTransformType::New();
+  ScaleTransformType::ScaleType scale;
+  scale[0] = 1.5;
+  scale[1] = 0.75;
+  scale[2] = 2.0;
+  transform->SetScale(scale);
+  transform->SetCenter(PointType(1.0));
+  ExpectSameAsTransformPoint(*transform);
+}
+
+
+// The subclasses of MatrixOffsetTransformBase that override TransformPoint must not be mapped with the matrix.
+TEST(TransformPoints, MatchesTransformPointOfAzimuthElevationToCartesianTransform)
+{
+  auto transform = itk::AzimuthElevationToCartesianTransform<double, Dimension>::New();
+  transform->SetAzimuthElevationToCartesianParameters(0.5, 2.0, 12, 10, 1.5, 2.5);
+  ExpectSameAsTransformPoint(*transform);
+  transform->SetForwardCartesianToAzimuthElevation();
+  ExpectSameAsTransformPoint(*transform);
+}
+
+
+TEST(TransformPoints, MatchesTransformPointOfScaleLogarithmicTransform)
+{
+  using ScaleTransformType = itk::ScaleLogarithmicTransform<double, Dimension>;
+  auto                          transform = ScaleTransformType::New();
+  ScaleTransformType::ScaleType scale;
+  scale[0] = 1.25;
+  scale[1] = 0.5;
+  scale[2] = 3.0;
+  transform->SetScale(scale);
+  transform->SetCenter(PointType(-2.0));
+  ExpectSameAsTransformPoint(*transform);
+}
+
+
+TEST(TransformPoints, MatchesTransformPointOfBSplineTransform)
+{
+  ExpectSameAsTransformPoint(*MakeBSplineTransform());
+  ExpectSameAsTransformPoint(*itk::BSplineTransform<double, Dimension, 2>::New());
+}
+
+
+TEST(TransformPoints, MatchesTransformPointOfCompositeTransform)
+{
+  auto translation = itk::TranslationTransform<double, Dimension>::New();
+  translation->SetOffset(itk::MakeVector(0.5, -1.0, 0.25));
+
+  auto transform = itk::CompositeTransform<double, Dimension>::New();
+  transform->AddTransform(MakeAffineTransform());
+  transform->AddTransform(MakeBSplineTransform());
+  transform->AddTransform(translation);
+  ExpectSameAsTransformPoint(*transform);
+}
@@ -0,0 +1,242 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAutomaticConvolutionImageFilter_h
+#define itkAutomaticConvolutionImageFilter_h
+
+#include "itkConvolutionImageFilterBase.h"
+
+#include "itkProgressAccumulator.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+/** \class AutomaticConvolutionImageFilterEnums
+ * \brief Contains all enum classes used by AutomaticConvolutionImageFilter class.
+ * \ingroup ITKConvolution
+ */
+class AutomaticConvolutionImageFilterEnums
+{
+public:
+  /**
+   * \ingroup ITKConvolution
+   * The method used to compute the convolution.
+   */
+  enum class ConvolutionMethod : uint8_t
+  {
+    AUTOMATIC = 0,
+    SPATIAL,
+    SEPARABLE,
+    FFT
+  };
+};
+/** Define how to print enumerations */
+extern ITKConvolution_EXPORT std::ostream &
+operator<<(std::ostream & out, const AutomaticConvolutionImageFilterEnums::ConvolutionMethod value);
+
+/**
+ * \class AutomaticConvolutionImageFilter
+ * \brief Convolve a given image with an arbitrary image kernel, with the
+ * method that is expected to be the fastest for the image and the kernel.
+ *
+ * This filter produces output equivalent to the output of the
+ * ConvolutionImageFilter, up to the rounding errors of the method. It
+ * computes the convolution with one of three methods:
+ * - SPATIAL: the inner product of the kernel with the neighborhood of each
+ *   pixel, by a ConvolutionImageFilter;
+ * - SEPARABLE: when the kernel is the outer product of one-dimensional
+ *   kernels, one ConvolutionImageFilter per dimension with these
+ *   one-dimensional kernels;
+ * - FFT: the multiplication in the Fourier domain of an
+ *   FFTConvolutionImageFilter.
+ *
+ * The kernel is separable when it has rank one: the kernel is compared with
+ * the outer product of its lines through its largest absolute value, and is
+ * considered separable when they differ by at most SeparabilityTolerance
+ * times that value. The separable method also needs a
+ * ZeroFluxNeumannBoundaryCondition (the default) or a
+ * ConstantBoundaryCondition, which can be applied one dimension at a time to
+ * the images between the passes, whose buffers only cover the regions
+ * needed by the next pass.
+ *
+ * With the AUTOMATIC method (the default), the method is selected at each
+ * update by SelectConvolutionMethod(), from the costs estimated by
+ * EstimateConvolutionCost(): the cost of the spatial method grows with the
+ * number of pixels of the kernel, the cost of the separable method with the
+ * sum of its sizes, and the cost of the FFT method with the size of the
+ * padded output requested region only. The costs are divided by the number
+ * of threads that process the pixels, and the cost of each filter of the
+ * methods includes a part that is not multi-threaded. GetSelectedConvolutionMethod()
+ * reports the method of the last update.
+ *
+ * \warning This filter ignores the spacing, origin, and orientation
+ * of the kernel image and treats them as identical to those in the
+ * input image.
+ *
+ * \ingroup ITKConvolution
+ * \sa ConvolutionImageFilter
+ * \sa FFTConvolutionImageFilter
+ */
+template <typename TInputImage, typename TKernelImage = TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT AutomaticConvolutionImageFilter
+  : public ConvolutionImageFilterBase<TInputImage, TKernelImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AutomaticConvolutionImageFilter);
+
+  using Self = AutomaticConvolutionImageFilter;
+  using Superclass = ConvolutionImageFilterBase<TInputImage, TKernelImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(AutomaticConvolutionImageFilter);
+
+  /** Dimensionality of input and output data is assumed to be the same. */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using KernelImageType = TKernelImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using KernelPixelType = typename KernelImageType::PixelType;
+  using InputSizeType = typename InputImageType::SizeType;
+  using OutputSizeType = typename OutputImageType::SizeType;
+  using KernelSizeType = typename KernelImageType::SizeType;
+  using SizeValueType = typename InputSizeType::SizeValueType;
+  using InputRegionType = typename InputImageType::RegionType;
+  using OutputRegionType = typename OutputImageType::RegionType;
+  using KernelRegionType = typename KernelImageType::RegionType;
+
+  /** The pixel type of the one-dimensional kernels of the separable
+   * method, and of the images between its passes. */
+  using RealPixelType = typename NumericTraits<KernelPixelType>::RealType;
+  using RealImageType = Image<RealPixelType, ImageDimension>;
+
+  /** The one-dimensional kernels of a separable kernel, along each dimension. */
+  using KernelFactorsType = std::array<std::vector<RealPixelType>, ImageDimension>;
+
+  /** Typedef to describe the boundary condition. */
+  using typename Superclass::BoundaryConditionType;
+
+  using ConvolutionMethodEnum = AutomaticConvolutionImageFilterEnums::ConvolutionMethod;
+
+  /** Set/Get the method used to compute the convolution. With AUTOMATIC
+   * (the default), the method is selected at each update. Setting SEPARABLE
+   * makes the update fail when the kernel or the boundary condition is not
+   * separable. */
+  itkSetEnumMacro(ConvolutionMethod, ConvolutionMethodEnum);
+  itkGetEnumMacro(ConvolutionMethod, ConvolutionMethodEnum);
+
+  /** Get the method used by the last update: SPATIAL, SEPARABLE or FFT. */
+  itkGetEnumMacro(SelectedConvolutionMethod, ConvolutionMethodEnum);
+
+  /** Set/Get the largest difference between the kernel and the outer product
+   * of its one-dimensional factors, relative to the largest absolute value
+   * of the kernel, for the kernel to be separable. Defaults to 1e-6. */
+  itkSetMacro(SeparabilityTolerance, double);
+  itkGetConstMacro(SeparabilityTolerance, double);
+
+  /** Set/Get the greatest prime factor of the sizes of the FFTs of the FFT
+   * method. Defaults to the one of the FFT filters. */
+  itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
+  itkGetConstMacro(SizeGreatestPrimeFactor, SizeValueType);
+
+protected:
+  AutomaticConvolutionImageFilter();
+  ~AutomaticConvolutionImageFilter() override = default;
+
+  /** The input requested region is the output requested region padded
+   * by the kernel radius, within the input largest possible region,
+   * and the whole kernel is requested. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Select the method and compute the convolution with a minipipeline. */
+  void
+  GenerateData() override;
+
+  /** Compute the one-dimensional factors of the kernel, normalized when
+   * Normalize is on, and return whether the kernel is separable within
+   * the SeparabilityTolerance. The factor along a dimension of size 1 is
+   * 1. */
+  bool
+  ComputeKernelFactors(KernelFactorsType & factors) const;
+
+  /** Return the method with the lowest estimated cost. The SEPARABLE
+   * method is only considered when the kernel is separable. */
+  virtual ConvolutionMethodEnum
+  SelectConvolutionMethod(bool kernelIsSeparable) const;
+
+  /** Return the estimated cost of the convolution of the output requested
+   * region with the given method, in arbitrary units shared by the three
+   * methods. */
+  virtual double
+  EstimateConvolutionCost(ConvolutionMethodEnum method) const;
+
+  /** Return the number of threads that process the pixels. */
+  unsigned int
+  GetNumberOfThreadsForCost() const;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Compute the convolution with a ConvolutionImageFilter. */
+  void
+  ConvolveSpatially(ProgressAccumulator * progress);
+
+  /** Compute the convolution with one ConvolutionImageFilter per dimension
+   * of the kernel whose size is not 1. */
+  void
+  ConvolveSeparably(const KernelFactorsType & factors, ProgressAccumulator * progress);
+
+  /** Compute the convolution with an FFTConvolutionImageFilter. */
+  void
+  ConvolveWithFFT(ProgressAccumulator * progress);
+
+  /** Return the boundary condition of the images between the passes of the
+   * separable method, which is equivalent to the boundary condition of the
+   * input when the previous passes multiply a constant by constantScale, or
+   * nullptr when the boundary condition of the input cannot be applied one
+   * dimension at a time. */
+  std::unique_ptr<ImageBoundaryCondition<RealImageType>>
+  CreateSeparableBoundaryCondition(RealPixelType constantScale) const;
+
+  /** Return the dimensions along which the separable method convolves. */
+  std::vector<unsigned int>
+  GetSeparablePasses() const;
+
+  ConvolutionMethodEnum m_ConvolutionMethod{ ConvolutionMethodEnum::AUTOMATIC };
+  ConvolutionMethodEnum m_SelectedConvolutionMethod{ ConvolutionMethodEnum::AUTOMATIC };
+  double                m_SeparabilityTolerance{ 1e-6 };
+  SizeValueType         m_SizeGreatestPrimeFactor{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkAutomaticConvolutionImageFilter.hxx"
+#endif
+
+#endif
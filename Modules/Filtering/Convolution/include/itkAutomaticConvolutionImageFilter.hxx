@@ -0,0 +1,518 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAutomaticConvolutionImageFilter_hxx
+#define itkAutomaticConvolutionImageFilter_hxx
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkConvolutionImageFilter.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::AutomaticConvolutionImageFilter()
+{
+  m_SizeGreatestPrimeFactor =
+    FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::New()->GetSizeGreatestPrimeFactor();
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // Pad the input image with the radius of the kernel.
+  if (this->GetInput())
+  {
+    InputRegionType inputRegion = this->GetOutput()->GetRequestedRegion();
+
+    KernelSizeType radius;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      radius[dim] = this->GetKernelImage()->GetLargestPossibleRegion().GetSize()[dim] / 2;
+    }
+    inputRegion.PadByRadius(radius);
+
+    // Crop the output request region to fit within the largest
+    // possible region.
+    const typename InputImageType::Pointer inputPtr = const_cast<InputImageType *>(this->GetInput());
+    if (!inputRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+    {
+      InvalidRequestedRegionError e(__FILE__, __LINE__);
+      e.SetLocation(ITK_LOCATION);
+      e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+      e.SetDataObject(inputPtr);
+      throw e;
+    }
+
+    inputPtr->SetRequestedRegion(inputRegion);
+  }
+
+  // Request the largest possible region for the kernel image.
+  if (this->GetKernelImage())
+  {
+    const typename KernelImageType::Pointer kernelPtr = const_cast<KernelImageType *>(this->GetKernelImage());
+    kernelPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateData()
+{
+  // Create a process accumulator for tracking the progress of this minipipeline
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  // The kernel is only factored when the separable method may be used.
+  KernelFactorsType factors;
+  bool              kernelIsSeparable = false;
+  if (ImageDimension > 1 && m_ConvolutionMethod != ConvolutionMethodEnum::SPATIAL &&
+      m_ConvolutionMethod != ConvolutionMethodEnum::FFT)
+  {
+    kernelIsSeparable =
+      this->CreateSeparableBoundaryCondition(NumericTraits<RealPixelType>::OneValue()) != nullptr &&
+      this->ComputeKernelFactors(factors);
+  }
+
+  m_SelectedConvolutionMethod = m_ConvolutionMethod;
+  if (m_ConvolutionMethod == ConvolutionMethodEnum::AUTOMATIC)
+  {
+    m_SelectedConvolutionMethod = this->SelectConvolutionMethod(kernelIsSeparable);
+  }
+  itkDebugMacro("Convolution method: " << m_SelectedConvolutionMethod);
+
+  switch (m_SelectedConvolutionMethod)
+  {
+    case ConvolutionMethodEnum::SEPARABLE:
+      if (!kernelIsSeparable)
+      {
+        itkExceptionMacro("The SEPARABLE method needs a separable kernel, and a ZeroFluxNeumannBoundaryCondition or a "
+                          "ConstantBoundaryCondition.");
+      }
+      this->ConvolveSeparably(factors, progress);
+      break;
+    case ConvolutionMethodEnum::FFT:
+      this->ConvolveWithFFT(progress);
+      break;
+    default:
+      this->ConvolveSpatially(progress);
+      break;
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+bool
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeKernelFactors(
+  KernelFactorsType & factors) const
+{
+  const KernelImageType * kernel = this->GetKernelImage();
+  const KernelRegionType  kernelRegion = kernel->GetLargestPossibleRegion();
+  const KernelSizeType    kernelSize = kernelRegion.GetSize();
+
+  // The pivot is the pixel with the largest absolute value. A rank one
+  // kernel is the outer product of its lines through the pivot, divided by
+  // the pivot value to the power ImageDimension - 1.
+  typename KernelImageType::IndexType pivotIndex = kernelRegion.GetIndex();
+  RealPixelType                       pivotValue{};
+  for (ImageRegionConstIteratorWithIndex<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+  {
+    const auto value = static_cast<RealPixelType>(it.Get());
+    if (itk::Math::abs(value) > itk::Math::abs(pivotValue))
+    {
+      pivotValue = value;
+      pivotIndex = it.GetIndex();
+    }
+  }
+  if (pivotValue == RealPixelType{})
+  {
+    return false;
+  }
+
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    factors[dim].resize(kernelSize[dim]);
+    typename KernelImageType::IndexType index = pivotIndex;
+    for (SizeValueType i = 0; i < kernelSize[dim]; ++i)
+    {
+      index[dim] = kernelRegion.GetIndex()[dim] + static_cast<IndexValueType>(i);
+      factors[dim][i] = static_cast<RealPixelType>(kernel->GetPixel(index)) / pivotValue;
+    }
+  }
+
+  const auto tolerance = static_cast<RealPixelType>(m_SeparabilityTolerance * itk::Math::abs(pivotValue));
+  for (ImageRegionConstIteratorWithIndex<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+  {
+    RealPixelType product = pivotValue;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      product *= factors[dim][it.GetIndex()[dim] - kernelRegion.GetIndex()[dim]];
+    }
+    if (itk::Math::abs(static_cast<RealPixelType>(it.Get()) - product) > tolerance)
+    {
+      return false;
+    }
+  }
+
+  if (this->GetNormalize())
+  {
+    // The normalized kernel is the product of the normalized factors.
+    for (auto & factor : factors)
+    {
+      RealPixelType sum{};
+      for (const RealPixelType value : factor)
+      {
+        sum += value;
+      }
+      if (sum == RealPixelType{})
+      {
+        return false;
+      }
+      for (RealPixelType & value : factor)
+      {
+        value /= sum;
+      }
+    }
+  }
+  else
+  {
+    // The pivot value goes to the factor of the first pass, so that the
+    // factors along dimensions of size 1 are 1.
+    for (RealPixelType & value : factors[this->GetSeparablePasses().front()])
+    {
+      value *= pivotValue;
+    }
+  }
+  return true;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+auto
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::SelectConvolutionMethod(
+  bool kernelIsSeparable) const -> ConvolutionMethodEnum
+{
+  ConvolutionMethodEnum method = ConvolutionMethodEnum::SPATIAL;
+  double                lowestCost = this->EstimateConvolutionCost(ConvolutionMethodEnum::SPATIAL);
+  if (kernelIsSeparable)
+  {
+    const double separableCost = this->EstimateConvolutionCost(ConvolutionMethodEnum::SEPARABLE);
+    if (separableCost < lowestCost)
+    {
+      method = ConvolutionMethodEnum::SEPARABLE;
+      lowestCost = separableCost;
+    }
+  }
+  if (this->EstimateConvolutionCost(ConvolutionMethodEnum::FFT) < lowestCost)
+  {
+    method = ConvolutionMethodEnum::FFT;
+  }
+  return method;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+double
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::EstimateConvolutionCost(
+  ConvolutionMethodEnum method) const
+{
+  // The costs, in nanoseconds per pixel, measured with float images on a
+  // single thread: the multiply-add of a kernel pixel in a
+  // NeighborhoodOperatorImageFilter, cheaper with the neighborhood of a line
+  // than with a neighborhood along several dimensions, the iteration over a
+  // pixel by each filter, and, for the FFT method, the butterflies per log2
+  // of the number of pixels and the copies of the padding, casting, shifting,
+  // multiplication and cropping filters. The allocation of the images is
+  // not multi-threaded, so a fraction of the costs per pixel is not divided
+  // by the number of threads.
+  constexpr double multiplyAddCost = 3.5;
+  constexpr double lineMultiplyAddCost = 0.6;
+  constexpr double pixelCost = 5.0;
+  constexpr double butterflyCost = 4.5;
+  constexpr double fftPixelCost = 20.0;
+  constexpr double serialFraction = 0.25;
+
+  const OutputSizeType outputSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  const auto           numberOfThreads = static_cast<double>(this->GetNumberOfThreadsForCost());
+  const double         pixelThreadFactor = serialFraction + (1.0 - serialFraction) / numberOfThreads;
+
+  switch (method)
+  {
+    case ConvolutionMethodEnum::SEPARABLE:
+    {
+      // The region of each pass is padded by the radius of the next ones.
+      double cost = 0.0;
+      for (const unsigned int pass : this->GetSeparablePasses())
+      {
+        double numberOfPixels = 1.0;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          numberOfPixels *= static_cast<double>(outputSize[dim] + ((dim > pass) ? 2 * (kernelSize[dim] / 2) : 0));
+        }
+        cost += numberOfPixels * (lineMultiplyAddCost * static_cast<double>(kernelSize[pass]) / numberOfThreads +
+                                  pixelCost * pixelThreadFactor);
+      }
+      return cost;
+    }
+    case ConvolutionMethodEnum::FFT:
+    {
+      // The output requested region is padded by the kernel radius, then to
+      // a size whose greatest prime factor is the one of the FFT filters.
+      double numberOfPixels = 1.0;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        SizeValueType paddedSize = outputSize[dim] + 2 * (kernelSize[dim] / 2);
+        if (m_SizeGreatestPrimeFactor > 1)
+        {
+          while (Math::GreatestPrimeFactor(paddedSize) > m_SizeGreatestPrimeFactor)
+          {
+            ++paddedSize;
+          }
+        }
+        else if (m_SizeGreatestPrimeFactor == 1)
+        {
+          paddedSize += paddedSize % 2;
+        }
+        numberOfPixels *= static_cast<double>(paddedSize);
+      }
+      return numberOfPixels * (butterflyCost * std::log2(std::max(numberOfPixels, 2.0)) / numberOfThreads +
+                               fftPixelCost * pixelThreadFactor);
+    }
+    default:
+    {
+      double numberOfPixels = 1.0;
+      double numberOfKernelPixels = 1.0;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        numberOfPixels *= static_cast<double>(outputSize[dim]);
+        numberOfKernelPixels *= static_cast<double>(kernelSize[dim]);
+      }
+      return numberOfPixels *
+             (multiplyAddCost * numberOfKernelPixels / numberOfThreads + pixelCost * pixelThreadFactor);
+    }
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+unsigned int
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GetNumberOfThreadsForCost() const
+{
+  return std::max(1u,
+                  std::min(static_cast<unsigned int>(this->GetNumberOfWorkUnits()),
+                           static_cast<unsigned int>(this->GetMultiThreader()->GetMaximumNumberOfThreads())));
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ConvolveSpatially(
+  ProgressAccumulator * progress)
+{
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+  auto localKernel = KernelImageType::New();
+  localKernel->Graft(this->GetKernelImage());
+
+  using ConvolutionFilterType = ConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType>;
+  auto convolutionFilter = ConvolutionFilterType::New();
+  convolutionFilter->SetInput(localInput);
+  convolutionFilter->SetKernelImage(localKernel);
+  convolutionFilter->SetNormalize(this->GetNormalize());
+  convolutionFilter->SetBoundaryCondition(this->GetBoundaryCondition());
+  convolutionFilter->SetOutputRegionMode(this->GetOutputRegionMode());
+  convolutionFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(convolutionFilter, 1.0f);
+
+  convolutionFilter->GraftOutput(this->GetOutput());
+  convolutionFilter->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  convolutionFilter->Update();
+  this->GraftOutput(convolutionFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ConvolveSeparably(
+  const KernelFactorsType & factors,
+  ProgressAccumulator *     progress)
+{
+  const std::vector<unsigned int> passes = this->GetSeparablePasses();
+  const float                     passWeight = 1.0f / static_cast<float>(passes.size());
+
+  // The one-dimensional kernel of a pass is an image of size 1 along the other dimensions.
+  const auto createPassKernel = [&factors](const unsigned int dim) {
+    KernelSizeType size;
+    size.Fill(1);
+    size[dim] = factors[dim].size();
+    auto passKernel = RealImageType::New();
+    passKernel->SetRegions(size);
+    passKernel->Allocate();
+    std::copy(factors[dim].begin(), factors[dim].end(), passKernel->GetBufferPointer());
+    return passKernel;
+  };
+  const auto sumFactor = [&factors](const unsigned int dim) {
+    RealPixelType sum{};
+    for (const RealPixelType value : factors[dim])
+    {
+      sum += value;
+    }
+    return sum;
+  };
+
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+
+  // All the passes compute the SAME output region mode: the output requested
+  // region is within the valid region in VALID mode, so the values are the same.
+  using FirstPassType = ConvolutionImageFilter<InputImageType, RealImageType, RealImageType>;
+  auto firstPass = FirstPassType::New();
+  firstPass->SetInput(localInput);
+  firstPass->SetKernelImage(createPassKernel(passes.front()));
+  firstPass->SetBoundaryCondition(this->GetBoundaryCondition());
+  firstPass->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  firstPass->ReleaseDataFlagOn();
+  progress->RegisterInternalFilter(firstPass, passWeight);
+
+  // A constant beyond the input is multiplied by the sum of the factors of each pass.
+  RealPixelType                                                       constantScale = sumFactor(passes.front());
+  std::vector<std::unique_ptr<ImageBoundaryCondition<RealImageType>>> boundaryConditions;
+
+  using MiddlePassType = ConvolutionImageFilter<RealImageType, RealImageType, RealImageType>;
+  std::vector<typename MiddlePassType::Pointer> middlePasses;
+  const RealImageType *                         passInput = firstPass->GetOutput();
+  for (size_t i = 1; i + 1 < passes.size(); ++i)
+  {
+    boundaryConditions.push_back(this->CreateSeparableBoundaryCondition(constantScale));
+    auto middlePass = MiddlePassType::New();
+    middlePass->SetInput(passInput);
+    middlePass->SetKernelImage(createPassKernel(passes[i]));
+    middlePass->SetBoundaryCondition(boundaryConditions.back().get());
+    middlePass->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    middlePass->ReleaseDataFlagOn();
+    progress->RegisterInternalFilter(middlePass, passWeight);
+    constantScale *= sumFactor(passes[i]);
+    passInput = middlePass->GetOutput();
+    middlePasses.push_back(middlePass);
+  }
+
+  boundaryConditions.push_back(this->CreateSeparableBoundaryCondition(constantScale));
+  using LastPassType = ConvolutionImageFilter<RealImageType, RealImageType, OutputImageType>;
+  auto lastPass = LastPassType::New();
+  lastPass->SetInput(passInput);
+  lastPass->SetKernelImage(createPassKernel(passes.back()));
+  lastPass->SetBoundaryCondition(boundaryConditions.back().get());
+  lastPass->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(lastPass, passWeight);
+
+  const OutputRegionType largestPossibleRegion = this->GetOutput()->GetLargestPossibleRegion();
+  lastPass->GraftOutput(this->GetOutput());
+  lastPass->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  lastPass->Update();
+  lastPass->GetOutput()->SetLargestPossibleRegion(largestPossibleRegion);
+  this->GraftOutput(lastPass->GetOutput());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ConvolveWithFFT(
+  ProgressAccumulator * progress)
+{
+  auto localInput = InputImageType::New();
+  localInput->Graft(this->GetInput());
+  auto localKernel = KernelImageType::New();
+  localKernel->Graft(this->GetKernelImage());
+
+  using ConvolutionFilterType = FFTConvolutionImageFilter<InputImageType, KernelImageType, OutputImageType>;
+  auto convolutionFilter = ConvolutionFilterType::New();
+  convolutionFilter->SetInput(localInput);
+  convolutionFilter->SetKernelImage(localKernel);
+  convolutionFilter->SetNormalize(this->GetNormalize());
+  convolutionFilter->SetBoundaryCondition(this->GetBoundaryCondition());
+  convolutionFilter->SetOutputRegionMode(this->GetOutputRegionMode());
+  convolutionFilter->SetSizeGreatestPrimeFactor(m_SizeGreatestPrimeFactor);
+  convolutionFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  progress->RegisterInternalFilter(convolutionFilter, 1.0f);
+
+  convolutionFilter->GraftOutput(this->GetOutput());
+  convolutionFilter->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  convolutionFilter->Update();
+  this->GraftOutput(convolutionFilter->GetOutput());
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+auto
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::CreateSeparableBoundaryCondition(
+  RealPixelType constantScale) const -> std::unique_ptr<ImageBoundaryCondition<RealImageType>>
+{
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  if (dynamic_cast<const ZeroFluxNeumannBoundaryCondition<InputImageType> *>(boundaryCondition))
+  {
+    return std::make_unique<ZeroFluxNeumannBoundaryCondition<RealImageType>>();
+  }
+  if (const auto * constantBoundaryCondition =
+        dynamic_cast<const ConstantBoundaryCondition<InputImageType> *>(boundaryCondition))
+  {
+    auto realBoundaryCondition = std::make_unique<ConstantBoundaryCondition<RealImageType>>();
+    realBoundaryCondition->SetConstant(static_cast<RealPixelType>(constantBoundaryCondition->GetConstant()) *
+                                       constantScale);
+    return realBoundaryCondition;
+  }
+  return nullptr;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+std::vector<unsigned int>
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GetSeparablePasses() const
+{
+  // The dimensions of size 1 are skipped, but there are at least two
+  // passes, so that the first pass reads the input and the last one writes
+  // the output.
+  const KernelSizeType      kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  std::vector<unsigned int> passes;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (kernelSize[dim] > 1)
+    {
+      passes.push_back(dim);
+    }
+  }
+  for (unsigned int dim = 0; dim < ImageDimension && passes.size() < 2; ++dim)
+  {
+    if (kernelSize[dim] == 1)
+    {
+      passes.insert(std::upper_bound(passes.begin(), passes.end(), dim), dim);
+    }
+  }
+  return passes;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+AutomaticConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::PrintSelf(std::ostream & os,
+                                                                                     Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ConvolutionMethod: " << m_ConvolutionMethod << std::endl;
+  os << indent << "SelectedConvolutionMethod: " << m_SelectedConvolutionMethod << std::endl;
+  os << indent << "SeparabilityTolerance: " << m_SeparabilityTolerance << std::endl;
+  os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+}
+} // namespace itk
+#endif
@@ -111,6 +111,28 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get the size of the blocks in which the output requested region
+   * is convolved, with the overlap-save method: each block of the input,
+   * padded by the kernel radius, is transformed separately, and only the
+   * pixels of the block are kept from the inverse transform. The size of
+   * the FFTs, and their memory, then depend on the size of the blocks
+   * rather than on the size of the image. A size of zero along a dimension
+   * (the default) does not split the region along that dimension.
+   *
+   * The blocks are only used by the GenerateData() of this class, not by
+   * the deconvolution filters that derive from it. */
+  itkSetMacro(BlockSize, InputSizeType);
+  itkGetConstReferenceMacro(BlockSize, InputSizeType);
+
+  /** Set/Get whether the spectrum of the kernel is kept between updates,
+   * and reused while the kernel, the normalization and the size of the
+   * FFTs do not change, for example to convolve many images of the same
+   * size, or blocks, with the same kernel. The kernel is considered
+   * unchanged while its modification time is. Off by default. */
+  itkSetMacro(ReuseKernelSpectrum, bool);
+  itkGetConstMacro(ReuseKernelSpectrum, bool);
+  itkBooleanMacro(ReuseKernelSpectrum);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -133,6 +155,11 @@ protected:
   void
   GenerateData() override;
 
+  /** Convolve the output requested region block by block, when a block
+   * size is set. */
+  void
+  GenerateDataInBlocks();
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -209,6 +236,15 @@ private:
   SizeValueType      m_SizeGreatestPrimeFactor{};
   InternalSizeType   m_FFTPadSize{ { 0 } };
   InternalRegionType m_PaddedInputRegion{};
+  InputSizeType      m_BlockSize{ { 0 } };
+  bool               m_ReuseKernelSpectrum{ false };
+
+  // The last spectrum of the kernel, and the modification time of the kernel, the normalization and the padded size
+  // it was computed with.
+  InternalComplexImagePointerType m_KernelSpectrum{};
+  ModifiedTimeType                m_KernelSpectrumMTime{ 0 };
+  bool                            m_KernelSpectrumNormalize{ false };
+  InternalSizeType                m_KernelSpectrumPaddedSize{ { 0 } };
 };
 } // namespace itk
 
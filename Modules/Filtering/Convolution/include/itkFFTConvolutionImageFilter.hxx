@@ -25,12 +25,17 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkFFTPadImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
 #include "itkRegionOfInterestImageFilter.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -82,6 +87,16 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  const OutputSizeType & outputRequestedSize = this->GetOutput()->GetRequestedRegion().GetSize();
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    if (m_BlockSize[dim] > 0 && m_BlockSize[dim] < outputRequestedSize[dim])
+    {
+      this->GenerateDataInBlocks();
+      return;
+    }
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -112,6 +127,115 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateDataInBlocks()
+{
+  this->AllocateOutputs();
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  const OutputRegionType outputRequestedRegion = output->GetRequestedRegion();
+  const KernelSizeType   kernelRadius = this->GetKernelRadius();
+
+  // Each block of the output is convolved from the input block padded by the kernel radius, further padded for the
+  // FFT. All the blocks have the same padded size, so that they share the spectrum of the kernel.
+  OutputSizeType   blockSize;
+  OutputSizeType   numberOfBlocks;
+  InternalSizeType paddedBlockSize;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    const SizeValueType outputRequestedSize = outputRequestedRegion.GetSize()[dim];
+    blockSize[dim] = (m_BlockSize[dim] > 0) ? std::min(m_BlockSize[dim], outputRequestedSize) : outputRequestedSize;
+    numberOfBlocks[dim] = (outputRequestedSize + blockSize[dim] - 1) / blockSize[dim];
+
+    paddedBlockSize[dim] = blockSize[dim] + 2 * kernelRadius[dim];
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(paddedBlockSize[dim]) > m_SizeGreatestPrimeFactor)
+      {
+        ++paddedBlockSize[dim];
+      }
+    }
+    else if (m_SizeGreatestPrimeFactor == 1)
+    {
+      // make sure the total size is even
+      paddedBlockSize[dim] += paddedBlockSize[dim] % 2;
+    }
+  }
+
+  // The progress of the kernel preparation is not reported: the blocks report theirs.
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  m_PaddedInputRegion = InternalRegionType(paddedBlockSize);
+  InternalComplexImagePointerType kernel = nullptr;
+  this->PrepareKernel(this->GetKernelImage(), kernel, progress, 0.0f);
+  const InternalComplexType * kernelBuffer = kernel->GetBufferPointer();
+
+  auto fftFilter = FFTFilterType::New();
+  fftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  auto ifftFilter = IFFTFilterType::New();
+  ifftFilter->SetActualXDimensionIsOdd(this->GetXDimensionIsOdd());
+  ifftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  const SizeValueType           totalNumberOfBlocks = numberOfBlocks.CalculateProductOfElements();
+  SizeValueType                 numberOfConvolvedBlocks = 0;
+  for (const auto & blockGridIndex : ImageRegionIndexRange<ImageDimension>(OutputRegionType(numberOfBlocks)))
+  {
+    OutputIndexType blockIndex;
+    InputIndexType  paddedBlockIndex;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      blockIndex[dim] =
+        outputRequestedRegion.GetIndex()[dim] + blockGridIndex[dim] * static_cast<IndexValueType>(blockSize[dim]);
+      paddedBlockIndex[dim] = blockIndex[dim] - static_cast<IndexValueType>(kernelRadius[dim]);
+    }
+    OutputRegionType blockRegion(blockIndex, blockSize);
+    blockRegion.Crop(outputRequestedRegion);
+
+    // Copy the padded block of the input. The pixels outside of the input buffer are given by the boundary condition,
+    // like in PadInput().
+    const InternalRegionType paddedBlockRegion(paddedBlockIndex, paddedBlockSize);
+    auto                     paddedBlock = InternalImageType::New();
+    paddedBlock->SetRegions(paddedBlockRegion);
+    paddedBlock->Allocate();
+    if (input->GetBufferedRegion().IsInside(paddedBlockRegion))
+    {
+      ImageAlgorithm::Copy(input, paddedBlock.GetPointer(), paddedBlockRegion, paddedBlockRegion);
+    }
+    else
+    {
+      for (ImageRegionIteratorWithIndex<InternalImageType> it(paddedBlock, paddedBlockRegion); !it.IsAtEnd(); ++it)
+      {
+        it.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(it.GetIndex(), input)));
+      }
+    }
+
+    fftFilter->SetInput(paddedBlock);
+    fftFilter->Update();
+    const InternalComplexImagePointerType spectrum = fftFilter->GetOutput();
+    spectrum->DisconnectPipeline();
+
+    // The spectra of the block and of the kernel have the same size.
+    InternalComplexType * spectrumBuffer = spectrum->GetBufferPointer();
+    const SizeValueType   numberOfSpectrumPixels = spectrum->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType i = 0; i < numberOfSpectrumPixels; ++i)
+    {
+      spectrumBuffer[i] *= kernelBuffer[i];
+    }
+
+    // The pixels of the block are those of the circular convolution that do not wrap around.
+    ifftFilter->SetInput(spectrum);
+    ifftFilter->Update();
+    ImageAlgorithm::Copy(ifftFilter->GetOutput(), output, blockRegion, blockRegion);
+
+    ++numberOfConvolvedBlocks;
+    this->UpdateProgress(static_cast<float>(numberOfConvolvedBlocks) / static_cast<float>(totalNumberOfBlocks));
+  }
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -345,67 +469,92 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
     kernelUpperBound[i] = inputPadSize[i] - kernelSize[i];
   }
 
-  InternalImagePointerType paddedKernelImage = nullptr;
-
-  const float paddingWeight = 0.2f;
-  if (this->GetNormalize())
+  // The spectrum of the kernel is computed again only if the kernel, the normalization or the padded size changed.
+  InternalComplexImagePointerType kernelSpectrum = nullptr;
+  if (m_KernelSpectrum && m_KernelSpectrumMTime == kernel->GetMTime() &&
+      m_KernelSpectrumNormalize == this->GetNormalize() && m_KernelSpectrumPaddedSize == inputPadSize)
   {
-    using NormalizeFilterType = NormalizeToConstantImageFilter<KernelImageType, InternalImageType>;
-    auto normalizeFilter = NormalizeFilterType::New();
-    normalizeFilter->SetConstant(NumericTraits<TInternalPrecision>::OneValue());
-    normalizeFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-    normalizeFilter->SetInput(kernel);
-    normalizeFilter->ReleaseDataFlagOn();
-    progress->RegisterInternalFilter(normalizeFilter, 0.2f * paddingWeight * progressWeight);
-
-    // Pad the kernel image with zeros.
-    using KernelPadType = ConstantPadImageFilter<InternalImageType, InternalImageType>;
-    using KernelPadPointer = typename KernelPadType::Pointer;
-    const KernelPadPointer kernelPadder = KernelPadType::New();
-    kernelPadder->SetConstant(TInternalPrecision{});
-    kernelPadder->SetPadUpperBound(kernelUpperBound);
-    kernelPadder->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-    kernelPadder->SetInput(normalizeFilter->GetOutput());
-    kernelPadder->ReleaseDataFlagOn();
-    progress->RegisterInternalFilter(kernelPadder, 0.8f * paddingWeight * progressWeight);
-    kernelPadder->Update();
-    paddedKernelImage = kernelPadder->GetOutput();
+    kernelSpectrum = m_KernelSpectrum;
   }
   else
   {
-    // Pad the kernel image with zeros.
-    using KernelPadType = ConstantPadImageFilter<KernelImageType, InternalImageType>;
-    using KernelPadPointer = typename KernelPadType::Pointer;
-    const KernelPadPointer kernelPadder = KernelPadType::New();
-    kernelPadder->SetConstant(TInternalPrecision{});
-    kernelPadder->SetPadUpperBound(kernelUpperBound);
-    kernelPadder->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-    kernelPadder->SetInput(kernel);
-    kernelPadder->ReleaseDataFlagOn();
-    progress->RegisterInternalFilter(kernelPadder, paddingWeight * progressWeight);
-    paddedKernelImage = kernelPadder->GetOutput();
+    InternalImagePointerType paddedKernelImage = nullptr;
+
+    const float paddingWeight = 0.2f;
+    if (this->GetNormalize())
+    {
+      using NormalizeFilterType = NormalizeToConstantImageFilter<KernelImageType, InternalImageType>;
+      auto normalizeFilter = NormalizeFilterType::New();
+      normalizeFilter->SetConstant(NumericTraits<TInternalPrecision>::OneValue());
+      normalizeFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      normalizeFilter->SetInput(kernel);
+      normalizeFilter->ReleaseDataFlagOn();
+      progress->RegisterInternalFilter(normalizeFilter, 0.2f * paddingWeight * progressWeight);
+
+      // Pad the kernel image with zeros.
+      using KernelPadType = ConstantPadImageFilter<InternalImageType, InternalImageType>;
+      using KernelPadPointer = typename KernelPadType::Pointer;
+      const KernelPadPointer kernelPadder = KernelPadType::New();
+      kernelPadder->SetConstant(TInternalPrecision{});
+      kernelPadder->SetPadUpperBound(kernelUpperBound);
+      kernelPadder->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      kernelPadder->SetInput(normalizeFilter->GetOutput());
+      kernelPadder->ReleaseDataFlagOn();
+      progress->RegisterInternalFilter(kernelPadder, 0.8f * paddingWeight * progressWeight);
+      kernelPadder->Update();
+      paddedKernelImage = kernelPadder->GetOutput();
+    }
+    else
+    {
+      // Pad the kernel image with zeros.
+      using KernelPadType = ConstantPadImageFilter<KernelImageType, InternalImageType>;
+      using KernelPadPointer = typename KernelPadType::Pointer;
+      const KernelPadPointer kernelPadder = KernelPadType::New();
+      kernelPadder->SetConstant(TInternalPrecision{});
+      kernelPadder->SetPadUpperBound(kernelUpperBound);
+      kernelPadder->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      kernelPadder->SetInput(kernel);
+      kernelPadder->ReleaseDataFlagOn();
+      progress->RegisterInternalFilter(kernelPadder, paddingWeight * progressWeight);
+      paddedKernelImage = kernelPadder->GetOutput();
+    }
+
+    // Shift the padded kernel image.
+    using KernelShiftFilterType = CyclicShiftImageFilter<InternalImageType, InternalImageType>;
+    auto                                       kernelShifter = KernelShiftFilterType::New();
+    typename KernelShiftFilterType::OffsetType kernelShift;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      kernelShift[i] = -(static_cast<typename KernelShiftFilterType::OffsetType::OffsetValueType>(kernelSize[i] / 2));
+    }
+    kernelShifter->SetShift(kernelShift);
+    kernelShifter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    kernelShifter->SetInput(paddedKernelImage);
+    kernelShifter->ReleaseDataFlagOn();
+    progress->RegisterInternalFilter(kernelShifter, 0.1f * progressWeight);
+
+    // Compute the kernel complex image
+    auto kernelFFTFilter = FFTFilterType::New();
+    kernelFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    kernelFFTFilter->SetInput(kernelShifter->GetOutput());
+    progress->RegisterInternalFilter(kernelFFTFilter, 0.699f * progressWeight);
+    kernelFFTFilter->Update();
+
+    kernelSpectrum = kernelFFTFilter->GetOutput();
+    kernelSpectrum->DisconnectPipeline();
   }
 
-  // Shift the padded kernel image.
-  using KernelShiftFilterType = CyclicShiftImageFilter<InternalImageType, InternalImageType>;
-  auto                                       kernelShifter = KernelShiftFilterType::New();
-  typename KernelShiftFilterType::OffsetType kernelShift;
-  for (unsigned int i = 0; i < ImageDimension; ++i)
+  if (m_ReuseKernelSpectrum)
+  {
+    m_KernelSpectrum = kernelSpectrum;
+    m_KernelSpectrumMTime = kernel->GetMTime();
+    m_KernelSpectrumNormalize = this->GetNormalize();
+    m_KernelSpectrumPaddedSize = inputPadSize;
+  }
+  else
   {
-    kernelShift[i] = -(static_cast<typename KernelShiftFilterType::OffsetType::OffsetValueType>(kernelSize[i] / 2));
+    m_KernelSpectrum = nullptr;
   }
-  kernelShifter->SetShift(kernelShift);
-  kernelShifter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  kernelShifter->SetInput(paddedKernelImage);
-  kernelShifter->ReleaseDataFlagOn();
-  progress->RegisterInternalFilter(kernelShifter, 0.1f * progressWeight);
-
-  // Compute the kernel complex image
-  auto kernelFFTFilter = FFTFilterType::New();
-  kernelFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  kernelFFTFilter->SetInput(kernelShifter->GetOutput());
-  progress->RegisterInternalFilter(kernelFFTFilter, 0.699f * progressWeight);
-  kernelFFTFilter->Update();
 
   // Shift the kernel complex image in space so that it coincides with the
   // input complex image
@@ -423,7 +572,7 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   }
   kernelInfoFilter->SetOutputOffset(kernelOffset);
   kernelInfoFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  kernelInfoFilter->SetInput(kernelFFTFilter->GetOutput());
+  kernelInfoFilter->SetInput(kernelSpectrum);
   progress->RegisterInternalFilter(kernelInfoFilter, 0.001f * progressWeight);
   kernelInfoFilter->Update();
 
@@ -524,6 +673,10 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "BlockSize: " << static_cast<typename NumericTraits<InputSizeType>::PrintType>(m_BlockSize)
+     << std::endl;
+  itkPrintSelfBooleanMacro(ReuseKernelSpectrum);
+  itkPrintSelfObjectMacro(KernelSpectrum);
 }
 
 } // namespace itk
@@ -0,0 +1,42 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkAutomaticConvolutionImageFilter.h"
+
+namespace itk
+{
+/** Define how to print enumerations */
+std::ostream &
+operator<<(std::ostream & out, const AutomaticConvolutionImageFilterEnums::ConvolutionMethod value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case AutomaticConvolutionImageFilterEnums::ConvolutionMethod::AUTOMATIC:
+        return "AutomaticConvolutionImageFilterEnums::ConvolutionMethod::AUTOMATIC";
+      case AutomaticConvolutionImageFilterEnums::ConvolutionMethod::SPATIAL:
+        return "AutomaticConvolutionImageFilterEnums::ConvolutionMethod::SPATIAL";
+      case AutomaticConvolutionImageFilterEnums::ConvolutionMethod::SEPARABLE:
+        return "AutomaticConvolutionImageFilterEnums::ConvolutionMethod::SEPARABLE";
+      case AutomaticConvolutionImageFilterEnums::ConvolutionMethod::FFT:
+        return "AutomaticConvolutionImageFilterEnums::ConvolutionMethod::FFT";
+      default:
+        return "INVALID VALUE FOR AutomaticConvolutionImageFilterEnums::ConvolutionMethod";
+    }
+  }();
+}
+} // namespace itk
@@ -0,0 +1,251 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAutomaticConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkConvolutionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int ImageDimension = 3;
+using ImageType = itk::Image<float, ImageDimension>;
+using ConvolutionFilterType = itk::AutomaticConvolutionImageFilter<ImageType>;
+using MethodEnum = itk::AutomaticConvolutionImageFilterEnums::ConvolutionMethod;
+using OutputRegionEnum = itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion;
+
+ImageType::Pointer
+CreateImage(const ImageType::RegionType & region)
+{
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.4 * index[0]) + 0.1 * index[1] * index[2] - 0.05 * index[0] * index[2]));
+  }
+  return image;
+}
+
+// A kernel that is the outer product of one-dimensional kernels.
+ImageType::Pointer
+CreateSeparableKernel(const ImageType::SizeType & size)
+{
+  auto kernel = ImageType::New();
+  kernel->SetRegions(size);
+  kernel->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>((1.0 + 0.3 * index[0]) * (2.0 - 0.5 * index[1]) * (0.5 + 0.2 * index[2] * index[2])));
+  }
+  return kernel;
+}
+
+ImageType::Pointer
+CreateNonSeparableKernel(const ImageType::SizeType & size)
+{
+  auto kernel = ImageType::New();
+  kernel->SetRegions(size);
+  kernel->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(kernel, kernel->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>(1.0 + std::sin(1.1 * index[0] + 0.7 * index[1] * index[2])));
+  }
+  return kernel;
+}
+
+template <typename TFilter>
+ImageType::Pointer
+Convolve(TFilter * filter, const ImageType * image, const ImageType * kernel, const ImageType::RegionType * region)
+{
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  if (region)
+  {
+    filter->GetOutput()->SetRequestedRegion(*region);
+    filter->Update();
+  }
+  else
+  {
+    filter->UpdateLargestPossibleRegion();
+  }
+  ImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+bool
+ImagesAreClose(const ImageType * image, const ImageType * referenceImage)
+{
+  if (image->GetBufferedRegion() != referenceImage->GetBufferedRegion() ||
+      image->GetLargestPossibleRegion() != referenceImage->GetLargestPossibleRegion())
+  {
+    std::cerr << "Test failed! Buffered region " << image->GetBufferedRegion() << " instead of "
+              << referenceImage->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  float maximumAbsoluteValue = 0.0f;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(referenceImage, referenceImage->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    maximumAbsoluteValue = std::max(maximumAbsoluteValue, itk::Math::abs(it.Get()));
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const float referenceValue = referenceImage->GetPixel(it.GetIndex());
+    if (itk::Math::abs(it.Get() - referenceValue) > 1e-4f * (1.0f + maximumAbsoluteValue))
+    {
+      std::cerr << "Test failed! Value " << it.Get() << " at index " << it.GetIndex() << " instead of "
+                << referenceValue << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// Checks that all the methods give the output of the ConvolutionImageFilter, and that the automatic method selects
+// the expected method for small, separable and large kernels.
+int
+itkAutomaticConvolutionImageFilterTest(int, char *[])
+{
+  auto filter = ConvolutionFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, AutomaticConvolutionImageFilter, ConvolutionImageFilterBase);
+
+  ITK_TEST_SET_GET_VALUE(MethodEnum::AUTOMATIC, filter->GetConvolutionMethod());
+  filter->SetConvolutionMethod(MethodEnum::FFT);
+  ITK_TEST_SET_GET_VALUE(MethodEnum::FFT, filter->GetConvolutionMethod());
+  ITK_TEST_SET_GET_VALUE(1e-6, filter->GetSeparabilityTolerance());
+  filter->SetSeparabilityTolerance(1e-3);
+  ITK_TEST_SET_GET_VALUE(1e-3, filter->GetSeparabilityTolerance());
+
+  const auto methods = { MethodEnum::AUTOMATIC, MethodEnum::SPATIAL, MethodEnum::SEPARABLE, MethodEnum::FFT };
+  for (const auto method : methods)
+  {
+    std::cout << "ConvolutionMethod: " << method << std::endl;
+  }
+
+  const ImageType::RegionType imageRegion(ImageType::IndexType{ { 3, -2, 1 } }, ImageType::SizeType{ { 23, 19, 11 } });
+  const ImageType::Pointer    image = CreateImage(imageRegion);
+
+  // A requested region at the border of the image.
+  const ImageType::RegionType requestedRegion(ImageType::IndexType{ { 3, 0, 1 } },
+                                              ImageType::SizeType{ { 17, 17, 10 } });
+
+  itk::ConstantBoundaryCondition<ImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(2.0f);
+  itk::PeriodicBoundaryCondition<ImageType> periodicBoundaryCondition;
+
+  const std::vector<ImageType::Pointer> separableKernels{ CreateSeparableKernel(ImageType::SizeType{ { 4, 3, 5 } }),
+                                                          CreateSeparableKernel(ImageType::SizeType{ { 5, 1, 2 } }),
+                                                          CreateSeparableKernel(ImageType::SizeType{ { 1, 1, 3 } }) };
+  const std::vector<ImageType::Pointer> nonSeparableKernels{ CreateNonSeparableKernel(
+    ImageType::SizeType{ { 5, 4, 3 } }) };
+
+  for (const bool isSeparable : { true, false })
+  {
+    for (const auto & kernel : isSeparable ? separableKernels : nonSeparableKernels)
+    {
+      for (const bool normalize : { false, true })
+      {
+        for (itk::ImageBoundaryCondition<ImageType> * boundaryCondition :
+             std::initializer_list<itk::ImageBoundaryCondition<ImageType> *>{
+               nullptr, &constantBoundaryCondition, &periodicBoundaryCondition })
+        {
+          for (const auto outputRegionMode : { OutputRegionEnum::SAME, OutputRegionEnum::VALID })
+          {
+            const auto setUp = [&](auto * convolutionFilter) {
+              convolutionFilter->SetNormalize(normalize);
+              convolutionFilter->SetOutputRegionMode(outputRegionMode);
+              if (boundaryCondition)
+              {
+                convolutionFilter->SetBoundaryCondition(boundaryCondition);
+              }
+            };
+            const ImageType::RegionType * region = (outputRegionMode == OutputRegionEnum::SAME) ? &requestedRegion
+                                                                                                : nullptr;
+
+            auto referenceFilter = itk::ConvolutionImageFilter<ImageType>::New();
+            setUp(referenceFilter.GetPointer());
+            const ImageType::Pointer referenceOutput = Convolve(referenceFilter.GetPointer(), image, kernel, region);
+
+            for (const auto method : methods)
+            {
+              auto convolutionFilter = ConvolutionFilterType::New();
+              setUp(convolutionFilter.GetPointer());
+              convolutionFilter->SetConvolutionMethod(method);
+              // The periodic boundary condition cannot be applied to the images between the passes.
+              if (method == MethodEnum::SEPARABLE && (!isSeparable || boundaryCondition == &periodicBoundaryCondition))
+              {
+                ITK_TRY_EXPECT_EXCEPTION(Convolve(convolutionFilter.GetPointer(), image, kernel, region));
+                continue;
+              }
+              if (!ImagesAreClose(Convolve(convolutionFilter.GetPointer(), image, kernel, region), referenceOutput))
+              {
+                std::cerr << "Kernel size: " << kernel->GetBufferedRegion().GetSize() << ", method: " << method
+                          << ", selected method: " << convolutionFilter->GetSelectedConvolutionMethod()
+                          << ", normalize: " << normalize << ", boundary condition: "
+                          << (boundaryCondition ? boundaryCondition->GetNameOfClass() : "default")
+                          << ", output region mode: " << outputRegionMode << std::endl;
+                return EXIT_FAILURE;
+              }
+              if (method != MethodEnum::AUTOMATIC)
+              {
+                ITK_TEST_EXPECT_EQUAL(convolutionFilter->GetSelectedConvolutionMethod(), method);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // A kernel that is not separable within the tolerance.
+  const ImageType::Pointer almostSeparableKernel = CreateSeparableKernel(ImageType::SizeType{ { 3, 3, 3 } });
+  const ImageType::IndexType center{ { 1, 1, 1 } };
+  almostSeparableKernel->SetPixel(center, 1.01f * almostSeparableKernel->GetPixel(center));
+  auto separableFilter = ConvolutionFilterType::New();
+  separableFilter->SetConvolutionMethod(MethodEnum::SEPARABLE);
+  ITK_TRY_EXPECT_EXCEPTION(Convolve(separableFilter.GetPointer(), image, almostSeparableKernel, nullptr));
+  separableFilter->SetSeparabilityTolerance(0.1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(Convolve(separableFilter.GetPointer(), image, almostSeparableKernel, nullptr));
+
+  // The automatic selection: the spatial method for a small kernel, the
+  // separable method for a large separable kernel, and the FFT method for a
+  // large kernel that is not separable.
+  const ImageType::Pointer largeImage = CreateImage(ImageType::RegionType(ImageType::SizeType{ { 40, 40, 40 } }));
+  const auto               selectMethod = [&largeImage](const ImageType * kernel) {
+    auto automaticFilter = ConvolutionFilterType::New();
+    Convolve(automaticFilter.GetPointer(), largeImage, kernel, nullptr);
+    return automaticFilter->GetSelectedConvolutionMethod();
+  };
+  ITK_TEST_EXPECT_EQUAL(selectMethod(CreateNonSeparableKernel(ImageType::SizeType::Filled(3))), MethodEnum::SPATIAL);
+  ITK_TEST_EXPECT_EQUAL(selectMethod(CreateSeparableKernel(ImageType::SizeType::Filled(9))), MethodEnum::SEPARABLE);
+  ITK_TEST_EXPECT_EQUAL(selectMethod(CreateNonSeparableKernel(ImageType::SizeType::Filled(15))), MethodEnum::FFT);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
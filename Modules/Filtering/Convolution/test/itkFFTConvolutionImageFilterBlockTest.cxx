@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int ImageDimension = 3;
+using ImageType = itk::Image<float, ImageDimension>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+ImageType::Pointer
+CreateImage(const ImageType::RegionType & region, const double frequency)
+{
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(frequency * index[0]) + 0.1 * index[1] * index[2] - 0.05 * index[0] * index[2]));
+  }
+  return image;
+}
+
+ImageType::Pointer
+Convolve(ConvolutionFilterType *       filter,
+         const ImageType *             image,
+         const ImageType *             kernel,
+         const ImageType::RegionType & requestedRegion)
+{
+  filter->SetInput(image);
+  filter->SetKernelImage(kernel);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+  ImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+bool
+ImagesAreClose(const ImageType * image, const ImageType * referenceImage, const char * description)
+{
+  if (image->GetBufferedRegion() != referenceImage->GetBufferedRegion())
+  {
+    std::cerr << "Test failed! " << description << ": buffered region " << image->GetBufferedRegion()
+              << " instead of " << referenceImage->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const float referenceValue = referenceImage->GetPixel(it.GetIndex());
+    if (itk::Math::abs(it.Get() - referenceValue) > 1e-4f * (1.0f + itk::Math::abs(referenceValue)))
+    {
+      std::cerr << "Test failed! " << description << ": value " << it.Get() << " at index " << it.GetIndex()
+                << " instead of " << referenceValue << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// Checks that the convolution in blocks gives the same output as the convolution at once, and that the reused
+// spectrum of the kernel gives the same output as a new one.
+int
+itkFFTConvolutionImageFilterBlockTest(int, char *[])
+{
+  auto filter = ConvolutionFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FFTConvolutionImageFilter, ConvolutionImageFilterBase);
+
+  ITK_TEST_SET_GET_VALUE(ImageType::SizeType::Filled(0), filter->GetBlockSize());
+  ITK_TEST_SET_GET_BOOLEAN(filter, ReuseKernelSpectrum, false);
+
+  const ImageType::RegionType imageRegion(ImageType::IndexType{ { 3, -2, 1 } }, ImageType::SizeType{ { 37, 29, 11 } });
+  const ImageType::Pointer    image = CreateImage(imageRegion, 0.3);
+  const ImageType::Pointer    otherImage = CreateImage(imageRegion, 0.7);
+  const ImageType::Pointer    kernel = CreateImage(ImageType::RegionType(ImageType::SizeType{ { 5, 4, 3 } }), 1.1);
+
+  // A requested region at the border of the image, whose blocks need the boundary condition.
+  const ImageType::RegionType requestedRegion(ImageType::IndexType{ { 3, 0, 1 } },
+                                              ImageType::SizeType{ { 30, 27, 10 } });
+
+  itk::ConstantBoundaryCondition<ImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(2.0f);
+
+  for (const bool normalize : { false, true })
+  {
+    for (const bool useConstantBoundaryCondition : { false, true })
+    {
+      const auto setUp = [&](ConvolutionFilterType * convolutionFilter) {
+        convolutionFilter->SetNormalize(normalize);
+        if (useConstantBoundaryCondition)
+        {
+          convolutionFilter->SetBoundaryCondition(&constantBoundaryCondition);
+        }
+      };
+
+      auto referenceFilter = ConvolutionFilterType::New();
+      setUp(referenceFilter);
+      const ImageType::Pointer referenceOutput = Convolve(referenceFilter, image, kernel, requestedRegion);
+
+      for (const auto & blockSize : { ImageType::SizeType{ { 8, 8, 4 } },
+                                      ImageType::SizeType{ { 13, 0, 3 } },
+                                      ImageType::SizeType{ { 0, 0, 1 } },
+                                      ImageType::SizeType{ { 64, 64, 64 } } })
+      {
+        auto blockFilter = ConvolutionFilterType::New();
+        setUp(blockFilter);
+        blockFilter->SetBlockSize(blockSize);
+        ITK_TEST_SET_GET_VALUE(blockSize, blockFilter->GetBlockSize());
+        if (!ImagesAreClose(Convolve(blockFilter, image, kernel, requestedRegion), referenceOutput, "Blocks"))
+        {
+          std::cerr << "Block size: " << blockSize << ", normalize: " << normalize
+                    << ", constant boundary condition: " << useConstantBoundaryCondition << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // The spectrum of the kernel is reused for another image, and computed again when the kernel is modified.
+  for (const auto & blockSize : { ImageType::SizeType{ { 0, 0, 0 } }, ImageType::SizeType{ { 10, 10, 5 } } })
+  {
+    auto reusingFilter = ConvolutionFilterType::New();
+    reusingFilter->ReuseKernelSpectrumOn();
+    reusingFilter->SetBlockSize(blockSize);
+    Convolve(reusingFilter, image, kernel, imageRegion);
+
+    auto referenceFilter = ConvolutionFilterType::New();
+    if (!ImagesAreClose(Convolve(reusingFilter, otherImage, kernel, imageRegion),
+                        Convolve(referenceFilter, otherImage, kernel, imageRegion),
+                        "Reused kernel spectrum"))
+    {
+      return EXIT_FAILURE;
+    }
+
+    const ImageType::Pointer modifiedKernel = CreateImage(kernel->GetBufferedRegion(), 1.1);
+    Convolve(reusingFilter, image, modifiedKernel, imageRegion);
+    modifiedKernel->SetPixel(ImageType::IndexType{ { 2, 1, 1 } }, 10.0f);
+    modifiedKernel->Modified();
+    if (!ImagesAreClose(Convolve(reusingFilter, otherImage, modifiedKernel, imageRegion),
+                        Convolve(referenceFilter, otherImage, modifiedKernel, imageRegion),
+                        "Modified kernel"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
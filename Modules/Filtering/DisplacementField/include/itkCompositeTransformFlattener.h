@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompositeTransformFlattener_h
+#define itkCompositeTransformFlattener_h
+
+#include "itkCompositeTransform.h"
+#include "itkDisplacementFieldTransform.h"
+
+namespace itk
+{
+/** \class CompositeTransformFlattener
+ * \brief Creates a transform for fast evaluation from a CompositeTransform.
+ *
+ * Deployed composite transforms often hold several stages, e.g. a
+ * translation, a rigid, an affine and a few displacement field transforms,
+ * all of which are evaluated at each point. This class creates a flattened
+ * composite transform that maps points like the composite transform, with
+ * fewer transforms to evaluate per point:
+ *
+ *   \li Each run of consecutive linear transforms is collapsed into a single
+ *       AffineTransform (see
+ *       CompositeTransform::CreateLinearlyCollapsedTransform()).
+ *   \li When BakeNonlinearTransforms is on, the transforms that are applied
+ *       from the first one up to the last non-linear one are baked into a
+ *       single DisplacementFieldTransform, whose field is sampled on the grid
+ *       of the DisplacementFieldReferenceImage, e.g. the grid of the images
+ *       to resample, or a coarser one. Only the linear transforms applied
+ *       after the non-linear ones remain, collapsed into one. Outside of the
+ *       grid, the baked transforms are approximated by a zero displacement.
+ *
+ * The composite transform is not modified, so that it can still be
+ * optimized. The flattened transform is cached: Update() only creates it
+ * again when the composite transform, one of its transforms, the reference
+ * image or this object has been modified since the previous update. Note that
+ * modifying the pixels of a displacement field in place does not modify its
+ * transform.
+ *
+ * \sa TransformToDisplacementFieldFilter
+ *
+ * \ingroup ITKDisplacementField
+ */
+template <typename TParametersValueType = double, unsigned int VDimension = 3>
+class ITK_TEMPLATE_EXPORT CompositeTransformFlattener : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompositeTransformFlattener);
+
+  /** Standard class type aliases. */
+  using Self = CompositeTransformFlattener;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CompositeTransformFlattener);
+
+  static constexpr unsigned int Dimension = VDimension;
+
+  using TransformType = Transform<TParametersValueType, VDimension, VDimension>;
+  using CompositeTransformType = CompositeTransform<TParametersValueType, VDimension>;
+  using DisplacementFieldTransformType = DisplacementFieldTransform<TParametersValueType, VDimension>;
+  using DisplacementFieldType = typename DisplacementFieldTransformType::DisplacementFieldType;
+  using ImageBaseType = ImageBase<VDimension>;
+
+  /** Set/Get the composite transform to flatten. */
+  itkSetConstObjectMacro(CompositeTransform, CompositeTransformType);
+  itkGetConstObjectMacro(CompositeTransform, CompositeTransformType);
+
+  /** Set/Get whether the non-linear transforms, and the linear ones applied before them, are baked into a single
+   * displacement field transform. Off by default. */
+  itkSetMacro(BakeNonlinearTransforms, bool);
+  itkGetConstMacro(BakeNonlinearTransforms, bool);
+  itkBooleanMacro(BakeNonlinearTransforms);
+
+  /** Set/Get the image whose origin, spacing, direction and largest possible region define the grid of the baked
+   * displacement field. Required when BakeNonlinearTransforms is on. */
+  itkSetConstObjectMacro(DisplacementFieldReferenceImage, ImageBaseType);
+  itkGetConstObjectMacro(DisplacementFieldReferenceImage, ImageBaseType);
+
+  /** Create the flattened transform, unless the one of the previous update is up to date. */
+  virtual void
+  Update();
+
+  /** Get the flattened transform created by the last update. */
+  itkGetModifiableObjectMacro(FlattenedTransform, CompositeTransformType);
+
+protected:
+  CompositeTransformFlattener() = default;
+  ~CompositeTransformFlattener() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Bake transforms, given as a composite transform, into a displacement field transform. */
+  virtual typename DisplacementFieldTransformType::Pointer
+  BakeTransforms(const CompositeTransformType * transforms) const;
+
+private:
+  /** Get the latest modification time of a transform, and of the transforms of a composite transform. */
+  static ModifiedTimeType
+  GetTransformMTime(const TransformType * transform);
+
+  typename CompositeTransformType::ConstPointer m_CompositeTransform{};
+  bool                                          m_BakeNonlinearTransforms{ false };
+  typename ImageBaseType::ConstPointer          m_DisplacementFieldReferenceImage{};
+  typename CompositeTransformType::Pointer      m_FlattenedTransform{};
+  ModifiedTimeType                              m_FlattenedTransformTime{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompositeTransformFlattener.hxx"
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompositeTransformFlattener_hxx
+#define itkCompositeTransformFlattener_hxx
+
+#include "itkTransformToDisplacementFieldFilter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int VDimension>
+ModifiedTimeType
+CompositeTransformFlattener<TParametersValueType, VDimension>::GetTransformMTime(const TransformType * transform)
+{
+  // The modification time of a composite transform does not account for the modifications of its transforms.
+  ModifiedTimeType mtime = transform->GetMTime();
+  const auto *     compositeTransform = dynamic_cast<const CompositeTransformType *>(transform);
+  if (compositeTransform)
+  {
+    for (const auto & nestedTransform : compositeTransform->GetTransformQueue())
+    {
+      mtime = std::max(mtime, GetTransformMTime(nestedTransform));
+    }
+  }
+  return mtime;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransformFlattener<TParametersValueType, VDimension>::Update()
+{
+  if (!m_CompositeTransform)
+  {
+    itkExceptionMacro("The composite transform is not set.");
+  }
+  if (m_BakeNonlinearTransforms && !m_DisplacementFieldReferenceImage)
+  {
+    itkExceptionMacro("The displacement field reference image is required to bake the non-linear transforms.");
+  }
+
+  ModifiedTimeType mtime = std::max(this->GetMTime(), GetTransformMTime(m_CompositeTransform));
+  if (m_BakeNonlinearTransforms)
+  {
+    mtime = std::max(mtime, m_DisplacementFieldReferenceImage->GetMTime());
+  }
+  if (m_FlattenedTransform && mtime <= m_FlattenedTransformTime)
+  {
+    return;
+  }
+
+  typename CompositeTransformType::Pointer flattenedTransform = m_CompositeTransform->CreateLinearlyCollapsedTransform();
+
+  if (m_BakeNonlinearTransforms)
+  {
+    // The transforms are applied from the back of the queue to its front, so the transforms to bake are the ones from
+    // the first non-linear transform of the queue to its back. Their domain is the grid of the reference image.
+    const auto & transformQueue = flattenedTransform->GetTransformQueue();
+    const auto   firstNonlinear = std::find_if(
+      transformQueue.begin(), transformQueue.end(), [](const auto & transform) { return !transform->IsLinear(); });
+    const bool isSingleDisplacementField =
+      firstNonlinear != transformQueue.end() && firstNonlinear + 1 == transformQueue.end() &&
+      dynamic_cast<const DisplacementFieldTransformType *>(firstNonlinear->GetPointer()) != nullptr;
+
+    if (firstNonlinear != transformQueue.end() && !isSingleDisplacementField)
+    {
+      auto transformsToBake = CompositeTransformType::New();
+      auto bakedTransform = CompositeTransformType::New();
+      for (auto it = transformQueue.begin(); it != transformQueue.end(); ++it)
+      {
+        if (it < firstNonlinear)
+        {
+          bakedTransform->AddTransform(*it);
+        }
+        else
+        {
+          transformsToBake->AddTransform(*it);
+        }
+      }
+      bakedTransform->AddTransform(this->BakeTransforms(transformsToBake));
+      flattenedTransform = bakedTransform;
+    }
+  }
+
+  m_FlattenedTransform = flattenedTransform;
+  m_FlattenedTransformTime = mtime;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransformFlattener<TParametersValueType, VDimension>::BakeTransforms(
+  const CompositeTransformType * transforms) const -> typename DisplacementFieldTransformType::Pointer
+{
+  using FieldFilterType = TransformToDisplacementFieldFilter<DisplacementFieldType, TParametersValueType>;
+  auto fieldFilter = FieldFilterType::New();
+  fieldFilter->SetTransform(transforms);
+  fieldFilter->SetReferenceImage(m_DisplacementFieldReferenceImage);
+  fieldFilter->UseReferenceImageOn();
+  fieldFilter->Update();
+
+  auto bakedTransform = DisplacementFieldTransformType::New();
+  bakedTransform->SetDisplacementField(fieldFilter->GetOutput());
+  return bakedTransform;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransformFlattener<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(CompositeTransform);
+  itkPrintSelfBooleanMacro(BakeNonlinearTransforms);
+  itkPrintSelfObjectMacro(DisplacementFieldReferenceImage);
+  itkPrintSelfObjectMacro(FlattenedTransform);
+  os << indent << "FlattenedTransformTime: " << m_FlattenedTransformTime << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -101,6 +101,48 @@ DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(con
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                             OutputPointType *      outputPoints,
+                                                                             SizeValueType numberOfPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionMacro("No interpolator is specified.");
+  }
+
+  const DisplacementFieldType * displacementField = this->m_DisplacementField;
+  const InterpolatorType *      interpolator = this->m_Interpolator;
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    typename InterpolatorType::PointType point;
+    point.CastFrom(inputPoints[i]);
+
+    // Out-of-bounds points are returned with zero displacement, as by TransformPoint.
+    OutputPointType outputPoint;
+    outputPoint.CastFrom(inputPoints[i]);
+    if (interpolator->IsInsideBuffer(point))
+    {
+      const typename InterpolatorType::ContinuousIndexType cidx =
+        displacementField
+          ->template TransformPhysicalPointToContinuousIndex<typename InterpolatorType::ContinuousIndexType::ValueType>(
+            point);
+      const typename InterpolatorType::OutputType displacement = interpolator->EvaluateAtContinuousIndex(cidx);
+      for (unsigned int ii = 0; ii < VDimension; ++ii)
+      {
+        outputPoint[ii] += displacement[ii];
+      }
+    }
+    outputPoints[i] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 bool
 DisplacementFieldTransform<TParametersValueType, VDimension>::GetInverse(Self * inverse) const
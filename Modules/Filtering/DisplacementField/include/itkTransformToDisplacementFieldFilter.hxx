@@ -24,6 +24,8 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -177,11 +179,12 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   OutputImageType *     output = this->GetOutput();
   const TransformType * transform = this->GetInput()->Get();
 
-  // Define a few variables that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;       // Coordinates of output pixel
-  PointType transformedPoint;  // Coordinates of transformed pixel
-  PixelType displacementPixel; // the difference, cast to pixel type
+  // The points of each scan line are mapped by a single call to the transform, to avoid a virtual call per pixel.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<PointType>                               outputPoints(lineLength); // Coordinates of output pixels
+  std::vector<typename TransformType::InputPointType>  transformInputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+  PixelType                                            displacementPixel; // the difference, cast to pixel type
 
 
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
@@ -189,15 +192,23 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   // Walk the output region for this thread.
   for (ImageScanlineIterator outIt(output, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    while (!outIt.IsAtEndOfLine())
+    // Determine the coordinates of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
     {
-      // Determine the index of the current output pixel
-      output->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+      output->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+      transformInputPoints[i].CastFrom(outputPoints[i]);
+    }
+
+    // Compute corresponding input pixel positions
+    transform->TransformPoints(transformInputPoints.data(), transformedPoints.data(), lineLength);
 
-      // Compute corresponding input pixel position
-      transformedPoint = transform->TransformPoint(outputPoint);
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      PointType transformedPoint; // Coordinates of transformed pixel
+      transformedPoint.CastFrom(transformedPoints[i]);
 
-      const typename PointType::VectorType displacementVector = transformedPoint - outputPoint;
+      const typename PointType::VectorType displacementVector = transformedPoint - outputPoints[i];
       // Cast PointType -> PixelType
       for (IndexValueType idx = 0; idx < ImageDimension; ++idx)
       {
@@ -206,7 +217,7 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
       outIt.Set(displacementPixel);
       ++outIt;
     }
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(lineLength);
   }
 }
 
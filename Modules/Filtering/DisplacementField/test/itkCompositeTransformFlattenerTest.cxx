@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCompositeTransformFlattener.h"
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkEuler2DTransform.h"
+#include "itkImage.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/*
+ * Flattens a composite transform of linear and BSpline transforms, and checks that the flattened transforms map
+ * points like the composite transform, that the composite transform is left unchanged, and that the flattened
+ * transform is only created again when an input is modified.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using FlattenerType = itk::CompositeTransformFlattener<double, Dimension>;
+using CompositeTransformType = FlattenerType::CompositeTransformType;
+using PointType = CompositeTransformType::InputPointType;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+BSplineTransformType::Pointer
+MakeBSplineTransform()
+{
+  auto                                       transform = BSplineTransformType::New();
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions.Fill(40.0);
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize.Fill(4);
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  transform->SetTransformDomainMeshSize(meshSize);
+
+  BSplineTransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.8 * std::sin(0.37 * i);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+bool
+MapsLikeCompositeTransform(const CompositeTransformType * transform,
+                           const CompositeTransformType * compositeTransform,
+                           double                         tolerance)
+{
+  for (double x = 2.0; x <= 36.0; x += 3.1)
+  {
+    for (double y = 2.0; y <= 36.0; y += 2.7)
+    {
+      const PointType point = itk::MakePoint(x, y);
+      const PointType expectedPoint = compositeTransform->TransformPoint(point);
+      const PointType flattenedPoint = transform->TransformPoint(point);
+      if (flattenedPoint.EuclideanDistanceTo(expectedPoint) > tolerance)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The flattened transform maps " << point << " to " << flattenedPoint << " instead of "
+                  << expectedPoint << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkCompositeTransformFlattenerTest(int, char *[])
+{
+  auto flattener = FlattenerType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(flattener, CompositeTransformFlattener, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(flattener->Update());
+
+  // The transforms are applied from the last one added to the first one.
+  auto translation = itk::TranslationTransform<double, Dimension>::New();
+  translation->SetOffset(itk::MakeVector(1.5, -0.5));
+  auto euler = itk::Euler2DTransform<double>::New();
+  euler->SetCenter(itk::MakePoint(20.0, 20.0));
+  euler->SetAngle(0.05);
+  auto affine = itk::AffineTransform<double, Dimension>::New();
+  affine->Scale(1.02);
+  affine->Translate(itk::MakeVector(-0.75, 0.25));
+  const auto bspline = MakeBSplineTransform();
+
+  auto nestedCompositeTransform = CompositeTransformType::New();
+  nestedCompositeTransform->AddTransform(euler);
+  nestedCompositeTransform->AddTransform(affine);
+
+  auto compositeTransform = CompositeTransformType::New();
+  compositeTransform->AddTransform(translation);
+  compositeTransform->AddTransform(nestedCompositeTransform);
+  compositeTransform->AddTransform(bspline);
+  compositeTransform->AddTransform(affine);
+  compositeTransform->AddTransform(euler);
+
+  flattener->SetCompositeTransform(compositeTransform);
+  ITK_TEST_SET_GET_VALUE(compositeTransform.GetPointer(), flattener->GetCompositeTransform());
+  ITK_TEST_SET_GET_BOOLEAN(flattener, BakeNonlinearTransforms, false);
+
+  // The first three linear transforms, then the two last ones, are collapsed.
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  const CompositeTransformType::Pointer collapsedTransform = flattener->GetFlattenedTransform();
+  ITK_TEST_EXPECT_EQUAL(collapsedTransform->GetNumberOfTransforms(), 3);
+  ITK_TEST_EXPECT_EQUAL(compositeTransform->GetNumberOfTransforms(), 5);
+  ITK_TEST_EXPECT_EQUAL(nestedCompositeTransform->GetNumberOfTransforms(), 2);
+  if (!MapsLikeCompositeTransform(collapsedTransform, compositeTransform, 1e-9))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The flattened transform is cached, until a transform of the composite transform is modified.
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  ITK_TEST_EXPECT_EQUAL(flattener->GetFlattenedTransform(), collapsedTransform);
+  affine->Translate(itk::MakeVector(0.5, 0.0));
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  ITK_TEST_EXPECT_TRUE(flattener->GetFlattenedTransform() != collapsedTransform);
+  if (!MapsLikeCompositeTransform(flattener->GetFlattenedTransform(), compositeTransform, 1e-9))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Baking requires a reference image.
+  flattener->BakeNonlinearTransformsOn();
+  ITK_TRY_EXPECT_EXCEPTION(flattener->Update());
+
+  // The BSpline transform and the linear transforms applied before it are baked at a resolution of 0.5.
+  using ImageType = itk::Image<float, Dimension>;
+  auto referenceImage = ImageType::New();
+  referenceImage->SetRegions(ImageType::SizeType{ { 80, 80 } });
+  referenceImage->SetSpacing(0.5);
+  flattener->SetDisplacementFieldReferenceImage(referenceImage);
+  ITK_TEST_SET_GET_VALUE(referenceImage.GetPointer(), flattener->GetDisplacementFieldReferenceImage());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  const CompositeTransformType::Pointer bakedTransform = flattener->GetFlattenedTransform();
+  ITK_TEST_EXPECT_EQUAL(bakedTransform->GetNumberOfTransforms(), 2);
+  ITK_TEST_EXPECT_TRUE(bakedTransform->GetNthTransformConstPointer(0)->IsLinear());
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<const FlattenerType::DisplacementFieldTransformType *>(
+                         bakedTransform->GetNthTransformConstPointer(1)) != nullptr);
+  if (!MapsLikeCompositeTransform(bakedTransform, compositeTransform, 0.05))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the reference image bakes the transforms again.
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  ITK_TEST_EXPECT_EQUAL(flattener->GetFlattenedTransform(), bakedTransform);
+  referenceImage->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(flattener->Update());
+  ITK_TEST_EXPECT_TRUE(flattener->GetFlattenedTransform() != bakedTransform);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -425,6 +425,26 @@ itkDisplacementFieldTransformTest(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
+  // Test transforming a batch of points, including points outside of the field, in place
+  DisplacementTransformType::InputPointType batchPoints[3] = { testPoint, testPoint, testPoint };
+  batchPoints[1][0] += 1.25;
+  batchPoints[2][1] -= 1000.0;
+  DisplacementTransformType::OutputPointType batchTruth[3];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    batchTruth[i] = displacementTransform->TransformPoint(batchPoints[i]);
+  }
+  displacementTransform->TransformPoints(batchPoints, batchPoints, 3);
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (batchPoints[i] != batchTruth[i])
+    {
+      std::cout << "Error transforming points: TransformPoints(...)" << std::endl;
+      std::cout << "Test failed!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   DisplacementTransformType::InputVectorType testVector;
   testVector[0] = 0.5;
   testVector[1] = 0.5;
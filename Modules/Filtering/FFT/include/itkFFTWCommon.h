@@ -33,7 +33,10 @@
 
 #endif
 
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace itk
 {
@@ -386,6 +389,108 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+  /** A plan shared through the plan cache of FFTWGlobalConfiguration, destroyed with its last reference. */
+  using CachedPlanPointer = std::shared_ptr<std::remove_pointer_t<PlanType>>;
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft_c2r() if it is not cached. The plan is
+   * executed on in and out by Execute(plan, in, out), and may be executed on other arrays of the same alignment. */
+  static CachedPlanPointer
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan(MakePlanCacheKey(FFTW_BACKWARD, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft_r2c() if it is not cached. */
+  static CachedPlanPointer
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan(MakePlanCacheKey(FFTW_FORWARD, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft() if it is not cached. */
+  static CachedPlanPointer
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads = 1,
+                    bool          canDestroyInput = false)
+  {
+    // The complex-to-complex transforms are told apart from the real ones by a sign twice as large.
+    return GetCachedPlan(MakePlanCacheKey(2 * sign, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    });
+  }
+
+  static void
+  Execute(const CachedPlanPointer & p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p.get(), in, out);
+  }
+  static void
+  Execute(const CachedPlanPointer & p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p.get(), in, out);
+  }
+  static void
+  Execute(const CachedPlanPointer & p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p.get(), in, out);
+  }
+
+private:
+  template <typename TInput, typename TOutput>
+  static std::vector<int>
+  MakePlanCacheKey(int direction, int rank, const int * n, TInput * in, TOutput * out, unsigned int flags, int threads)
+  {
+    std::vector<int> key{ static_cast<int>(sizeof(PixelType)), direction, static_cast<int>(flags), threads, rank };
+    key.insert(key.end(), n, n + rank);
+    // The new-array execute functions require arrays of the same alignment, and the same in-placeness.
+    key.push_back(static_cast<int>(static_cast<void *>(in) == static_cast<void *>(out)));
+#  ifndef ITK_USE_CUFFTW
+    key.push_back(fftwf_alignment_of(reinterpret_cast<PixelType *>(in)));
+    key.push_back(fftwf_alignment_of(reinterpret_cast<PixelType *>(out)));
+#  endif
+    return key;
+  }
+
+  template <typename TCreatePlan>
+  static CachedPlanPointer
+  GetCachedPlan(const std::vector<int> & key, const TCreatePlan & createPlan)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto cachedPlan = FFTWGlobalConfiguration::GetCachedPlan(key, [&createPlan] {
+      return FFTWGlobalConfiguration::CachedPlanPointer(
+        createPlan(), [&mutex = FFTWGlobalConfiguration::GetLockMutex()](PlanType p) {
+          const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(mutex);
+          fftwf_destroy_plan(p);
+        });
+    });
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(cachedPlan);
+#  else
+    // cuFFTW plans are not cached.
+    return CachedPlanPointer(createPlan(), fftwf_destroy_plan);
+#  endif
+  }
 };
 
 #endif // ITK_USE_FFTWF
@@ -715,6 +820,108 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+  /** A plan shared through the plan cache of FFTWGlobalConfiguration, destroyed with its last reference. */
+  using CachedPlanPointer = std::shared_ptr<std::remove_pointer_t<PlanType>>;
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft_c2r() if it is not cached. The plan is
+   * executed on in and out by Execute(plan, in, out), and may be executed on other arrays of the same alignment. */
+  static CachedPlanPointer
+  GetCachedPlan_dft_c2r(int           rank,
+                        const int *   n,
+                        ComplexType * in,
+                        PixelType *   out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan(MakePlanCacheKey(FFTW_BACKWARD, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft_r2c() if it is not cached. */
+  static CachedPlanPointer
+  GetCachedPlan_dft_r2c(int           rank,
+                        const int *   n,
+                        PixelType *   in,
+                        ComplexType * out,
+                        unsigned int  flags,
+                        int           threads = 1,
+                        bool          canDestroyInput = false)
+  {
+    return GetCachedPlan(MakePlanCacheKey(FFTW_FORWARD, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+    });
+  }
+
+  /** Get a plan from the process-wide plan cache, creating it with Plan_dft() if it is not cached. */
+  static CachedPlanPointer
+  GetCachedPlan_dft(int           rank,
+                    const int *   n,
+                    ComplexType * in,
+                    ComplexType * out,
+                    int           sign,
+                    unsigned int  flags,
+                    int           threads = 1,
+                    bool          canDestroyInput = false)
+  {
+    // The complex-to-complex transforms are told apart from the real ones by a sign twice as large.
+    return GetCachedPlan(MakePlanCacheKey(2 * sign, rank, n, in, out, flags, threads), [=] {
+      return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+    });
+  }
+
+  static void
+  Execute(const CachedPlanPointer & p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p.get(), in, out);
+  }
+  static void
+  Execute(const CachedPlanPointer & p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p.get(), in, out);
+  }
+  static void
+  Execute(const CachedPlanPointer & p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p.get(), in, out);
+  }
+
+private:
+  template <typename TInput, typename TOutput>
+  static std::vector<int>
+  MakePlanCacheKey(int direction, int rank, const int * n, TInput * in, TOutput * out, unsigned int flags, int threads)
+  {
+    std::vector<int> key{ static_cast<int>(sizeof(PixelType)), direction, static_cast<int>(flags), threads, rank };
+    key.insert(key.end(), n, n + rank);
+    // The new-array execute functions require arrays of the same alignment, and the same in-placeness.
+    key.push_back(static_cast<int>(static_cast<void *>(in) == static_cast<void *>(out)));
+#  ifndef ITK_USE_CUFFTW
+    key.push_back(fftw_alignment_of(reinterpret_cast<PixelType *>(in)));
+    key.push_back(fftw_alignment_of(reinterpret_cast<PixelType *>(out)));
+#  endif
+    return key;
+  }
+
+  template <typename TCreatePlan>
+  static CachedPlanPointer
+  GetCachedPlan(const std::vector<int> & key, const TCreatePlan & createPlan)
+  {
+#  ifndef ITK_USE_CUFFTW
+    const auto cachedPlan = FFTWGlobalConfiguration::GetCachedPlan(key, [&createPlan] {
+      return FFTWGlobalConfiguration::CachedPlanPointer(
+        createPlan(), [&mutex = FFTWGlobalConfiguration::GetLockMutex()](PlanType p) {
+          const std::lock_guard<FFTWGlobalConfiguration::MutexType> lockGuard(mutex);
+          fftw_destroy_plan(p);
+        });
+    });
+    return std::static_pointer_cast<std::remove_pointer_t<PlanType>>(cachedPlan);
+#  else
+    // cuFFTW plans are not cached.
+    return CachedPlanPointer(createPlan(), fftw_destroy_plan);
+#  endif
+  }
 };
 
 #endif
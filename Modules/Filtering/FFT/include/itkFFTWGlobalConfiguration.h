@@ -35,6 +35,10 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <functional>
+#  include <map>
+#  include <memory>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +60,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE_SIZE - Defines the maximum number of plans kept
+//                             in the process-wide plan cache (64 by
+//                             default, 0 disables the cache).
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -348,6 +355,48 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /** The key of a plan in the plan cache, made of every parameter the plan depends on: precision, transform kind
+   * and direction, sizes, flags, number of threads, and the alignments of the arrays. */
+  using PlanCacheKeyType = std::vector<int>;
+
+  /** A plan of the plan cache, whose deleter destroys it. */
+  using CachedPlanPointer = std::shared_ptr<void>;
+
+  /**
+   * \brief Get the plan of the process-wide plan cache for the key, creating
+   * it with createPlan if it is not in the cache.
+   *
+   * The cache is shared by all the FFTW filters, so that identical
+   * transforms are planned only once per process, whatever the filter
+   * instance. The cached plans are executed with the new-array execute
+   * functions of FFTW, which are thread-safe. When the cache is full,
+   * the least recently used plan is dropped; it is destroyed once the
+   * filters that execute it release it.
+   * \sa fftw::Proxy
+   */
+  static CachedPlanPointer
+  GetCachedPlan(const PlanCacheKeyType & key, const std::function<CachedPlanPointer()> & createPlan);
+
+  /**
+   * \brief Set/Get the maximum number of plans kept in the plan cache.
+   *
+   * If the environmental variable "ITK_FFTW_PLAN_CACHE_SIZE", is set,
+   * then the environmental setting overrides default settings.
+   * Zero disables the cache.
+   */
+  static void
+  SetPlanCacheSize(const SizeValueType v);
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Get the number of plans in the plan cache. */
+  static SizeValueType
+  GetNumberOfCachedPlans();
+
+  /** Drop all the plans of the plan cache. */
+  static void
+  ClearPlanCache();
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -358,6 +407,17 @@ private:
 
   itkGetGlobalDeclarationMacro(FFTWGlobalConfigurationGlobals, PimplGlobals);
 
+  struct CachedPlan
+  {
+    CachedPlanPointer m_Plan;
+    SizeValueType     m_LastUse;
+  };
+
+  /** Moves the least recently used plans out of the plan cache until it has at most maximumNumberOfPlans plans.
+   * The plan cache mutex must be held. */
+  void
+  DropLeastRecentlyUsedPlans(const SizeValueType maximumNumberOfPlans, std::vector<CachedPlanPointer> & droppedPlans);
+
 
   /** This is a singleton pattern New.  There will only be ONE
    * reference to a FFTWGlobalConfiguration object per process.
@@ -368,6 +428,7 @@ private:
   static FFTWGlobalConfigurationGlobals * m_PimplGlobals;
 
   std::mutex  m_Mutex;
+  std::mutex  m_PlanCacheMutex;
   bool        m_NewWisdomAvailable{ false };
   int         m_PlanRigor{ 0 };
   bool        m_WriteWisdomCache{ false };
@@ -376,6 +437,10 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  std::map<PlanCacheKeyType, CachedPlan> m_PlanCache;
+  SizeValueType                          m_PlanCacheSize{ 64 };
+  SizeValueType                          m_PlanCacheUseCount{ 0 };
 };
 } // namespace itk
 #endif
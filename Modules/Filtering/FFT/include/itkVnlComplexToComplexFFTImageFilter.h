@@ -28,7 +28,11 @@ namespace itk
  *
  * \brief VNL based complex to complex Fast Fourier Transform.
  *
- * This filter requires input images with sizes which are a power of two.
+ * The image may have any size. Along the dimensions whose size has a
+ * prime factorization consisting of 2s, 3s, and 5s, the transform is
+ * computed directly, and along the others with Bluestein's algorithm,
+ * which is slower: see GetSizeGreatestPrimeFactor(), used by
+ * FFTPadImageFilter to pad the images to such sizes.
  *
  * \ingroup FourierTransform
  * \ingroup ITKFFT
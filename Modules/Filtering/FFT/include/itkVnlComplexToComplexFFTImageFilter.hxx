@@ -44,17 +44,6 @@ VnlComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGene
   const typename ImageType::RegionType bufferedRegion = input->GetBufferedRegion();
   const typename ImageType::SizeType & imageSize = bufferedRegion.GetSize();
 
-  for (unsigned int ii = 0; ii < ImageDimension; ++ii)
-  {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(imageSize[ii]))
-    {
-      itkExceptionMacro("Cannot compute FFT of image with size "
-                        << imageSize
-                        << ". VnlComplexToComplexFFTImageFilter operates only on images whose size in each dimension "
-                           "has only a combination of 2,3, and 5 as prime factors.");
-    }
-  }
-
   // Copy the input to the output, and we will work in place on the output.
   ImageAlgorithm::Copy<ImageType, ImageType>(input, output, bufferedRegion, bufferedRegion);
 
@@ -65,11 +54,11 @@ VnlComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGene
   VnlFFTCommon::VnlFFTTransform<Image<typename PixelType::value_type, ImageDimension>> vnlfft(imageSize);
   if (this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE)
   {
-    vnlfft.transform(outputBuffer, 1);
+    vnlfft.transform(outputBuffer, 1, this->GetMultiThreader());
   }
   else
   {
-    vnlfft.transform(outputBuffer, -1);
+    vnlfft.transform(outputBuffer, -1, this->GetMultiThreader());
   }
 }
 
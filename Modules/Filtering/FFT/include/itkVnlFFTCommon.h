@@ -19,9 +19,14 @@
 #define itkVnlFFTCommon_h
 
 #include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
 
 #include "vnl/algo/vnl_fft_base.h"
 
+#include <complex>
+#include <memory>
+#include <vector>
+
 namespace itk
 {
 
@@ -43,14 +48,56 @@ struct VnlFFTCommon
   static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
 
   /** Convenience struct for computing the discrete Fourier
-  Transform. */
+  Transform.
+
+  The transform along each dimension is computed by batches of lines,
+  which are given to Vnl's GPFA routine all at once (through its LOT
+  parameter), and which are distributed over the threads of a
+  MultiThreaderBase. Along the dimensions whose size is a product of 2's,
+  3's and 5's, the lines are transformed directly; along the other
+  dimensions, the transform is computed with Bluestein's algorithm, as a
+  convolution whose size is a product of 2's, 3's and 5's. */
   template <typename TImage>
   struct VnlFFTTransform : public vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>
   {
     using Base = vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>;
+    using ValueType = typename TImage::PixelType;
+    using ComplexType = std::complex<ValueType>;
 
     //: constructor takes size of signal.
     VnlFFTTransform(const typename TImage::SizeType & s);
+
+    //: dir = +1/-1 according to direction of transform. The signal is
+    // transformed in place, with the threads of the multi-threader, or
+    // of a new one when it is nullptr.
+    void
+    transform(ComplexType * signal, int dir, MultiThreaderBase * multiThreader = nullptr);
+
+  private:
+    /** The chirp of Bluestein's algorithm, w[k] = exp(-i pi k^2 / n), and
+     * the spectra of the kernels of the convolution, for each direction. */
+    struct BluesteinConvolution
+    {
+      std::vector<ComplexType>         m_Chirp;
+      std::vector<ComplexType>         m_ForwardKernelSpectrum;
+      std::vector<ComplexType>         m_BackwardKernelSpectrum;
+      vnl_fft_prime_factors<ValueType> m_Factors;
+    };
+
+    /** Transforms count lines of size n along a dimension, whose elements
+     * are separated by stride, and whose first elements are separated by
+     * jump, in complex values. */
+    void
+    TransformLines(ComplexType * lines,
+                   unsigned int  dimension,
+                   SizeValueType stride,
+                   SizeValueType jump,
+                   SizeValueType count,
+                   int           dir) const;
+
+    typename TImage::SizeType m_Size{};
+
+    std::unique_ptr<BluesteinConvolution> m_Bluestein[TImage::ImageDimension];
   };
 };
 } // namespace itk
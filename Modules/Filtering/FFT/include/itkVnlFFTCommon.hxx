@@ -18,6 +18,13 @@
 #ifndef itkVnlFFTCommon_hxx
 #define itkVnlFFTCommon_hxx
 
+#include "itkMath.h"
+
+#include "vnl/algo/vnl_fft.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 namespace itk
 {
@@ -41,10 +48,217 @@ VnlFFTCommon::IsDimensionSizeLegal(TSizeValue n)
 
 template <typename TImage>
 VnlFFTCommon::VnlFFTTransform<TImage>::VnlFFTTransform(const typename TImage::SizeType & s)
+  : m_Size(s)
+{
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    if (IsDimensionSizeLegal(s[i]))
+    {
+      Base::factors_[TImage::ImageDimension - i - 1].resize(s[i]);
+      continue;
+    }
+
+    // Bluestein's algorithm: the transform of size n is the convolution of the signal weighted by the chirp with
+    // the conjugate of the chirp, times the chirp. The convolution is computed with transforms of the smallest legal
+    // size m >= 2 n - 1, so that the circular convolution does not wrap around.
+    const SizeValueType n = s[i];
+    SizeValueType       m = 2 * n - 1;
+    while (!IsDimensionSizeLegal(m))
+    {
+      ++m;
+    }
+    auto bluestein = std::make_unique<BluesteinConvolution>();
+    bluestein->m_Factors.resize(static_cast<int>(m));
+
+    // k^2 is reduced modulo 2 n, the period of the chirp, to keep the angles accurate for large k.
+    bluestein->m_Chirp.resize(n);
+    for (SizeValueType k = 0; k < n; ++k)
+    {
+      const double angle = -Math::pi * static_cast<double>((std::uint64_t{ k } * k) % (2 * n)) / n;
+      bluestein->m_Chirp[k] =
+        ComplexType(static_cast<ValueType>(std::cos(angle)), static_cast<ValueType>(std::sin(angle)));
+    }
+
+    // The kernels are centered at index zero, and scaled by 1/m, the normalization of the backward transform of the
+    // convolution.
+    const auto computeKernelSpectrum = [&bluestein, n, m](std::vector<ComplexType> & spectrum, bool conjugate) {
+      spectrum.assign(m, ComplexType());
+      for (SizeValueType k = 0; k < n; ++k)
+      {
+        const ComplexType value = conjugate ? std::conj(bluestein->m_Chirp[k]) : bluestein->m_Chirp[k];
+        spectrum[k] = value;
+        spectrum[(m - k) % m] = value;
+      }
+      auto * data = reinterpret_cast<ValueType *>(spectrum.data());
+      long   info = 0;
+      vnl_fft_gpfa(data,
+                   data + 1,
+                   bluestein->m_Factors.trigs(),
+                   2,
+                   0,
+                   static_cast<long>(m),
+                   1,
+                   -1,
+                   bluestein->m_Factors.pqr(),
+                   &info);
+      for (auto & value : spectrum)
+      {
+        value /= static_cast<ValueType>(m);
+      }
+    };
+    computeKernelSpectrum(bluestein->m_ForwardKernelSpectrum, true);
+    computeKernelSpectrum(bluestein->m_BackwardKernelSpectrum, false);
+
+    m_Bluestein[i] = std::move(bluestein);
+  }
+}
+
+template <typename TImage>
+void
+VnlFFTCommon::VnlFFTTransform<TImage>::transform(ComplexType * signal, int dir, MultiThreaderBase * multiThreader)
 {
+  MultiThreaderBase::Pointer newMultiThreader;
+  if (multiThreader == nullptr)
+  {
+    newMultiThreader = MultiThreaderBase::New();
+    multiThreader = newMultiThreader;
+  }
+
+  SizeValueType numberOfPixels = 1;
+  for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
+  {
+    numberOfPixels *= m_Size[i];
+  }
+
+  // transform along each dimension, i, in turn.
+  SizeValueType stride = 1;
   for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
   {
-    Base::factors_[TImage::ImageDimension - i - 1].resize(s[i]);
+    const SizeValueType n = m_Size[i];
+    if (n > 1)
+    {
+      // The lines along the dimension are grouped in blocks of lines whose first elements are separated by jump: the
+      // adjacent lines of each slice across the dimension, or, along the first dimension, all the lines.
+      const SizeValueType numberOfLines = numberOfPixels / n;
+      const SizeValueType jump = (stride > 1) ? 1 : n;
+      const SizeValueType linesPerBlock = (stride > 1) ? stride : numberOfLines;
+      const SizeValueType numberOfBlocks = numberOfLines / linesPerBlock;
+
+      // Each block is split into batches of lines, several per work unit, for load balancing. The batches of
+      // Bluestein's algorithm are bounded, as they are copied in a buffer.
+      const SizeValueType numberOfBatches = 4 * SizeValueType{ multiThreader->GetNumberOfWorkUnits() };
+      const SizeValueType maximumBatchSize =
+        m_Bluestein[i] ? std::min<SizeValueType>(linesPerBlock, 64) : linesPerBlock;
+      const SizeValueType batchSize =
+        std::clamp<SizeValueType>((numberOfLines + numberOfBatches - 1) / numberOfBatches, 1, maximumBatchSize);
+      const SizeValueType batchesPerBlock = (linesPerBlock + batchSize - 1) / batchSize;
+
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfBlocks * batchesPerBlock,
+        [&](SizeValueType batch) {
+          const SizeValueType block = batch / batchesPerBlock;
+          const SizeValueType firstLine = (batch % batchesPerBlock) * batchSize;
+          this->TransformLines(signal + block * n * stride + firstLine * jump,
+                               i,
+                               stride,
+                               jump,
+                               std::min(batchSize, linesPerBlock - firstLine),
+                               dir);
+        },
+        nullptr);
+    }
+    stride *= n;
+  }
+}
+
+template <typename TImage>
+void
+VnlFFTCommon::VnlFFTTransform<TImage>::TransformLines(ComplexType * lines,
+                                                      unsigned int  dimension,
+                                                      SizeValueType stride,
+                                                      SizeValueType jump,
+                                                      SizeValueType count,
+                                                      int           dir) const
+{
+  // This relies on the assumption that std::complex<T> is layout compatible with "struct { T real; T imag; }", like
+  // vnl_fft_base.
+  const SizeValueType n = m_Size[dimension];
+  long                info = 0;
+  if (!m_Bluestein[dimension])
+  {
+    const auto & factors = Base::factors_[TImage::ImageDimension - dimension - 1];
+    auto *       data = reinterpret_cast<ValueType *>(lines);
+    vnl_fft_gpfa(data,
+                 data + 1,
+                 factors.trigs(),
+                 static_cast<long>(2 * stride),
+                 static_cast<long>(2 * jump),
+                 static_cast<long>(n),
+                 static_cast<long>(count),
+                 dir,
+                 factors.pqr(),
+                 &info);
+    return;
+  }
+
+  const BluesteinConvolution & bluestein = *m_Bluestein[dimension];
+  const auto                   m = static_cast<SizeValueType>(bluestein.m_Factors.number());
+  const auto chirp = [&bluestein, dir](SizeValueType k) {
+    return (dir < 0) ? bluestein.m_Chirp[k] : std::conj(bluestein.m_Chirp[k]);
+  };
+
+  std::vector<ComplexType> buffer(count * m);
+  for (SizeValueType l = 0; l < count; ++l)
+  {
+    const ComplexType * line = lines + l * jump;
+    ComplexType *       bufferLine = buffer.data() + l * m;
+    for (SizeValueType k = 0; k < n; ++k)
+    {
+      bufferLine[k] = line[k * stride] * chirp(k);
+    }
+  }
+
+  auto * data = reinterpret_cast<ValueType *>(buffer.data());
+  vnl_fft_gpfa(data,
+               data + 1,
+               bluestein.m_Factors.trigs(),
+               2,
+               static_cast<long>(2 * m),
+               static_cast<long>(m),
+               static_cast<long>(count),
+               -1,
+               bluestein.m_Factors.pqr(),
+               &info);
+  const std::vector<ComplexType> & kernelSpectrum =
+    (dir < 0) ? bluestein.m_ForwardKernelSpectrum : bluestein.m_BackwardKernelSpectrum;
+  for (SizeValueType l = 0; l < count; ++l)
+  {
+    ComplexType * bufferLine = buffer.data() + l * m;
+    for (SizeValueType k = 0; k < m; ++k)
+    {
+      bufferLine[k] *= kernelSpectrum[k];
+    }
+  }
+  vnl_fft_gpfa(data,
+               data + 1,
+               bluestein.m_Factors.trigs(),
+               2,
+               static_cast<long>(2 * m),
+               static_cast<long>(m),
+               static_cast<long>(count),
+               1,
+               bluestein.m_Factors.pqr(),
+               &info);
+
+  for (SizeValueType l = 0; l < count; ++l)
+  {
+    ComplexType *       line = lines + l * jump;
+    const ComplexType * bufferLine = buffer.data() + l * m;
+    for (SizeValueType k = 0; k < n; ++k)
+    {
+      line[k * stride] = chirp(k) * bufferLine[k];
+    }
   }
 }
 
@@ -50,13 +50,6 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(inputSize[i]))
-    {
-      itkExceptionMacro("Cannot compute FFT of image with size "
-                        << inputSize
-                        << ". VnlForwardFFTImageFilter operates only on images whose size in each dimension has only a "
-                           "combination of 2,3, and 5 as prime factors.");
-    }
     vectorSize *= inputSize[i];
   }
 
@@ -69,7 +62,7 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
+  vnlfft.transform(signal.data_block(), -1, this->GetMultiThreader());
 
   // Copy the VNL output back to the ITK image.
   for (ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion()); !oIt.IsAtEnd();
@@ -32,9 +32,11 @@ namespace itk
  *
  * \brief VNL-based reverse Fast Fourier Transform.
  *
- * The input image size must be a multiple of combinations of 2s, 3s,
- * and/or 5s in all dimensions (2, 3, and 5 should be the only prime
- * factors of the image size along each dimension).
+ * The image may have any size. Along the dimensions whose size has a
+ * prime factorization consisting of 2s, 3s, and 5s, the transform is
+ * computed directly, and along the others with Bluestein's algorithm,
+ * which is slower: see GetSizeGreatestPrimeFactor(), used by
+ * FFTPadImageFilter to pad the images to such sizes.
  *
  * \ingroup FourierTransform
  *
@@ -32,8 +32,11 @@ namespace itk
  *
  * \brief VNL-based forward Fast Fourier Transform.
  *
- * The input image size in all dimensions must have a prime
- * factorization consisting of 2s, 3s, and 5s.
+ * The image may have any size. Along the dimensions whose size has a
+ * prime factorization consisting of 2s, 3s, and 5s, the transform is
+ * computed directly, and along the others with Bluestein's algorithm,
+ * which is slower: see GetSizeGreatestPrimeFactor(), used by
+ * FFTPadImageFilter to pad the images to such sizes.
  *
  * \ingroup FourierTransform
  *
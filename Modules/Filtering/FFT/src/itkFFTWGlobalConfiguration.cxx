@@ -130,7 +130,7 @@ FFTWGlobalConfiguration::GetPlanRigorName(const int value)
 static bool
 isDeclineString(std::string response)
 {
-  std::for_each(response.begin(), response.end(), ::toupper);
+  std::transform(response.begin(), response.end(), response.begin(), ::toupper);
   if (response == "NO" || response == "OFF" || response == "0")
   {
     return true;
@@ -469,6 +469,21 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string planCacheSizeEnv;
+    if (itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE_SIZE", planCacheSizeEnv))
+    {
+      try
+      {
+        this->m_PlanCacheSize = std::stoul(planCacheSizeEnv);
+      }
+      catch (...)
+      {
+        itkWarningMacro("Warning: Invalid FFTW PLAN CACHE SIZE: " << planCacheSizeEnv);
+      }
+    }
+  }
+
   if (this->m_ReadWisdomCache)
   {
     const std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -485,6 +500,9 @@ FFTWGlobalConfiguration::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The cached plans must be destroyed before the cleanup of FFTW. Their deleters lock m_Mutex.
+  this->m_PlanCache.clear();
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     const std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -672,14 +690,18 @@ FFTWGlobalConfiguration::ExportWisdomFileFloat(const std::string &
 
 #    ifdef _WIN32
   int fd;
-  if (!_sopen_s(&fd, path.c_str(), _O_RDONLY, _SH_DENYNO, _S_IREAD))
+  if (!_sopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC, _SH_DENYWR, _S_IWRITE))
   {
     FILE * f;
-    if ((f = _fdopen(fd, "r")) != nullptr)
-    { // strange but seems ok under VC++
-      ret = (fftwf_import_wisdom_from_file(f) != 0);
+    if ((f = _fdopen(fd, "w")) != nullptr)
+    {
+      fftwf_export_wisdom_to_file(f);
+      ret = (fclose(f) == 0);
+    }
+    else
+    {
+      _close(fd);
     }
-    _close(fd);
   }
 #    else
   std::cout << "Trying to write : " << path << std::endl;
@@ -689,7 +711,7 @@ FFTWGlobalConfiguration::ExportWisdomFileFloat(const std::string &
     flock(fileno(f), LOCK_EX);
     fftwf_export_wisdom_to_file(f);
     flock(fileno(f), LOCK_UN);
-    ret = (fclose(f) != 0);
+    ret = (fclose(f) == 0);
   }
 #    endif
 #  endif
@@ -705,16 +727,26 @@ FFTWGlobalConfiguration::ExportWisdomFileDouble(const std::string &
 {
   bool ret = false;
 #  if defined(ITK_USE_FFTWD)
+  {
+    // If necessary, make a directory for writing the file.
+    const std::string directoryName = itksys::SystemTools::GetParentDirectory(path.c_str());
+    itksys::SystemTools::MakeDirectory(directoryName.c_str());
+  }
+
 #    ifdef _WIN32
   FILE * f;
   int    fd;
-  if (!_sopen_s(&fd, path.c_str(), _O_RDONLY, _SH_DENYNO, _S_IREAD))
+  if (!_sopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC, _SH_DENYWR, _S_IWRITE))
   {
-    if ((f = _fdopen(fd, "r")) != nullptr)
-    { // strange but seems ok under VC++
-      ret = (fftw_import_wisdom_from_file(f) != 0);
+    if ((f = _fdopen(fd, "w")) != nullptr)
+    {
+      fftw_export_wisdom_to_file(f);
+      ret = (fclose(f) == 0);
+    }
+    else
+    {
+      _close(fd);
     }
-    _close(fd);
   }
 #    else
   std::cout << "Trying to write : " << path << std::endl;
@@ -724,7 +756,7 @@ FFTWGlobalConfiguration::ExportWisdomFileDouble(const std::string &
     flock(fileno(f), LOCK_EX);
     fftw_export_wisdom_to_file(f);
     flock(fileno(f), LOCK_UN);
-    ret = (fclose(f) != 0);
+    ret = (fclose(f) == 0);
   }
 #    endif
 #  endif
@@ -807,6 +839,92 @@ FFTWGlobalConfiguration::GetWriteWisdomCache()
 }
 
 
+FFTWGlobalConfiguration::CachedPlanPointer
+FFTWGlobalConfiguration::GetCachedPlan(const PlanCacheKeyType &                   key,
+                                       const std::function<CachedPlanPointer()> & createPlan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer instance = GetInstance();
+
+  // The dropped plans are destroyed once the cache mutex is released, because their deleters lock the FFTW mutex.
+  std::vector<CachedPlanPointer> droppedPlans;
+  {
+    const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+    const auto                        it = instance->m_PlanCache.find(key);
+    if (it != instance->m_PlanCache.end())
+    {
+      it->second.m_LastUse = ++instance->m_PlanCacheUseCount;
+      return it->second.m_Plan;
+    }
+  }
+
+  // The plan is created without holding the cache mutex, so that the lookups of the other threads go on meanwhile.
+  const CachedPlanPointer plan = createPlan();
+
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+
+  // If another thread has cached the same plan meanwhile, its plan is used.
+  CachedPlan & cachedPlan = instance->m_PlanCache.emplace(key, CachedPlan{ plan, 0 }).first->second;
+  cachedPlan.m_LastUse = ++instance->m_PlanCacheUseCount;
+  const CachedPlanPointer result = cachedPlan.m_Plan;
+  instance->DropLeastRecentlyUsedPlans(instance->m_PlanCacheSize, droppedPlans);
+  return result;
+}
+
+void
+FFTWGlobalConfiguration::DropLeastRecentlyUsedPlans(const SizeValueType                maximumNumberOfPlans,
+                                                    std::vector<CachedPlanPointer> & droppedPlans)
+{
+  while (m_PlanCache.size() > maximumNumberOfPlans)
+  {
+    const auto leastRecentlyUsed =
+      std::min_element(m_PlanCache.begin(), m_PlanCache.end(), [](const auto & lhs, const auto & rhs) {
+        return lhs.second.m_LastUse < rhs.second.m_LastUse;
+      });
+    droppedPlans.push_back(std::move(leastRecentlyUsed->second.m_Plan));
+    m_PlanCache.erase(leastRecentlyUsed);
+  }
+}
+
+void
+FFTWGlobalConfiguration::SetPlanCacheSize(const SizeValueType v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  std::vector<CachedPlanPointer>    droppedPlans;
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  instance->m_PlanCacheSize = v;
+  instance->DropLeastRecentlyUsedPlans(v, droppedPlans);
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCacheSize;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetNumberOfCachedPlans()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  return instance->m_PlanCache.size();
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const Pointer                     instance = GetInstance();
+  std::vector<CachedPlanPointer>    droppedPlans;
+  const std::lock_guard<std::mutex> lockGuard(instance->m_PlanCacheMutex);
+  instance->DropLeastRecentlyUsedPlans(0, droppedPlans);
+}
+
 void
 FFTWGlobalConfiguration::SetWisdomCacheBase(const std::string & v)
 {
@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWGlobalConfiguration.h"
+#include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+// Checks that the FFTW filters share their plans through the plan cache of
+// FFTWGlobalConfiguration, and that the cached plans give the same results
+// as new ones.
+int
+itkFFTWPlanCacheTest(int, char *[])
+{
+#if defined(ITK_USE_FFTWD)
+  using PixelType = double;
+#else
+  using PixelType = float;
+#endif
+  using ImageType = itk::Image<PixelType, 2>;
+  using ForwardFilterType = itk::FFTWRealToHalfHermitianForwardFFTImageFilter<ImageType>;
+  using InverseFilterType = itk::FFTWHalfHermitianToRealInverseFFTImageFilter<ForwardFilterType::OutputImageType>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 12, 10 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<PixelType>(it.GetIndex()[0] * 3 - it.GetIndex()[1] * it.GetIndex()[0] % 7));
+  }
+
+  // Round trip through the forward and inverse transforms.
+  const auto roundTrip = [&image] {
+    const auto forward = ForwardFilterType::New();
+    forward->SetInput(image);
+    const auto inverse = InverseFilterType::New();
+    inverse->SetInput(forward->GetOutput());
+    inverse->SetActualXDimensionIsOdd(false);
+    inverse->Update();
+    ImageType::Pointer output = inverse->GetOutput();
+    output->DisconnectPipeline();
+    return output;
+  };
+
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+
+  const auto firstOutput = roundTrip();
+  const auto numberOfCachedPlans = itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans();
+  ITK_TEST_EXPECT_TRUE(numberOfCachedPlans > 0);
+
+  // The plans of new filter instances with the same sizes are found in the cache.
+  const auto secondOutput = roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), numberOfCachedPlans);
+
+  // Without the cache, the plans are created again.
+  const auto planCacheSize = itk::FFTWGlobalConfiguration::GetPlanCacheSize();
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+  const auto uncachedOutput = roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetNumberOfCachedPlans(), 0);
+  itk::FFTWGlobalConfiguration::SetPlanCacheSize(planCacheSize);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), planCacheSize);
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    if (!itk::Math::FloatAlmostEqual(firstOutput->GetPixel(index), it.Get(), 4, PixelType{ 1e-4 }) ||
+        firstOutput->GetPixel(index) != secondOutput->GetPixel(index) ||
+        firstOutput->GetPixel(index) != uncachedOutput->GetPixel(index))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Unexpected round trip value at index " << index << ": " << firstOutput->GetPixel(index) << ", "
+                << secondOutput->GetPixel(index) << " and " << uncachedOutput->GetPixel(index) << ", instead of "
+                << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
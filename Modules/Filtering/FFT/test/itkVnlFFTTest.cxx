@@ -47,7 +47,7 @@ itkVnlFFTTest(int, char *[])
 
   unsigned int SizeOfDimensions1[] = { 4, 4, 4, 4 };
   unsigned int SizeOfDimensions2[] = { 3, 5, 4 };
-  unsigned int SizeOfDimensions3[] = { 7, 6, 4 }; // Should fail
+  unsigned int SizeOfDimensions3[] = { 7, 6, 4 }; // Computed with Bluestein's algorithm along the first dimension
   int          rval = 0;
   std::cerr << "Vnl float,1 (4,4,4)" << std::endl;
   if ((test_fft<float, 1, itk::VnlForwardFFTImageFilter<ImageF1>, itk::VnlInverseFFTImageFilter<ImageCF1>>(
@@ -141,79 +141,53 @@ itkVnlFFTTest(int, char *[])
     rval++;
   }
 
-  // These tests should fail.
-
   std::cerr << "Vnl float,1 (7,6,4)" << std::endl;
   if ((test_fft<float, 1, itk::VnlForwardFFTImageFilter<ImageF1>, itk::VnlInverseFFTImageFilter<ImageCF1>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   std::cerr << "Vnl float,2 (7,6,4)" << std::endl;
   if ((test_fft<float, 2, itk::VnlForwardFFTImageFilter<ImageF2>, itk::VnlInverseFFTImageFilter<ImageCF2>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   std::cerr << "Vnl float,3 (7,6,4)" << std::endl;
   if ((test_fft<float, 3, itk::VnlForwardFFTImageFilter<ImageF3>, itk::VnlInverseFFTImageFilter<ImageCF3>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   std::cerr << "Vnl double,1 (7,6,4)" << std::endl;
   if ((test_fft<double, 1, itk::VnlForwardFFTImageFilter<ImageD1>, itk::VnlInverseFFTImageFilter<ImageCD1>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   std::cerr << "Vnl double,2 (7,6,4)" << std::endl;
   if ((test_fft<double, 2, itk::VnlForwardFFTImageFilter<ImageD2>, itk::VnlInverseFFTImageFilter<ImageCD2>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   std::cerr << "Vnl double,3 (7,6,4)" << std::endl;
   if ((test_fft<double, 3, itk::VnlForwardFFTImageFilter<ImageD3>, itk::VnlInverseFFTImageFilter<ImageCD3>>(
-        SizeOfDimensions3)) == 0)
+        SizeOfDimensions3)) != 0)
   {
     std::cerr << "--------------------- Failed!" << std::endl;
     rval++;
   }
-  else
-  {
-    std::cerr << "Caught expected size error." << std::endl;
-  }
 
   return rval == 0 ? 0 : -1;
 }
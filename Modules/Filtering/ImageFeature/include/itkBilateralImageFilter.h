@@ -22,6 +22,7 @@
 #include "itkFixedArray.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkNeighborhood.h"
+#include "itkPixelTraits.h"
 
 namespace itk
 {
@@ -48,6 +49,18 @@ namespace itk
  * Bilateral filtering is capable of reducing the noise in an image
  * by an order of magnitude while maintaining edges.
  *
+ * By default, the filter evaluates the product of the domain and the range
+ * Gaussian over the whole neighborhood of each pixel, which gets expensive
+ * for large domain sigmas, and in 3D. When UsePermutohedralLattice is on,
+ * the filter instead splats the pixels onto a permutohedral lattice in the
+ * joint domain and range space, blurs the lattice and interpolates the
+ * result at each pixel (see PermutohedralLattice). The cost of this
+ * approximation is independent of the domain sigma, and it supports pixel
+ * types with multiple components (such as RGBPixel and Vector), whose range
+ * distance is the Euclidean distance between the pixel values. The lattice
+ * does not truncate the Gaussians, so DomainMu and RangeMu only determine the
+ * size of the input requested region, and the Radius is ignored.
+ *
  * The bilateral operator used here was described by Tomasi and
  * Manduchi in \cite tomasi1998.
  *
@@ -61,8 +74,7 @@ namespace itk
  *
  * \ingroup ImageEnhancement
  * \ingroup ImageFeatureExtraction
- * \todo Support color images
- * \todo Support vector images
+ * \todo Support multi-component pixels without the permutohedral lattice
  * \ingroup ITKImageFeature
  *
  * \sphinx
@@ -168,6 +180,14 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  /** Set/Get whether the filter approximates the bilateral filter with a
+   * permutohedral lattice, instead of evaluating it over the neighborhood
+   * of each pixel. Required for multi-component pixel types. Default is
+   * false. */
+  itkSetMacro(UsePermutohedralLattice, bool);
+  itkGetConstMacro(UsePermutohedralLattice, bool);
+  itkBooleanMacro(UsePermutohedralLattice);
+
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
 
 protected:
@@ -181,6 +201,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Filters the image with a permutohedral lattice when UsePermutohedralLattice is on, and otherwise calls the
+   * implementation of the superclass, which calls DynamicThreadedGenerateData. */
+  void
+  GenerateData() override;
+
   /** Do some setup before the ThreadedGenerateData */
   void
   BeforeThreadedGenerateData() override;
@@ -200,6 +225,12 @@ protected:
   GenerateInputRequestedRegion() override;
 
 private:
+  /** Number of components of the pixels, whose Euclidean distance is the range distance. */
+  static constexpr unsigned int NumberOfPixelComponents = PixelTraits<InputPixelType>::Dimension;
+
+  void
+  GenerateDataUsingPermutohedralLattice();
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma{};
@@ -226,6 +257,8 @@ private:
   double              m_DynamicRange{};
   double              m_DynamicRangeUsed{};
   std::vector<double> m_RangeGaussianTable{};
+
+  bool m_UsePermutohedralLattice{ false };
 };
 } // end namespace itk
 
@@ -19,11 +19,15 @@
 #define itkBilateralImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "itkGaussianImageSource.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkTotalProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
+#include "itkPermutohedralLattice.h"
 
 #include <cmath> // For abs.
 
@@ -118,10 +122,96 @@ BilateralImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
   throw e;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  if (m_UsePermutohedralLattice)
+  {
+    this->AllocateOutputs();
+    this->GenerateDataUsingPermutohedralLattice();
+  }
+  else
+  {
+    Superclass::GenerateData();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::GenerateDataUsingPermutohedralLattice()
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  // The features of a pixel are its position and its value, scaled by the domain and range sigmas, so that the
+  // Gaussian of standard deviation 1 of the lattice is the product of the domain and the range Gaussian. The values
+  // are the pixel components, and a homogeneous coordinate that accumulates the weights of the filter.
+  using LatticeType = PermutohedralLattice<ImageDimension + NumberOfPixelComponents, NumberOfPixelComponents + 1>;
+  using FeatureVectorType = typename LatticeType::FeatureVectorType;
+  using InputPixelTraits = DefaultConvertPixelTraits<InputPixelType>;
+  using OutputPixelTraits = DefaultConvertPixelTraits<OutputPixelType>;
+
+  const typename InputImageType::SpacingType spacing = input->GetSpacing();
+
+  const auto computeFeatures = [this, &spacing](const typename InputImageType::IndexType & index,
+                                                const InputPixelType &                     pixel) {
+    FeatureVectorType features;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      features[i] = index[i] * spacing[i] / m_DomainSigma[i];
+    }
+    for (unsigned int c = 0; c < NumberOfPixelComponents; ++c)
+    {
+      features[ImageDimension + c] = static_cast<double>(InputPixelTraits::GetNthComponent(c, pixel)) / m_RangeSigma;
+    }
+    return features;
+  };
+
+  LatticeType lattice;
+  for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, input->GetRequestedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const InputPixelType                  pixel = it.Get();
+    typename LatticeType::ValueVectorType values;
+    for (unsigned int c = 0; c < NumberOfPixelComponents; ++c)
+    {
+      values[c] = static_cast<double>(InputPixelTraits::GetNthComponent(c, pixel));
+    }
+    values[NumberOfPixelComponents] = 1.0;
+    lattice.Splat(computeFeatures(it.GetIndex(), pixel), values);
+  }
+
+  lattice.Blur();
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    output->GetRequestedRegion(),
+    [input, output, &lattice, &computeFeatures](const OutputImageRegionType & outputRegion) {
+      ImageRegionIteratorWithIndex<OutputImageType> it(output, outputRegion);
+      for (; !it.IsAtEnd(); ++it)
+      {
+        const auto    values = lattice.Slice(computeFeatures(it.GetIndex(), input->GetPixel(it.GetIndex())));
+        const double  normFactor = values[NumberOfPixelComponents];
+        OutputPixelType outputPixel{};
+        for (unsigned int c = 0; c < NumberOfPixelComponents; ++c)
+        {
+          OutputPixelTraits::SetNthComponent(
+            c, outputPixel, static_cast<typename OutputPixelTraits::ComponentType>(values[c] / normFactor));
+        }
+        it.Set(outputPixel);
+      }
+    },
+    this);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
+  if constexpr (NumberOfPixelComponents > 1)
+  {
+    itkExceptionMacro("Pixels with multiple components are only supported when UsePermutohedralLattice is on.");
+  }
+
   // Build a small image of the n-dimensional Gaussian used for domain filter
   //
   // Gaussian image size will be (2*std::ceil(2.5*sigma)+1) x
@@ -193,14 +283,19 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 
   // Build a lookup table for the range gaussian
 
-  auto localInput = TInputImage::New();
-  localInput->Graft(this->GetInput());
-
   // First, determine the min and max intensity range
-  auto statistics = StatisticsImageFilter<TInputImage>::New();
+  if constexpr (NumberOfPixelComponents == 1)
+  {
+    auto localInput = TInputImage::New();
+    localInput->Graft(this->GetInput());
+
+    auto statistics = StatisticsImageFilter<TInputImage>::New();
 
-  statistics->SetInput(localInput);
-  statistics->Update();
+    statistics->SetInput(localInput);
+    statistics->Update();
+
+    m_DynamicRange = (static_cast<double>(statistics->GetMaximum()) - static_cast<double>(statistics->GetMinimum()));
+  }
 
   // Now create the lookup table whose domain runs from 0.0 to
   // (max-min) and range is gaussian evaluated at
@@ -214,8 +309,6 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
   double tableDelta;
   double v;
 
-  m_DynamicRange = (static_cast<double>(statistics->GetMaximum()) - static_cast<double>(statistics->GetMinimum()));
-
   m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
 
   tableDelta = m_DynamicRangeUsed / static_cast<double>(m_NumberOfRangeGaussianSamples);
@@ -231,78 +324,82 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread)
+  [[maybe_unused]] const OutputImageRegionType & outputRegionForThread)
 {
-  const typename TInputImage::ConstPointer input = this->GetInput();
-  const typename TOutputImage::Pointer     output = this->GetOutput();
-
-  const double rangeDistanceThreshold = m_DynamicRangeUsed;
+  // The neighborhood evaluation only supports scalar pixels: BeforeThreadedGenerateData throws for other pixels.
+  if constexpr (NumberOfPixelComponents == 1)
+  {
+    const typename TInputImage::ConstPointer input = this->GetInput();
+    const typename TOutputImage::Pointer     output = this->GetOutput();
 
-  // Find the boundary "faces"
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>                              fC;
-  const typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType faceList =
-    fC(this->GetInput(), outputRegionForThread, m_GaussianKernel.GetRadius());
+    const double rangeDistanceThreshold = m_DynamicRangeUsed;
 
-  const double distanceToTableIndex = static_cast<double>(m_NumberOfRangeGaussianSamples) / m_DynamicRangeUsed;
+    // Find the boundary "faces"
+    NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>                              fC;
+    const typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType faceList =
+      fC(this->GetInput(), outputRegionForThread, m_GaussianKernel.GetRadius());
 
-  // Process all the faces, the NeighborhoodIterator will determine
-  // whether a specified region needs to use the boundary conditions or
-  // not.
+    const double distanceToTableIndex = static_cast<double>(m_NumberOfRangeGaussianSamples) / m_DynamicRangeUsed;
 
+    // Process all the faces, the NeighborhoodIterator will determine
+    // whether a specified region needs to use the boundary conditions or
+    // not.
 
-  KernelConstIteratorType kernelEnd = m_GaussianKernel.End();
 
-  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+    KernelConstIteratorType kernelEnd = m_GaussianKernel.End();
 
-  ZeroFluxNeumannBoundaryCondition<TInputImage> BC;
-  for (const auto & face : faceList)
-  {
-    // walk the boundary face and the corresponding section of the output
-    NeighborhoodIteratorType b_iter = NeighborhoodIteratorType(m_GaussianKernel.GetRadius(), this->GetInput(), face);
-    b_iter.OverrideBoundaryCondition(&BC);
-    ImageRegionIterator<OutputImageType> o_iter = ImageRegionIterator<OutputImageType>(this->GetOutput(), face);
+    TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
-    while (!b_iter.IsAtEnd())
+    ZeroFluxNeumannBoundaryCondition<TInputImage> BC;
+    for (const auto & face : faceList)
     {
-      // Setup
-      const auto          centerPixel = static_cast<OutputPixelRealType>(b_iter.GetCenterPixel());
-      OutputPixelRealType val = 0.0;
-      OutputPixelRealType normFactor = 0.0;
-
-      // Walk the neighborhood of the input and the kernel
-      KernelConstIteratorType k_it = m_GaussianKernel.Begin();
-      for (typename TInputImage::IndexValueType i = 0; k_it < kernelEnd; ++k_it, ++i)
-      {
-        // range distance between neighborhood pixel and neighborhood center
-        const auto pixel = static_cast<OutputPixelRealType>(b_iter.GetPixel(i));
-        // flip sign if needed
-        const OutputPixelRealType rangeDistance = std::abs(pixel - centerPixel);
+      // walk the boundary face and the corresponding section of the output
+      NeighborhoodIteratorType b_iter = NeighborhoodIteratorType(m_GaussianKernel.GetRadius(), this->GetInput(), face);
+      b_iter.OverrideBoundaryCondition(&BC);
+      ImageRegionIterator<OutputImageType> o_iter = ImageRegionIterator<OutputImageType>(this->GetOutput(), face);
 
-        // if the range distance is close enough, then use the pixel
-        if (rangeDistance < rangeDistanceThreshold)
+      while (!b_iter.IsAtEnd())
+      {
+        // Setup
+        const auto          centerPixel = static_cast<OutputPixelRealType>(b_iter.GetCenterPixel());
+        OutputPixelRealType val = 0.0;
+        OutputPixelRealType normFactor = 0.0;
+
+        // Walk the neighborhood of the input and the kernel
+        KernelConstIteratorType k_it = m_GaussianKernel.Begin();
+        for (typename TInputImage::IndexValueType i = 0; k_it < kernelEnd; ++k_it, ++i)
         {
-          // look up the range gaussian in a table
-          const OutputPixelRealType tableArg = rangeDistance * distanceToTableIndex;
-          const OutputPixelRealType rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
-
-          // normalization factor so filter integrates to one
-          // (product of the domain and the range gaussian)
-          const OutputPixelRealType gaussianProduct = (*k_it) * rangeGaussian;
-          normFactor += gaussianProduct;
-
-          // Input Image * Domain Gaussian * Range Gaussian
-          val += pixel * gaussianProduct;
+          // range distance between neighborhood pixel and neighborhood center
+          const auto pixel = static_cast<OutputPixelRealType>(b_iter.GetPixel(i));
+          // flip sign if needed
+          const OutputPixelRealType rangeDistance = std::abs(pixel - centerPixel);
+
+          // if the range distance is close enough, then use the pixel
+          if (rangeDistance < rangeDistanceThreshold)
+          {
+            // look up the range gaussian in a table
+            const OutputPixelRealType tableArg = rangeDistance * distanceToTableIndex;
+            const OutputPixelRealType rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
+
+            // normalization factor so filter integrates to one
+            // (product of the domain and the range gaussian)
+            const OutputPixelRealType gaussianProduct = (*k_it) * rangeGaussian;
+            normFactor += gaussianProduct;
+
+            // Input Image * Domain Gaussian * Range Gaussian
+            val += pixel * gaussianProduct;
+          }
         }
-      }
-      // normalize the value
-      val /= normFactor;
+        // normalize the value
+        val /= normFactor;
 
-      // store the filtered value
-      o_iter.Set(static_cast<OutputPixelType>(val));
+        // store the filtered value
+        o_iter.Set(static_cast<OutputPixelType>(val));
 
-      ++b_iter;
-      ++o_iter;
-      progress.CompletedPixel();
+        ++b_iter;
+        ++o_iter;
+        progress.CompletedPixel();
+      }
     }
   }
 }
@@ -321,6 +418,7 @@ BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  itkPrintSelfBooleanMacro(UsePermutohedralLattice);
 }
 } // end namespace itk
 
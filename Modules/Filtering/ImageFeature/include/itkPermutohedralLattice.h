@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPermutohedralLattice_h
+#define itkPermutohedralLattice_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+
+#include <array>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PermutohedralLattice
+ * \brief Gaussian filtering of values at arbitrary positions of a high-dimensional feature space.
+ *
+ * The permutohedral lattice, described by Adams, Baek and Davis ("Fast
+ * High-Dimensional Filtering Using the Permutohedral Lattice", Computer
+ * Graphics Forum, 2010), approximates the convolution of a set of values,
+ * each at a position of a feature space, by a Gaussian of standard deviation
+ * 1 along each feature, in three steps:
+ *
+ * - Splat adds each value to the vertices of the simplex of the lattice that
+ *   encloses its position, with barycentric weights.
+ * - Blur convolves the values of the lattice vertices by a [1 2 1] kernel
+ *   along each of the VFeatureDimension+1 directions of the lattice.
+ * - Slice interpolates the blurred values at a position, from the vertices of
+ *   its enclosing simplex.
+ *
+ * Only the vertices of the simplices that enclose a splatted position are
+ * stored, in a hash table, so the cost of filtering n values is
+ * O(n * VFeatureDimension^2), independent of the standard deviation of the
+ * Gaussian in the original units of the features (which are scaled by it).
+ *
+ * Slice is const, and may be called concurrently.
+ *
+ * \sa BilateralImageFilter
+ * \ingroup ITKImageFeature
+ */
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType = double>
+class ITK_TEMPLATE_EXPORT PermutohedralLattice
+{
+public:
+  /** Standard class type aliases. */
+  using Self = PermutohedralLattice;
+
+  static constexpr unsigned int FeatureDimension = VFeatureDimension;
+  static constexpr unsigned int ValueDimension = VValueDimension;
+
+  using RealType = TRealType;
+  using FeatureVectorType = std::array<RealType, VFeatureDimension>;
+  using ValueVectorType = std::array<RealType, VValueDimension>;
+
+  PermutohedralLattice();
+
+  /** Adds the values at the position of the features. */
+  void
+  Splat(const FeatureVectorType & features, const ValueVectorType & values);
+
+  /** Blurs the splatted values. */
+  void
+  Blur();
+
+  /** Returns the blurred values interpolated at the position of the features. */
+  ValueVectorType
+  Slice(const FeatureVectorType & features) const;
+
+  /** Returns the number of lattice vertices that have been splatted onto. */
+  SizeValueType
+  GetNumberOfVertices() const
+  {
+    return m_Values.size() / VValueDimension;
+  }
+
+private:
+  using KeyType = std::array<int, VFeatureDimension>;
+
+  /** The VFeatureDimension+1 vertices of the simplex that encloses a position, and their barycentric weights. */
+  struct Simplex
+  {
+    std::array<KeyType, VFeatureDimension + 1>  m_Keys;
+    std::array<RealType, VFeatureDimension + 2> m_Weights;
+  };
+
+  Simplex
+  ComputeEnclosingSimplex(const FeatureVectorType & features) const;
+
+  static SizeValueType
+  Hash(const KeyType & key);
+
+  /** Returns the index of the vertex with the specified key, or -1 when it has no value. */
+  OffsetValueType
+  FindVertex(const KeyType & key) const;
+
+  /** Returns the index of the vertex with the specified key, adding it when it has no value. */
+  SizeValueType
+  FindOrInsertVertex(const KeyType & key);
+
+  void
+  GrowHashTable();
+
+  /** The features are scaled such that the lattice blur approximates a Gaussian of standard deviation 1. */
+  std::array<RealType, VFeatureDimension> m_ScaleFactors;
+
+  /** The remainder-k vertex of a simplex, in canonical (sorted) coordinates. */
+  std::array<std::array<int, VFeatureDimension + 1>, VFeatureDimension + 1> m_CanonicalSimplex;
+
+  /** The keys and values of the vertices, and the open addressing hash table that maps a key to its vertex index
+   * plus one (zero marking an empty slot). */
+  std::vector<KeyType>       m_Keys;
+  std::vector<RealType>      m_Values;
+  std::vector<SizeValueType> m_HashTable;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPermutohedralLattice.hxx"
+#endif
+
+#endif
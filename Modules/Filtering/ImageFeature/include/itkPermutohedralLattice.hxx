@@ -0,0 +1,328 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPermutohedralLattice_hxx
+#define itkPermutohedralLattice_hxx
+
+#include <cmath>
+
+namespace itk
+{
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::PermutohedralLattice()
+{
+  constexpr int d = VFeatureDimension;
+
+  // The lattice points are (d+1) apart. This scaling makes the [1 2 1] blur along each of the d+1 lattice directions
+  // approximate a Gaussian of standard deviation 1.
+  const double inverseStandardDeviation = std::sqrt(2.0 / 3.0) * (d + 1);
+  for (int i = 0; i < d; ++i)
+  {
+    m_ScaleFactors[i] = static_cast<RealType>(inverseStandardDeviation / std::sqrt((i + 1.0) * (i + 2.0)));
+  }
+
+  for (int i = 0; i <= d; ++i)
+  {
+    for (int j = 0; j <= d - i; ++j)
+    {
+      m_CanonicalSimplex[i][j] = i;
+    }
+    for (int j = d - i + 1; j <= d; ++j)
+    {
+      m_CanonicalSimplex[i][j] = i - (d + 1);
+    }
+  }
+
+  m_HashTable.resize(1024);
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+auto
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::ComputeEnclosingSimplex(
+  const FeatureVectorType & features) const -> Simplex
+{
+  constexpr int d = VFeatureDimension;
+
+  // Elevate the features onto the hyperplane of the lattice, whose coordinates sum to zero.
+  std::array<RealType, VFeatureDimension + 1> elevated;
+  RealType                                    sum = 0;
+  for (int i = d; i > 0; --i)
+  {
+    const RealType scaled = features[i - 1] * m_ScaleFactors[i - 1];
+    elevated[i] = sum - i * scaled;
+    sum += scaled;
+  }
+  elevated[0] = sum;
+
+  // Find the nearest remainder-0 lattice point (whose coordinates are multiples of d+1), and the order of the
+  // differences to it, which determines the enclosing simplex.
+  std::array<int, VFeatureDimension + 1> nearest;
+  int                                    coordinateSum = 0;
+  for (int i = 0; i <= d; ++i)
+  {
+    const RealType scaled = elevated[i] / (d + 1);
+    const auto     up = static_cast<int>(std::ceil(scaled)) * (d + 1);
+    const auto     down = static_cast<int>(std::floor(scaled)) * (d + 1);
+    nearest[i] = (up - elevated[i] < elevated[i] - down) ? up : down;
+    coordinateSum += nearest[i];
+  }
+  coordinateSum /= d + 1;
+
+  std::array<int, VFeatureDimension + 1> rank{};
+  for (int i = 0; i < d; ++i)
+  {
+    for (int j = i + 1; j <= d; ++j)
+    {
+      if (elevated[i] - nearest[i] < elevated[j] - nearest[j])
+      {
+        ++rank[i];
+      }
+      else
+      {
+        ++rank[j];
+      }
+    }
+  }
+
+  // Move the nearest point back onto the hyperplane, if its coordinates do not sum to zero.
+  if (coordinateSum > 0)
+  {
+    for (int i = 0; i <= d; ++i)
+    {
+      if (rank[i] >= d + 1 - coordinateSum)
+      {
+        nearest[i] -= d + 1;
+        rank[i] += coordinateSum - (d + 1);
+      }
+      else
+      {
+        rank[i] += coordinateSum;
+      }
+    }
+  }
+  else if (coordinateSum < 0)
+  {
+    for (int i = 0; i <= d; ++i)
+    {
+      if (rank[i] < -coordinateSum)
+      {
+        nearest[i] += d + 1;
+        rank[i] += (d + 1) + coordinateSum;
+      }
+      else
+      {
+        rank[i] += coordinateSum;
+      }
+    }
+  }
+
+  Simplex simplex;
+  simplex.m_Weights.fill(0);
+  for (int i = 0; i <= d; ++i)
+  {
+    const RealType delta = (elevated[i] - nearest[i]) / (d + 1);
+    simplex.m_Weights[d - rank[i]] += delta;
+    simplex.m_Weights[d + 1 - rank[i]] -= delta;
+  }
+  simplex.m_Weights[0] += 1 + simplex.m_Weights[d + 1];
+
+  // The key of a vertex consists of its first d coordinates, as the last one follows from the zero sum.
+  for (int remainder = 0; remainder <= d; ++remainder)
+  {
+    for (int i = 0; i < d; ++i)
+    {
+      simplex.m_Keys[remainder][i] = nearest[i] + m_CanonicalSimplex[remainder][rank[i]];
+    }
+  }
+  return simplex;
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+SizeValueType
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::Hash(const KeyType & key)
+{
+  SizeValueType hash = 0;
+  for (const int coordinate : key)
+  {
+    hash += static_cast<SizeValueType>(coordinate);
+    hash *= 2531011;
+  }
+  return hash;
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+OffsetValueType
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::FindVertex(const KeyType & key) const
+{
+  const SizeValueType mask = m_HashTable.size() - 1;
+  for (SizeValueType slot = Hash(key) & mask;; slot = (slot + 1) & mask)
+  {
+    const SizeValueType entry = m_HashTable[slot];
+    if (entry == 0)
+    {
+      return -1;
+    }
+    if (m_Keys[entry - 1] == key)
+    {
+      return static_cast<OffsetValueType>(entry - 1);
+    }
+  }
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+SizeValueType
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::FindOrInsertVertex(const KeyType & key)
+{
+  // Keep the load factor of the hash table below 1/2.
+  if (2 * (m_Keys.size() + 1) > m_HashTable.size())
+  {
+    this->GrowHashTable();
+  }
+
+  const SizeValueType mask = m_HashTable.size() - 1;
+  for (SizeValueType slot = Hash(key) & mask;; slot = (slot + 1) & mask)
+  {
+    const SizeValueType entry = m_HashTable[slot];
+    if (entry == 0)
+    {
+      m_Keys.push_back(key);
+      m_Values.resize(m_Values.size() + VValueDimension, RealType{ 0 });
+      m_HashTable[slot] = m_Keys.size();
+      return m_Keys.size() - 1;
+    }
+    if (m_Keys[entry - 1] == key)
+    {
+      return entry - 1;
+    }
+  }
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+void
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::GrowHashTable()
+{
+  m_HashTable.assign(2 * m_HashTable.size(), 0);
+
+  const SizeValueType mask = m_HashTable.size() - 1;
+  for (SizeValueType vertex = 0; vertex < m_Keys.size(); ++vertex)
+  {
+    SizeValueType slot = Hash(m_Keys[vertex]) & mask;
+    while (m_HashTable[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    m_HashTable[slot] = vertex + 1;
+  }
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+void
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::Splat(const FeatureVectorType & features,
+                                                                           const ValueVectorType &   values)
+{
+  const Simplex simplex = this->ComputeEnclosingSimplex(features);
+
+  for (unsigned int remainder = 0; remainder <= VFeatureDimension; ++remainder)
+  {
+    // Find the vertex first, as inserting it reallocates the values.
+    const SizeValueType vertex = this->FindOrInsertVertex(simplex.m_Keys[remainder]);
+    RealType * const    vertexValues = m_Values.data() + vertex * VValueDimension;
+    for (unsigned int i = 0; i < VValueDimension; ++i)
+    {
+      vertexValues[i] += simplex.m_Weights[remainder] * values[i];
+    }
+  }
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+void
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::Blur()
+{
+  const SizeValueType   numberOfVertices = m_Keys.size();
+  std::vector<RealType> blurredValues(m_Values.size());
+
+  for (unsigned int direction = 0; direction <= VFeatureDimension; ++direction)
+  {
+    for (SizeValueType vertex = 0; vertex < numberOfVertices; ++vertex)
+    {
+      // The two neighbors along the direction: moving by d+1 along one coordinate is moving by -1 along all others.
+      // Along the last direction, whose coordinate is not part of the key, all key coordinates move.
+      const KeyType & key = m_Keys[vertex];
+      KeyType         previousKey;
+      KeyType         nextKey;
+      for (unsigned int i = 0; i < VFeatureDimension; ++i)
+      {
+        previousKey[i] = key[i] - 1;
+        nextKey[i] = key[i] + 1;
+      }
+      if (direction < VFeatureDimension)
+      {
+        previousKey[direction] = key[direction] + static_cast<int>(VFeatureDimension);
+        nextKey[direction] = key[direction] - static_cast<int>(VFeatureDimension);
+      }
+      const OffsetValueType previous = this->FindVertex(previousKey);
+      const OffsetValueType next = this->FindVertex(nextKey);
+
+      const RealType * const values = m_Values.data() + vertex * VValueDimension;
+      RealType * const       blurred = blurredValues.data() + vertex * VValueDimension;
+      for (unsigned int i = 0; i < VValueDimension; ++i)
+      {
+        blurred[i] = RealType{ 0.5 } * values[i];
+      }
+      for (const OffsetValueType neighbor : { previous, next })
+      {
+        if (neighbor >= 0)
+        {
+          const RealType * const neighborValues = m_Values.data() + neighbor * VValueDimension;
+          for (unsigned int i = 0; i < VValueDimension; ++i)
+          {
+            blurred[i] += RealType{ 0.25 } * neighborValues[i];
+          }
+        }
+      }
+    }
+    m_Values.swap(blurredValues);
+  }
+}
+
+template <unsigned int VFeatureDimension, unsigned int VValueDimension, typename TRealType>
+auto
+PermutohedralLattice<VFeatureDimension, VValueDimension, TRealType>::Slice(const FeatureVectorType & features) const
+  -> ValueVectorType
+{
+  const Simplex simplex = this->ComputeEnclosingSimplex(features);
+
+  ValueVectorType values{};
+  for (unsigned int remainder = 0; remainder <= VFeatureDimension; ++remainder)
+  {
+    const OffsetValueType vertex = this->FindVertex(simplex.m_Keys[remainder]);
+    if (vertex >= 0)
+    {
+      const RealType * const vertexValues = m_Values.data() + vertex * VValueDimension;
+      for (unsigned int i = 0; i < VValueDimension; ++i)
+      {
+        values[i] += simplex.m_Weights[remainder] * vertexValues[i];
+      }
+    }
+  }
+  return values;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBilateralImageFilter.h"
+
+#include "itkGTest.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVector.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+// Creates an image with two regions of different values, split at the middle of the first dimension, with Gaussian
+// noise.
+template <typename TImage>
+typename TImage::Pointer
+CreateNoisyStepImage(const typename TImage::SizeType &  size,
+                     const typename TImage::PixelType & lowValue,
+                     const typename TImage::PixelType & highValue,
+                     double                             noiseSigma)
+{
+  const auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  std::mt19937                     randomNumberEngine;
+  std::normal_distribution<double> noise(0.0, noiseSigma);
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    auto pixel = (it.GetIndex()[0] < static_cast<itk::IndexValueType>(size[0] / 2)) ? lowValue : highValue;
+    using PixelTraitsType = itk::DefaultConvertPixelTraits<typename TImage::PixelType>;
+    for (unsigned int c = 0; c < itk::PixelTraits<typename TImage::PixelType>::Dimension; ++c)
+    {
+      const double component = PixelTraitsType::GetNthComponent(c, pixel) + noise(randomNumberEngine);
+      PixelTraitsType::SetNthComponent(c, pixel, static_cast<typename PixelTraitsType::ComponentType>(component));
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+} // namespace
+
+
+TEST(BilateralImageFilter, PermutohedralLatticeIsOffByDefault)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::BilateralImageFilter<ImageType, ImageType>;
+  EXPECT_FALSE(FilterType::New()->GetUsePermutohedralLattice());
+}
+
+
+TEST(BilateralImageFilter, PermutohedralLatticePreservesUniformImage)
+{
+  using ImageType = itk::Image<float, 3>;
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 12, 9, 7 } });
+  image->Allocate();
+  image->FillBuffer(42.0f);
+
+  const auto filter = itk::BilateralImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetDomainSigma(3.0);
+  filter->SetRangeSigma(10.0);
+  filter->UsePermutohedralLatticeOn();
+  filter->Update();
+
+  for (itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), image->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_NEAR(it.Get(), 42.0f, 1e-3f);
+  }
+}
+
+
+TEST(BilateralImageFilter, PermutohedralLatticeApproximatesNeighborhoodEvaluation)
+{
+  using ImageType = itk::Image<float, 2>;
+  const auto image = CreateNoisyStepImage<ImageType>({ { 48, 40 } }, 100.0f, 200.0f, 10.0);
+
+  const auto filter = itk::BilateralImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetDomainSigma(2.0);
+  filter->SetRangeSigma(25.0);
+  filter->Update();
+  const ImageType::Pointer reference = filter->GetOutput();
+  reference->DisconnectPipeline();
+
+  filter->UsePermutohedralLatticeOn();
+  filter->Update();
+  const ImageType * const output = filter->GetOutput();
+
+  double sumOfAbsoluteDifferences = 0.0;
+  double maximumAbsoluteDifference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(reference, reference->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const double difference = std::abs(it.Get() - output->GetPixel(it.GetIndex()));
+    sumOfAbsoluteDifferences += difference;
+    maximumAbsoluteDifference = std::max(maximumAbsoluteDifference, difference);
+  }
+  const double meanAbsoluteDifference =
+    sumOfAbsoluteDifferences / static_cast<double>(reference->GetBufferedRegion().GetNumberOfPixels());
+  // The lattice approximates the Gaussians within a small fraction of the step and of the noise.
+  EXPECT_LT(meanAbsoluteDifference, 1.0);
+  EXPECT_LT(maximumAbsoluteDifference, 5.0);
+}
+
+
+TEST(BilateralImageFilter, PermutohedralLatticeSupportsMultiComponentPixels)
+{
+  using PixelType = itk::Vector<float, 3>;
+  using ImageType = itk::Image<PixelType, 3>;
+  const auto image = CreateNoisyStepImage<ImageType>(
+    { { 16, 12, 10 } }, itk::MakeVector(100.0f, 20.0f, 50.0f), itk::MakeVector(20.0f, 100.0f, 50.0f), 10.0);
+
+  const auto filter = itk::BilateralImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(image);
+  filter->SetDomainSigma(2.0);
+  filter->SetRangeSigma(30.0);
+  EXPECT_THROW(filter->Update(), itk::ExceptionObject);
+
+  filter->UsePermutohedralLatticeOn();
+  filter->Update();
+
+  // The noise is smoothed within each region, while the edge between them is preserved.
+  const ImageType * const output = filter->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const PixelType expected = (it.GetIndex()[0] < 8) ? itk::MakeVector(100.0f, 20.0f, 50.0f)
+                                                       : itk::MakeVector(20.0f, 100.0f, 50.0f);
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      EXPECT_NEAR(it.Get()[c], expected[c], 8.0) << it.GetIndex();
+    }
+  }
+}
@@ -19,6 +19,8 @@
 #define itkBinaryFunctorImageFilter_h
 
 #include "itkInPlaceImageFilter.h"
+#include "itkFusiblePixelwiseImageSource.h"
+#include "itkSpanFunctor.h"
 #include "itkSimpleDataObjectDecorator.h"
 
 namespace itk
@@ -50,7 +52,9 @@ namespace itk
  * Corresponding Pixels In Two Images} \endsphinx
  */
 template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
-class ITK_TEMPLATE_EXPORT BinaryFunctorImageFilter : public InPlaceImageFilter<TInputImage1, TOutputImage>
+class ITK_TEMPLATE_EXPORT BinaryFunctorImageFilter
+  : public InPlaceImageFilter<TInputImage1, TOutputImage>
+  , public FusiblePixelwiseImageSource<TOutputImage>
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(BinaryFunctorImageFilter);
@@ -176,6 +180,28 @@ public:
   itkConceptMacro(SameDimensionCheck2,
                   (Concept::SameDimension<Self::InputImage1Dimension, Self::OutputImageDimension>));
 
+  /** Set/Get whether the output of this filter may be fused: computed line
+   * by line by the pixel-wise filter that consumes it, and released after
+   * that filter has generated its output. Only enable it when the output
+   * has that single consumer, and is not used otherwise.
+   * Defaults to FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion().
+   * \sa FusiblePixelwiseImageSourceBase */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  bool
+  CanFuseOutput() const override
+  {
+    return m_PixelwiseFusion;
+  }
+
+  void
+  GenerateFusedOutputLine(const OutputImageRegionType & outputLineRegion, OutputImagePixelType * buffer) override;
+
+  void
+  ReleaseInputsOfFusedOutput() override;
+
 protected:
   BinaryFunctorImageFilter();
   ~BinaryFunctorImageFilter() override = default;
@@ -193,6 +219,26 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Decide which inputs are fused. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Only prepares the functor when the output is fused, and releases the
+   * fused inputs afterwards otherwise. */
+  void
+  GenerateData() override;
+
+  /** The inputs of a fused output are released by ReleaseInputsOfFusedOutput. */
+  void
+  ReleaseInputs() override;
+
+  /** A fused input has no buffer to reuse. */
+  bool
+  CanRunInPlace() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 
   // Needed to take the image information from the 2nd input, if the first one is
   // a simple decorated object.
@@ -201,6 +247,8 @@ protected:
 
 private:
   FunctorType m_Functor{};
+
+  bool m_PixelwiseFusion{ FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion() };
 };
 } // end namespace itk
 
@@ -178,6 +178,17 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
+
+  // Whole scanlines of Image buffers are passed to the functor as spans.
+  constexpr bool spanOfInput1 = HasContiguousScanlines<TInputImage1> && HasContiguousScanlines<TOutputImage>;
+  constexpr bool spanOfInput2 = HasContiguousScanlines<TInputImage2> && HasContiguousScanlines<TOutputImage>;
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -186,18 +197,25 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (spanOfInput1 && spanOfInput2)
       {
-        outputIt.Set(m_Functor(inputIt1.Get(), inputIt2.Get()));
-        ++inputIt2;
-        ++inputIt1;
-        ++outputIt;
+        Functor::ApplyToSpan(m_Functor, &inputIt1.Value(), &inputIt2.Value(), &outputIt.Value(), lineLength);
+      }
+      else
+      {
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(m_Functor(inputIt1.Get(), inputIt2.Get()));
+          ++inputIt2;
+          ++inputIt1;
+          ++outputIt;
+        }
       }
 
       inputIt1.NextLine();
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr1)
@@ -209,15 +227,22 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (spanOfInput1)
+      {
+        Functor::ApplyToSpan(m_Functor, &inputIt1.Value(), input2Value, &outputIt.Value(), lineLength);
+      }
+      else
       {
-        outputIt.Set(m_Functor(inputIt1.Get(), input2Value));
-        ++inputIt1;
-        ++outputIt;
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(m_Functor(inputIt1.Get(), input2Value));
+          ++inputIt1;
+          ++outputIt;
+        }
       }
       inputIt1.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr2)
@@ -229,15 +254,22 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
 
     while (!inputIt2.IsAtEnd())
     {
-      while (!inputIt2.IsAtEndOfLine())
+      if constexpr (spanOfInput2)
       {
-        outputIt.Set(m_Functor(input1Value, inputIt2.Get()));
-        ++inputIt2;
-        ++outputIt;
+        Functor::ApplyToSpan(m_Functor, input1Value, &inputIt2.Value(), &outputIt.Value(), lineLength);
+      }
+      else
+      {
+        while (!inputIt2.IsAtEndOfLine())
+        {
+          outputIt.Set(m_Functor(input1Value, inputIt2.Get()));
+          ++inputIt2;
+          ++outputIt;
+        }
       }
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else
@@ -245,6 +277,109 @@ BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::D
     itkGenericExceptionMacro("At most one of the inputs can be a constant.");
   }
 }
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  // A missing input image is a constant.
+  const auto * inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto * inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+
+  typename FusiblePixelwiseImageSource<TInputImage1>::LineReader inputReader1(inputPtr1);
+  typename FusiblePixelwiseImageSource<TInputImage2>::LineReader inputReader2(inputPtr2);
+  const Input1ImagePixelType * const inputLine1 = inputPtr1 ? inputReader1.Read(outputLineRegion) : nullptr;
+  const Input2ImagePixelType * const inputLine2 = inputPtr2 ? inputReader2.Read(outputLineRegion) : nullptr;
+
+  const SizeValueType lineLength = outputLineRegion.GetSize(0);
+  if (inputLine1 && inputLine2)
+  {
+    Functor::ApplyToSpan(m_Functor, inputLine1, inputLine2, buffer, lineLength);
+  }
+  else if (inputLine1)
+  {
+    Functor::ApplyToSpan(m_Functor, inputLine1, this->GetConstant2(), buffer, lineLength);
+  }
+  else if (inputLine2)
+  {
+    Functor::ApplyToSpan(m_Functor, this->GetConstant1(), inputLine2, buffer, lineLength);
+  }
+  else
+  {
+    itkGenericExceptionMacro("At most one of the inputs can be a constant.");
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+bool
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() &&
+         FusiblePixelwiseImageSourceBase::GetFusedSource(ProcessObject::GetInput(0)) == nullptr;
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage, typename TFunction>
+void
+BinaryFunctorImageFilter<TInputImage1, TInputImage2, TOutputImage, TFunction>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
@@ -167,6 +167,13 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
   const OutputImageRegionType & outputRegionForThread)
 
 {
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    TOutputImage *        outputPtr = this->GetOutput(0);
+    TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
   m_DynamicThreadedGenerateDataFunction(outputRegionForThread);
 }
 
@@ -186,6 +193,11 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  // Whole scanlines of Image buffers are passed to the functor as spans.
+  constexpr bool spanOfInput1 = HasContiguousScanlines<TInputImage1> && HasContiguousScanlines<TOutputImage>;
+  constexpr bool spanOfInput2 = HasContiguousScanlines<TInputImage2> && HasContiguousScanlines<TOutputImage>;
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
   if (inputPtr1 && inputPtr2)
   {
     ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
@@ -194,18 +206,25 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (spanOfInput1 && spanOfInput2)
+      {
+        Functor::ApplyToSpan(functor, &inputIt1.Value(), &inputIt2.Value(), &outputIt.Value(), lineLength);
+      }
+      else
       {
-        outputIt.Set(functor(inputIt1.Get(), inputIt2.Get()));
-        ++inputIt2;
-        ++inputIt1;
-        ++outputIt;
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(inputIt1.Get(), inputIt2.Get()));
+          ++inputIt2;
+          ++inputIt1;
+          ++outputIt;
+        }
       }
 
       inputIt1.NextLine();
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr1)
@@ -217,15 +236,22 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt1.IsAtEnd())
     {
-      while (!inputIt1.IsAtEndOfLine())
+      if constexpr (spanOfInput1)
       {
-        outputIt.Set(functor(inputIt1.Get(), input2Value));
-        ++inputIt1;
-        ++outputIt;
+        Functor::ApplyToSpan(functor, &inputIt1.Value(), input2Value, &outputIt.Value(), lineLength);
+      }
+      else
+      {
+        while (!inputIt1.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(inputIt1.Get(), input2Value));
+          ++inputIt1;
+          ++outputIt;
+        }
       }
       inputIt1.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else if (inputPtr2)
@@ -237,15 +263,22 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
 
     while (!inputIt2.IsAtEnd())
     {
-      while (!inputIt2.IsAtEndOfLine())
+      if constexpr (spanOfInput2)
       {
-        outputIt.Set(functor(input1Value, inputIt2.Get()));
-        ++inputIt2;
-        ++outputIt;
+        Functor::ApplyToSpan(functor, input1Value, &inputIt2.Value(), &outputIt.Value(), lineLength);
+      }
+      else
+      {
+        while (!inputIt2.IsAtEndOfLine())
+        {
+          outputIt.Set(functor(input1Value, inputIt2.Get()));
+          ++inputIt2;
+          ++outputIt;
+        }
       }
       inputIt2.NextLine();
       outputIt.NextLine();
-      progress.Completed(outputRegionForThread.GetSize()[0]);
+      progress.Completed(lineLength);
     }
   }
   else
@@ -253,6 +286,118 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
     itkGenericExceptionMacro("At most one of the inputs can be a constant.");
   }
 }
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  m_GenerateFusedOutputLineFunction(outputLineRegion, buffer);
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+template <typename TFunctor>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::GenerateFusedOutputLineWithFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  // A missing input image is a constant.
+  const auto * inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto * inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+
+  typename FusiblePixelwiseImageSource<TInputImage1>::LineReader inputReader1(inputPtr1);
+  typename FusiblePixelwiseImageSource<TInputImage2>::LineReader inputReader2(inputPtr2);
+  const Input1ImagePixelType * const inputLine1 = inputPtr1 ? inputReader1.Read(outputLineRegion) : nullptr;
+  const Input2ImagePixelType * const inputLine2 = inputPtr2 ? inputReader2.Read(outputLineRegion) : nullptr;
+
+  const SizeValueType lineLength = outputLineRegion.GetSize(0);
+  if (inputLine1 && inputLine2)
+  {
+    Functor::ApplyToSpan(functor, inputLine1, inputLine2, buffer, lineLength);
+  }
+  else if (inputLine1)
+  {
+    Functor::ApplyToSpan(functor, inputLine1, this->GetConstant2(), buffer, lineLength);
+  }
+  else if (inputLine2)
+  {
+    Functor::ApplyToSpan(functor, this->GetConstant1(), inputLine2, buffer, lineLength);
+  }
+  else
+  {
+    itkGenericExceptionMacro("At most one of the inputs can be a constant.");
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+bool
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() &&
+         FusiblePixelwiseImageSourceBase::GetFusedSource(ProcessObject::GetInput(0)) == nullptr;
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
@@ -22,6 +22,7 @@
 #include "itkNeighborhoodOperator.h"
 #include "itkImage.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkSpanFunctor.h" // For HasContiguousScanlines.
 
 namespace itk
 {
@@ -35,6 +36,13 @@ namespace itk
  * with the image region.  Apply the mirror()'d operator for
  * non-symmetric NeighborhoodOperators.
  *
+ * One-dimensional operators (operators whose radius is zero along all
+ * axes but one), like the operators of the separable
+ * DiscreteGaussianImageFilter, are applied to whole scanlines at once:
+ * the filter sums the weighted, contiguous input lines that surround each
+ * output line, and only calls the boundary condition for the pixels beyond
+ * the edges of the input buffer.
+ *
  * \ingroup ImageFilters
  *
  * \sa Image
@@ -180,6 +188,28 @@ protected:
   }
 
 private:
+  using InputPixelRealType = typename NumericTraits<InputPixelType>::RealType;
+  using AccumulateRealType = typename NumericTraits<InputPixelRealType>::AccumulateType;
+
+  /** Whether the operator can be applied line by line: whether its radius is
+   * zero along all axes but the returned axis, and whether the boundary
+   * condition can be evaluated by its GetPixel method. */
+  bool
+  CanApplyOperatorAlongAxis(unsigned int & axis) const;
+
+  /** Applies a one-dimensional operator along the given axis to each
+   * scanline of outputRegionForThread. */
+  void
+  ApplyOperatorAlongAxis(const OutputImageRegionType & outputRegionForThread, unsigned int axis);
+
+  /** Copies length input pixels, starting at start and going along the
+   * first axis, into line. Pixels outside the buffered region of the input
+   * are given by the boundary condition. */
+  void
+  CopyInputLine(const typename InputImageType::IndexType & start,
+                SizeValueType                              length,
+                InputPixelRealType *                       line) const;
+
   /** Internal operator used to filter the image. */
   OutputNeighborhoodType m_Operator{};
 
@@ -24,6 +24,11 @@
 #include "itkImageRegionIterator.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkTotalProgressReporter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkConstantBoundaryCondition.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -76,6 +81,16 @@ void
 NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if constexpr (HasContiguousScanlines<InputImageType> && HasContiguousScanlines<OutputImageType>)
+  {
+    unsigned int axis = 0;
+    if (this->CanApplyOperatorAlongAxis(axis))
+    {
+      this->ApplyOperatorAlongAxis(outputRegionForThread, axis);
+      return;
+    }
+  }
+
   using BFC = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>;
   using FaceListType = typename BFC::FaceListType;
 
@@ -114,6 +129,149 @@ NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::
     }
   }
 }
+
+template <typename TInputImage, typename TOutputImage, typename TOperatorValueType>
+bool
+NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::CanApplyOperatorAlongAxis(
+  unsigned int & axis) const
+{
+  axis = 0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (m_Operator.GetRadius(i) > 0)
+    {
+      if (axis != i && m_Operator.GetRadius(axis) > 0)
+      {
+        return false;
+      }
+      axis = i;
+    }
+  }
+
+  // The neighborhood iterators apply the boundary condition beyond the edges of the buffered region, while GetPixel
+  // applies it beyond the edges of the largest possible region. For the zero-flux Neumann and constant boundary
+  // conditions, both agree, as the requested input region extends up to the edges of the largest possible region
+  // wherever pixels beyond it are needed.
+  const InputImageType * input = this->GetInput();
+  return dynamic_cast<const ZeroFluxNeumannBoundaryCondition<InputImageType> *>(m_BoundsCondition) != nullptr ||
+         dynamic_cast<const ConstantBoundaryCondition<InputImageType> *>(m_BoundsCondition) != nullptr ||
+         input->GetBufferedRegion() == input->GetLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage, typename TOperatorValueType>
+void
+NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::ApplyOperatorAlongAxis(
+  const OutputImageRegionType & outputRegionForThread,
+  unsigned int                  axis)
+{
+  // Same computation as NeighborhoodInnerProduct, for each pixel of a line at once.
+  using WeightType = typename NumericTraits<ComputingPixelType>::ValueType;
+
+  OutputImageType * output = this->GetOutput();
+
+  const auto              radius = static_cast<OffsetValueType>(m_Operator.GetRadius(axis));
+  std::vector<WeightType> weights(m_Operator.Size());
+  for (unsigned int k = 0; k < m_Operator.Size(); ++k)
+  {
+    weights[k] = static_cast<WeightType>(m_Operator[k]);
+  }
+
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
+  // Along the first axis, a single input line holds the neighborhoods of all the pixels of an output line. Along
+  // the other axes, each weight is applied to another input line.
+  std::vector<InputPixelRealType> inputLine(axis == 0 ? lineLength + 2 * radius : lineLength);
+  std::vector<AccumulateRealType> sums(lineLength);
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  for (ImageScanlineIterator outputIt(output, outputRegionForThread); !outputIt.IsAtEnd(); outputIt.NextLine())
+  {
+    const typename OutputImageType::IndexType & lineIndex = outputIt.GetIndex();
+
+    std::fill(sums.begin(), sums.end(), AccumulateRealType{});
+    if (axis == 0)
+    {
+      typename InputImageType::IndexType start = lineIndex;
+      start[0] -= radius;
+      this->CopyInputLine(start, inputLine.size(), inputLine.data());
+    }
+    for (unsigned int k = 0; k < weights.size(); ++k)
+    {
+      const InputPixelRealType * neighbors = inputLine.data() + k;
+      if (axis != 0)
+      {
+        typename InputImageType::IndexType start = lineIndex;
+        start[axis] += static_cast<OffsetValueType>(k) - radius;
+        this->CopyInputLine(start, lineLength, inputLine.data());
+        neighbors = inputLine.data();
+      }
+
+      const WeightType weight = weights[k];
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        sums[i] += static_cast<AccumulateRealType>(weight * neighbors[i]);
+      }
+    }
+
+    OutputPixelType * const outputLine = &outputIt.Value();
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      outputLine[i] = static_cast<OutputPixelType>(static_cast<ComputingPixelType>(sums[i]));
+    }
+    progress.Completed(lineLength);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TOperatorValueType>
+void
+NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, TOperatorValueType>::CopyInputLine(
+  const typename InputImageType::IndexType & start,
+  SizeValueType                              length,
+  InputPixelRealType *                       line) const
+{
+  const InputImageType * input = this->GetInput();
+  const auto &           bufferedRegion = input->GetBufferedRegion();
+
+  // The part [begin, end) of the line lies inside the buffered region.
+  const auto      lineLength = static_cast<OffsetValueType>(length);
+  OffsetValueType begin = 0;
+  OffsetValueType end = 0;
+  bool            lineIsInside = true;
+  for (unsigned int i = 1; i < InputImageDimension; ++i)
+  {
+    lineIsInside = lineIsInside && start[i] >= bufferedRegion.GetIndex(i) &&
+                   start[i] < bufferedRegion.GetIndex(i) + static_cast<OffsetValueType>(bufferedRegion.GetSize(i));
+  }
+  if (lineIsInside)
+  {
+    const OffsetValueType bufferedBegin = bufferedRegion.GetIndex(0) - start[0];
+    begin = std::clamp<OffsetValueType>(bufferedBegin, 0, lineLength);
+    end = std::clamp<OffsetValueType>(
+      bufferedBegin + static_cast<OffsetValueType>(bufferedRegion.GetSize(0)), begin, lineLength);
+  }
+
+  typename InputImageType::IndexType index = start;
+  for (OffsetValueType i = 0; i < begin; ++i)
+  {
+    index[0] = start[0] + i;
+    line[i] = static_cast<InputPixelRealType>(m_BoundsCondition->GetPixel(index, input));
+  }
+  if (begin < end)
+  {
+    index[0] = start[0] + begin;
+    const InputPixelType * const inputLine = input->GetBufferPointer() + input->ComputeOffset(index);
+    for (OffsetValueType i = begin; i < end; ++i)
+    {
+      line[i] = static_cast<InputPixelRealType>(inputLine[i - begin]);
+    }
+  }
+  for (OffsetValueType i = end; i < lineLength; ++i)
+  {
+    index[0] = start[0] + i;
+    line[i] = static_cast<InputPixelRealType>(m_BoundsCondition->GetPixel(index, input));
+  }
+}
 } // end namespace itk
 
 #endif
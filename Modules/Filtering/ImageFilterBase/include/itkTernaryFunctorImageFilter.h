@@ -19,6 +19,7 @@
 #define itkTernaryFunctorImageFilter_h
 
 #include "itkInPlaceImageFilter.h"
+#include "itkFusiblePixelwiseImageSource.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
 namespace itk
@@ -40,7 +41,9 @@ template <typename TInputImage1,
           typename TInputImage3,
           typename TOutputImage,
           typename TFunction>
-class ITK_TEMPLATE_EXPORT TernaryFunctorImageFilter : public InPlaceImageFilter<TInputImage1, TOutputImage>
+class ITK_TEMPLATE_EXPORT TernaryFunctorImageFilter
+  : public InPlaceImageFilter<TInputImage1, TOutputImage>
+  , public FusiblePixelwiseImageSource<TOutputImage>
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(TernaryFunctorImageFilter);
@@ -134,6 +137,28 @@ public:
   itkConceptMacro(SameDimensionCheck2, (Concept::SameDimension<Input1ImageDimension, Input3ImageDimension>));
   itkConceptMacro(SameDimensionCheck3, (Concept::SameDimension<Input1ImageDimension, OutputImageDimension>));
 
+  /** Set/Get whether the output of this filter may be fused: computed line
+   * by line by the pixel-wise filter that consumes it, and released after
+   * that filter has generated its output. Only enable it when the output
+   * has that single consumer, and is not used otherwise.
+   * Defaults to FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion().
+   * \sa FusiblePixelwiseImageSourceBase */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  bool
+  CanFuseOutput() const override
+  {
+    return m_PixelwiseFusion;
+  }
+
+  void
+  GenerateFusedOutputLine(const OutputImageRegionType & outputLineRegion, OutputImagePixelType * buffer) override;
+
+  void
+  ReleaseInputsOfFusedOutput() override;
+
 protected:
   TernaryFunctorImageFilter();
   ~TernaryFunctorImageFilter() override = default;
@@ -156,9 +181,31 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Decide which inputs are fused. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Only prepares the functor when the output is fused, and releases the
+   * fused inputs afterwards otherwise. */
+  void
+  GenerateData() override;
+
+  /** The inputs of a fused output are released by ReleaseInputsOfFusedOutput. */
+  void
+  ReleaseInputs() override;
+
+  /** A fused input has no buffer to reuse. */
+  bool
+  CanRunInPlace() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 
 private:
   FunctorType m_Functor{};
+
+  bool m_PixelwiseFusion{ FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion() };
 };
 } // end namespace itk
 
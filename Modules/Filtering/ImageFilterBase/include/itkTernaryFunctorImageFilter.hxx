@@ -130,6 +130,12 @@ TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
+
   ImageScanlineConstIterator inputIt1(inputPtr1, outputRegionForThread);
   ImageScanlineConstIterator inputIt2(inputPtr2, outputRegionForThread);
   ImageScanlineConstIterator inputIt3(inputPtr3, outputRegionForThread);
@@ -152,6 +158,127 @@ TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  const auto * inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto * inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+  const auto * inputPtr3 = dynamic_cast<const TInputImage3 *>(ProcessObject::GetInput(2));
+
+  typename FusiblePixelwiseImageSource<TInputImage1>::LineReader inputReader1(inputPtr1);
+  typename FusiblePixelwiseImageSource<TInputImage2>::LineReader inputReader2(inputPtr2);
+  typename FusiblePixelwiseImageSource<TInputImage3>::LineReader inputReader3(inputPtr3);
+  const Input1ImagePixelType * const inputLine1 = inputReader1.Read(outputLineRegion);
+  const Input2ImagePixelType * const inputLine2 = inputReader2.Read(outputLineRegion);
+  const Input3ImagePixelType * const inputLine3 = inputReader3.Read(outputLineRegion);
+
+  const SizeValueType lineLength = outputLineRegion.GetSize(0);
+  for (SizeValueType i = 0; i < lineLength; ++i)
+  {
+    buffer[i] = m_Functor(inputLine1[i], inputLine2[i], inputLine3[i]);
+  }
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+bool
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() &&
+         FusiblePixelwiseImageSourceBase::GetFusedSource(ProcessObject::GetInput(0)) == nullptr;
+}
+
+template <typename TInputImage1,
+          typename TInputImage2,
+          typename TInputImage3,
+          typename TOutputImage,
+          typename TFunction>
+void
+TernaryFunctorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
@@ -19,6 +19,7 @@
 #define itkTernaryGeneratorImageFilter_h
 
 #include "itkInPlaceImageFilter.h"
+#include "itkFusiblePixelwiseImageSource.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkSimpleDataObjectDecorator.h"
 
@@ -51,7 +52,9 @@ namespace itk
  * \ingroup ITKImageFilterBase
  */
 template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
-class ITK_TEMPLATE_EXPORT TernaryGeneratorImageFilter : public InPlaceImageFilter<TInputImage1, TOutputImage>
+class ITK_TEMPLATE_EXPORT TernaryGeneratorImageFilter
+  : public InPlaceImageFilter<TInputImage1, TOutputImage>
+  , public FusiblePixelwiseImageSource<TOutputImage>
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(TernaryGeneratorImageFilter);
@@ -166,6 +169,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, f](const OutputImageRegionType & outputLineRegion,
+                                                  OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(f, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -176,6 +183,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, f](const OutputImageRegionType & outputLineRegion,
+                                                  OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(f, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -190,6 +201,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, funcPointer](const OutputImageRegionType & outputLineRegion,
+                                                            OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(funcPointer, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -199,6 +214,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, funcPointer](const OutputImageRegionType & outputLineRegion,
+                                                            OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(funcPointer, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -220,6 +239,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, functor](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(functor, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, functor](const OutputImageRegionType & outputLineRegion,
+                                                        OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(functor, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -235,6 +258,28 @@ public:
   itkConceptMacro(SameDimensionCheck2, (Concept::SameDimension<Input1ImageDimension, Input3ImageDimension>));
   itkConceptMacro(SameDimensionCheck3, (Concept::SameDimension<Input1ImageDimension, OutputImageDimension>));
 
+  /** Set/Get whether the output of this filter may be fused: computed line
+   * by line by the pixel-wise filter that consumes it, and released after
+   * that filter has generated its output. Only enable it when the output
+   * has that single consumer, and is not used otherwise.
+   * Defaults to FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion().
+   * \sa FusiblePixelwiseImageSourceBase */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  bool
+  CanFuseOutput() const override
+  {
+    return m_PixelwiseFusion;
+  }
+
+  void
+  GenerateFusedOutputLine(const OutputImageRegionType & outputLineRegion, OutputImagePixelType * buffer) override;
+
+  void
+  ReleaseInputsOfFusedOutput() override;
+
 protected:
   TernaryGeneratorImageFilter();
   ~TernaryGeneratorImageFilter() override = default;
@@ -258,9 +303,38 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  template <typename TFunctor>
+  void
+  GenerateFusedOutputLineWithFunctor(const TFunctor &              functor,
+                                     const OutputImageRegionType & outputLineRegion,
+                                     OutputImagePixelType *        buffer);
+
+  /** Decide which inputs are fused. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Only prepares the functor when the output is fused, and releases the
+   * fused inputs afterwards otherwise. */
+  void
+  GenerateData() override;
+
+  /** The inputs of a fused output are released by ReleaseInputsOfFusedOutput. */
+  void
+  ReleaseInputs() override;
+
+  /** A fused input has no buffer to reuse. */
+  bool
+  CanRunInPlace() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 
 private:
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction{};
+  std::function<void(const OutputImageRegionType &, OutputImagePixelType *)> m_GenerateFusedOutputLineFunction{};
+
+  bool m_PixelwiseFusion{ FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion() };
 };
 } // end namespace itk
 
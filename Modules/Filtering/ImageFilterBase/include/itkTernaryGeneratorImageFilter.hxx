@@ -233,6 +233,13 @@ void
 TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    TOutputImage *        outputPtr = this->GetOutput(0);
+    TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
   m_DynamicThreadedGenerateDataFunction(outputRegionForThread);
 }
 
@@ -340,6 +347,117 @@ TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputIma
     }
   }
 }
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  m_GenerateFusedOutputLineFunction(outputLineRegion, buffer);
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+template <typename TFunctor>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::GenerateFusedOutputLineWithFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  // A missing input image is a constant.
+  const auto * inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto * inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+  const auto * inputPtr3 = dynamic_cast<const TInputImage3 *>(ProcessObject::GetInput(2));
+
+  typename FusiblePixelwiseImageSource<TInputImage1>::LineReader inputReader1(inputPtr1);
+  typename FusiblePixelwiseImageSource<TInputImage2>::LineReader inputReader2(inputPtr2);
+  typename FusiblePixelwiseImageSource<TInputImage3>::LineReader inputReader3(inputPtr3);
+  const Input1ImagePixelType * const inputLine1 = inputPtr1 ? inputReader1.Read(outputLineRegion) : nullptr;
+  const Input2ImagePixelType * const inputLine2 = inputPtr2 ? inputReader2.Read(outputLineRegion) : nullptr;
+  const Input3ImagePixelType * const inputLine3 = inputPtr3 ? inputReader3.Read(outputLineRegion) : nullptr;
+
+  const Input1ImagePixelType & input1Value = inputPtr1 ? Input1ImagePixelType() : this->GetConstant1();
+  const Input2ImagePixelType & input2Value = inputPtr2 ? Input2ImagePixelType() : this->GetConstant2();
+  const Input3ImagePixelType & input3Value = inputPtr3 ? Input3ImagePixelType() : this->GetConstant3();
+
+  const SizeValueType lineLength = outputLineRegion.GetSize(0);
+  for (SizeValueType i = 0; i < lineLength; ++i)
+  {
+    buffer[i] = functor(inputLine1 ? inputLine1[i] : input1Value,
+                          inputLine2 ? inputLine2[i] : input2Value,
+                          inputLine3 ? inputLine3[i] : input3Value);
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+bool
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() &&
+         FusiblePixelwiseImageSourceBase::GetFusedSource(ProcessObject::GetInput(0)) == nullptr;
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TInputImage3, typename TOutputImage>
+void
+TernaryGeneratorImageFilter<TInputImage1, TInputImage2, TInputImage3, TOutputImage>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
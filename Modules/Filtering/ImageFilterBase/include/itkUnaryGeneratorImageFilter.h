@@ -20,6 +20,8 @@
 
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
+#include "itkFusiblePixelwiseImageSource.h"
+#include "itkSpanFunctor.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
 #include <functional>
@@ -52,7 +54,9 @@ namespace itk
  *
  */
 template <typename TInputImage, typename TOutputImage>
-class ITK_TEMPLATE_EXPORT UnaryGeneratorImageFilter : public InPlaceImageFilter<TInputImage, TOutputImage>
+class ITK_TEMPLATE_EXPORT UnaryGeneratorImageFilter
+  : public InPlaceImageFilter<TInputImage, TOutputImage>
+  , public FusiblePixelwiseImageSource<TOutputImage>
 {
 public:
   ITK_DISALLOW_COPY_AND_MOVE(UnaryGeneratorImageFilter);
@@ -94,6 +98,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, f](const OutputImageRegionType & outputLineRegion,
+                                                  OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(f, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -103,6 +111,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, f](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(f, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, f](const OutputImageRegionType & outputLineRegion,
+                                                  OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(f, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -118,6 +130,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, funcPointer](const OutputImageRegionType & outputLineRegion,
+                                                            OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(funcPointer, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -127,6 +143,10 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, funcPointer](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(funcPointer, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, funcPointer](const OutputImageRegionType & outputLineRegion,
+                                                            OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(funcPointer, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
@@ -146,11 +166,37 @@ public:
     m_DynamicThreadedGenerateDataFunction = [this, functor](const OutputImageRegionType & outputRegionForThread) {
       return this->DynamicThreadedGenerateDataWithFunctor(functor, outputRegionForThread);
     };
+    m_GenerateFusedOutputLineFunction = [this, functor](const OutputImageRegionType & outputLineRegion,
+                                                        OutputImagePixelType *        buffer) {
+      return this->GenerateFusedOutputLineWithFunctor(functor, outputLineRegion, buffer);
+    };
 
     this->Modified();
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** Set/Get whether the output of this filter may be fused: computed line
+   * by line by the pixel-wise filter that consumes it, and released after
+   * that filter has generated its output. Only enable it when the output
+   * has that single consumer, and is not used otherwise.
+   * Defaults to FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion().
+   * \sa FusiblePixelwiseImageSourceBase */
+  itkSetMacro(PixelwiseFusion, bool);
+  itkGetConstMacro(PixelwiseFusion, bool);
+  itkBooleanMacro(PixelwiseFusion);
+
+  bool
+  CanFuseOutput() const override
+  {
+    return m_PixelwiseFusion;
+  }
+
+  void
+  GenerateFusedOutputLine(const OutputImageRegionType & outputLineRegion, OutputImagePixelType * buffer) override;
+
+  void
+  ReleaseInputsOfFusedOutput() override;
+
 protected:
   UnaryGeneratorImageFilter();
   ~UnaryGeneratorImageFilter() override = default;
@@ -183,8 +229,37 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  template <typename TFunctor>
+  void
+  GenerateFusedOutputLineWithFunctor(const TFunctor &              functor,
+                                     const OutputImageRegionType & outputLineRegion,
+                                     OutputImagePixelType *        buffer);
+
+  /** Decide which inputs are fused. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Only prepares the functor when the output is fused, and releases the
+   * fused inputs afterwards otherwise. */
+  void
+  GenerateData() override;
+
+  /** The inputs of a fused output are released by ReleaseInputsOfFusedOutput. */
+  void
+  ReleaseInputs() override;
+
+  /** A fused input has no buffer to reuse. */
+  bool
+  CanRunInPlace() const override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction{};
+  std::function<void(const OutputImageRegionType &, OutputImagePixelType *)> m_GenerateFusedOutputLineFunction{};
+
+  bool m_PixelwiseFusion{ FusiblePixelwiseImageSourceBase::GetGlobalDefaultPixelwiseFusion() };
 };
 } // end namespace itk
 
@@ -68,6 +68,13 @@ void
 UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (FusiblePixelwiseImageSourceBase::HasFusedInputs(this))
+  {
+    TOutputImage *        outputPtr = this->GetOutput(0);
+    TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+    this->GenerateOutputRegionLineByLine(outputPtr, outputRegionForThread, progress);
+    return;
+  }
   m_DynamicThreadedGenerateDataFunction(outputRegionForThread);
 }
 
@@ -99,17 +106,117 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
 
   while (!inputIt.IsAtEnd())
   {
-    while (!inputIt.IsAtEndOfLine())
+    if constexpr (HasContiguousScanlines<TInputImage> && HasContiguousScanlines<TOutputImage>)
+    {
+      Functor::ApplyToSpan(functor, &inputIt.Value(), &outputIt.Value(), regionSize[0]);
+    }
+    else
     {
-      outputIt.Set(functor(inputIt.Get()));
-      ++inputIt;
-      ++outputIt;
+      while (!inputIt.IsAtEndOfLine())
+      {
+        outputIt.Set(functor(inputIt.Get()));
+        ++inputIt;
+        ++outputIt;
+      }
     }
     progress.Completed(regionSize[0]);
     inputIt.NextLine();
     outputIt.NextLine();
   }
 }
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateFusedOutputLine(
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  m_GenerateFusedOutputLineFunction(outputLineRegion, buffer);
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunctor>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateFusedOutputLineWithFunctor(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputLineRegion,
+  OutputImagePixelType *        buffer)
+{
+  InputImageRegionType inputLineRegion;
+  this->CallCopyOutputRegionToInputRegion(inputLineRegion, outputLineRegion);
+
+  typename FusiblePixelwiseImageSource<TInputImage>::LineReader inputReader(this->GetInput());
+  const InputImagePixelType * const inputLine = inputReader.Read(inputLineRegion);
+
+  Functor::ApplyToSpan(functor, inputLine, buffer, outputLineRegion.GetSize(0));
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::ReleaseInputsOfFusedOutput()
+{
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+  Superclass::ReleaseInputs();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  FusiblePixelwiseImageSourceBase::FuseInputs(this, this->CanComputeFusedInputs());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  if (this->IsOutputFused())
+  {
+    // The consumer computes the output by GenerateFusedOutputLine.
+    this->BeforeThreadedGenerateData();
+    return;
+  }
+
+  try
+  {
+    Superclass::GenerateData();
+  }
+  catch (...)
+  {
+    FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+    throw;
+  }
+  FusiblePixelwiseImageSourceBase::ReleaseFusedInputs(this);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::ReleaseInputs()
+{
+  if (!this->IsOutputFused())
+  {
+    Superclass::ReleaseInputs();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::CanRunInPlace() const
+{
+  return Superclass::CanRunInPlace() &&
+         FusiblePixelwiseImageSourceBase::GetFusedSource(ProcessObject::GetInput(0)) == nullptr;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(PixelwiseFusion);
+}
 } // end namespace itk
 
 #endif
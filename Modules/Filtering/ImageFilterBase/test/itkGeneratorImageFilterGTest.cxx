@@ -19,8 +19,11 @@
 #include "itkUnaryGeneratorImageFilter.h"
 #include "itkBinaryGeneratorImageFilter.h"
 #include "itkTernaryGeneratorImageFilter.h"
+#include "itkBinaryFunctorImageFilter.h"
+#include "itkTernaryFunctorImageFilter.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 
 #include "itkGTest.h"
 
@@ -439,3 +442,128 @@ TEST(TernaryGeneratorImageFilter, Constants)
 
   EXPECT_NEAR(103.0, outputImage->GetPixel(idx), 1e-8);
 }
+
+
+namespace
+{
+template <typename TPixelType>
+struct MultiplyAddFunctor
+{
+  bool
+  operator==(const MultiplyAddFunctor &) const
+  {
+    return true;
+  }
+  bool
+  operator!=(const MultiplyAddFunctor &) const
+  {
+    return false;
+  }
+
+  TPixelType
+  operator()(const TPixelType & p1, const TPixelType & p2) const
+  {
+    return p1 * p2 + 1;
+  }
+  TPixelType
+  operator()(const TPixelType & p1, const TPixelType & p2, const TPixelType & p3) const
+  {
+    return p1 * p2 + p3;
+  }
+};
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRampImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(TImage::SizeType::Filled(6)));
+  image->Allocate();
+
+  typename TImage::PixelType value{};
+  for (itk::ImageRegionIterator<TImage> iter(image, image->GetBufferedRegion()); !iter.IsAtEnd(); ++iter)
+  {
+    iter.Set(++value);
+  }
+  return image;
+}
+
+// Updates a chain of unary, binary and ternary filters, some of them with constant inputs, and returns its output.
+template <typename TImage>
+typename TImage::Pointer
+UpdatePixelwiseChain(const TImage * image, bool pixelwiseFusion, bool expectReleasedIntermediates)
+{
+  using Utils = Utilities<3, typename TImage::PixelType>;
+
+  using UnaryFilterType = itk::UnaryGeneratorImageFilter<TImage, TImage>;
+  using BinaryFilterType = itk::BinaryGeneratorImageFilter<TImage, TImage, TImage>;
+  using TernaryFilterType = itk::TernaryGeneratorImageFilter<TImage, TImage, TImage, TImage>;
+  using BinaryFunctorFilterType =
+    itk::BinaryFunctorImageFilter<TImage, TImage, TImage, MultiplyAddFunctor<typename TImage::PixelType>>;
+  using TernaryFunctorFilterType =
+    itk::TernaryFunctorImageFilter<TImage, TImage, TImage, TImage, MultiplyAddFunctor<typename TImage::PixelType>>;
+
+  auto unaryFilter = UnaryFilterType::New();
+  unaryFilter->SetInput(image);
+  unaryFilter->SetFunctor(Utils::MyUnaryFunction);
+
+  auto binaryFilter = BinaryFilterType::New();
+  binaryFilter->SetConstant1(2.0f);
+  binaryFilter->SetInput2(unaryFilter->GetOutput());
+  binaryFilter->SetFunctor(Utils::MyBinaryFunction1);
+
+  auto ternaryFilter = TernaryFilterType::New();
+  ternaryFilter->SetInput1(binaryFilter->GetOutput());
+  ternaryFilter->SetInput2(image);
+  ternaryFilter->SetConstant3(3.0f);
+  ternaryFilter->SetFunctor(Utils::MyTernaryFunction2);
+
+  auto binaryFunctorFilter = BinaryFunctorFilterType::New();
+  binaryFunctorFilter->SetInput1(ternaryFilter->GetOutput());
+  binaryFunctorFilter->SetConstant2(0.5f);
+
+  auto ternaryFunctorFilter = TernaryFunctorFilterType::New();
+  ternaryFunctorFilter->SetInput1(binaryFunctorFilter->GetOutput());
+  ternaryFunctorFilter->SetInput2(image);
+  ternaryFunctorFilter->SetInput3(unaryFilter->GetOutput());
+
+  // The output of the unary filter has two consumers, so it must not be fused.
+  unaryFilter->SetPixelwiseFusion(false);
+  binaryFilter->SetPixelwiseFusion(pixelwiseFusion);
+  ternaryFilter->SetPixelwiseFusion(pixelwiseFusion);
+  binaryFunctorFilter->SetPixelwiseFusion(pixelwiseFusion);
+  ternaryFunctorFilter->SetPixelwiseFusion(pixelwiseFusion);
+
+  ternaryFunctorFilter->Update();
+
+  EXPECT_NE(unaryFilter->GetOutput()->GetBufferPointer(), nullptr);
+  EXPECT_EQ(binaryFilter->GetOutput()->GetBufferPointer() == nullptr, expectReleasedIntermediates);
+  EXPECT_EQ(ternaryFilter->GetOutput()->GetBufferPointer() == nullptr, expectReleasedIntermediates);
+  EXPECT_EQ(binaryFunctorFilter->GetOutput()->GetBufferPointer() == nullptr, expectReleasedIntermediates);
+
+  typename TImage::Pointer output = ternaryFunctorFilter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+} // namespace
+
+
+TEST(GeneratorImageFilter, PixelwiseFusion)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  const auto image = CreateRampImage<ImageType>();
+
+  const auto expected = UpdatePixelwiseChain<ImageType>(image, false, false);
+  const auto fused = UpdatePixelwiseChain<ImageType>(image, true, true);
+
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> iter(expected, expected->GetBufferedRegion()); !iter.IsAtEnd();
+       ++iter)
+  {
+    const auto & index = iter.GetIndex();
+    const float  input = image->GetPixel(index);
+    const float  ternary = (2.0f + 3 * (input + 10)) - input * 3.0f;
+    EXPECT_EQ(iter.Get(), (ternary * 0.5f + 1) * input + (input + 10));
+    EXPECT_EQ(iter.Get(), fused->GetPixel(index));
+  }
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkGTest.h"
+
+
+namespace
+{
+using InputImageType = itk::Image<short, 3>;
+using OutputImageType = itk::Image<float, 3>;
+using FilterType = itk::NeighborhoodOperatorImageFilter<InputImageType, OutputImageType, double>;
+using OperatorType = FilterType::OutputNeighborhoodType;
+
+InputImageType::Pointer
+CreateInputImage()
+{
+  auto image = InputImageType::New();
+  image->SetRegions(InputImageType::RegionType({ { -3, 2, 0 } }, { { 17, 11, 7 } }));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<short>((index[0] * 7 + index[1] * 13 + index[2] * index[2] * 5) % 23 - 9));
+  }
+  return image;
+}
+
+// An asymmetric operator, along the given axes.
+OperatorType
+CreateOperator(const OperatorType::SizeType & radius)
+{
+  OperatorType oper;
+  oper.SetRadius(radius);
+  for (unsigned int k = 0; k < oper.Size(); ++k)
+  {
+    oper[k] = 0.25 + 0.5 * k - 0.125 * k * k;
+  }
+  return oper;
+}
+
+// The value of each output pixel, as computed by the neighborhood iterators.
+float
+ComputeExpectedPixel(const InputImageType *                       input,
+                     const OperatorType &                         oper,
+                     itk::ImageBoundaryCondition<InputImageType> & boundaryCondition,
+                     const InputImageType::IndexType &            index)
+{
+  double sum = 0.0;
+  for (unsigned int k = 0; k < oper.Size(); ++k)
+  {
+    const InputImageType::IndexType neighbor = index + oper.GetOffset(k);
+    sum += oper[k] * static_cast<double>(boundaryCondition.GetPixel(neighbor, input));
+  }
+  return static_cast<float>(sum);
+}
+
+void
+ExpectFilterOutput(const OperatorType &                          oper,
+                   itk::ImageBoundaryCondition<InputImageType> * boundaryCondition,
+                   const OutputImageType::RegionType *           requestedRegion = nullptr)
+{
+  const auto input = CreateInputImage();
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetOperator(oper);
+  if (boundaryCondition)
+  {
+    filter->OverrideBoundaryCondition(boundaryCondition);
+  }
+  if (requestedRegion)
+  {
+    filter->GetOutput()->SetRequestedRegion(*requestedRegion);
+  }
+  filter->Update();
+
+  itk::ZeroFluxNeumannBoundaryCondition<InputImageType> defaultBoundaryCondition;
+  auto & expectedBoundaryCondition = boundaryCondition ? *boundaryCondition : defaultBoundaryCondition;
+
+  const OutputImageType * output = filter->GetOutput();
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, output->GetRequestedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_NEAR(it.Get(), ComputeExpectedPixel(input, oper, expectedBoundaryCondition, it.GetIndex()), 1e-4)
+      << it.GetIndex();
+  }
+}
+} // namespace
+
+
+TEST(NeighborhoodOperatorImageFilter, OneDimensionalOperators)
+{
+  itk::ConstantBoundaryCondition<InputImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(5);
+  itk::PeriodicBoundaryCondition<InputImageType> periodicBoundaryCondition;
+
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    for (const itk::SizeValueType radius : { 0, 1, 3, 9 })
+    {
+      OperatorType::SizeType operatorRadius{};
+      operatorRadius[axis] = radius;
+      const OperatorType oper = CreateOperator(operatorRadius);
+
+      ExpectFilterOutput(oper, nullptr);
+      ExpectFilterOutput(oper, &constantBoundaryCondition);
+      ExpectFilterOutput(oper, &periodicBoundaryCondition);
+    }
+  }
+}
+
+
+TEST(NeighborhoodOperatorImageFilter, StreamedOneDimensionalOperators)
+{
+  itk::ConstantBoundaryCondition<InputImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(-2);
+
+  const OutputImageType::RegionType requestedRegion({ { 1, 4, 2 } }, { { 9, 3, 4 } });
+  for (unsigned int axis = 0; axis < 3; ++axis)
+  {
+    OperatorType::SizeType operatorRadius{};
+    operatorRadius[axis] = 4;
+    const OperatorType oper = CreateOperator(operatorRadius);
+
+    ExpectFilterOutput(oper, nullptr, &requestedRegion);
+    ExpectFilterOutput(oper, &constantBoundaryCondition, &requestedRegion);
+  }
+}
+
+
+TEST(NeighborhoodOperatorImageFilter, MultiDimensionalOperator)
+{
+  const OperatorType oper = CreateOperator({ { 1, 2, 1 } });
+  ExpectFilterOutput(oper, nullptr);
+
+  const OutputImageType::RegionType requestedRegion({ { -2, 3, 1 } }, { { 5, 6, 3 } });
+  ExpectFilterOutput(oper, nullptr, &requestedRegion);
+}
@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelImageGaussianResampleImageFilter_h
+#define itkLabelImageGaussianResampleImageFilter_h
+
+#include "itkResampleImageFilter.h"
+#include "itkLabelImageGaussianInterpolateImageFunction.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class LabelImageGaussianResampleImageFilter
+ * \brief Resample a multi-label image, voting for the label of each output
+ * pixel with Gaussian weights.
+ *
+ * This filter resamples a label image like a ResampleImageFilter whose
+ * interpolator is a LabelImageGaussianInterpolateImageFunction, with the
+ * same output: each output pixel is the label whose Gaussian-weighted count
+ * in the neighborhood of the mapped position is largest. Sigma and Alpha
+ * are those of the interpolator.
+ *
+ * Rather than evaluating the interpolator at each output pixel, the filter
+ * votes for all the labels of the neighborhood in a single pass over the
+ * input buffer, accumulating the weights of the labels in a compact array
+ * that is reused from one pixel to the next. When the transform maps the
+ * axes of the output grid onto the axes of the input grid (see
+ * ResampleImageFilter::ComputeAxisAlignedIndexSteps()), the error-function
+ * weights of each output row, column and slice are computed once, before
+ * the threads run, instead of once per output pixel.
+ *
+ * The filter falls back to the resampling of the superclass when another
+ * interpolator or an extrapolator is set, or when the input or the output
+ * is a SpecialCoordinatesImage.
+ *
+ * \sa LabelImageGaussianInterpolateImageFunction
+ * \sa ResampleImageFilter
+ *
+ * \ingroup GeometricTransform
+ * \ingroup ITKImageGrid
+ */
+template <typename TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TInterpolatorPrecisionType = double,
+          typename TTransformPrecisionType = TInterpolatorPrecisionType>
+class ITK_TEMPLATE_EXPORT LabelImageGaussianResampleImageFilter
+  : public ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LabelImageGaussianResampleImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = LabelImageGaussianResampleImageFilter;
+  using Superclass =
+    ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(LabelImageGaussianResampleImageFilter);
+
+  static constexpr unsigned int InputImageDimension = Superclass::InputImageDimension;
+  static constexpr unsigned int OutputImageDimension = Superclass::OutputImageDimension;
+
+  using typename Superclass::InputImageType;
+  using typename Superclass::OutputImageType;
+  using typename Superclass::InputImageRegionType;
+  using typename Superclass::OutputImageRegionType;
+  using typename Superclass::InputPixelType;
+  using typename Superclass::PixelType;
+  using typename Superclass::IndexType;
+  using typename Superclass::TransformType;
+  using typename Superclass::ContinuousInputIndexType;
+
+  /** The interpolator whose output the filter computes. */
+  using LabelInterpolatorType = LabelImageGaussianInterpolateImageFunction<TInputImage, TInterpolatorPrecisionType>;
+  using RealType = typename LabelInterpolatorType::RealType;
+  using ArrayType = typename LabelInterpolatorType::ArrayType;
+
+  /** Set/Get the standard deviations of the Gaussian, in physical units. Forwarded to the interpolator. */
+  void
+  SetSigma(const ArrayType & sigma)
+  {
+    m_LabelInterpolator->SetSigma(sigma);
+  }
+  ArrayType
+  GetSigma() const
+  {
+    return m_LabelInterpolator->GetSigma();
+  }
+
+  /** Set/Get the cutoff distance of the Gaussian, in standard deviations. Forwarded to the interpolator. */
+  void
+  SetAlpha(const RealType alpha)
+  {
+    m_LabelInterpolator->SetAlpha(alpha);
+  }
+  RealType
+  GetAlpha() const
+  {
+    return m_LabelInterpolator->GetAlpha();
+  }
+
+protected:
+  LabelImageGaussianResampleImageFilter();
+  ~LabelImageGaussianResampleImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Computes the weight tables, when the transform maps the axes of the output grid onto the axes of the input
+   * grid. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  AfterThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  /** The region of the input buffer in the neighborhood of a position, along a dimension, and the weights of its
+   * indices, like GaussianInterpolateImageFunction::ComputeInterpolationRegion() and
+   * GaussianInterpolateImageFunction::ComputeErrorFunctionArray(). */
+  void
+  ComputeWeights(unsigned int     dimension,
+                 double           continuousIndex,
+                 IndexValueType & regionIndex,
+                 SizeValueType &  regionSize,
+                 RealType *       weights) const;
+
+  /** The weights accumulated by each label of a neighborhood. */
+  struct LabelVotes
+  {
+    std::vector<InputPixelType> m_Labels;
+    std::vector<RealType>       m_Weights;
+  };
+
+  /** Returns the label with the largest weight in the input region, whose indices along each dimension d are
+   * weighted by weights[d]. */
+  InputPixelType
+  VoteLabel(const InputImageRegionType & region, const RealType * const * weights, LabelVotes & votes) const;
+
+  /** The weights of the neighborhood along a dimension, for each index of the output requested region along that
+   * dimension: whether it is mapped inside the input buffer, and the region and weights of its neighborhood. */
+  struct WeightTable
+  {
+    IndexValueType              m_StartIndex{};
+    SizeValueType               m_MaximumRegionSize{};
+    std::vector<bool>           m_IsInside;
+    std::vector<IndexValueType> m_RegionIndices;
+    std::vector<SizeValueType>  m_RegionSizes;
+    std::vector<RealType>       m_Weights;
+  };
+
+  typename LabelInterpolatorType::Pointer m_LabelInterpolator{};
+
+  // Whether the label interpolator is used, and the filter votes in one pass. Set by BeforeThreadedGenerateData().
+  bool m_VoteInOnePass{ false };
+
+  // The constants of the weights of LabelImageGaussianInterpolateImageFunction, along each dimension.
+  ArrayType     m_BoundingBoxStart{};
+  ArrayType     m_ScalingFactor{};
+  ArrayType     m_CutOffDistance{};
+  SizeValueType m_MaximumRegionSize{};
+
+  std::vector<WeightTable> m_WeightTables{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLabelImageGaussianResampleImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,439 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelImageGaussianResampleImageFilter_hxx
+#define itkLabelImageGaussianResampleImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkMath.h"
+#include "itkSpecialCoordinatesImage.h"
+#include "itkTotalProgressReporter.h"
+#include "vnl/vnl_erf.h"
+
+#include <algorithm> // For max and min.
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  LabelImageGaussianResampleImageFilter()
+  : m_LabelInterpolator(LabelInterpolatorType::New())
+{
+  this->SetInterpolator(m_LabelInterpolator);
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  using OutputSpecialCoordinatesImageType = SpecialCoordinatesImage<PixelType, OutputImageDimension>;
+  using InputSpecialCoordinatesImageType = SpecialCoordinatesImage<InputPixelType, InputImageDimension>;
+
+  const InputImageType *  inputPtr = this->GetInput();
+  const OutputImageType * outputPtr = this->GetOutput();
+
+  m_WeightTables.clear();
+  m_VoteInOnePass = this->GetInterpolator() == m_LabelInterpolator.GetPointer() && !this->GetExtrapolator() &&
+                    dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) == nullptr &&
+                    dynamic_cast<const OutputSpecialCoordinatesImageType *>(outputPtr) == nullptr;
+  if (!m_VoteInOnePass)
+  {
+    return;
+  }
+
+  // The constants of GaussianInterpolateImageFunction::ComputeBoundingBox().
+  const typename InputImageType::SpacingType & spacing = inputPtr->GetSpacing();
+  const IndexType &                            largestIndex = inputPtr->GetLargestPossibleRegion().GetIndex();
+  const ArrayType                              sigma = m_LabelInterpolator->GetSigma();
+  const RealType                               alpha = m_LabelInterpolator->GetAlpha();
+  m_MaximumRegionSize = 0;
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    m_BoundingBoxStart[d] = largestIndex[d] - 0.5;
+    m_ScalingFactor[d] = 1.0 / (Math::sqrt2 * sigma[d] / spacing[d]);
+    m_CutOffDistance[d] = sigma[d] * alpha / spacing[d];
+
+    // The neighborhood [floor(x + 0.5 - c), ceil(x + 0.5 + c)) has at most ceil(2 c) + 1 indices.
+    m_MaximumRegionSize =
+      std::max(m_MaximumRegionSize, static_cast<SizeValueType>(std::ceil(2.0 * m_CutOffDistance[d])) + 2);
+  }
+
+  FixedArray<double, InputImageDimension> steps;
+  if (!this->ComputeAxisAlignedIndexSteps(this->GetEvaluationTransform(), steps))
+  {
+    return;
+  }
+
+  const TransformType * transformPtr = this->GetEvaluationTransform();
+  const auto            transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+    return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+      transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+  };
+
+  const OutputImageRegionType & requestedRegion = outputPtr->GetRequestedRegion();
+
+  m_WeightTables.resize(InputImageDimension);
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    const auto length = static_cast<SizeValueType>(requestedRegion.GetSize(d));
+
+    WeightTable & table = m_WeightTables[d];
+    table.m_StartIndex = requestedRegion.GetIndex(d);
+    table.m_MaximumRegionSize = m_MaximumRegionSize;
+    table.m_IsInside.assign(length, false);
+    table.m_RegionIndices.assign(length, 0);
+    table.m_RegionSizes.assign(length, 0);
+    table.m_Weights.assign(length * m_MaximumRegionSize, 0.0);
+
+    IndexType index = requestedRegion.GetIndex();
+    for (SizeValueType i = 0; i < length; ++i, ++index[d])
+    {
+      const double x = transformIndex(index)[d];
+      if (x >= m_LabelInterpolator->GetStartContinuousIndex()[d] && x < m_LabelInterpolator->GetEndContinuousIndex()[d])
+      {
+        table.m_IsInside[i] = true;
+        this->ComputeWeights(
+          d, x, table.m_RegionIndices[i], table.m_RegionSizes[i], &table.m_Weights[i * m_MaximumRegionSize]);
+      }
+    }
+  }
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  AfterThreadedGenerateData()
+{
+  m_WeightTables.clear();
+  Superclass::AfterThreadedGenerateData();
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeWeights(unsigned int     dimension,
+                 double           continuousIndex,
+                 IndexValueType & regionIndex,
+                 SizeValueType &  regionSize,
+                 RealType *       weights) const
+{
+  const InputImageRegionType & bufferedRegion = this->GetInput()->GetBufferedRegion();
+
+  const TInterpolatorPrecisionType cBegin = continuousIndex + 0.5 - m_CutOffDistance[dimension];
+  const TInterpolatorPrecisionType cEnd = continuousIndex + 0.5 + m_CutOffDistance[dimension];
+  const IndexValueType             begin =
+    std::max(bufferedRegion.GetIndex(dimension), static_cast<IndexValueType>(std::floor(cBegin)));
+  const IndexValueType end =
+    std::min(bufferedRegion.GetIndex(dimension) + static_cast<IndexValueType>(bufferedRegion.GetSize(dimension)),
+             static_cast<IndexValueType>(std::ceil(cEnd)));
+  regionIndex = begin;
+  regionSize = static_cast<SizeValueType>(std::max(end - begin, IndexValueType{ 0 }));
+  itkAssertInDebugAndIgnoreInReleaseMacro(regionSize <= m_MaximumRegionSize);
+
+  // The differences of the error function at the borders of the pixels, accumulated from the first pixel.
+  RealType t = (m_BoundingBoxStart[dimension] - static_cast<RealType>(continuousIndex) + static_cast<RealType>(begin)) *
+               m_ScalingFactor[dimension];
+  RealType eLast = vnl_erf(t);
+  for (SizeValueType i = 0; i < regionSize; ++i)
+  {
+    t += m_ScalingFactor[dimension];
+    const RealType eNow = vnl_erf(t);
+    weights[i] = eNow - eLast;
+    eLast = eNow;
+  }
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+auto
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  VoteLabel(const InputImageRegionType & region, const RealType * const * weights, LabelVotes & votes) const
+  -> InputPixelType
+{
+  votes.m_Labels.clear();
+  votes.m_Weights.clear();
+
+  const InputImageType *        inputPtr = this->GetInput();
+  const InputPixelType * const  buffer = inputPtr->GetBufferPointer();
+  const OffsetValueType * const offsetTable = inputPtr->GetOffsetTable();
+  const OffsetValueType         regionOffset = inputPtr->ComputeOffset(region.GetIndex());
+  const SizeValueType           lineLength = region.GetSize(0);
+
+  // Same traversal, products and running maximum as LabelImageGaussianInterpolateImageFunction, so that the labels
+  // are identical, ties included. Neighboring pixels mostly share their label, so the label of the previous pixel is
+  // looked up first.
+  RealType                                       maximumWeight = 0.0;
+  InputPixelType                                 maximumLabel{};
+  size_t                                         current = 0;
+  std::array<SizeValueType, InputImageDimension> k{};
+  while (true)
+  {
+    OffsetValueType lineOffset = regionOffset;
+    for (unsigned int d = 1; d < InputImageDimension; ++d)
+    {
+      lineOffset += static_cast<OffsetValueType>(k[d]) * offsetTable[d];
+    }
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      RealType w = weights[0][i];
+      for (unsigned int d = 1; d < InputImageDimension; ++d)
+      {
+        w *= weights[d][k[d]];
+      }
+
+      const InputPixelType label = buffer[lineOffset + static_cast<OffsetValueType>(i)];
+      if (current >= votes.m_Labels.size() || !(votes.m_Labels[current] == label))
+      {
+        current = std::find(votes.m_Labels.cbegin(), votes.m_Labels.cend(), label) - votes.m_Labels.cbegin();
+        if (current == votes.m_Labels.size())
+        {
+          votes.m_Labels.push_back(label);
+          votes.m_Weights.push_back(0.0);
+        }
+      }
+      RealType & labelWeight = votes.m_Weights[current];
+      labelWeight += w;
+      if (labelWeight > maximumWeight)
+      {
+        maximumWeight = labelWeight;
+        maximumLabel = label;
+      }
+    }
+
+    // Go to the next line
+    unsigned int d = 1;
+    for (; d < InputImageDimension && ++k[d] == region.GetSize(d); ++d)
+    {
+      k[d] = 0;
+    }
+    if (d >= InputImageDimension)
+    {
+      break;
+    }
+  }
+  return maximumLabel;
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  if (!m_VoteInOnePass)
+  {
+    Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  OutputImageType *      outputPtr = this->GetOutput();
+  const InputImageType * inputPtr = this->GetInput();
+  const TransformType *  transformPtr = this->GetEvaluationTransform();
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const PixelType     defaultValue = this->GetDefaultPixelValue();
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  const auto          votedPixel = [](const InputPixelType label) {
+    return Self::CastPixelWithBoundsChecking(static_cast<typename Superclass::ComponentType>(label));
+  };
+
+  LabelVotes                                        votes;
+  InputImageRegionType                              region;
+  std::array<const RealType *, InputImageDimension> weights{};
+
+  if (!m_WeightTables.empty())
+  {
+    // The weights of the output pixels are looked up in the tables.
+    for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+    {
+      IndexType index = outIt.GetIndex();
+      bool      isLineInside = true;
+      for (unsigned int d = 0; d < InputImageDimension; ++d)
+      {
+        const WeightTable & table = m_WeightTables[d];
+        const auto          i = static_cast<SizeValueType>(index[d] - table.m_StartIndex);
+        isLineInside = isLineInside && (d == 0 || table.m_IsInside[i]);
+        region.SetIndex(d, table.m_RegionIndices[i]);
+        region.SetSize(d, table.m_RegionSizes[i]);
+        weights[d] = &table.m_Weights[i * table.m_MaximumRegionSize];
+      }
+
+      const WeightTable & table = m_WeightTables[0];
+      for (; !outIt.IsAtEndOfLine(); ++outIt, ++index[0])
+      {
+        const auto i = static_cast<SizeValueType>(index[0] - table.m_StartIndex);
+        if (isLineInside && table.m_IsInside[i])
+        {
+          region.SetIndex(0, table.m_RegionIndices[i]);
+          region.SetSize(0, table.m_RegionSizes[i]);
+          weights[0] = &table.m_Weights[i * table.m_MaximumRegionSize];
+          outIt.Set(votedPixel(this->VoteLabel(region, weights.data(), votes)));
+        }
+        else
+        {
+          outIt.Set(defaultValue); // default background value
+        }
+      }
+      progress.Completed(lineLength);
+    }
+    return;
+  }
+
+  // Otherwise, the input continuous indices of the pixels of each scan line are computed like in the superclass, and
+  // the weights of each pixel are computed from them.
+  std::vector<RealType>                                weightBuffer(InputImageDimension * m_MaximumRegionSize);
+  std::vector<ContinuousInputIndexType>                inputIndices(lineLength);
+  std::vector<typename TransformType::InputPointType>  outputPoints;
+  std::vector<typename TransformType::OutputPointType> inputPoints;
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    weights[d] = &weightBuffer[d * m_MaximumRegionSize];
+  }
+
+  const OutputImageRegionType & largestPossibleRegion = outputPtr->GetLargestPossibleRegion();
+  const auto                    firstIndexValueOfLargestPossibleRegion = largestPossibleRegion.GetIndex(0);
+  const auto                    firstSizeValueOfLargestPossibleRegion =
+    static_cast<double>(largestPossibleRegion.GetSize(0));
+
+  const auto transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+    return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+      transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+  };
+
+  const bool isLinear = transformPtr->GetTransformCategory() == TransformType::TransformCategoryEnum::Linear;
+  if (!isLinear)
+  {
+    outputPoints.resize(lineLength);
+    inputPoints.resize(lineLength);
+  }
+
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+  {
+    IndexType index = outIt.GetIndex();
+    if (isLinear)
+    {
+      // Interpolate along the line between the mapped ends of the scan line of the largest possible region, like
+      // ResampleImageFilter::LinearThreadedGenerateData().
+      IndexValueType scanlineIndex = index[0];
+      index[0] = firstIndexValueOfLargestPossibleRegion;
+      const ContinuousInputIndexType startIndex = transformIndex(index);
+      index[0] += firstSizeValueOfLargestPossibleRegion;
+      const auto vectorFromStartIndex = transformIndex(index) - startIndex;
+      for (SizeValueType j = 0; j < lineLength; ++j, ++scanlineIndex)
+      {
+        const double alpha =
+          (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
+        inputIndices[j] = startIndex;
+        for (unsigned int d = 0; d < InputImageDimension; ++d)
+        {
+          inputIndices[j][d] += alpha * vectorFromStartIndex[d];
+        }
+      }
+    }
+    else
+    {
+      for (SizeValueType j = 0; j < lineLength; ++j, ++index[0])
+      {
+        typename Superclass::OutputPointType outputPoint;
+        outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+        outputPoints[j].CastFrom(outputPoint);
+      }
+      transformPtr->TransformPoints(outputPoints.data(), inputPoints.data(), lineLength);
+      for (SizeValueType j = 0; j < lineLength; ++j)
+      {
+        inputIndices[j] = inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+          typename Superclass::InputPointType(inputPoints[j]));
+      }
+    }
+
+    for (SizeValueType j = 0; j < lineLength; ++j, ++outIt)
+    {
+      const ContinuousInputIndexType & inputIndex = inputIndices[j];
+      if (m_LabelInterpolator->IsInsideBuffer(inputIndex))
+      {
+        for (unsigned int d = 0; d < InputImageDimension; ++d)
+        {
+          IndexValueType regionIndex;
+          SizeValueType  regionSize;
+          this->ComputeWeights(d, inputIndex[d], regionIndex, regionSize, &weightBuffer[d * m_MaximumRegionSize]);
+          region.SetIndex(d, regionIndex);
+          region.SetSize(d, regionSize);
+        }
+        outIt.Set(votedPixel(this->VoteLabel(region, weights.data(), votes)));
+      }
+      else
+      {
+        outIt.Set(defaultValue); // default background value
+      }
+    }
+    progress.Completed(lineLength);
+  }
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+LabelImageGaussianResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(LabelInterpolator);
+  itkPrintSelfBooleanMacro(VoteInOnePass);
+  os << indent << "BoundingBoxStart: " << m_BoundingBoxStart << std::endl;
+  os << indent << "ScalingFactor: " << m_ScalingFactor << std::endl;
+  os << indent << "CutOffDistance: " << m_CutOffDistance << std::endl;
+  os << indent << "MaximumRegionSize: " << m_MaximumRegionSize << std::endl;
+  os << indent << "WeightTables: " << m_WeightTables.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
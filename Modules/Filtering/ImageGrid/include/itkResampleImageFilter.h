@@ -28,6 +28,8 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
 
+#include <vector>
+
 
 namespace itk
 {
@@ -55,6 +57,22 @@ namespace itk
  * to use a default pixel value.  If different behavior is desired, an
  * extrapolator function can be set with SetExtrapolator().
  *
+ * When the transform maps the axes of the output grid onto the axes of the
+ * input grid, e.g. for a scaling and a translation with the same direction
+ * as the input image, like when changing the spacing of an image, and the
+ * interpolator has a separable kernel (e.g. LinearInterpolateImageFunction,
+ * BSplineInterpolateImageFunction and WindowedSincInterpolateImageFunction,
+ * see InterpolateImageFunction::GetSeparableKernelRadius()), the filter can
+ * compute the kernel weights once per output row, column and slice, and
+ * apply them one dimension at a time, rather than evaluating the
+ * interpolator at each output pixel. This requires scalar pixels and no
+ * extrapolator, and is turned on with UseSeparableResamplingOn(). The output
+ * then only differs from the output of the evaluation per pixel by rounding
+ * errors.
+ * With AntiAliasingOn(), the kernel of this separable resampling is also
+ * stretched by the downsampling factor along each dimension, so that it
+ * low-pass filters the image before sampling it.
+ *
  * Output information (spacing, size and direction) for the output
  * image should be set. This information has the normal defaults of
  * unit spacing, zero origin and identity direction. Optionally, the
@@ -270,6 +288,33 @@ public:
   itkBooleanMacro(UseReferenceImage);
   itkGetConstMacro(UseReferenceImage, bool);
 
+  /** Turn on/off the separable resampling, used when the transform maps the
+   * axes of the output grid onto the axes of the input grid and the
+   * interpolator has a separable kernel. Off by default. */
+  itkSetMacro(UseSeparableResampling, bool);
+  itkBooleanMacro(UseSeparableResampling);
+  itkGetConstMacro(UseSeparableResampling, bool);
+
+  /** Turn on/off the stretching of the kernel of the separable resampling by
+   * the downsampling factor of each dimension, to avoid aliasing. Has no
+   * effect when the image is not resampled separably. Off by default. */
+  itkSetMacro(AntiAliasing, bool);
+  itkBooleanMacro(AntiAliasing);
+  itkGetConstMacro(AntiAliasing, bool);
+
+  /** Turn on/off the evaluation of a copy of a CompositeTransform in which
+   * each run of consecutive linear transforms is collapsed into a single
+   * matrix and offset (see CompositeTransform::CreateLinearlyCollapsedTransform()).
+   * A composite of linear transforms is then resampled through the linear
+   * path. The points are then mapped by the product of the matrices rather
+   * than by each matrix in turn, so the output may differ from the output
+   * without collapsing by floating point rounding errors, which may in turn
+   * change the pixel selected by a nearest neighbor interpolator at the
+   * boundary between two pixels. Off by default. */
+  itkSetMacro(CollapseCompositeTransform, bool);
+  itkBooleanMacro(CollapseCompositeTransform);
+  itkGetConstMacro(CollapseCompositeTransform, bool);
+
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<PixelComponentType>));
 
 protected:
@@ -305,7 +350,10 @@ protected:
 
   /** Set up state of filter before multi-threading.
    * InterpolatorType::SetInputImage is not thread-safe and hence
-   * has to be set up before DynamicThreadedGenerateData */
+   * has to be set up before DynamicThreadedGenerateData.
+   * With CollapseCompositeTransformOn() and a CompositeTransform, the threads
+   * evaluate a copy of it in which consecutive linear transforms are
+   * collapsed into one. */
   void
   BeforeThreadedGenerateData() override;
 
@@ -340,6 +388,25 @@ protected:
   virtual void
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
+  /** Implementation for resampling with the separable kernel of the
+   * interpolator, when the transform maps the axes of the output grid onto
+   * the axes of the input grid. */
+  virtual void
+  SeparableThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
+
+  /** Computes, for each dimension, the step along the same dimension of the input continuous index per output index,
+   * and returns true, when the transform maps the axes of the output grid onto the axes of the input grid. */
+  bool
+  ComputeAxisAlignedIndexSteps(const TransformType * transform, FixedArray<double, InputImageDimension> & steps) const;
+
+  /** Get the transform evaluated by the threads. Only set between BeforeThreadedGenerateData() and
+   * AfterThreadedGenerateData(). */
+  const TransformType *
+  GetEvaluationTransform() const
+  {
+    return m_EvaluationTransform;
+  }
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** Cast pixel from interpolator output to PixelType. */
   itkLegacyMacro(virtual PixelType CastPixelWithBoundsChecking(const InterpolatorOutputType value,
@@ -347,7 +414,7 @@ protected:
                                                                const ComponentType          maxComponent) const;)
 #endif
 
-private:
+  /** Cast an interpolated value to PixelType, clamping its components to the range of PixelComponentType. */
   static PixelComponentType
   CastComponentWithBoundsChecking(const PixelComponentType value);
 
@@ -362,9 +429,27 @@ private:
   static PixelType
   CastPixelWithBoundsChecking(const TPixel value);
 
+private:
   void
   InitializeTransform();
 
+  /** Interpolates the input at the continuous indices of the pixels of an output scan line. Each run of consecutive
+   * indices inside the input buffer is passed to the interpolator as a single batch. The indices outside the buffer
+   * are passed to the extrapolator, if any. */
+  void
+  InterpolateScanline(const std::vector<ContinuousInputIndexType> & inputIndices,
+                      const std::vector<bool> &                     isInside,
+                      std::vector<InterpolatorOutputType> &         values) const;
+
+  /** Computes the steps of ComputeAxisAlignedIndexSteps(), and returns true, when the separable resampling applies to
+   * the transform. */
+  bool
+  ComputeSeparableIndexSteps(const TransformType * transform, FixedArray<double, InputImageDimension> & steps) const;
+
+  /** Computes the kernel tables of the separable resampling, when it applies. */
+  void
+  InitializeSeparableKernelTables();
+
   SizeType                m_Size{};         // Size of the output image
   InterpolatorPointerType m_Interpolator{}; // Image function for
                                             // interpolation
@@ -378,6 +463,28 @@ private:
   DirectionType   m_OutputDirection{};      // output image direction cosines
   IndexType       m_OutputStartIndex{};     // output image start index
   bool            m_UseReferenceImage{ false };
+  bool            m_UseSeparableResampling{ false };
+  bool            m_AntiAliasing{ false };
+  bool            m_CollapseCompositeTransform{ false };
+
+  // The transform evaluated by the threads: the transform, with the consecutive linear transforms of a composite
+  // transform collapsed. Only set during the generation of the data.
+  typename TransformType::ConstPointer m_EvaluationTransform{};
+
+  // The separable kernel of the interpolator along a dimension, for each index of the output requested region along
+  // that dimension: whether it is mapped inside the input buffer, and the input indices and weights of its samples.
+  struct SeparableKernelTable
+  {
+    IndexValueType              m_StartIndex{};
+    unsigned int                m_NumberOfSamples{};
+    std::vector<bool>           m_IsInside{};
+    std::vector<IndexValueType> m_Indices{};
+    std::vector<double>         m_Weights{};
+  };
+
+  // The kernel tables of each dimension when the separable resampling applies, empty otherwise. Only set during the
+  // generation of the data.
+  std::vector<SeparableKernelTable> m_SeparableKernelTables{};
 };
 } // end namespace itk
 
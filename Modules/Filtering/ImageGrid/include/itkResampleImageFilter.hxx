@@ -20,15 +20,19 @@
 
 #include "itkObjectFactory.h"
 #include "itkIdentityTransform.h"
+#include "itkCompositeTransform.h"
 #include "itkTotalProgressReporter.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
 
 #include <algorithm>   // For max.
+#include <cmath>
 #include <type_traits> // For is_same.
+#include <vector>
 
 namespace itk
 {
@@ -165,12 +169,28 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   m_Interpolator->SetInputImage(this->GetInput());
 
+  // With CollapseCompositeTransform on, evaluate a single matrix per run of consecutive linear transforms of a
+  // composite transform, rather than each of them. When all its transforms are linear, this also enables the linear
+  // fast path.
+  m_EvaluationTransform = this->GetTransform();
+  if constexpr (InputImageDimension == OutputImageDimension)
+  {
+    using CompositeTransformType = CompositeTransform<TTransformPrecisionType, OutputImageDimension>;
+    const auto * compositeTransform = dynamic_cast<const CompositeTransformType *>(this->GetTransform());
+    if (m_CollapseCompositeTransform && compositeTransform)
+    {
+      m_EvaluationTransform = compositeTransform->CreateLinearlyCollapsedTransform().GetPointer();
+    }
+  }
+
   // Connect input image to extrapolator
   if (!m_Extrapolator.IsNull())
   {
     m_Extrapolator->SetInputImage(this->GetInput());
   }
 
+  this->InitializeSeparableKernelTables();
+
   unsigned int nComponents = DefaultConvertPixelTraits<PixelType>::GetNumberOfComponents(m_DefaultPixelValue);
 
   if (nComponents == 0)
@@ -194,6 +214,9 @@ void
 ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
   AfterThreadedGenerateData()
 {
+  m_EvaluationTransform = nullptr;
+  m_SeparableKernelTables.clear();
+
   // Disconnect input image from the interpolator
   m_Interpolator->SetInputImage(nullptr);
   if (!m_Extrapolator.IsNull())
@@ -222,6 +245,12 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     return;
   }
 
+  if (!m_SeparableKernelTables.empty())
+  {
+    this->SeparableThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
   const bool isSpecialCoordinatesImage =
     ((dynamic_cast<const InputSpecialCoordinatesImageType *>(this->GetInput()) != nullptr) ||
      (dynamic_cast<const OutputSpecialCoordinatesImageType *>(this->GetOutput()) != nullptr));
@@ -231,7 +260,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   // can be used if the transformation is linear. Transform respond
   // to the IsLinear() call.
   if (!isSpecialCoordinatesImage &&
-      this->GetTransform()->GetTransformCategory() == TransformType::TransformCategoryEnum::Linear)
+      m_EvaluationTransform->GetTransformCategory() == TransformType::TransformCategoryEnum::Linear)
   {
     this->LinearThreadedGenerateData(outputRegionForThread);
     return;
@@ -372,7 +401,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  const TransformType *  transformPtr = this->GetTransform();
+  const TransformType *  transformPtr = m_EvaluationTransform;
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
@@ -382,45 +411,51 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
-
-  using OutputType = typename InterpolatorType::OutputType;
+  // The points of each scan line are mapped by a single call to the transform, which avoids a virtual call per pixel
+  // and lets transforms like BSplineTransform share work between the points. Likewise for the interpolator.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> inputPoints(lineLength);
+  std::vector<ContinuousInputIndexType>                inputIndices(lineLength);
+  std::vector<bool>                                    isInside(lineLength);
+  std::vector<InterpolatorOutputType>                  values(lineLength);
 
   // Walk the output region
-  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
-
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
+    // Determine the coordinates of the output pixels of the line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < lineLength; ++i, ++index[0])
+    {
+      OutputPointType outputPoint; // Coordinates of current output pixel
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+      outputPoints[i].CastFrom(outputPoint);
+    }
 
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), inputPoints.data(), lineLength);
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
+    for (SizeValueType i = 0; i < lineLength; ++i)
     {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      const InputPointType inputPoint(inputPoints[i]);
+      const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndices[i]);
+      isInside[i] = m_Interpolator->IsInsideBuffer(inputIndices[i]) && (!isSpecialCoordinatesImage || isInsideInput);
     }
-    else
+
+    // Evaluate input at right position and copy to the output
+    this->InterpolateScanline(inputIndices, isInside, values);
+    for (SizeValueType i = 0; i < lineLength; ++i, ++outIt)
     {
-      if (m_Extrapolator.IsNull())
+      if (isInside[i] || m_Extrapolator)
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        outIt.Set(Self::CastPixelWithBoundsChecking(values[i]));
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        outIt.Set(m_DefaultPixelValue); // default background value
       }
     }
-    progress.CompletedPixel();
+    progress.Completed(lineLength);
   }
 }
 
@@ -434,7 +469,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  const TransformType *  transformPtr = this->GetTransform();
+  const TransformType *  transformPtr = m_EvaluationTransform;
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
@@ -464,6 +499,11 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  const SizeValueType                   lineLength = outputRegionForThread.GetSize(0);
+  std::vector<ContinuousInputIndexType> inputIndices(lineLength);
+  std::vector<bool>                     isInside(lineLength);
+  std::vector<InterpolatorOutputType>   values(lineLength);
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -479,44 +519,370 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
     IndexValueType scanlineIndex = outIt.GetIndex()[0];
 
-
-    while (!outIt.IsAtEndOfLine())
+    for (SizeValueType j = 0; j < lineLength; ++j, ++scanlineIndex)
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-      ContinuousInputIndexType inputIndex(startIndex);
+      ContinuousInputIndexType & inputIndex = inputIndices[j];
+      inputIndex = startIndex;
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
+      isInside[j] = m_Interpolator->IsInsideBuffer(inputIndex);
+    }
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+    // Evaluate input at right position and copy to the output
+    this->InterpolateScanline(inputIndices, isInside, values);
+    for (SizeValueType j = 0; j < lineLength; ++j, ++outIt)
+    {
+      if (isInside[j] || m_Extrapolator)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        outIt.Set(Self::CastPixelWithBoundsChecking(values[j]));
       }
       else
       {
-        if (m_Extrapolator.IsNull())
+        outIt.Set(defaultValue); // default background value
+      }
+    }
+    progress.Completed(lineLength);
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  InterpolateScanline(const std::vector<ContinuousInputIndexType> & inputIndices,
+                      const std::vector<bool> &                     isInside,
+                      std::vector<InterpolatorOutputType> &         values) const
+{
+  const SizeValueType lineLength = inputIndices.size();
+  for (SizeValueType i = 0; i < lineLength;)
+  {
+    SizeValueType runEnd = i + 1;
+    while (runEnd < lineLength && isInside[runEnd] == isInside[i])
+    {
+      ++runEnd;
+    }
+    if (isInside[i])
+    {
+      m_Interpolator->EvaluateAtContinuousIndices(&inputIndices[i], &values[i], runEnd - i);
+    }
+    else if (m_Extrapolator)
+    {
+      for (SizeValueType j = i; j < runEnd; ++j)
+      {
+        values[j] = m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[j]);
+      }
+    }
+    i = runEnd;
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+bool
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeAxisAlignedIndexSteps(const TransformType * transform, FixedArray<double, InputImageDimension> & steps) const
+{
+  if constexpr (InputImageDimension == OutputImageDimension)
+  {
+    using OutputSpecialCoordinatesImageType = SpecialCoordinatesImage<PixelType, OutputImageDimension>;
+    using InputSpecialCoordinatesImageType = SpecialCoordinatesImage<InputPixelType, InputImageDimension>;
+
+    const OutputImageType * outputPtr = this->GetOutput();
+    const InputImageType *  inputPtr = this->GetInput();
+    if (transform->GetTransformCategory() != TransformType::TransformCategoryEnum::Linear ||
+        dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr ||
+        dynamic_cast<const OutputSpecialCoordinatesImageType *>(outputPtr) != nullptr)
+    {
+      return false;
+    }
+
+    const auto transformIndex = [outputPtr, transform, inputPtr](const IndexType & index) {
+      return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+        transform->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+    };
+
+    // Each output index must only move the input continuous index along the same dimension, up to a drift of a
+    // negligible fraction of a pixel over the largest possible region.
+    const OutputImageRegionType &  largestPossibleRegion = outputPtr->GetLargestPossibleRegion();
+    const ContinuousInputIndexType startIndex = transformIndex(largestPossibleRegion.GetIndex());
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      IndexType index = largestPossibleRegion.GetIndex();
+      ++index[d];
+      const auto step = transformIndex(index) - startIndex;
+      for (unsigned int e = 0; e < InputImageDimension; ++e)
+      {
+        if (e != d && !(std::abs(step[e]) * largestPossibleRegion.GetSize(d) <= 1e-4))
         {
-          outIt.Set(defaultValue); // default background value
+          return false;
         }
-        else
+      }
+      steps[d] = step[d];
+    }
+    return true;
+  }
+  else
+  {
+    (void)transform;
+    (void)steps;
+    return false;
+  }
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+bool
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  ComputeSeparableIndexSteps(const TransformType * transform, FixedArray<double, InputImageDimension> & steps) const
+{
+  if (!std::is_arithmetic_v<InputPixelType> || !m_UseSeparableResampling || m_Extrapolator ||
+      m_Interpolator->GetSeparableKernelRadius() <= 0.0)
+  {
+    return false;
+  }
+  return this->ComputeAxisAlignedIndexSteps(transform, steps);
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  InitializeSeparableKernelTables()
+{
+  m_SeparableKernelTables.clear();
+
+  FixedArray<double, InputImageDimension> steps;
+  if (!this->ComputeSeparableIndexSteps(m_EvaluationTransform, steps))
+  {
+    return;
+  }
+
+  const OutputImageType * outputPtr = this->GetOutput();
+  const InputImageType *  inputPtr = this->GetInput();
+  const TransformType *   transformPtr = m_EvaluationTransform;
+  const auto              transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+    return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+      transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+  };
+
+  const OutputImageRegionType & requestedRegion = outputPtr->GetRequestedRegion();
+  const double                  radius = m_Interpolator->GetSeparableKernelRadius();
+
+  m_SeparableKernelTables.resize(InputImageDimension);
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    // When downsampling with anti-aliasing, the kernel is stretched by the downsampling factor, and normalized.
+    const double stretch = m_AntiAliasing ? std::max(std::abs(steps[d]), 1.0) : 1.0;
+    const auto   halfNumberOfSamples = static_cast<IndexValueType>(std::ceil(radius * stretch));
+    const auto   numberOfSamples = static_cast<unsigned int>(2 * halfNumberOfSamples);
+    const auto   length = static_cast<SizeValueType>(requestedRegion.GetSize(d));
+
+    SeparableKernelTable & table = m_SeparableKernelTables[d];
+    table.m_StartIndex = requestedRegion.GetIndex(d);
+    table.m_NumberOfSamples = numberOfSamples;
+    table.m_IsInside.assign(length, false);
+    table.m_Indices.assign(length * numberOfSamples, m_Interpolator->GetStartIndex()[d]);
+    table.m_Weights.assign(length * numberOfSamples, 0.0);
+
+    IndexType index = requestedRegion.GetIndex();
+    for (SizeValueType i = 0; i < length; ++i, ++index[d])
+    {
+      const double x = transformIndex(index)[d];
+      if (!(x >= m_Interpolator->GetStartContinuousIndex()[d] && x < m_Interpolator->GetEndContinuousIndex()[d]))
+      {
+        continue;
+      }
+      table.m_IsInside[i] = true;
+
+      IndexValueType * indices = &table.m_Indices[i * numberOfSamples];
+      double *         weights = &table.m_Weights[i * numberOfSamples];
+      const auto       firstIndex = Math::Floor<IndexValueType>(x) - halfNumberOfSamples + 1;
+      double           sumOfWeights = 0.0;
+      for (unsigned int j = 0; j < numberOfSamples; ++j)
+      {
+        const IndexValueType sampleIndex = firstIndex + static_cast<IndexValueType>(j);
+        indices[j] = m_Interpolator->ApplySeparableKernelBoundaryCondition(d, sampleIndex);
+        weights[j] = m_Interpolator->EvaluateSeparableKernel((x - sampleIndex) / stretch);
+        sumOfWeights += weights[j];
+      }
+      if (stretch > 1.0 && sumOfWeights != 0.0)
+      {
+        for (unsigned int j = 0; j < numberOfSamples; ++j)
+        {
+          weights[j] /= sumOfWeights;
+        }
+      }
+    }
+  }
+}
+
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  SeparableThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  if constexpr (InputImageDimension != OutputImageDimension || !std::is_arithmetic_v<InputPixelType>)
+  {
+    itkExceptionMacro("The separable resampling requires scalar pixels, and images of the same dimension.");
+  }
+  else
+  {
+    OutputImageType * outputPtr = this->GetOutput();
+
+    TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+    // The input region covering the samples of the output pixels of the region that are mapped inside the input buffer.
+    InputImageRegionType inputRegion;
+    bool                 isInside = true;
+    for (unsigned int d = 0; d < InputImageDimension && isInside; ++d)
+    {
+      const SeparableKernelTable & table = m_SeparableKernelTables[d];
+      const auto                   first =
+        static_cast<SizeValueType>(outputRegionForThread.GetIndex(d) - table.m_StartIndex);
+      IndexValueType minIndex = NumericTraits<IndexValueType>::max();
+      IndexValueType maxIndex = NumericTraits<IndexValueType>::min();
+      for (SizeValueType i = first; i < first + outputRegionForThread.GetSize(d); ++i)
+      {
+        if (table.m_IsInside[i])
+        {
+          const auto samples = table.m_Indices.cbegin() + i * table.m_NumberOfSamples;
+          const auto [minSample, maxSample] = std::minmax_element(samples, samples + table.m_NumberOfSamples);
+          minIndex = std::min(minIndex, *minSample);
+          maxIndex = std::max(maxIndex, *maxSample);
+        }
+      }
+      isInside = minIndex <= maxIndex;
+      inputRegion.SetIndex(d, minIndex);
+      inputRegion.SetSize(d, static_cast<SizeValueType>(maxIndex - minIndex + 1));
+    }
+
+    if (!isInside)
+    {
+      for (ImageRegionIterator<OutputImageType> outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+      {
+        outIt.Set(m_DefaultPixelValue);
+      }
+      progress.Completed(outputRegionForThread.GetNumberOfPixels());
+      return;
+    }
+
+    // Resample the samples of the input region one dimension at a time: after the pass of a dimension, the buffer
+    // holds the values of the output region along that dimension and the previous ones, and of the input region along
+    // the next ones, with the first dimension varying fastest.
+    std::vector<InterpolatorOutputType> values;
+    values.reserve(inputRegion.GetNumberOfPixels());
+    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(inputRegion))
+    {
+      values.push_back(m_Interpolator->GetSeparableKernelSample(index));
+    }
+
+    std::vector<InterpolatorOutputType> resampledValues;
+    typename InputImageType::SizeType   bufferSize;
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      bufferSize[d] = inputRegion.GetSize(d);
+    }
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      const SeparableKernelTable & table = m_SeparableKernelTables[d];
+      const auto                   first =
+        static_cast<SizeValueType>(outputRegionForThread.GetIndex(d) - table.m_StartIndex);
+      const SizeValueType          outputLength = outputRegionForThread.GetSize(d);
+      const SizeValueType          inputLength = bufferSize[d];
+      SizeValueType                innerSize = 1;
+      SizeValueType                outerSize = 1;
+      for (unsigned int e = 0; e < d; ++e)
+      {
+        innerSize *= bufferSize[e];
+      }
+      for (unsigned int e = d + 1; e < InputImageDimension; ++e)
+      {
+        outerSize *= bufferSize[e];
+      }
+
+      resampledValues.assign(outerSize * outputLength * innerSize, InterpolatorOutputType{});
+      for (SizeValueType outer = 0; outer < outerSize; ++outer)
+      {
+        const InterpolatorOutputType * const inputLine = values.data() + outer * inputLength * innerSize;
+        InterpolatorOutputType * const       outputLine = resampledValues.data() + outer * outputLength * innerSize;
+        for (SizeValueType i = 0; i < outputLength; ++i)
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          if (!table.m_IsInside[first + i])
+          {
+            continue;
+          }
+          InterpolatorOutputType * const output = outputLine + i * innerSize;
+          for (unsigned int j = 0; j < table.m_NumberOfSamples; ++j)
+          {
+            const SizeValueType sample = (first + i) * table.m_NumberOfSamples + j;
+            const double        weight = table.m_Weights[sample];
+            // Skipping the samples of zero weight also avoids turning infinite samples into NaN.
+            if (weight == 0.0)
+            {
+              continue;
+            }
+            const InterpolatorOutputType * const input =
+              inputLine + (table.m_Indices[sample] - inputRegion.GetIndex(d)) * innerSize;
+            for (SizeValueType n = 0; n < innerSize; ++n)
+            {
+              output[n] += weight * input[n];
+            }
+          }
         }
       }
+      values.swap(resampledValues);
+      bufferSize[d] = outputLength;
+    }
 
-      ++outIt;
-      ++scanlineIndex;
+    // The buffer holds the output region, in the order of the iterator.
+    auto valueIt = values.cbegin();
+    for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+    {
+      bool isLineInside = true;
+      for (unsigned int d = 1; d < InputImageDimension; ++d)
+      {
+        const SeparableKernelTable & table = m_SeparableKernelTables[d];
+        isLineInside = isLineInside && table.m_IsInside[outIt.GetIndex()[d] - table.m_StartIndex];
+      }
+      const SeparableKernelTable & table = m_SeparableKernelTables[0];
+      for (auto i = static_cast<SizeValueType>(outIt.GetIndex()[0] - table.m_StartIndex); !outIt.IsAtEndOfLine();
+           ++outIt, ++valueIt, ++i)
+      {
+        if (isLineInside && table.m_IsInside[i])
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(*valueIt));
+        }
+        else
+        {
+          outIt.Set(m_DefaultPixelValue);
+        }
+      }
     }
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(outputRegionForThread.GetNumberOfPixels());
   }
 }
 
+
 template <typename TInputImage,
           typename TOutputImage,
           typename TInterpolatorPrecisionType,
@@ -565,7 +931,17 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       // Input requested region is partially outside the largest possible region.
       //   or
       // Input requested region is completely inside the largest possible region.
-      inputRequestedRegion.PadByRadius(m_Interpolator->GetRadius());
+      auto radius = m_Interpolator->GetRadius();
+      FixedArray<double, InputImageDimension> steps;
+      if (m_AntiAliasing && this->ComputeSeparableIndexSteps(transform, steps))
+      {
+        // The kernel of the separable resampling is stretched by the downsampling factor.
+        for (unsigned int d = 0; d < InputImageDimension; ++d)
+        {
+          radius[d] *= static_cast<SizeValueType>(std::ceil(std::max(std::abs(steps[d]), 1.0)));
+        }
+      }
+      inputRequestedRegion.PadByRadius(radius);
       inputRequestedRegion.Crop(inputLargestRegion);
       input->SetRequestedRegion(inputRequestedRegion);
     }
@@ -673,6 +1049,9 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   os << indent << "Interpolator: " << m_Interpolator.GetPointer() << std::endl;
   os << indent << "Extrapolator: " << m_Extrapolator.GetPointer() << std::endl;
   itkPrintSelfBooleanMacro(UseReferenceImage);
+  itkPrintSelfBooleanMacro(UseSeparableResampling);
+  itkPrintSelfBooleanMacro(AntiAliasing);
+  itkPrintSelfBooleanMacro(CollapseCompositeTransform);
 }
 } // end namespace itk
 
@@ -0,0 +1,188 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// The header file to be tested:
+#include "itkLabelImageGaussianResampleImageFilter.h"
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkScaleTransform.h"
+#include "itkTranslationTransform.h"
+#include "itkVersorRigid3DTransform.h"
+
+// Google Test header file:
+#include <gtest/gtest.h>
+
+// Standard C++ header files:
+#include <cmath>
+
+
+namespace
+{
+using ImageType = itk::Image<short, 3>;
+
+// Creates a label image of nested blobs, whose buffered region does not start at the origin.
+ImageType::Pointer
+CreateLabelImage()
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::IndexType{ { 2, -3, 1 } }, ImageType::SizeType{ { 24, 20, 12 } }));
+  image->SetSpacing(itk::MakeVector(0.8, 1.0, 1.5));
+  image->SetOrigin(itk::MakePoint(-4.0, 2.0, 1.0));
+  image->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<3>(image->GetBufferedRegion()))
+  {
+    const double x = index[0] - 13.5;
+    const double y = index[1] - 7.0;
+    const double z = index[2] - 7.0;
+    short        label = 0;
+    if (x * x + y * y + 2 * z * z < 60)
+    {
+      label = (x * y > 0) ? 7 : 3;
+    }
+    if (std::abs(x + y + z) < 1.5)
+    {
+      label = -2;
+    }
+    image->SetPixel(index, label);
+  }
+  return image;
+}
+
+
+// A transform that is not linear: a translation whose offset depends on the position.
+class WarpTransform : public itk::TranslationTransform<double, 3>
+{
+public:
+  using Self = WarpTransform;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  TransformCategoryEnum
+  GetTransformCategory() const override
+  {
+    return TransformCategoryEnum::DisplacementField;
+  }
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    OutputPointType result = point;
+    result[0] += 0.7 * std::sin(0.3 * point[1]);
+    result[1] += 0.5 * std::cos(0.2 * point[2] + 0.1 * point[0]);
+    result[2] += 0.1 * point[0];
+    return result;
+  }
+};
+
+
+// Expects the filter to produce the same labels as a ResampleImageFilter with a
+// LabelImageGaussianInterpolateImageFunction.
+void
+Expect_same_labels_as_interpolator(const itk::Transform<double, 3, 3> * transform,
+                                   const ImageType::SpacingType &       outputSpacing,
+                                   const ImageType::SizeType &          outputSize)
+{
+  const auto image = CreateLabelImage();
+
+  const auto filter = itk::LabelImageGaussianResampleImageFilter<ImageType>::New();
+  filter->SetInput(image);
+  filter->SetTransform(transform);
+  filter->SetOutputOrigin(itk::MakePoint(-5.0, 1.0, 2.0));
+  filter->SetOutputSpacing(outputSpacing);
+  filter->SetSize(outputSize);
+  filter->SetSigma(itk::MakeFilled<itk::FixedArray<double, 3>>(1.2));
+  filter->SetAlpha(2.5);
+  filter->SetDefaultPixelValue(99);
+
+  const auto interpolator = itk::LabelImageGaussianInterpolateImageFunction<ImageType, double>::New();
+  interpolator->SetSigma(filter->GetSigma());
+  interpolator->SetAlpha(filter->GetAlpha());
+  const auto referenceFilter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+  referenceFilter->SetInput(image);
+  referenceFilter->SetTransform(transform);
+  referenceFilter->SetInterpolator(interpolator);
+  referenceFilter->SetOutputOrigin(filter->GetOutputOrigin());
+  referenceFilter->SetOutputSpacing(outputSpacing);
+  referenceFilter->SetSize(outputSize);
+  referenceFilter->SetDefaultPixelValue(99);
+
+  filter->Update();
+  referenceFilter->Update();
+
+  const ImageType * output = filter->GetOutput();
+  const ImageType * referenceOutput = referenceFilter->GetOutput();
+  ASSERT_EQ(output->GetBufferedRegion(), referenceOutput->GetBufferedRegion());
+
+  size_t numberOfForegroundPixels = 0;
+  size_t numberOfDefaultPixels = 0;
+  for (const auto & index : itk::ImageRegionIndexRange<3>(output->GetBufferedRegion()))
+  {
+    EXPECT_EQ(output->GetPixel(index), referenceOutput->GetPixel(index)) << "Index " << index;
+    numberOfForegroundPixels += (output->GetPixel(index) != 0 && output->GetPixel(index) != 99);
+    numberOfDefaultPixels += (output->GetPixel(index) == 99);
+  }
+
+  // Both the labels and the background are resampled.
+  EXPECT_GT(numberOfForegroundPixels, 0u);
+  EXPECT_GT(numberOfDefaultPixels, 0u);
+}
+} // namespace
+
+
+// The transform maps the axes of the output grid onto the axes of the input grid, so the weights are tabulated.
+TEST(LabelImageGaussianResampleImageFilter, ResamplesLikeInterpolatorAlongAxes)
+{
+  const auto transform = itk::ScaleTransform<double, 3>::New();
+  transform->SetScale(itk::MakeVector(1.1, 0.9, 1.3));
+  Expect_same_labels_as_interpolator(transform, itk::MakeVector(0.5, 0.7, 1.1), ImageType::SizeType{ { 40, 30, 20 } });
+}
+
+
+TEST(LabelImageGaussianResampleImageFilter, ResamplesLikeInterpolatorWithRotation)
+{
+  const auto transform = itk::VersorRigid3DTransform<double>::New();
+  transform->SetCenter(itk::MakePoint(5.0, 10.0, 10.0));
+  transform->SetRotation(itk::MakeVector(0.2, 0.3, 1.0), 0.4);
+  Expect_same_labels_as_interpolator(transform, itk::MakeVector(0.6, 0.6, 0.9), ImageType::SizeType{ { 36, 34, 22 } });
+}
+
+
+TEST(LabelImageGaussianResampleImageFilter, ResamplesLikeInterpolatorWithNonlinearTransform)
+{
+  Expect_same_labels_as_interpolator(
+    WarpTransform::New(), itk::MakeVector(0.6, 0.8, 1.0), ImageType::SizeType{ { 36, 30, 20 } });
+}
+
+
+// With another interpolator, the filter resamples like its superclass.
+TEST(LabelImageGaussianResampleImageFilter, FallsBackToSuperclassWithOtherInterpolator)
+{
+  const auto image = CreateLabelImage();
+  const auto filter = itk::LabelImageGaussianResampleImageFilter<ImageType>::New();
+  filter->SetInput(image);
+  filter->SetInterpolator(itk::NearestNeighborInterpolateImageFunction<ImageType, double>::New());
+  filter->SetOutputParametersFromImage(image);
+  filter->Update();
+
+  for (const auto & index : itk::ImageRegionIndexRange<3>(image->GetBufferedRegion()))
+  {
+    EXPECT_EQ(filter->GetOutput()->GetPixel(index), image->GetPixel(index));
+  }
+}
@@ -19,12 +19,19 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkCompositeTransform.h"
 #include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkScaleTransform.h"
+#include "itkWindowedSincInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
 
 // Standard C++ header files:
+#include <cmath>
 #include <limits>
 #include <random>
 
@@ -111,6 +118,65 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// Resamples a 3D image with a scaling, a translation and a change of direction that keep the axes of the input
+// image, separably or not, and expects the same output. Part of the output is outside of the input image.
+template <typename TInterpolator>
+void
+Expect_separable_resampling_matches_resampling_per_pixel(TInterpolator & interpolator)
+{
+  using ImageType = itk::Image<float, 3>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(ImageType::IndexType{ { 2, -1, 0 } }, ImageType::SizeType{ { 23, 17, 9 } }));
+  image->SetSpacing(itk::MakeVector(1.0, 1.5, 2.0));
+  ImageType::DirectionType direction;
+  direction.Fill(0.0);
+  direction[0][0] = -1.0;
+  direction[1][1] = 1.0;
+  direction[2][2] = -1.0;
+  image->SetDirection(direction);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.4 * index[0]) * std::cos(0.3 * index[1]) + 0.1 * index[2] * index[0]));
+  }
+
+  auto transform = itk::ScaleTransform<double, 3>::New();
+  transform->SetScale(itk::MakeVector(0.8, 1.3, 1.1));
+  transform->SetCenter(itk::MakePoint(-3.0, 4.0, -2.0));
+
+  const auto resample = [&](bool useSeparableResampling) {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetInterpolator(&interpolator);
+    filter->SetTransform(transform);
+    filter->SetOutputOrigin(itk::MakePoint(-4.0, -3.0, 1.0));
+    filter->SetOutputSpacing(itk::MakeVector(0.7, 2.1, 1.3));
+    filter->SetOutputDirection(direction);
+    filter->SetSize(FilterType::SizeType{ { 31, 11, 14 } });
+    filter->SetDefaultPixelValue(-100.0f);
+    filter->SetUseSeparableResampling(useSeparableResampling);
+    filter->Update();
+    return ImageType::Pointer{ filter->GetOutput() };
+  };
+
+  const ImageType::Pointer expectedOutput = resample(false);
+  const ImageType::Pointer output = resample(true);
+
+  unsigned int numberOfDefaultPixels = 0;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const float expectedValue = expectedOutput->GetPixel(it.GetIndex());
+    EXPECT_NEAR(it.Get(), expectedValue, 1e-4) << interpolator.GetNameOfClass() << " at " << it.GetIndex();
+    numberOfDefaultPixels += (expectedValue == -100.0f);
+  }
+  EXPECT_GT(numberOfDefaultPixels, 0u);
+  EXPECT_LT(numberOfDefaultPixels, output->GetBufferedRegion().GetNumberOfPixels());
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -172,3 +238,154 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+TEST(ResampleImageFilter, SeparableResamplingMatchesResamplingPerPixel)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  Expect_separable_resampling_matches_resampling_per_pixel(*itk::LinearInterpolateImageFunction<ImageType>::New());
+
+  const auto bsplineInterpolator = itk::BSplineInterpolateImageFunction<ImageType>::New();
+  for (const unsigned int splineOrder : { 0u, 1u, 2u, 3u })
+  {
+    bsplineInterpolator->SetSplineOrder(splineOrder);
+    Expect_separable_resampling_matches_resampling_per_pixel(*bsplineInterpolator);
+  }
+
+  Expect_separable_resampling_matches_resampling_per_pixel(
+    *itk::WindowedSincInterpolateImageFunction<ImageType, 3>::New());
+}
+
+
+TEST(ResampleImageFilter, SeparableResamplingMatchesResamplingPerPixelHalfwayBetweenPixels)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 8, 6 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(it.GetIndex()[0] * it.GetIndex()[0] + 10 * it.GetIndex()[1]));
+  }
+
+  // The output pixels are halfway between the input pixels, where the kernel of order 0 changes from one pixel to the
+  // next, and the kernel of order 1 gives both pixels the same weight.
+  const auto interpolator = itk::BSplineInterpolateImageFunction<ImageType>::New();
+  for (const unsigned int splineOrder : { 0u, 1u })
+  {
+    interpolator->SetSplineOrder(splineOrder);
+
+    const auto resample = [&](bool useSeparableResampling) {
+      auto filter = FilterType::New();
+      filter->SetInput(image);
+      filter->SetInterpolator(interpolator);
+      filter->SetOutputOrigin(itk::MakePoint(0.5, 0.5));
+      filter->SetSize(FilterType::SizeType{ { 7, 5 } });
+      filter->SetUseSeparableResampling(useSeparableResampling);
+      filter->Update();
+      return ImageType::Pointer{ filter->GetOutput() };
+    };
+
+    const ImageType::Pointer expectedOutput = resample(false);
+    const ImageType::Pointer output = resample(true);
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      EXPECT_FLOAT_EQ(it.Get(), expectedOutput->GetPixel(it.GetIndex())) << splineOrder << " at " << it.GetIndex();
+    }
+
+    const ImageType::IndexType index{ { 2, 3 } };
+    EXPECT_FLOAT_EQ(output->GetPixel(index),
+                    splineOrder == 0 ? image->GetPixel({ { 3, 4 } })
+                                     : 0.25f * (image->GetPixel({ { 2, 3 } }) + image->GetPixel({ { 3, 3 } }) +
+                                                image->GetPixel({ { 2, 4 } }) + image->GetPixel({ { 3, 4 } })));
+  }
+}
+
+
+TEST(ResampleImageFilter, CollapsedCompositeTransformGivesSameOutput)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 16, 12 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(std::sin(0.5 * it.GetIndex()[0]) + 0.2 * it.GetIndex()[1]));
+  }
+
+  auto rotation = itk::AffineTransform<double, 2>::New();
+  rotation->Rotate2D(0.3);
+  auto scale = itk::ScaleTransform<double, 2>::New();
+  scale->SetScale(itk::MakeVector(1.2, 0.9));
+  scale->SetCenter(itk::MakePoint(5.0, 4.0));
+  auto compositeTransform = itk::CompositeTransform<double, 2>::New();
+  compositeTransform->AddTransform(rotation);
+  compositeTransform->AddTransform(scale);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetTransform(compositeTransform);
+  filter->SetSize(FilterType::SizeType{ { 16, 12 } });
+  EXPECT_FALSE(filter->GetCollapseCompositeTransform());
+  filter->Update();
+  const ImageType::Pointer expectedOutput = filter->GetOutput();
+  expectedOutput->DisconnectPipeline();
+
+  // The matrices are multiplied before the points are mapped, which only changes the rounding errors.
+  filter->CollapseCompositeTransformOn();
+  filter->Update();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_NEAR(it.Get(), expectedOutput->GetPixel(it.GetIndex()), 1e-5) << " at " << it.GetIndex();
+  }
+  EXPECT_EQ(compositeTransform->GetNumberOfTransforms(), 2u);
+}
+
+
+TEST(ResampleImageFilter, AntiAliasingSmoothsDownsampledImage)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  // A checkerboard, downsampled by a factor of 4: without anti-aliasing, the output samples single input pixels, with
+  // anti-aliasing, it is close to the mean of the checkerboard.
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 64 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set((it.GetIndex()[0] + it.GetIndex()[1]) % 2 == 0 ? 100.0f : 0.0f);
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetOutputOrigin(itk::MakePoint(1.5, 1.5));
+  filter->SetOutputSpacing(itk::MakeVector(4.0, 4.0));
+  filter->SetSize(FilterType::SizeType{ { 15, 15 } });
+  EXPECT_FALSE(filter->GetUseSeparableResampling());
+  EXPECT_FALSE(filter->GetAntiAliasing());
+  filter->UseSeparableResamplingOn();
+
+  filter->Update();
+  EXPECT_NEAR(filter->GetOutput()->GetPixel({ { 7, 7 } }), 50.0f, 1e-3);
+
+  filter->SetOutputOrigin(itk::MakePoint(2.0, 2.0));
+  filter->Update();
+  EXPECT_FLOAT_EQ(filter->GetOutput()->GetPixel({ { 7, 7 } }), 100.0f);
+
+  filter->AntiAliasingOn();
+  filter->Update();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    EXPECT_NEAR(it.Get(), 50.0f, 5.0f) << " at " << it.GetIndex();
+  }
+}
@@ -75,6 +75,10 @@ public:
   OutputType
   operator()(const InputType & A) const;
 
+  /** Clamps a span of pixels, with the bounds copied out of the functor, so that the loop can be vectorized. */
+  void
+  ProcessSpan(const InputType * input, OutputType * output, SizeValueType length) const;
+
   itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputType, OutputType>));
   itkConceptMacro(InputConvertibleToDoubleCheck, (Concept::Convertible<InputType, double>));
   itkConceptMacro(DoubleLessThanComparableToOutputCheck, (Concept::LessThanComparable<double, OutputType>));
@@ -105,6 +109,19 @@ Clamp<TInput, TOutput>::operator()(const InputType & A) const -> OutputType
   return static_cast<OutputType>(A);
 }
 
+template <typename TInput, typename TOutput>
+inline void
+Clamp<TInput, TOutput>::ProcessSpan(const InputType * input, OutputType * output, SizeValueType length) const
+{
+  const OutputType lowerBound = m_LowerBound;
+  const OutputType upperBound = m_UpperBound;
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    const auto dA = static_cast<double>(input[i]);
+    output[i] = (dA < lowerBound) ? lowerBound : ((dA > upperBound) ? upperBound : static_cast<OutputType>(input[i]));
+  }
+}
+
 } // end namespace Functor
 
 
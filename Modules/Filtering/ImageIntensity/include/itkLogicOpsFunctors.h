@@ -20,6 +20,7 @@
 
 #include "itkNumericTraits.h"
 #include "itkMath.h"
+#include "itkSpanFunctor.h"
 
 
 namespace itk
@@ -99,6 +100,25 @@ public:
   }
 
 protected:
+  /** Sets each output pixel to the foreground value where predicate holds for the input pixels, and to the
+   * background value elsewhere. The inputs are spans or constants, as for Functor::ApplyToSpan. The values are
+   * copied out of the functor, so that the loop can be vectorized. */
+  template <typename TPredicate, typename TSpan1, typename TSpan2>
+  void
+  ProcessSpanWithPredicate(const TPredicate & predicate,
+                           TSpan1             A,
+                           TSpan2             B,
+                           TOutput *          output,
+                           SizeValueType      length) const
+  {
+    const TOutput foregroundValue = m_ForegroundValue;
+    const TOutput backgroundValue = m_BackgroundValue;
+    for (SizeValueType i = 0; i < length; ++i)
+    {
+      output[i] = predicate(SpanElement(A, i), SpanElement(B, i)) ? foregroundValue : backgroundValue;
+    }
+  }
+
   TOutput m_ForegroundValue;
   TOutput m_BackgroundValue;
 };
@@ -136,6 +156,18 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate(
+      [](const TInput1 & a, const TInput2 & b) { return Math::ExactlyEquals(a, static_cast<TInput1>(b)); },
+      A,
+      B,
+      output,
+      length);
+  }
 };
 /**
  * \class NotEqual
@@ -170,6 +202,18 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate(
+      [](const TInput1 & a, const TInput2 & b) { return Math::NotExactlyEquals(a, b); },
+      A,
+      B,
+      output,
+      length);
+  }
 };
 
 /**
@@ -205,6 +249,13 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate([](const TInput1 & a, const TInput2 & b) { return a >= b; }, A, B, output, length);
+  }
 };
 
 
@@ -240,6 +291,13 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate([](const TInput1 & a, const TInput2 & b) { return a > b; }, A, B, output, length);
+  }
 };
 
 
@@ -275,6 +333,13 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate([](const TInput1 & a, const TInput2 & b) { return a <= b; }, A, B, output, length);
+  }
 };
 
 
@@ -310,6 +375,13 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  template <typename TSpan1, typename TSpan2>
+  void
+  ProcessSpan(TSpan1 A, TSpan2 B, TOutput * output, SizeValueType length) const
+  {
+    this->ProcessSpanWithPredicate([](const TInput1 & a, const TInput2 & b) { return a < b; }, A, B, output, length);
+  }
 };
 
 
@@ -339,6 +411,17 @@ public:
     }
     return this->m_BackgroundValue;
   }
+
+  void
+  ProcessSpan(const TInput * input, TOutput * output, SizeValueType length) const
+  {
+    const TOutput foregroundValue = this->m_ForegroundValue;
+    const TOutput backgroundValue = this->m_BackgroundValue;
+    for (SizeValueType i = 0; i < length; ++i)
+    {
+      output[i] = !input[i] ? foregroundValue : backgroundValue;
+    }
+  }
 };
 
 /**
@@ -183,6 +183,14 @@ public:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** BeforeThreadedGenerateData reads the whole input, which is therefore
+   * never fused. The output of this filter may still be fused. */
+  bool
+  CanComputeFusedInputs() const override
+  {
+    return false;
+  }
+
   itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputPixelType>));
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
   itkConceptMacro(RealTypeMultiplyOperatorCheck, (Concept::MultiplyOperator<RealType>));
@@ -148,6 +148,14 @@ public:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** BeforeThreadedGenerateData reads the whole input, which is therefore
+   * never fused. The output of this filter may still be fused. */
+  bool
+  CanComputeFusedInputs() const override
+  {
+    return false;
+  }
+
   itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputValueType>));
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputValueType>));
 
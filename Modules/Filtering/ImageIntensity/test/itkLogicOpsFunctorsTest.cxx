@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <gtest/gtest.h>
+
+#include "itkLogicOpsFunctors.h"
+#include "itkArithmeticOpsFunctors.h"
+#include "itkClampImageFilter.h"
+
+#include <vector>
+
+namespace
+{
+const std::vector<float> input1{ -2.5f, -1.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.5f, 7.0f, 7.0f, -0.5f, 4.0f };
+const std::vector<float> input2{ 1.0f, -1.0f, 0.0f, 2.0f, 1.0f, -3.0f, 3.5f, 8.0f, 6.0f, -0.5f, 1.0f };
+
+// Checks that ApplyToSpan gives the same output as the functor applied to each pixel, for spans and constants.
+template <typename TFunctor>
+void
+ExpectSpanMatchesPixelwise(const TFunctor & functor)
+{
+  const itk::SizeValueType length = input1.size();
+  std::vector<float>       output(length);
+
+  itk::Functor::ApplyToSpan(functor, input1.data(), input2.data(), output.data(), length);
+  for (itk::SizeValueType i = 0; i < length; ++i)
+  {
+    EXPECT_EQ(output[i], functor(input1[i], input2[i])) << i;
+  }
+
+  itk::Functor::ApplyToSpan(functor, input1.data(), 1.0f, output.data(), length);
+  for (itk::SizeValueType i = 0; i < length; ++i)
+  {
+    EXPECT_EQ(output[i], functor(input1[i], 1.0f)) << i;
+  }
+
+  itk::Functor::ApplyToSpan(functor, 0.0f, input2.data(), output.data(), length);
+  for (itk::SizeValueType i = 0; i < length; ++i)
+  {
+    EXPECT_EQ(output[i], functor(0.0f, input2[i])) << i;
+  }
+
+  // In place.
+  output = input1;
+  itk::Functor::ApplyToSpan(functor, output.data(), input2.data(), output.data(), length);
+  for (itk::SizeValueType i = 0; i < length; ++i)
+  {
+    EXPECT_EQ(output[i], functor(input1[i], input2[i])) << i;
+  }
+}
+
+template <template <typename, typename, typename> class TLogicOp>
+void
+ExpectLogicOpSpanMatchesPixelwise()
+{
+  using OpType = TLogicOp<float, float, float>;
+  static_assert(itk::Functor::HasBinaryProcessSpan<OpType, const float *, const float *, float>::value,
+                "The logic functors process spans.");
+
+  OpType op;
+  ExpectSpanMatchesPixelwise(op);
+
+  op.SetForegroundValue(5.0f);
+  op.SetBackgroundValue(-3.0f);
+  ExpectSpanMatchesPixelwise(op);
+}
+} // namespace
+
+
+TEST(LogicOpsTest, ProcessSpan)
+{
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::Equal>();
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::NotEqual>();
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::GreaterEqual>();
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::Greater>();
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::LessEqual>();
+  ExpectLogicOpSpanMatchesPixelwise<itk::Functor::Less>();
+}
+
+
+TEST(LogicOpsTest, NOTProcessSpan)
+{
+  itk::Functor::NOT<float> op;
+  op.SetForegroundValue(2.0f);
+
+  std::vector<float> output(input1.size());
+  itk::Functor::ApplyToSpan(op, input1.data(), output.data(), input1.size());
+  for (itk::SizeValueType i = 0; i < input1.size(); ++i)
+  {
+    EXPECT_EQ(output[i], op(input1[i])) << i;
+  }
+}
+
+
+TEST(LogicOpsTest, ArithmeticAndClampSpans)
+{
+  // Functors without ProcessSpan are applied pixel by pixel.
+  static_assert(!itk::Functor::HasBinaryProcessSpan<itk::Functor::Add2<float>, const float *, float, float>::value,
+                "Add2 has no ProcessSpan.");
+  ExpectSpanMatchesPixelwise(itk::Functor::Add2<float>());
+  ExpectSpanMatchesPixelwise(itk::Functor::Mult<float>());
+  ExpectSpanMatchesPixelwise(itk::Functor::Div<float, float, float>());
+
+  itk::Functor::Clamp<float, short> clamp;
+  clamp.SetBounds(-1, 3);
+  static_assert(itk::Functor::HasUnaryProcessSpan<itk::Functor::Clamp<float, short>, float, short>::value,
+                "Clamp processes spans.");
+
+  std::vector<short> output(input1.size());
+  itk::Functor::ApplyToSpan(clamp, input1.data(), output.data(), input1.size());
+  for (itk::SizeValueType i = 0; i < input1.size(); ++i)
+  {
+    EXPECT_EQ(output[i], clamp(input1[i])) << i;
+  }
+}
@@ -20,6 +20,12 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkSpanFunctor.h"
+#include "itkTotalProgressReporter.h"
+
+#include <type_traits>
+#include <utility> // For pair.
+#include <vector>
 
 namespace itk
 {
@@ -36,6 +42,14 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * The median of a small neighborhood (at most MaximumSortingNetworkSize
+ * pixels) of arithmetic pixels is selected by a branch-free sorting network.
+ * For larger neighborhoods of 8-bit and 16-bit integer pixels, the filter
+ * keeps a histogram of the neighborhood, which it slides along each line of
+ * the image: each step only adds and removes the pixels of two columns of the
+ * neighborhood, and updates the median from the previous one. Other
+ * neighborhoods are partially sorted, pixel by pixel.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -84,6 +98,9 @@ public:
 
   using InputSizeType = typename InputImageType::SizeType;
 
+  /** The maximum number of pixels of a neighborhood whose median is selected by a sorting network. */
+  static constexpr SizeValueType MaximumSortingNetworkSize = 25;
+
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
   itkConceptMacro(InputConvertibleToOutputCheck, (Concept::Convertible<InputPixelType, OutputPixelType>));
   itkConceptMacro(InputLessThanComparableCheck, (Concept::LessThanComparable<InputPixelType>));
@@ -104,6 +121,22 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  /** Whether the median of the input pixels can be computed from a histogram that has a bin for each pixel value. */
+  static constexpr bool CanUseHistogram = std::is_integral_v<InputPixelType> && !std::is_same_v<InputPixelType, bool> &&
+                                          sizeof(InputPixelType) <= 2 && HasContiguousScanlines<InputImageType>;
+
+  using ComparatorType = std::pair<SizeValueType, SizeValueType>;
+
+  /** Returns the comparators of a sorting network for numberOfPixels pixels (Batcher's merge exchange), keeping only
+   * those that the pixel in the middle depends on. */
+  static std::vector<ComparatorType>
+  MakeMedianSortingNetwork(SizeValueType numberOfPixels);
+
+  /** Computes the output lines of the specified region, by sliding a histogram of the neighborhood along each line. */
+  void
+  GenerateDataUsingHistogram(const OutputImageRegionType & outputRegionForThread, TotalProgressReporter & progress);
 };
 } // end namespace itk
 
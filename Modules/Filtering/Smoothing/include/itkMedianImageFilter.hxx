@@ -21,6 +21,7 @@
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
+#include "itkImageScanlineIterator.h"
 #include "itkIndexRange.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
@@ -50,39 +51,74 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 
   const auto radius = this->GetRadius();
 
-  // Find the data-set boundary "faces" and the center non-boundary subregion.
-  const auto calculatorResult =
-    NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
   const auto neighborhoodOffsets = GenerateRectangularImageNeighborhoodOffsets<InputImageDimension>(radius);
   const auto neighborhoodSize = neighborhoodOffsets.size();
 
+  if constexpr (CanUseHistogram)
+  {
+    if (neighborhoodSize > MaximumSortingNetworkSize)
+    {
+      this->GenerateDataUsingHistogram(outputRegionForThread, progress);
+      return;
+    }
+  }
+
+  // Find the data-set boundary "faces" and the center non-boundary subregion.
+  const auto calculatorResult =
+    NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::Compute(*input, outputRegionForThread, radius);
+
   // All of our neighborhoods have an odd number of pixels, so there is
   // always a median.
   std::vector<InputPixelType> pixels(neighborhoodSize);
   const auto                  medianIterator = pixels.begin() + (neighborhoodSize / 2);
 
-
-  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
-
-  const auto nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
-  if (!nonBoundaryRegion.GetSize().empty())
+  // The comparators of the sorting network, if the median is selected by a sorting network.
+  std::vector<ComparatorType> sortingNetwork;
+  if constexpr (std::is_arithmetic_v<InputPixelType>)
   {
-    // Process the non-boundary subregion, using a faster pixel access policy without boundary extrapolation.
-    auto neighborhoodRange =
-      ShapedImageNeighborhoodRange<const InputImageType, BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>>(
-        *input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, nonBoundaryRegion).begin();
+    if (neighborhoodSize <= MaximumSortingNetworkSize)
+    {
+      sortingNetwork = MakeMedianSortingNetwork(neighborhoodSize);
+    }
+  }
+
+  const auto generateOutputRegion = [&](const OutputImageRegionType & region, auto & neighborhoodRange) {
+    auto outputIterator = ImageRegionRange<OutputImageType>(*output, region).begin();
 
-    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(nonBoundaryRegion))
+    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(region))
     {
       neighborhoodRange.SetLocation(index);
       std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
-      std::nth_element(pixels.begin(), medianIterator, pixels.end());
+      if (sortingNetwork.empty())
+      {
+        std::nth_element(pixels.begin(), medianIterator, pixels.end());
+      }
+      else
+      {
+        for (const auto & comparator : sortingNetwork)
+        {
+          const InputPixelType first = pixels[comparator.first];
+          const InputPixelType second = pixels[comparator.second];
+          pixels[comparator.first] = std::min(first, second);
+          pixels[comparator.second] = std::max(first, second);
+        }
+      }
       *outputIterator = *medianIterator;
       ++outputIterator;
       progress.CompletedPixel();
     }
+  };
+
+  const auto nonBoundaryRegion = calculatorResult.GetNonBoundaryRegion();
+  if (!nonBoundaryRegion.GetSize().empty())
+  {
+    // Process the non-boundary subregion, using a faster pixel access policy without boundary extrapolation.
+    auto neighborhoodRange =
+      ShapedImageNeighborhoodRange<const InputImageType, BufferedImageNeighborhoodPixelAccessPolicy<InputImageType>>(
+        *input, Index<InputImageDimension>(), neighborhoodOffsets);
+    generateOutputRegion(nonBoundaryRegion, neighborhoodRange);
   }
 
   // Process each of the boundary faces.  These are N-d regions which border
@@ -91,17 +127,185 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   {
     auto neighborhoodRange =
       ShapedImageNeighborhoodRange<const InputImageType>(*input, Index<InputImageDimension>(), neighborhoodOffsets);
-    auto outputIterator = ImageRegionRange<OutputImageType>(*output, boundaryFace).begin();
+    generateOutputRegion(boundaryFace, neighborhoodRange);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+MedianImageFilter<TInputImage, TOutputImage>::MakeMedianSortingNetwork(SizeValueType numberOfPixels)
+  -> std::vector<ComparatorType>
+{
+  std::vector<ComparatorType> comparators;
+  if (numberOfPixels < 2)
+  {
+    return comparators;
+  }
 
-    for (const auto & index : ImageRegionIndexRange<InputImageDimension>(boundaryFace))
+  // Batcher's merge exchange, which sorts any number of elements (Knuth, TAOCP Vol. 3, Algorithm 5.2.2M).
+  SizeValueType t = 0;
+  while ((SizeValueType{ 1 } << t) < numberOfPixels)
+  {
+    ++t;
+  }
+  for (SizeValueType p = SizeValueType{ 1 } << (t - 1); p > 0; p /= 2)
+  {
+    SizeValueType q = SizeValueType{ 1 } << (t - 1);
+    SizeValueType r = 0;
+    SizeValueType d = p;
+    while (true)
     {
-      neighborhoodRange.SetLocation(index);
-      std::copy_n(neighborhoodRange.cbegin(), neighborhoodSize, pixels.begin());
-      std::nth_element(pixels.begin(), medianIterator, pixels.end());
-      *outputIterator = *medianIterator;
+      for (SizeValueType i = 0; i + d < numberOfPixels; ++i)
+      {
+        if ((i & p) == r)
+        {
+          comparators.emplace_back(i, i + d);
+        }
+      }
+      if (q == p)
+      {
+        break;
+      }
+      d = q - p;
+      q /= 2;
+      r = p;
+    }
+  }
+
+  // Only keep the comparators that the median depends on, going backward from the pixel in the middle.
+  std::vector<bool> isNeeded(numberOfPixels, false);
+  isNeeded[numberOfPixels / 2] = true;
+  std::vector<ComparatorType> neededComparators;
+  for (auto comparator = comparators.crbegin(); comparator != comparators.crend(); ++comparator)
+  {
+    if (isNeeded[comparator->first] || isNeeded[comparator->second])
+    {
+      isNeeded[comparator->first] = true;
+      isNeeded[comparator->second] = true;
+      neededComparators.push_back(*comparator);
+    }
+  }
+  return { neededComparators.crbegin(), neededComparators.crend() };
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::GenerateDataUsingHistogram(
+  const OutputImageRegionType & outputRegionForThread,
+  TotalProgressReporter &       progress)
+{
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const auto radius = this->GetRadius();
+
+  // Like the neighborhood ranges of DynamicThreadedGenerateData, the pixels outside the buffered region are those at
+  // the nearest index inside it (zero flux Neumann boundary condition).
+  const InputImageRegionType & bufferedRegion = input->GetBufferedRegion();
+  const auto                   bufferedBegin = bufferedRegion.GetIndex();
+  const auto                   bufferedEnd = bufferedRegion.GetUpperIndex();
+  const InputPixelType * const buffer = input->GetBufferPointer();
+
+  // The offsets of the pixels of a column of the neighborhood, which is orthogonal to the lines.
+  InputSizeType columnRadius = radius;
+  columnRadius[0] = 0;
+  const auto                   columnNeighborOffsets = GenerateRectangularImageNeighborhoodOffsets(columnRadius);
+  std::vector<OffsetValueType> columnBufferOffsets(columnNeighborOffsets.size());
+
+  const SizeValueType medianRank = columnNeighborOffsets.size() * (2 * radius[0] + 1) / 2;
+
+  // A bin for each pixel value, in increasing order.
+  using BinType = unsigned int;
+  const auto toBin = [](InputPixelType value) {
+    return static_cast<BinType>(static_cast<int>(value) - static_cast<int>(NumericTraits<InputPixelType>::min()));
+  };
+  std::vector<SizeValueType> histogram(SizeValueType{ 1 } << (8 * sizeof(InputPixelType)));
+
+  // The bin of the median, and the number of pixels of the histogram in the bins below it. The median of the previous
+  // line is a good guess for the next one.
+  BinType       medianBin = toBin(*buffer);
+  SizeValueType numberOfPixelsBelowMedian = 0;
+
+  const auto addColumn = [&](IndexValueType columnIndex) {
+    const InputPixelType * const column = buffer + (std::clamp(columnIndex, bufferedBegin[0], bufferedEnd[0]) -
+                                                    bufferedBegin[0]);
+    for (const OffsetValueType offset : columnBufferOffsets)
+    {
+      const BinType bin = toBin(column[offset]);
+      ++histogram[bin];
+      numberOfPixelsBelowMedian += (bin < medianBin);
+    }
+  };
+  const auto removeColumn = [&](IndexValueType columnIndex) {
+    const InputPixelType * const column = buffer + (std::clamp(columnIndex, bufferedBegin[0], bufferedEnd[0]) -
+                                                    bufferedBegin[0]);
+    for (const OffsetValueType offset : columnBufferOffsets)
+    {
+      const BinType bin = toBin(column[offset]);
+      --histogram[bin];
+      numberOfPixelsBelowMedian -= (bin < medianBin);
+    }
+  };
+  const auto updateMedian = [&] {
+    while (numberOfPixelsBelowMedian > medianRank)
+    {
+      --medianBin;
+      numberOfPixelsBelowMedian -= histogram[medianBin];
+    }
+    while (numberOfPixelsBelowMedian + histogram[medianBin] <= medianRank)
+    {
+      numberOfPixelsBelowMedian += histogram[medianBin];
+      ++medianBin;
+    }
+  };
+
+  const auto lineRadius = static_cast<IndexValueType>(radius[0]);
+
+  ImageScanlineIterator<OutputImageType> outputIterator(output, outputRegionForThread);
+  while (!outputIterator.IsAtEnd())
+  {
+    const auto lineIndex = outputIterator.GetIndex();
+
+    for (size_t i = 0; i < columnNeighborOffsets.size(); ++i)
+    {
+      auto neighborIndex = lineIndex + columnNeighborOffsets[i];
+      neighborIndex[0] = bufferedBegin[0];
+      for (unsigned int dim = 1; dim < InputImageDimension; ++dim)
+      {
+        neighborIndex[dim] = std::clamp(neighborIndex[dim], bufferedBegin[dim], bufferedEnd[dim]);
+      }
+      columnBufferOffsets[i] = input->ComputeOffset(neighborIndex);
+    }
+
+    // Fill the histogram with the neighborhood of the first pixel, and slide it along the line.
+    IndexValueType x = lineIndex[0];
+    for (IndexValueType columnIndex = x - lineRadius; columnIndex <= x + lineRadius; ++columnIndex)
+    {
+      addColumn(columnIndex);
+    }
+    while (true)
+    {
+      updateMedian();
+      outputIterator.Set(static_cast<OutputPixelType>(
+        static_cast<InputPixelType>(static_cast<int>(medianBin) + NumericTraits<InputPixelType>::min())));
       ++outputIterator;
-      progress.CompletedPixel();
+      if (outputIterator.IsAtEndOfLine())
+      {
+        break;
+      }
+      removeColumn(x - lineRadius);
+      ++x;
+      addColumn(x + lineRadius);
     }
+
+    // Empty the histogram for the next line.
+    for (IndexValueType columnIndex = x - lineRadius; columnIndex <= x + lineRadius; ++columnIndex)
+    {
+      removeColumn(columnIndex);
+    }
+
+    progress.Completed(outputRegionForThread.GetSize(0));
+    outputIterator.NextLine();
   }
 }
 } // end namespace itk
@@ -21,8 +21,13 @@
 
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkImageNeighborhoodOffsets.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkShapedImageNeighborhoodRange.h"
 
+#include <algorithm>
 #include <numeric> // For iota.
+#include <random>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -92,6 +97,58 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+// Creates a test image, filled with random pixel values in the specified interval.
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(const typename TImage::RegionType & imageRegion, double minimumValue, double maximumValue)
+{
+  using PixelType = typename TImage::PixelType;
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+  std::mt19937                           randomNumberEngine;
+  std::uniform_real_distribution<double> distribution(minimumValue, maximumValue);
+  for (auto & pixel : itk::ImageBufferRange{ *image })
+  {
+    pixel = static_cast<PixelType>(distribution(randomNumberEngine));
+  }
+  return image;
+}
+
+
+// Expects that the output pixels of the filter, in the specified output region, are the medians of the input
+// neighborhoods, as selected by std::nth_element.
+template <typename TImage>
+void
+Expect_median_of_each_neighborhood(const TImage &                      inputImage,
+                                   const typename TImage::SizeType &   radius,
+                                   const typename TImage::RegionType & outputRegion)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const auto filter = itk::MedianImageFilter<TImage, TImage>::New();
+  filter->SetInput(&inputImage);
+  filter->SetRadius(radius);
+  filter->GetOutput()->SetRequestedRegion(outputRegion);
+  filter->Update();
+  const TImage & outputImage = *filter->GetOutput();
+
+  const auto neighborhoodOffsets = itk::GenerateRectangularImageNeighborhoodOffsets(radius);
+  auto       neighborhoodRange = itk::ShapedImageNeighborhoodRange<const TImage>(
+    inputImage, typename TImage::IndexType(), neighborhoodOffsets);
+  std::vector<PixelType> pixels(neighborhoodOffsets.size());
+
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(&outputImage, outputRegion); !it.IsAtEnd(); ++it)
+  {
+    neighborhoodRange.SetLocation(it.GetIndex());
+    std::copy(neighborhoodRange.cbegin(), neighborhoodRange.cend(), pixels.begin());
+    const auto medianIterator = pixels.begin() + pixels.size() / 2;
+    std::nth_element(pixels.begin(), medianIterator, pixels.end());
+    ASSERT_EQ(it.Get(), *medianIterator) << "index = " << it.GetIndex() << ", radius = " << radius;
+  }
+}
+
 } // namespace
 
 
@@ -122,3 +179,44 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the sorting networks (for small neighborhoods) and the sliding histogram (for large neighborhoods of
+// integer pixels) select the same median as a partial sort.
+TEST(MedianImageFilter, SameMedianAsPartialSortForAnyNeighborhoodSize)
+{
+  using FloatImageType = itk::Image<float, 2>;
+  using ShortImageType = itk::Image<short, 3>;
+  using UCharImageType = itk::Image<unsigned char, 2>;
+
+  const auto floatImage = CreateRandomImage<FloatImageType>(itk::Size<2>{ { 19, 13 } }, -100.0, 100.0);
+  for (itk::SizeValueType radius0 = 0; radius0 <= 3; ++radius0)
+  {
+    for (itk::SizeValueType radius1 = 0; radius1 <= 2; ++radius1)
+    {
+      Expect_median_of_each_neighborhood(
+        *floatImage, { { radius0, radius1 } }, floatImage->GetLargestPossibleRegion());
+    }
+  }
+
+  const auto ucharImage = CreateRandomImage<UCharImageType>(itk::Size<2>{ { 23, 17 } }, 0.0, 255.0);
+  for (itk::SizeValueType radius = 1; radius <= 4; ++radius)
+  {
+    Expect_median_of_each_neighborhood(*ucharImage, { { radius, radius } }, ucharImage->GetLargestPossibleRegion());
+  }
+  Expect_median_of_each_neighborhood(*ucharImage, { { 0, 20 } }, ucharImage->GetLargestPossibleRegion());
+
+  // A region with a nonzero index, and pixel values that are both negative and positive.
+  ShortImageType::RegionType shortImageRegion({ { -4, 3, 1 } }, { { 16, 9, 7 } });
+  const auto shortImage = CreateRandomImage<ShortImageType>(shortImageRegion, -1500.0, 3000.0);
+  for (const auto & radius : { ShortImageType::SizeType{ { 1, 1, 1 } },
+                               ShortImageType::SizeType{ { 2, 1, 3 } },
+                               ShortImageType::SizeType{ { 5, 5, 5 } },
+                               ShortImageType::SizeType{ { 0, 3, 2 } } })
+  {
+    Expect_median_of_each_neighborhood(*shortImage, radius, shortImageRegion);
+  }
+
+  // A requested region inside the image.
+  Expect_median_of_each_neighborhood(*shortImage, { { 2, 2, 2 } }, { { { -1, 5, 2 } }, { { 9, 4, 3 } } });
+}
@@ -118,6 +118,17 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the pixel data may be memory-mapped instead of read.
+   * When enabled, and the ImageIO can map the file (see
+   * ImageIOBase::MapPixelData()) because the pixels are stored exactly as
+   * they are laid out in the output image, the output buffer wraps the
+   * mapped file: no buffer is allocated and no data is copied. The mapping
+   * is private, so the file is not changed when the output is modified.
+   * Otherwise the file is read as usual. Off by default. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstReferenceMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -153,6 +164,11 @@ protected:
   void
   GenerateData() override;
 
+  /** Try to make the output buffer wrap the memory-mapped pixel data of the
+   * file. Returns false if the file can not be mapped for the output. */
+  bool
+  MapOutputBuffer();
+
   ImageIOBase::Pointer m_ImageIO{};
 
   bool m_UserSpecifiedImageIO{}; // keep track whether the
@@ -160,6 +176,8 @@ protected:
 
   bool m_UseStreaming{};
 
+  bool m_UseMemoryMapping{ false };
+
 private:
   std::string m_ExceptionMessage{};
 
@@ -50,6 +50,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   itkPrintSelfBooleanMacro(UserSpecifiedImageIO);
   itkPrintSelfBooleanMacro(UseStreaming);
+  itkPrintSelfBooleanMacro(UseMemoryMapping);
 
   os << indent << "ExceptionMessage: " << m_ExceptionMessage << std::endl;
   os << indent << "ActualIORegion: " << m_ActualIORegion << std::endl;
@@ -359,9 +360,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << '\n');
 
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -384,6 +382,16 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   itkDebugMacro("Setting imageIO IORegion to: " << m_ActualIORegion);
   m_ImageIO->SetIORegion(m_ActualIORegion);
 
+  if (m_UseMemoryMapping && this->MapOutputBuffer())
+  {
+    itkDebugMacro("Output buffer is memory-mapped, no reading required.");
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
   // the size of the buffer is computed based on the actual number of
   // pixels to be read and the actual size of the pixels to be read
   // (as opposed to the sizes of the output)
@@ -440,6 +448,46 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->UpdateProgress(1.0f);
 }
 
+template <typename TOutputImage, typename ConvertPixelTraits>
+bool
+ImageFileReader<TOutputImage, ConvertPixelTraits>::MapOutputBuffer()
+{
+  using PixelContainerType = typename TOutputImage::PixelContainer;
+  using ElementType = typename PixelContainerType::Element;
+
+  const typename TOutputImage::Pointer output = this->GetOutput();
+  const ImageRegionType                region = output->GetRequestedRegion();
+
+  // The pixels must be stored in the file exactly as in the output buffer.
+  const IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
+  if (m_ImageIO->GetComponentType() != ioType ||
+      m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents() ||
+      m_ActualIORegion.GetNumberOfPixels() != region.GetNumberOfPixels())
+  {
+    return false;
+  }
+  const size_t numberOfBytes =
+    m_ActualIORegion.GetNumberOfPixels() * m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+  if (numberOfBytes % sizeof(ElementType) != 0)
+  {
+    return false;
+  }
+
+  std::shared_ptr<void> mappedPixelData = m_ImageIO->MapPixelData();
+  if (mappedPixelData == nullptr ||
+      reinterpret_cast<std::uintptr_t>(mappedPixelData.get()) % alignof(ElementType) != 0)
+  {
+    return false;
+  }
+
+  auto * const buffer = static_cast<ElementType *>(mappedPixelData.get());
+  output->SetBufferedRegion(region);
+  output->GetPixelContainer()->SetImportPointer(
+    buffer, static_cast<typename PixelContainerType::ElementIdentifier>(numberOfBytes / sizeof(ElementType)),
+    std::move(mappedPixelData));
+  return true;
+}
+
 template <typename TOutputImage, typename ConvertPixelTraits>
 void
 ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(const void * inputData, size_t numberOfPixels)
@@ -38,6 +38,7 @@
 #include "vcl_compiler.h"
 
 #include <fstream>
+#include <memory>
 #include <string>
 
 namespace itk
@@ -440,6 +441,20 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Memory-map the pixel data of the file, instead of reading it.
+   *
+   * Returns a pointer to the mapped pixel data, laid out exactly as Read()
+   * would have written it into a buffer. The mapping remains valid as long
+   * as a copy of the returned pointer exists. The mapping is private:
+   * modifying the pixel data does not modify the file.
+   *
+   * Returns nullptr if the pixel data can not be mapped, for example because
+   * it is compressed, needs byte swapping or reordering, or because the
+   * IORegion does not cover the whole image. This method may only be called
+   * after ReadImageInformation() and SetIORegion(). */
+  virtual std::shared_ptr<void>
+  MapPixelData();
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -695,6 +710,19 @@ protected:
   virtual bool
   HasSupportedWriteExtension(const char * fileName, bool ignoreCase = true);
 
+  /** Get the name of the file storing the raw pixel data of the whole
+   * image, and the offset (in bytes) of the first pixel in that file.
+   * Used by MapPixelData(). Returns false if the pixel data is not stored
+   * uncompressed, contiguously, and in the native byte order, which is
+   * what the default implementation assumes. */
+  virtual bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset);
+
+  /** Memory-map numberOfBytes bytes of the file, starting at offset.
+   * Returns nullptr if the file can not be mapped. */
+  static std::shared_ptr<void>
+  MapFileRegion(const std::string & fileName, SizeType offset, SizeType numberOfBytes);
+
   /** Used internally to keep track of the type of the pixel. */
   IOPixelEnum m_PixelType{ IOPixelEnum::SCALAR };
 
@@ -35,6 +35,14 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * The files are read concurrently, using the MultiThreader of this
+ * filter: up to NumberOfWorkUnits files are read at the same time,
+ * each one directly into its slice of the output buffer whenever
+ * possible. The MetaDataDictionaryArray is in file order, whatever the
+ * order in which the files were read. When an ImageIO is specified, or
+ * the number of work units is 1, the files are read one after another,
+ * using the specified ImageIO itself.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
@@ -23,10 +23,12 @@
 #include "itkArray.h"
 #include "itkVector.h"
 #include "itkMath.h"
-#include "itkProgressReporter.h"
+#include "itkTotalProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include <algorithm>
 #include <cstddef> // For ptrdiff_t.
 #include <iomanip>
+#include <memory>
 
 namespace itk
 {
@@ -278,7 +280,7 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   output->Allocate();
 
   // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
+  TotalProgressReporter progress(this, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
 
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
@@ -289,30 +291,39 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
   typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
   const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
 
-  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
-  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
-  double                             maxSpacingDeviation = 0.0;
-  bool                               prevSliceIsValid = false;
-
-  for (int i = 0; i != numberOfFiles; ++i)
-  {
+  // The files are read concurrently, each one by its own ImageFileReader.
+  // Slices that fit the output are read directly into the output buffer, so
+  // that the memory in flight is limited to the ImageIO internals of the
+  // files currently being read: at most one per work unit. An ImageIO
+  // specified by the user can only read one file at a time, and may hold
+  // settings that a new instance would not have, so the files are then read
+  // one after another with it.
+  const ThreadIdType numberOfWorkUnits =
+    std::min(this->GetNumberOfWorkUnits(), static_cast<ThreadIdType>(numberOfFiles));
+  const bool readSerially = numberOfWorkUnits <= 1 || m_ImageIO.IsNotNull();
+
+  // The per slice information is processed in file order, after all files are read.
+  // Note that sliceIsRead is not a std::vector<bool>, as its elements are written concurrently.
+  std::vector<typename TOutputImage::PointType> sliceOrigins(numberOfFiles);
+  std::vector<char>                             sliceIsRead(numberOfFiles, 0);
+  std::vector<std::unique_ptr<DictionaryType>>  sliceDictionaries(numberOfFiles);
+
+  const auto readSlice = [&](SizeValueType i) {
+    IndexType sliceStartIndex = requestedRegion.GetIndex();
     if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
     {
-      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+      sliceStartIndex[this->m_NumberOfDimensionsInImage] = static_cast<IndexValueType>(i);
     }
 
     const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+    const int  iFileName = (m_ReverseOrder ? numberOfFiles - static_cast<int>(i) - 1 : static_cast<int>(i));
 
     // check if we need this slice
     if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
     {
-      continue;
+      return;
     }
 
     // configure reader
@@ -368,7 +379,8 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
 
         const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+                                        ? (static_cast<ptrdiff_t>(i) -
+                                           requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
                                         : 0;
 
         const ptrdiff_t numberOfPixelComponentsUpToSlice =
@@ -414,12 +426,65 @@ ImageSeriesReader<TOutputImage>::GenerateData()
         ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
       }
 
+      sliceOrigins[i] = readerOutput->GetOrigin();
+      sliceIsRead[i] = true;
+
+      // report progress for read slices
+      progress.CompletedPixel();
+    } // end !insideRequestedRegion
+
+    // Copy the MetaDataDictionary, which may be added to the array once the
+    // sampling of the slices is known. The copy shares the entries of the
+    // dictionary of the ImageIO until either of them is modified.
+    if (reader->GetImageIO())
+    {
+      sliceDictionaries[i] = std::make_unique<DictionaryType>(reader->GetImageIO()->GetMetaDataDictionary());
+    }
+  };
+
+  if (readSerially)
+  {
+    for (int i = 0; i != numberOfFiles; ++i)
+    {
+      readSlice(i);
+    }
+  }
+  else
+  {
+    // The number of work units of the multi-threader is only changed for the
+    // duration of the read.
+    MultiThreaderBase * const multiThreader = this->GetMultiThreader();
+    const ThreadIdType        multiThreaderNumberOfWorkUnits = multiThreader->GetNumberOfWorkUnits();
+    multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    try
+    {
+      multiThreader->ParallelizeArray(0, numberOfFiles, readSlice, nullptr);
+    }
+    catch (...)
+    {
+      multiThreader->SetNumberOfWorkUnits(multiThreaderNumberOfWorkUnits);
+      throw;
+    }
+    multiThreader->SetNumberOfWorkUnits(multiThreaderNumberOfWorkUnits);
+  }
+
+  typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
+  typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
+  double                             maxSpacingDeviation = 0.0;
+  bool                               prevSliceIsValid = false;
+  std::vector<double>                spacingDeviations(numberOfFiles, 0.0);
+  std::vector<char>                  nonUniformSamplings(numberOfFiles, 0);
+
+  for (int i = 0; i != numberOfFiles; ++i)
+  {
+    if (sliceIsRead[i])
+    {
       // verify that slice spacing is the expected one
       // since we can be skipping some slices because they are outside of requested region
       // I am using additional variable
       if (prevSliceIsValid)
       {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
+        const typename TOutputImage::PointType & sliceOrigin = sliceOrigins[i];
         using SpacingScalarType = typename TOutputImage::SpacingValueType;
         Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
         for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
@@ -433,40 +498,48 @@ ImageSeriesReader<TOutputImage>::GenerateData()
               dirNnorm,
               outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
         {
-          nonUniformSampling = true;
-          spacingDeviation = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
-          if (spacingDeviation > maxSpacingDeviation)
+          nonUniformSamplings[i] = true;
+          spacingDeviations[i] = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
+          if (spacingDeviations[i] > maxSpacingDeviation)
           {
-            maxSpacingDeviation = spacingDeviation;
+            maxSpacingDeviation = spacingDeviations[i];
           }
 
-          needToUpdateMetaDataDictionaryArray = true;
+          // The array of dictionaries records the slice-specific deviations,
+          // unless it already holds them from a previous update with the same
+          // output information.
+          if (m_MetaDataDictionaryArray.empty())
+          {
+            needToUpdateMetaDataDictionaryArray = true;
+          }
         }
         prevSliceOrigin = sliceOrigin;
       }
       else
       {
-        prevSliceOrigin = readerOutput->GetOrigin();
+        prevSliceOrigin = sliceOrigins[i];
         prevSliceIsValid = true;
       }
+    }
+  } // end per slice loop
 
-      // report progress for read slices
-      progress.CompletedPixel();
-    } // end !insideRequestedRegion
-
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+  // Move the MetaDataDictionaries into the array, in file order
+  if (needToUpdateMetaDataDictionaryArray)
+  {
+    for (int i = 0; i != numberOfFiles; ++i)
     {
-      auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      if (nonUniformSampling)
+      if (sliceDictionaries[i])
       {
-        // slice-specific information
-        EncapsulateMetaData<double>(*newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+        if (nonUniformSamplings[i])
+        {
+          // slice-specific information
+          EncapsulateMetaData<double>(
+            *sliceDictionaries[i], "ITK_non_uniform_sampling_deviation", spacingDeviations[i]);
+        }
+        m_MetaDataDictionaryArray.push_back(sliceDictionaries[i].release());
       }
-      m_MetaDataDictionaryArray.push_back(newDictionary);
     }
-  } // end per slice loop
+  }
 
 
   if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage &&
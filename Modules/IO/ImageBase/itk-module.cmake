@@ -17,6 +17,8 @@ itk_module(
   ITKTestKernel
   ITKIOGDCM
   ITKIOMeta
+  ITKIONIFTI
+  ITKIONRRD
   ITKImageIntensity
   DESCRIPTION
   "${DOCUMENTATION}")
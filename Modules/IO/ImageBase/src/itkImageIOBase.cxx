@@ -22,6 +22,15 @@
 #include "itksys/SystemTools.hxx"
 #include "itkPrintHelper.h"
 
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 
 namespace itk
 {
@@ -312,6 +321,114 @@ ImageIOBase::ReadBufferAsBinary(std::istream & is, void * buffer, ImageIOBase::S
   return true;
 }
 
+std::shared_ptr<void>
+ImageIOBase::MapPixelData()
+{
+  // Only the whole image can be mapped, as it is stored contiguously in the file.
+  if (m_IORegion.GetImageDimension() == 0 ||
+      m_IORegion.GetNumberOfPixels() != static_cast<ImageIORegion::SizeValueType>(this->GetImageSizeInPixels()))
+  {
+    return nullptr;
+  }
+  for (unsigned int i = 0; i < m_IORegion.GetImageDimension(); ++i)
+  {
+    if (m_IORegion.GetIndex(i) != 0)
+    {
+      return nullptr;
+    }
+  }
+
+  std::string dataFileName;
+  SizeType    offset = 0;
+  if (!this->GetRawPixelDataLocation(dataFileName, offset))
+  {
+    return nullptr;
+  }
+
+  // The first pixel must be suitably aligned to be accessed in place.
+  const unsigned int componentSize = this->GetComponentSize();
+  if (componentSize == 0 || offset % componentSize != 0)
+  {
+    return nullptr;
+  }
+  return MapFileRegion(dataFileName, offset, this->GetImageSizeInBytes());
+}
+
+bool
+ImageIOBase::GetRawPixelDataLocation(std::string &, SizeType &)
+{
+  return false;
+}
+
+std::shared_ptr<void>
+ImageIOBase::MapFileRegion(const std::string & fileName, SizeType offset, SizeType numberOfBytes)
+{
+  if (numberOfBytes == 0)
+  {
+    return nullptr;
+  }
+#if defined(_WIN32)
+  const std::wstring uncpath = itksys::SystemTools::ConvertToWindowsExtendedPath(fileName.c_str());
+  const HANDLE       file =
+    CreateFileW(uncpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    return nullptr;
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    return nullptr;
+  }
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeType alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+  void *         base = MapViewOfFile(mapping,
+                              FILE_MAP_COPY,
+                              static_cast<DWORD>(alignedOffset >> 32),
+                              static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                              static_cast<SIZE_T>(offset - alignedOffset + numberOfBytes));
+  CloseHandle(mapping); // the view keeps the mapping alive
+  if (base == nullptr)
+  {
+    return nullptr;
+  }
+  return std::shared_ptr<void>(static_cast<char *>(base) + (offset - alignedOffset),
+                               [base](void *) { UnmapViewOfFile(base); });
+#else
+  const int file = open(fileName.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    return nullptr;
+  }
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) != 0 || static_cast<SizeType>(fileStatus.st_size) < offset + numberOfBytes)
+  {
+    close(file);
+    return nullptr;
+  }
+  const auto     pageSize = static_cast<SizeType>(sysconf(_SC_PAGESIZE));
+  const SizeType alignedOffset = offset - offset % pageSize;
+  const size_t   length = offset - alignedOffset + numberOfBytes;
+  // A private mapping is copy-on-write, so that the pixels may be modified without changing the file.
+  void * base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(alignedOffset));
+  close(file); // the mapping keeps the file alive
+  if (base == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  return std::shared_ptr<void>(static_cast<char *>(base) + (offset - alignedOffset),
+                               [base, length](void *) { munmap(base, length); });
+#endif
+}
+
 unsigned int
 ImageIOBase::GetPixelSize() const
 {
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageIOFactory.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageFileReaderMemoryMappingTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  using ImageType = itk::Image<short, 3>;
+
+  template <typename TImage = ImageType>
+  static typename TImage::Pointer
+  MakeImage()
+  {
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::SizeType{ { 13, 7, 5 } });
+    image->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      const typename TImage::IndexType index = it.GetIndex();
+      it.Set(static_cast<typename TImage::PixelType>(index[0] - 10 * index[1] + 100 * index[2]));
+    }
+    return image;
+  }
+
+  template <typename TImage>
+  static void
+  WriteImage(const TImage * image, const std::string & fileName, bool useCompression)
+  {
+    const auto writer = itk::ImageFileWriter<TImage>::New();
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->SetUseCompression(useCompression);
+    writer->Update();
+  }
+
+  // Returns whether the ImageIO for the specified file can map its pixel data.
+  static bool
+  CanMapPixelData(const std::string & fileName)
+  {
+    const itk::ImageIOBase::Pointer imageIO =
+      itk::ImageIOFactory::CreateImageIO(fileName.c_str(), itk::ImageIOFactory::IOFileModeEnum::ReadMode);
+    imageIO->SetFileName(fileName);
+    imageIO->ReadImageInformation();
+    itk::ImageIORegion ioRegion(imageIO->GetNumberOfDimensions());
+    for (unsigned int i = 0; i < imageIO->GetNumberOfDimensions(); ++i)
+    {
+      ioRegion.SetSize(i, imageIO->GetDimensions(i));
+    }
+    imageIO->SetIORegion(ioRegion);
+    return imageIO->MapPixelData() != nullptr;
+  }
+
+  // Checks that reading the file with memory mapping gives the same image as reading it without.
+  template <typename TImage = ImageType>
+  static void
+  ExpectSameImageWithMemoryMapping(const std::string & fileName, bool expectMapped)
+  {
+    const auto reader = itk::ImageFileReader<TImage>::New();
+    reader->SetFileName(fileName);
+    reader->Update();
+    const typename TImage::ConstPointer expected = reader->GetOutput();
+
+    const auto mappingReader = itk::ImageFileReader<TImage>::New();
+    mappingReader->SetFileName(fileName);
+    mappingReader->UseMemoryMappingOn();
+    EXPECT_TRUE(mappingReader->GetUseMemoryMapping());
+    mappingReader->Update();
+    const typename TImage::Pointer actual = mappingReader->GetOutput();
+
+    EXPECT_EQ(*actual, *expected);
+
+    // A mapped buffer is not managed by the pixel container itself.
+    EXPECT_EQ(actual->GetPixelContainer()->GetContainerManageMemory(), !expectMapped);
+
+    // The mapping is private: modifying the image must not modify the file.
+    actual->GetBufferPointer()[0] = 123;
+    reader->Modified();
+    reader->Update();
+    EXPECT_EQ(reader->GetOutput()->GetBufferPointer()[0], MakeImage<TImage>()->GetBufferPointer()[0]);
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, UseMemoryMappingIsOffByDefault)
+{
+  EXPECT_FALSE(itk::ImageFileReader<ImageType>::New()->GetUseMemoryMapping());
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MapsUncompressedFiles)
+{
+  const ImageType::Pointer image = MakeImage();
+
+  for (const std::string fileName : { "MemoryMapping.mhd", "MemoryMapping.nhdr", "MemoryMapping.nii" })
+  {
+    WriteImage(image.GetPointer(), fileName, false);
+    EXPECT_TRUE(CanMapPixelData(fileName)) << fileName;
+    ExpectSameImageWithMemoryMapping(fileName, true);
+  }
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, MapsUncompressedFilesWithAttachedHeader)
+{
+  // The pixel data follows a header of arbitrary length, so it is only aligned for single byte pixels.
+  using ByteImageType = itk::Image<unsigned char, 3>;
+  const ByteImageType::Pointer image = MakeImage<ByteImageType>();
+
+  for (const std::string fileName : { "MemoryMappingAttached.mha", "MemoryMappingAttached.nrrd" })
+  {
+    WriteImage(image.GetPointer(), fileName, false);
+    EXPECT_TRUE(CanMapPixelData(fileName)) << fileName;
+    ExpectSameImageWithMemoryMapping<ByteImageType>(fileName, true);
+  }
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, FallsBackToReadingCompressedFiles)
+{
+  const ImageType::Pointer image = MakeImage();
+
+  for (const std::string fileName :
+       { "MemoryMappingCompressed.mha", "MemoryMappingCompressed.nrrd", "MemoryMappingCompressed.nii.gz" })
+  {
+    WriteImage(image.GetPointer(), fileName, true);
+    EXPECT_FALSE(CanMapPixelData(fileName)) << fileName;
+    ExpectSameImageWithMemoryMapping(fileName, false);
+  }
+}
+
+
+TEST_F(ITKImageFileReaderMemoryMappingTest, FallsBackToReadingOtherPixelTypes)
+{
+  const std::string fileName = "MemoryMappingShort.mha";
+  WriteImage(MakeImage().GetPointer(), fileName, false);
+
+  // The pixels must be converted from short to float, so they can not be mapped.
+  using FloatImageType = itk::Image<float, 3>;
+  const auto reader = itk::ImageFileReader<FloatImageType>::New();
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  reader->Update();
+  EXPECT_TRUE(reader->GetOutput()->GetPixelContainer()->GetContainerManageMemory());
+  EXPECT_EQ(reader->GetOutput()->GetPixel({ { 3, 2, 1 } }), 3.0f - 20.0f + 100.0f);
+}
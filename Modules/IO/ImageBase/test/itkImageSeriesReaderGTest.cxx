@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaImageIO.h"
+#include "itkMetaDataObject.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+struct ITKImageSeriesReaderTest : public ::testing::Test
+{
+  using ImageType = itk::Image<short, 3>;
+  using SliceType = ImageType;
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+  static constexpr unsigned int NumberOfSlices = 9;
+  static constexpr unsigned int MissingSliceIndex = 4;
+
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+
+    // Write the slices, with a missing slice before the slice MissingSliceIndex,
+    // to check the per slice non-uniform sampling information.
+    for (unsigned int i = 0; i < NumberOfSlices; ++i)
+    {
+      auto slice = SliceType::New();
+      slice->SetRegions(SliceType::SizeType{ { 11, 6, 1 } });
+      slice->SetOrigin(SliceType::PointType{ { { 0.0, 0.0, i < MissingSliceIndex ? i : i + 1.0 } } });
+      slice->Allocate();
+      for (itk::ImageRegionIteratorWithIndex<SliceType> it(slice, slice->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      {
+        it.Set(static_cast<short>(it.GetIndex()[0] - 10 * it.GetIndex()[1] + 100 * i));
+      }
+      itk::EncapsulateMetaData<std::string>(slice->GetMetaDataDictionary(), "SliceName", std::to_string(i));
+
+      const auto fileName = "ImageSeriesReaderSlice" + std::to_string(i) + ".mha";
+      const auto writer = itk::ImageFileWriter<SliceType>::New();
+      writer->SetInput(slice);
+      writer->SetFileName(fileName);
+      writer->Update();
+      m_FileNames.push_back(fileName);
+    }
+  }
+
+  ReaderType::Pointer
+  ReadSeries(itk::ThreadIdType  numberOfWorkUnits,
+             bool               metaDataDictionaryArrayUpdate = true,
+             itk::ImageIOBase * imageIO = nullptr) const
+  {
+    const auto reader = ReaderType::New();
+    reader->SetFileNames(m_FileNames);
+    if (imageIO)
+    {
+      reader->SetImageIO(imageIO);
+    }
+    reader->SetNumberOfWorkUnits(numberOfWorkUnits);
+    reader->SetMetaDataDictionaryArrayUpdate(metaDataDictionaryArrayUpdate);
+    reader->Update();
+    return reader;
+  }
+
+  std::vector<std::string> m_FileNames;
+};
+
+} // namespace
+
+
+TEST_F(ITKImageSeriesReaderTest, ConcurrentReadingGivesSameResult)
+{
+  const ReaderType::Pointer serialReader = ReadSeries(1);
+  const ImageType *         expected = serialReader->GetOutput();
+  EXPECT_EQ(expected->GetPixel({ { 3, 2, 5 } }), 3 - 20 + 500);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2u, 4u, 100u })
+  {
+    const ReaderType::Pointer reader = ReadSeries(numberOfWorkUnits);
+    EXPECT_EQ(*reader->GetOutput(), *expected) << numberOfWorkUnits;
+
+    // The dictionaries are in file order, whatever the order of reading.
+    const ReaderType::DictionaryArrayType & dictionaries = *reader->GetMetaDataDictionaryArray();
+    ASSERT_EQ(dictionaries.size(), NumberOfSlices);
+    for (unsigned int i = 0; i < NumberOfSlices; ++i)
+    {
+      std::string sliceName;
+      EXPECT_TRUE(itk::ExposeMetaData<std::string>(*dictionaries[i], "SliceName", sliceName));
+      EXPECT_EQ(sliceName, std::to_string(i));
+    }
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, MissingSliceIsRecordedPerSlice)
+{
+  // The spacing between the slices is the distance between the first and the
+  // last slices, divided by the number of intervals.
+  constexpr double spacing = NumberOfSlices / (NumberOfSlices - 1.0);
+
+  // The dictionaries of the slices are also recorded when the update of the
+  // array is off, as the sampling is not uniform.
+  for (const bool metaDataDictionaryArrayUpdate : { true, false })
+  {
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1u, 3u })
+    {
+      const ReaderType::Pointer reader = ReadSeries(numberOfWorkUnits, metaDataDictionaryArrayUpdate);
+      // The number of work units of the multi-threader is restored after the read.
+      EXPECT_EQ(reader->GetMultiThreader()->GetNumberOfWorkUnits(),
+                ReaderType::New()->GetMultiThreader()->GetNumberOfWorkUnits());
+
+      double maximumDeviation = 0.0;
+      EXPECT_TRUE(itk::ExposeMetaData<double>(
+        reader->GetOutput()->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", maximumDeviation));
+      EXPECT_DOUBLE_EQ(maximumDeviation, 2.0 - spacing);
+
+      const ReaderType::DictionaryArrayType & dictionaries = *reader->GetMetaDataDictionaryArray();
+      ASSERT_EQ(dictionaries.size(), NumberOfSlices);
+      EXPECT_FALSE(dictionaries[0]->HasKey("ITK_non_uniform_sampling_deviation"));
+      for (unsigned int i = 1; i < NumberOfSlices; ++i)
+      {
+        double deviation = 0.0;
+        EXPECT_TRUE(itk::ExposeMetaData<double>(*dictionaries[i], "ITK_non_uniform_sampling_deviation", deviation));
+        EXPECT_DOUBLE_EQ(deviation, i == MissingSliceIndex ? 2.0 - spacing : spacing - 1.0) << i;
+      }
+    }
+  }
+}
+
+
+TEST_F(ITKImageSeriesReaderTest, SpecifiedImageIOIsShared)
+{
+  const ReaderType::Pointer serialReader = ReadSeries(1);
+
+  // A specified ImageIO is used for all the files, which are then read one
+  // after another, whatever the number of work units.
+  const auto                imageIO = itk::MetaImageIO::New();
+  const ReaderType::Pointer reader = ReadSeries(4, true, imageIO);
+  EXPECT_EQ(*reader->GetOutput(), *serialReader->GetOutput());
+  EXPECT_EQ(reader->GetImageIO(), imageIO.GetPointer());
+  EXPECT_EQ(imageIO->GetFileName(), m_FileNames.back());
+}
@@ -187,6 +187,13 @@ protected:
   ~MetaImageIO() override;
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The pixel data can be mapped when it is stored uncompressed, in native
+   * byte order, either in the header file (ElementDataFile = LOCAL) or in a
+   * single separate data file. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   template <unsigned int VNRows, unsigned int VNColumns = VNRows>
   bool
   WriteMatrixInMetaData(std::ostringstream &       strs,
@@ -511,6 +511,76 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+bool
+MetaImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1 ||
+      m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB())
+  {
+    return false;
+  }
+
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  if (elementDataFileName.empty() || elementDataFileName.compare(0, 4, "LIST") == 0 ||
+      elementDataFileName.find('%') != std::string::npos)
+  {
+    return false;
+  }
+
+  const bool isLocal = itksys::SystemTools::UpperCase(elementDataFileName) == "LOCAL";
+  if (isLocal)
+  {
+    fileName = m_FileName;
+  }
+  else if (itksys::SystemTools::FileIsFullPath(elementDataFileName))
+  {
+    fileName = elementDataFileName;
+  }
+  else
+  {
+    fileName = itksys::SystemTools::CollapseFullPath(elementDataFileName,
+                                                     itksys::SystemTools::GetFilenamePath(m_FileName));
+  }
+
+  const int headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0)
+  {
+    offset = static_cast<SizeType>(headerSize);
+  }
+  else if (headerSize == -1)
+  {
+    // The pixel data is stored at the end of the file.
+    const SizeType fileSize = itksys::SystemTools::FileLength(fileName);
+    if (fileSize < this->GetImageSizeInBytes())
+    {
+      return false;
+    }
+    offset = fileSize - this->GetImageSizeInBytes();
+  }
+  else if (isLocal)
+  {
+    // The pixel data directly follows the header, so parse it again to find where it ends.
+    std::ifstream stream;
+    this->OpenFileForReading(stream, m_FileName);
+    MetaImage header;
+    if (!header.ReadStream(0, &stream, false))
+    {
+      return false;
+    }
+    const std::streamoff headerEnd = stream.tellg();
+    if (headerEnd <= 0)
+    {
+      return false;
+    }
+    offset = static_cast<SizeType>(headerEnd);
+  }
+  else
+  {
+    offset = 0;
+  }
+  return true;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
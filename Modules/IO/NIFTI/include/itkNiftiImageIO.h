@@ -230,6 +230,12 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The pixel data can be mapped when it is stored uncompressed, in native
+   * byte order, without rescaling, and with the same layout in ITK and NIfTI
+   * (i.e., scalar, complex, RGB, or RGBA pixels). */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   virtual bool
   GetUseLegacyModeForTwoFileWriting() const
   {
@@ -839,6 +839,34 @@ NiftiImageIO::DetermineFileType(const char * FileNameToRead)
   return static_cast<NiftiImageIOEnums::NiftiFileEnum>(imageFTYPE);
 }
 
+// The pixels can be mapped when they are stored uncompressed, in the byte
+// order of this machine, and are not rescaled on reading.
+bool
+NiftiImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  // Vector and tensor pixels are stored with the components in a separate dimension.
+  if (this->MustRescale() || !(this->GetNumberOfComponents() == 1 || this->GetPixelType() == IOPixelEnum::COMPLEX ||
+                               this->GetPixelType() == IOPixelEnum::RGB || this->GetPixelType() == IOPixelEnum::RGBA))
+  {
+    return false;
+  }
+
+  nifti_image * header = nifti_image_read(this->GetFileName(), false);
+  if (header == nullptr)
+  {
+    return false;
+  }
+  const bool canMap = header->iname != nullptr && header->iname_offset >= 0 && !nifti_is_gzfile(header->iname) &&
+                      header->byteorder == nifti_short_order();
+  if (canMap)
+  {
+    fileName = header->iname;
+    offset = static_cast<SizeType>(header->iname_offset);
+  }
+  nifti_image_free(header);
+  return canMap;
+}
+
 // This method will only test if the header looks like an
 // Nifti Header.  Some code is redundant with ReadImageInformation
 // a StateMachine could provide a better implementation
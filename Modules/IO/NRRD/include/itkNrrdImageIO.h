@@ -98,6 +98,12 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** The pixel data can be mapped when it is stored with the raw encoding,
+   * in native byte order, in a single (attached or detached) data file,
+   * and with the pixel components along the fastest axis. */
+  bool
+  GetRawPixelDataLocation(std::string & fileName, SizeType & offset) override;
+
   void
   InternalSetCompressor(const std::string & _compressor) override;
 
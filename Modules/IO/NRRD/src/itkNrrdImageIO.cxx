@@ -712,6 +712,77 @@ NrrdImageIO::ReadImageInformation()
   }
 }
 
+bool
+NrrdImageIO::GetRawPixelDataLocation(std::string & fileName, SizeType & offset)
+{
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  // Only parse the header, but keep the data file open, positioned at the
+  // first pixel (after the line and byte skipping), so that its offset is known.
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+
+#if !defined(__MINGW32__) && (defined(ITK_HAS_FEENABLEEXCEPT) || defined(_MSC_VER))
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState{ FloatingPointExceptions::GetExceptionAction() ==
+                     itk::FloatingPointExceptions::ExceptionActionEnum::EXIT };
+  FloatingPointExceptions::Disable();
+#endif
+
+  bool canMap = false;
+  if (nrrdLoad(nrrd, this->GetFileName(), nio) == 0)
+  {
+    unsigned int       rangeAxisIdx[NRRD_DIM_MAX];
+    const unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrd, rangeAxisIdx);
+    const size_t       elementSize = nrrdElementSize(nrrd);
+
+    canMap = nio->format == nrrdFormatNRRD && nio->encoding == nrrdEncodingRaw && nio->dataFile != nullptr &&
+             nio->dataFNFormat == nullptr &&
+             (nio->dataFNArr->len == 0 || (nio->dataFNArr->len == 1 && strcmp(nio->dataFN[0], "-") != 0)) &&
+             (elementSize == 1 || nio->endian == airMyEndian()) &&
+             (rangeAxisNum == 0 || (rangeAxisNum == 1 && rangeAxisIdx[0] == 0)) &&
+             nrrdKind3DMaskedSymMatrix != nrrd->axis[0].kind &&
+             nrrdElementNumber(nrrd) * elementSize == static_cast<size_t>(this->GetImageSizeInBytes());
+    if (canMap)
+    {
+      const long position = ftell(nio->dataFile);
+      canMap = position >= 0;
+      if (nio->dataFNArr->len == 0)
+      {
+        fileName = this->GetFileName();
+      }
+      else if (nio->dataFN[0][0] == '/' || nio->dataFN[0][1] == ':' || !airStrlen(nio->path))
+      {
+        fileName = nio->dataFN[0];
+      }
+      else
+      {
+        fileName = std::string(nio->path) + '/' + nio->dataFN[0];
+      }
+      offset = static_cast<SizeType>(position);
+    }
+  }
+  else
+  {
+    free(biffGetDone(NRRD));
+  }
+
+#if !defined(__MINGW32__) && (defined(ITK_HAS_FEENABLEEXCEPT) || defined(_MSC_VER))
+  // restore state
+  FloatingPointExceptions::SetEnabled(saveFPEState);
+#endif
+
+  if (nio->dataFile != nullptr)
+  {
+    airFclose(nio->dataFile);
+    nio->dataFile = nullptr;
+  }
+  nrrdNuke(nrrd);
+  nrrdIoStateNix(nio);
+  return canMap;
+}
+
 void
 NrrdImageIO::Read(void * buffer)
 {
@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <fstream>
+#include "itkRawImageIO.h"
+#include "itkImageSeriesReader.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+
+// Reads a series of raw files, with a header and big endian pixels, using
+// several work units. All the settings of the RawImageIO must be used for
+// each of the files.
+int
+itkRawImageIOSeriesTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << itkNameOfTestExecutableMacro(argv) << " TemporaryDirectoryName" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string directory = argv[1];
+
+  using PixelType = short;
+  using ImageType = itk::Image<PixelType, 3>;
+  using RawImageIOType = itk::RawImageIO<PixelType, 2>;
+  using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+  constexpr unsigned int  width = 7;
+  constexpr unsigned int  height = 5;
+  constexpr unsigned int  numberOfSlices = 6;
+  constexpr unsigned long headerSize = 12;
+
+  const auto pixelValue = [](unsigned int x, unsigned int y, unsigned int z) {
+    return static_cast<PixelType>(x + 10 * y + 100 * z - 300);
+  };
+
+  // Write each slice as a header followed by its big endian pixels.
+  std::vector<std::string> fileNames;
+  for (unsigned int z = 0; z < numberOfSlices; ++z)
+  {
+    const std::string fileName = directory + "/RawImageIOSeriesTest" + std::to_string(z) + ".raw";
+    std::ofstream     file(fileName, std::ios::binary);
+    const std::string header(headerSize, 'H');
+    file.write(header.data(), header.size());
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        const auto value = static_cast<unsigned short>(pixelValue(x, y, z));
+        const char bytes[2] = { static_cast<char>(value >> 8), static_cast<char>(value & 0xff) };
+        file.write(bytes, 2);
+      }
+    }
+    fileNames.push_back(fileName);
+  }
+
+  auto rawImageIO = RawImageIOType::New();
+  rawImageIO->SetFileDimensionality(2);
+  rawImageIO->SetDimensions(0, width);
+  rawImageIO->SetDimensions(1, height);
+  rawImageIO->SetSpacing(0, 0.5);
+  rawImageIO->SetSpacing(1, 0.25);
+  rawImageIO->SetOrigin(0, -3.0);
+  rawImageIO->SetOrigin(1, 2.0);
+  rawImageIO->SetHeaderSize(headerSize);
+  rawImageIO->SetByteOrderToBigEndian();
+
+  auto reader = ReaderType::New();
+  reader->SetFileNames(fileNames);
+  reader->SetImageIO(rawImageIO);
+  reader->SetNumberOfWorkUnits(4);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  const ImageType * image = reader->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(image->GetLargestPossibleRegion().GetSize(),
+                        (ImageType::SizeType{ { width, height, numberOfSlices } }));
+  ITK_TEST_EXPECT_EQUAL(image->GetSpacing()[0], 0.5);
+  ITK_TEST_EXPECT_EQUAL(image->GetSpacing()[1], 0.25);
+  ITK_TEST_EXPECT_EQUAL(image->GetOrigin()[0], -3.0);
+  ITK_TEST_EXPECT_EQUAL(image->GetOrigin()[1], 2.0);
+
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    const PixelType              expected = pixelValue(index[0], index[1], index[2]);
+    if (it.Get() != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in pixel value at index " << index << std::endl;
+      std::cerr << "Expected value " << expected << std::endl;
+      std::cerr << " differs from " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
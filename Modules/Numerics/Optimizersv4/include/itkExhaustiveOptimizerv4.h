@@ -78,6 +78,13 @@ namespace itk
  * start_parameter[d] = - stepLength * scaling[d] * numberOfSteps[d]
  *   end_parameter[d] = + stepLength * scaling[d] * numberOfSteps[d]
  *
+ * When MaximumNumberOfConcurrentMetrics and NumberOfWorkUnits are greater
+ * than 1, the grid positions are evaluated concurrently on clones of the
+ * metric, in blocks. The IterationEvents are
+ * then invoked for each position of a block once it is evaluated, in the
+ * same order and with the same state of the optimizer as when walking the
+ * grid one position at a time.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -165,6 +172,14 @@ protected:
   void
   IncrementIndex(ParametersType & newPosition);
 
+  /** Walk the grid by blocks of positions, evaluated concurrently. */
+  void
+  ResumeWalkingConcurrently();
+
+  /** Update the extrema of the metric with the value at a position. */
+  void
+  UpdateMetricValueExtrema(const ParametersType & position);
+
 protected:
   ParametersType m_InitialPosition{};
   MeasureType    m_CurrentValue{ 0 };
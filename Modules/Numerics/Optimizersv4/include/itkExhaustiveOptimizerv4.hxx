@@ -18,6 +18,7 @@
 #ifndef itkExhaustiveOptimizerv4_hxx
 #define itkExhaustiveOptimizerv4_hxx
 
+#include <algorithm>
 
 namespace itk
 {
@@ -99,6 +100,12 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
   itkDebugMacro("ResumeWalk");
   m_Stop = false;
 
+  if (this->GetNumberOfConcurrentMetrics() > 1)
+  {
+    this->ResumeWalkingConcurrently();
+    return;
+  }
+
   while (!m_Stop)
   {
     const ParametersType currentPosition = this->GetCurrentPosition();
@@ -110,17 +117,7 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
     }
 
     m_CurrentValue = this->m_Metric->GetValue();
-
-    if (m_CurrentValue > m_MaximumMetricValue)
-    {
-      m_MaximumMetricValue = m_CurrentValue;
-      m_MaximumMetricValuePosition = currentPosition;
-    }
-    if (m_CurrentValue < m_MinimumMetricValue)
-    {
-      m_MinimumMetricValue = m_CurrentValue;
-      m_MinimumMetricValuePosition = currentPosition;
-    }
+    this->UpdateMetricValueExtrema(currentPosition);
 
     if (m_Stop)
     {
@@ -138,6 +135,102 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
   }
 }
 
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalkingConcurrently()
+{
+  // Each block holds a few positions per metric, so that the threads are not restarted for every position.
+  const SizeValueType blockSize = 8 * this->GetNumberOfConcurrentMetrics();
+
+  // The metric is cloned again for each walk, as it may have changed since the previous one.
+  this->ClearConcurrentMetrics();
+
+  typename Superclass::ParametersListType positions;
+  std::vector<ParametersType>             indices;
+  typename Superclass::MeasureListType    values;
+  typename Superclass::ExceptionListType  exceptions;
+
+  ParametersType nextPosition = this->GetCurrentPosition();
+  bool           completed = false;
+
+  while (!m_Stop && !completed)
+  {
+    // Enumerate the next block of grid positions. IncrementIndex() flags the end of the grid in m_Stop.
+    positions.clear();
+    indices.clear();
+    while (positions.size() < blockSize && !completed)
+    {
+      positions.push_back(nextPosition);
+      indices.push_back(m_CurrentIndex);
+      this->IncrementIndex(nextPosition);
+      completed = m_Stop;
+      m_Stop = false;
+    }
+    const ParametersType nextIndex = m_CurrentIndex;
+    const SizeValueType  numberOfPositions = positions.size();
+
+    this->EvaluateMetricConcurrently(positions, values, exceptions);
+
+    SizeValueType i = 0;
+    while (i < numberOfPositions && !m_Stop)
+    {
+      if (exceptions[i])
+      {
+        std::rethrow_exception(exceptions[i]);
+      }
+
+      this->m_Metric->SetParameters(positions[i]);
+      m_CurrentIndex = indices[i];
+      m_CurrentValue = values[i];
+      this->UpdateMetricValueExtrema(positions[i]);
+
+      m_StopConditionDescription.str("");
+      m_StopConditionDescription << this->GetNameOfClass() << ": Running. "
+                                 << "@ index " << this->GetCurrentIndex() << " value is " << m_CurrentValue;
+
+      this->InvokeEvent(IterationEvent());
+      this->m_CurrentIteration++;
+      ++i;
+    }
+
+    // Leave the optimizer at the position that follows the last evaluated one, as AdvanceOneStep() does.
+    if (i < numberOfPositions)
+    {
+      this->m_Metric->SetParameters(positions[i]);
+      m_CurrentIndex = indices[i];
+    }
+    else
+    {
+      this->m_Metric->SetParameters(nextPosition);
+      m_CurrentIndex = nextIndex;
+    }
+    if (completed && i == numberOfPositions)
+    {
+      m_Stop = true;
+      m_StopConditionDescription.str("");
+      m_StopConditionDescription << this->GetNameOfClass() << ": "
+                                 << "Completed sampling of parametric space of size " << nextPosition.GetSize();
+    }
+  }
+  this->ClearConcurrentMetrics();
+}
+
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::UpdateMetricValueExtrema(const ParametersType & position)
+{
+  if (m_CurrentValue > m_MaximumMetricValue)
+  {
+    m_MaximumMetricValue = m_CurrentValue;
+    m_MaximumMetricValuePosition = position;
+  }
+  if (m_CurrentValue < m_MinimumMetricValue)
+  {
+    m_MinimumMetricValue = m_CurrentValue;
+    m_MinimumMetricValuePosition = position;
+  }
+}
+
 template <typename TInternalComputationValueType>
 void
 ExhaustiveOptimizerv4<TInternalComputationValueType>::StopWalking()
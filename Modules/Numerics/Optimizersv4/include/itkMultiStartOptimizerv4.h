@@ -36,6 +36,12 @@ namespace itk
  *   focus modifying the parameter sample space.  This is why we place the burden on the user to provide
  *   the parameter samples over which to optimize.
  *
+ *   Without a local optimizer, the metric is only evaluated at each of the
+ *   parameter samples. These evaluations run concurrently, on clones of the
+ *   metric, when MaximumNumberOfConcurrentMetrics and NumberOfWorkUnits are
+ *   greater than 1, and the IterationEvents are then invoked for each sample
+ *   once all are evaluated.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
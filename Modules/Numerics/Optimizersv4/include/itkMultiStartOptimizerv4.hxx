@@ -164,6 +164,22 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
   this->InvokeEvent(StartEvent());
 
+  // Without a local optimizer, the metric values at the remaining samples do not depend on each other, so they may be
+  // computed concurrently up front.
+  const SizeValueType firstIteration = this->m_CurrentIteration;
+  const bool          evaluateConcurrently =
+    this->m_LocalOptimizer.IsNull() && this->GetNumberOfConcurrentMetrics() > 1;
+
+  typename Superclass::MeasureListType   concurrentValues;
+  typename Superclass::ExceptionListType concurrentExceptions;
+  if (evaluateConcurrently)
+  {
+    const ParametersListType positions(this->m_ParametersList.begin() + firstIteration, this->m_ParametersList.end());
+    this->ClearConcurrentMetrics();
+    this->EvaluateMetricConcurrently(positions, concurrentValues, concurrentExceptions);
+    this->ClearConcurrentMetrics();
+  }
+
   this->m_Stop = false;
   while (!this->m_Stop)
   {
@@ -177,7 +193,19 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
         this->m_LocalOptimizer->StartOptimization();
         this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
       }
-      this->m_CurrentMetricValue = this->m_Metric->GetValue();
+      if (evaluateConcurrently)
+      {
+        const SizeValueType i = this->m_CurrentIteration - firstIteration;
+        if (concurrentExceptions[i])
+        {
+          std::rethrow_exception(concurrentExceptions[i]);
+        }
+        this->m_CurrentMetricValue = concurrentValues[i];
+      }
+      else
+      {
+        this->m_CurrentMetricValue = this->m_Metric->GetValue();
+      }
       this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
     }
     catch (const ExceptionObject &)
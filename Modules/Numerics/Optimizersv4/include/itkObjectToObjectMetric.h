@@ -330,6 +330,14 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, which computes the same values with a
+   * clone of the moving transform, so that the parameters of the copy can be
+   * set independently. The fixed transform and the virtual domain image are
+   * shared. Derived classes copy their settings, and the copy must be
+   * initialized before use. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Verify that virtual domain and displacement field are the same size
    * and in the same physical space. */
   virtual void
@@ -536,6 +536,35 @@ ObjectToObjectMetric<TFixedDimension, TMovingDimension, TVirtualImage, TParamete
   return true;
 }
 
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TParametersValueType>
+typename LightObject::Pointer
+ObjectToObjectMetric<TFixedDimension, TMovingDimension, TVirtualImage, TParametersValueType>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->m_FixedObject = this->m_FixedObject;
+  rval->m_MovingObject = this->m_MovingObject;
+  rval->m_GradientSource = this->m_GradientSource;
+  rval->m_FixedTransform = this->m_FixedTransform;
+  if (this->m_MovingTransform)
+  {
+    rval->m_MovingTransform = this->m_MovingTransform->Clone();
+  }
+  if (this->m_UserHasSetVirtualDomain)
+  {
+    rval->SetVirtualDomainFromImage(this->m_VirtualImage);
+  }
+  return loPtr;
+}
+
 template <unsigned int TFixedDimension,
           unsigned int TMovingDimension,
           typename TVirtualImage,
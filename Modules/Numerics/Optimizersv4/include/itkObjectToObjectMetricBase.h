@@ -245,6 +245,18 @@ public:
     return MetricCategoryEnum::UNKNOWN_METRIC;
   }
 
+  /** Set/Get the maximum number of work units used by the metric, for the
+   * metrics that are multi-threaded. The other metrics ignore it, and report
+   * one work unit. */
+  virtual void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType itkNotUsed(number))
+  {}
+  virtual ThreadIdType
+  GetMaximumNumberOfWorkUnits() const
+  {
+    return 1;
+  }
+
 protected:
   ObjectToObjectMetricBaseTemplate();
   ~ObjectToObjectMetricBaseTemplate() override = default;
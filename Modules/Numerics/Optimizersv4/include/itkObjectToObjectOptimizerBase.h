@@ -25,6 +25,9 @@
 #include "itkObjectToObjectMetricBase.h"
 #include "itkIntTypes.h"
 
+#include <exception>
+#include <vector>
+
 namespace itk
 {
 /** \class ObjectToObjectOptimizerBaseTemplateEnums
@@ -104,6 +107,12 @@ extern ITKOptimizersv4_EXPORT std::ostream &
  * Threading of some optimizer operations may be handled within
  * derived classes, for example in GradientDescentOptimizer.
  *
+ * Derivative-free optimizers that evaluate many candidate positions
+ * independently, such as ExhaustiveOptimizerv4 and MultiStartOptimizerv4,
+ * can evaluate them concurrently on clones of their metric, when
+ * MaximumNumberOfConcurrentMetrics is greater than 1. See
+ * EvaluateMetricConcurrently().
+ *
  * \note Derived classes must override StartOptimization, and then call
  * this base class version to perform common initializations.
  *
@@ -144,6 +153,11 @@ public:
   /** Measure type */
   using MeasureType = typename MetricType::MeasureType;
 
+  /** Types of the positions and values of concurrent metric evaluations. */
+  using ParametersListType = std::vector<ParametersType>;
+  using MeasureListType = std::vector<MeasureType>;
+  using ExceptionListType = std::vector<std::exception_ptr>;
+
   /** Stop condition return string type */
   using StopConditionReturnStringType = std::string;
 
@@ -154,6 +168,17 @@ public:
   itkSetObjectMacro(Metric, MetricType);
   itkGetModifiableObjectMacro(Metric, MetricType);
 
+  /** Set/Get the maximum number of metrics on which the optimizers that
+   * support it evaluate candidate positions concurrently. These metrics are
+   * clones of the metric of the optimizer (see LightObject::Clone()), so the
+   * class of the metric must implement InternalClone() to copy its settings
+   * and clone its transform, as the ImageToImageMetricv4 classes do. At most
+   * NumberOfWorkUnits metrics are used, among which the work units are
+   * divided. Defaults to 1: the positions are evaluated one at a time, on
+   * the metric of the optimizer. */
+  itkSetClampMacro(MaximumNumberOfConcurrentMetrics, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(MaximumNumberOfConcurrentMetrics, SizeValueType);
+
   /** Accessor for metric value. Returns the value
    *  stored in m_CurrentMetricValue from the most recent
    *  call to evaluate the metric. */
@@ -283,6 +308,31 @@ protected:
 
   ~ObjectToObjectOptimizerBaseTemplate() override;
 
+  /** Get the number of metrics on which EvaluateMetricConcurrently()
+   * evaluates positions: MaximumNumberOfConcurrentMetrics, limited to
+   * NumberOfWorkUnits. */
+  SizeValueType
+  GetNumberOfConcurrentMetrics() const;
+
+  /** Evaluate the metric at each of the positions, concurrently on clones of
+   * the metric of the optimizer, each of which runs on a thread of its own
+   * with an equal share of the NumberOfWorkUnits. The clones are created and
+   * initialized by the first call after ClearConcurrentMetrics(). The values
+   * are stored in the same order as the positions. An exception thrown by
+   * the evaluation of a position is stored in \c exceptions, while the other
+   * positions are still evaluated. The parameters of the metric of the
+   * optimizer are not changed. */
+  void
+  EvaluateMetricConcurrently(const ParametersListType & positions,
+                             MeasureListType &          values,
+                             ExceptionListType &        exceptions);
+
+  /** Release the clones of the metric. Derived classes call it before
+   * evaluating positions concurrently, as the metric may have changed since
+   * the previous evaluations, and once they are done. */
+  void
+  ClearConcurrentMetrics();
+
   MetricTypePointer m_Metric{};
   ThreadIdType      m_NumberOfWorkUnits{};
   SizeValueType     m_CurrentIteration{};
@@ -315,6 +365,11 @@ protected:
    */
   bool m_DoEstimateScales{};
 
+  SizeValueType m_MaximumNumberOfConcurrentMetrics{ 1 };
+
+  /** Clones of m_Metric that evaluate positions concurrently. */
+  std::vector<MetricTypePointer> m_ConcurrentMetrics{};
+
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 };
@@ -18,6 +18,9 @@
 #define ITK_TEMPLATE_EXPLICIT_ObjectToObjectOptimizerBaseTemplate
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkParallelizeOnDedicatedThreads.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -72,6 +75,79 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::PrintSelf(st
 
   itkPrintSelfBooleanMacro(WeightsAreIdentity);
   itkPrintSelfBooleanMacro(DoEstimateScales);
+
+  os << indent << "MaximumNumberOfConcurrentMetrics: " << m_MaximumNumberOfConcurrentMetrics << std::endl;
+}
+
+template <typename TInternalComputationValueType>
+SizeValueType
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::GetNumberOfConcurrentMetrics() const
+{
+  return std::min(this->m_MaximumNumberOfConcurrentMetrics, static_cast<SizeValueType>(this->m_NumberOfWorkUnits));
+}
+
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::ClearConcurrentMetrics()
+{
+  this->m_ConcurrentMetrics.clear();
+}
+
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::EvaluateMetricConcurrently(
+  const ParametersListType & positions,
+  MeasureListType &          values,
+  ExceptionListType &        exceptions)
+{
+  if (this->m_Metric.IsNull())
+  {
+    itkExceptionMacro("m_Metric must be set.");
+  }
+
+  const SizeValueType numberOfPositions = positions.size();
+  values.assign(numberOfPositions, MeasureType{});
+  if (numberOfPositions == 0)
+  {
+    exceptions.clear();
+    return;
+  }
+
+  const SizeValueType numberOfMetrics = std::min(numberOfPositions, this->GetNumberOfConcurrentMetrics());
+  while (this->m_ConcurrentMetrics.size() < numberOfMetrics)
+  {
+    const LightObject::Pointer clone = this->m_Metric->Clone();
+    const MetricTypePointer    metric = dynamic_cast<MetricType *>(clone.GetPointer());
+    if (metric.IsNull())
+    {
+      itkExceptionMacro("The metric " << this->m_Metric->GetNameOfClass() << " cannot be cloned.");
+    }
+    metric->Initialize();
+    if (metric->GetNumberOfParameters() != this->m_Metric->GetNumberOfParameters())
+    {
+      itkExceptionMacro("The clone of the metric " << this->m_Metric->GetNameOfClass() << " has "
+                                                   << metric->GetNumberOfParameters() << " parameters instead of "
+                                                   << this->m_Metric->GetNumberOfParameters()
+                                                   << ". Its class must implement InternalClone().");
+    }
+    this->m_ConcurrentMetrics.push_back(metric);
+  }
+
+  // The metrics share the work units of the optimizer.
+  const auto numberOfWorkUnitsPerMetric =
+    static_cast<ThreadIdType>(std::max<SizeValueType>(1, this->m_NumberOfWorkUnits / numberOfMetrics));
+  for (SizeValueType i = 0; i < numberOfMetrics; ++i)
+  {
+    this->m_ConcurrentMetrics[i]->SetMaximumNumberOfWorkUnits(numberOfWorkUnitsPerMetric);
+  }
+
+  exceptions = ParallelizeOnDedicatedThreads(
+    numberOfPositions, numberOfMetrics, [this, &positions, &values](SizeValueType i, SizeValueType metricIndex) {
+      MetricType * const metric = this->m_ConcurrentMetrics[metricIndex];
+      ParametersType     position(positions[i]);
+      metric->SetParameters(position);
+      values[i] = metric->GetValue();
+    });
 }
 
 template <typename TInternalComputationValueType>
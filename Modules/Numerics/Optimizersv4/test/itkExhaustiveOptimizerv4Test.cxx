@@ -328,6 +328,36 @@ itkExhaustiveOptimizerv4Test(int, char *[])
   }
 
 
+  // Evaluating the grid positions concurrently gives the same results, and invokes the same iteration events.
+  auto concurrentOptimizer = OptimizerType::New();
+  auto concurrentIdxObserver = IndexObserver::New();
+  concurrentOptimizer->AddObserver(itk::IterationEvent(), concurrentIdxObserver);
+  auto concurrentMetric = ExhaustiveOptv4Metric::New();
+  concurrentMetric->SetParameters(initialPosition);
+  concurrentOptimizer->SetMetric(concurrentMetric);
+  concurrentOptimizer->SetMaximumNumberOfConcurrentMetrics(4);
+  ITK_TEST_SET_GET_VALUE(4, concurrentOptimizer->GetMaximumNumberOfConcurrentMetrics());
+  concurrentOptimizer->SetNumberOfWorkUnits(4);
+  concurrentOptimizer->SetScales(parametersScale);
+  concurrentOptimizer->SetStepLength(stepLength);
+  concurrentOptimizer->SetNumberOfSteps(steps);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(concurrentOptimizer->StartOptimization());
+
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMinimumMetricValue(), itkOptimizer->GetMinimumMetricValue());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMaximumMetricValue(), itkOptimizer->GetMaximumMetricValue());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMinimumMetricValuePosition(),
+                        itkOptimizer->GetMinimumMetricValuePosition());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMaximumMetricValuePosition(),
+                        itkOptimizer->GetMaximumMetricValuePosition());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentValue(), itkOptimizer->GetCurrentValue());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentIndex(), itkOptimizer->GetCurrentIndex());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentPosition(), itkOptimizer->GetCurrentPosition());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentIteration(), itkOptimizer->GetCurrentIteration());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetStopConditionDescription(),
+                        itkOptimizer->GetStopConditionDescription());
+  ITK_TEST_EXPECT_TRUE(concurrentIdxObserver->m_VisitedIndices == idxObserver->m_VisitedIndices);
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
@@ -254,6 +254,30 @@ itkMultiStartOptimizerv4Test(int, char *[])
   }
   std::cout << "Test 1 passed." << std::endl;
 
+  /*
+   * Test 1 with concurrent metrics
+   */
+  std::cout << "Test optimization 1 with concurrent metrics:" << std::endl;
+  auto concurrentOptimizer = OptimizerType::New();
+  auto concurrentMetric = MultiStartOptimizerv4TestMetric::New();
+  concurrentOptimizer->SetMetric(concurrentMetric);
+  ITK_TEST_SET_GET_VALUE(1, concurrentOptimizer->GetMaximumNumberOfConcurrentMetrics());
+  concurrentOptimizer->SetMaximumNumberOfConcurrentMetrics(0);
+  ITK_TEST_SET_GET_VALUE(1, concurrentOptimizer->GetMaximumNumberOfConcurrentMetrics());
+  concurrentOptimizer->SetMaximumNumberOfConcurrentMetrics(3);
+  ITK_TEST_SET_GET_VALUE(3, concurrentOptimizer->GetMaximumNumberOfConcurrentMetrics());
+  concurrentOptimizer->SetNumberOfWorkUnits(4);
+  concurrentMetric->SetParameters(parametersList[0]);
+  concurrentOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(concurrentOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(concurrentOptimizer->GetMetricValuesList() == itkOptimizer->GetMetricValuesList());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetBestParametersIndex(), itkOptimizer->GetBestParametersIndex());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentIteration(), itkOptimizer->GetCurrentIteration());
+  std::cout << "Test 1 with concurrent metrics passed." << std::endl;
+
   /*
    * Test 2
    */
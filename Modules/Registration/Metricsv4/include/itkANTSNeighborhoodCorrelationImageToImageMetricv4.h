@@ -48,7 +48,9 @@ namespace itk
  *
  * 2) The evaluation uses on-the-fly queues with multi-threading and a sliding
  * neighborhood window. This is described in the above paper and specifically
- * optimized for dense registration.
+ * optimized for dense registration. Alternatively, SetUseSeparableBoxFilter(true)
+ * computes the neighborhood sums of the dense evaluation by separable box
+ * filtering, whose cost does not grow with the radius.
  *
  *  Example of usage:
  *
@@ -156,6 +158,15 @@ public:
   itkGetMacro(Radius, RadiusType);
   itkGetConstMacro(Radius, RadiusType);
 
+  /** Set/Get whether the dense evaluation computes the sums over the neighborhood of each voxel by separable box
+   * filtering, instead of the sliding queues of the scanning window. Each work unit then evaluates the fixed and
+   * moving images once per voxel of its region (padded by the radius), and its cost does not depend on the radius.
+   * It keeps 2 * radius + 1 slices of eight values per voxel in memory, per work unit. Sparse evaluation is not
+   * affected. Off by default. */
+  itkSetMacro(UseSeparableBoxFilter, bool);
+  itkGetConstMacro(UseSeparableBoxFilter, bool);
+  itkBooleanMacro(UseSeparableBoxFilter);
+
   void
   Initialize() override;
 
@@ -185,9 +196,15 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, including its settings. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   // Radius of the neighborhood window centered at each pixel
   RadiusType m_Radius{};
+
+  bool m_UseSeparableBoxFilter{ false };
 };
 
 } // end namespace itk
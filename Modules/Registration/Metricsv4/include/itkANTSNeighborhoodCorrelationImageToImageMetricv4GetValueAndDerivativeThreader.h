@@ -25,6 +25,7 @@
 
 #include <deque>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -150,6 +151,12 @@ protected:
     : m_ANTSAssociate(nullptr)
   {}
 
+  bool
+  SupportsSparseDerivativeAccumulation() const override
+  {
+    return true;
+  }
+
   /**
    * Dense threader and sparse threader invoke different in multi-threading. This class uses overloaded
    * implementations of \c ProcessVirtualPoint_impl and \c ThreadExecution_impl in order to handle the
@@ -247,6 +254,22 @@ protected:
   void
   ThreadedExecution_impl(IdentityHelper<T> itkNotUsed(self), const DomainType & domain, const ThreadIdType threadId);
 
+  /** Dense evaluation over a region, used instead of the scanning window when the metric's UseSeparableBoxFilter
+   * is on. The slices of the region (padded by the radius) along the last dimension are evaluated one at a time.
+   * The sums over the window within each slice are computed by box filtering along each other dimension, and the
+   * sums over the whole window by adding and removing the slices that enter and leave it. */
+  void
+  ThreadedExecutionUsingSeparableBoxFilter(const ImageRegionType & virtualImageSubRegion, const ThreadIdType threadId);
+
+  /** Replaces the values of an image buffer by their sums over [i - radius, i + radius] along the specified axis,
+   * clipped to the buffer. */
+  static void
+  BoxSumAlongAxis(InternalComputationValueType *              buffer,
+                  const typename ImageRegionType::SizeType &  bufferSize,
+                  const unsigned int                          axis,
+                  const SizeValueType                         radius,
+                  std::vector<InternalComputationValueType> & workBuffer);
+
   /** Common functions for computing correlation over scanning windows **/
 
   /** Create an iterator over the virtual sub region */
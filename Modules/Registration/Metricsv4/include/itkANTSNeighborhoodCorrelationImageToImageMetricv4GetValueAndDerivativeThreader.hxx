@@ -18,6 +18,8 @@
 #ifndef itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -41,6 +43,12 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
 
   std::call_once(this->m_ANTSAssociateOnceFlag, [this, &associate]() { this->m_ANTSAssociate = associate; });
 
+  if (associate->GetUseSeparableBoxFilter())
+  {
+    this->ThreadedExecutionUsingSeparableBoxFilter(virtualImageSubRegion, threadId);
+    return;
+  }
+
   VirtualPointType   virtualPoint;
   MeasureType        metricValueResult{};
   MeasureType        metricValueSum{};
@@ -126,6 +134,264 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   Superclass::ThreadedExecution(domain, threadId);
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                             TImageToImageMetric,
+                                                                             TNeighborhoodCorrelationMetric>::
+  ThreadedExecutionUsingSeparableBoxFilter(const ImageRegionType & virtualImageSubRegion, const ThreadIdType threadId)
+{
+  using LocalRealType = InternalComputationValueType;
+  constexpr unsigned int SliceAxis = TImageToImageMetric::VirtualImageDimension - 1;
+
+  // The sums over the window: of the fixed values, the moving values, their squares, their products, and the
+  // number of valid voxels.
+  enum
+  {
+    SumFixed,
+    SumMoving,
+    SumFixed2,
+    SumMoving2,
+    SumFixedMoving,
+    Count,
+    NumberOfSums
+  };
+
+  const RadiusType                              radius = this->m_ANTSAssociate->GetRadius();
+  const typename VirtualImageType::ConstPointer virtualImage = this->m_ANTSAssociate->GetVirtualImage();
+
+  // Like the scanning window, the window of each voxel is clipped to the buffered region of the virtual image.
+  ImageRegionType paddedRegion = virtualImageSubRegion;
+  paddedRegion.PadByRadius(radius);
+  paddedRegion.Crop(virtualImage->GetBufferedRegion());
+
+  typename ImageRegionType::SizeType sliceSize = paddedRegion.GetSize();
+  sliceSize[SliceAxis] = 1;
+  const SizeValueType sliceLength = ImageRegionType(sliceSize).GetNumberOfPixels();
+  const SizeValueType numberOfSlots =
+    std::min<SizeValueType>(2 * radius[SliceAxis] + 1, paddedRegion.GetSize(SliceAxis));
+
+  // The slices of the padded region that are in the window of the current slice are kept in a ring of slots,
+  // each holding the fixed and moving values of the slice, their validity, and the sums over the window within the
+  // slice. windowSums holds the sums over the whole window.
+  std::vector<LocalRealType> fixedValues(numberOfSlots * sliceLength);
+  std::vector<LocalRealType> movingValues(numberOfSlots * sliceLength);
+  std::vector<unsigned char> validities(numberOfSlots * sliceLength);
+  std::vector<LocalRealType> sliceSums(numberOfSlots * NumberOfSums * sliceLength);
+  std::vector<LocalRealType> windowSums(NumberOfSums * sliceLength);
+  std::vector<LocalRealType> workBuffer;
+
+  const IndexValueType firstSlice = paddedRegion.GetIndex(SliceAxis);
+  const IndexValueType lastSlice = firstSlice + static_cast<IndexValueType>(paddedRegion.GetSize(SliceAxis)) - 1;
+  const auto           slotOfSlice = [firstSlice, numberOfSlots](const IndexValueType slice) {
+    return static_cast<SizeValueType>(slice - firstSlice) % numberOfSlots;
+  };
+
+  const auto evaluateSlice = [&, this](const IndexValueType slice) {
+    const SizeValueType slotOffset = slotOfSlice(slice) * sliceLength;
+    LocalRealType *     sums = sliceSums.data() + slotOffset * NumberOfSums;
+
+    ImageRegionType sliceRegion = paddedRegion;
+    sliceRegion.SetIndex(SliceAxis, slice);
+    sliceRegion.SetSize(SliceAxis, 1);
+    VirtualPointType     virtualPoint;
+    FixedImagePointType  mappedFixedPoint;
+    FixedImagePixelType  fixedImageValue;
+    MovingImagePointType mappedMovingPoint;
+    MovingImagePixelType movingImageValue;
+    SizeValueType        i = 0;
+    for (ImageRegionConstIteratorWithIndex<VirtualImageType> it(virtualImage, sliceRegion); !it.IsAtEnd(); ++it, ++i)
+    {
+      this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(it.GetIndex(), virtualPoint);
+      const bool pointIsValid =
+        this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue) &&
+        this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
+
+      const LocalRealType fixedValue = pointIsValid ? static_cast<LocalRealType>(fixedImageValue) : LocalRealType{};
+      const LocalRealType movingValue = pointIsValid ? static_cast<LocalRealType>(movingImageValue) : LocalRealType{};
+      fixedValues[slotOffset + i] = fixedValue;
+      movingValues[slotOffset + i] = movingValue;
+      validities[slotOffset + i] = pointIsValid;
+      sums[SumFixed * sliceLength + i] = fixedValue;
+      sums[SumMoving * sliceLength + i] = movingValue;
+      sums[SumFixed2 * sliceLength + i] = fixedValue * fixedValue;
+      sums[SumMoving2 * sliceLength + i] = movingValue * movingValue;
+      sums[SumFixedMoving * sliceLength + i] = fixedValue * movingValue;
+      sums[Count * sliceLength + i] = pointIsValid ? 1 : 0;
+    }
+
+    for (unsigned int axis = 0; axis < SliceAxis; ++axis)
+    {
+      for (unsigned int sum = 0; sum < NumberOfSums; ++sum)
+      {
+        BoxSumAlongAxis(sums + sum * sliceLength, sliceSize, axis, radius[axis], workBuffer);
+      }
+    }
+  };
+
+  const auto addSliceSums = [&](const IndexValueType slice, const LocalRealType sign) {
+    const LocalRealType * const sums = sliceSums.data() + slotOfSlice(slice) * NumberOfSums * sliceLength;
+    for (SizeValueType i = 0; i < NumberOfSums * sliceLength; ++i)
+    {
+      windowSums[i] += sign * sums[i];
+    }
+  };
+
+  MeasureType              metricValueResult{};
+  MeasureType              metricValueSum{};
+  const ScanIteratorType   scanIt;
+  const ScanParametersType scanParameters{};
+  ScanMemType              scanMem{};
+  scanMem.movingImageGradient.Fill(0.0);
+
+  DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
+
+  // The slices currently summed into windowSums.
+  IndexValueType windowBegin = firstSlice;
+  IndexValueType windowEnd = firstSlice - 1;
+
+  const IndexValueType subRegionFirstSlice = virtualImageSubRegion.GetIndex(SliceAxis);
+  const IndexValueType subRegionLastSlice =
+    subRegionFirstSlice + static_cast<IndexValueType>(virtualImageSubRegion.GetSize(SliceAxis)) - 1;
+  const auto sliceRadius = static_cast<IndexValueType>(radius[SliceAxis]);
+  for (IndexValueType slice = subRegionFirstSlice; slice <= subRegionLastSlice; ++slice)
+  {
+    for (; windowBegin < std::max(slice - sliceRadius, firstSlice); ++windowBegin)
+    {
+      addSliceSums(windowBegin, -1);
+    }
+    while (windowEnd < std::min(slice + sliceRadius, lastSlice))
+    {
+      ++windowEnd;
+      evaluateSlice(windowEnd);
+      addSliceSums(windowEnd, 1);
+    }
+
+    const SizeValueType slotOffset = slotOfSlice(slice) * sliceLength;
+    ImageRegionType     outputRegion = virtualImageSubRegion;
+    outputRegion.SetIndex(SliceAxis, slice);
+    outputRegion.SetSize(SliceAxis, 1);
+    for (ImageRegionConstIteratorWithIndex<VirtualImageType> it(virtualImage, outputRegion); !it.IsAtEnd(); ++it)
+    {
+      const VirtualIndexType & virtualIndex = it.GetIndex();
+      SizeValueType            i = 0;
+      for (unsigned int axis = SliceAxis; axis > 0; --axis)
+      {
+        i = i * sliceSize[axis - 1] +
+            static_cast<SizeValueType>(virtualIndex[axis - 1] - paddedRegion.GetIndex(axis - 1));
+      }
+      if (!validities[slotOffset + i])
+      {
+        continue;
+      }
+
+      const LocalRealType count = windowSums[Count * sliceLength + i];
+      const LocalRealType sumFixed = windowSums[SumFixed * sliceLength + i];
+      const LocalRealType sumMoving = windowSums[SumMoving * sliceLength + i];
+      const LocalRealType fixedMean = sumFixed / count;
+      const LocalRealType movingMean = sumMoving / count;
+
+      scanMem.fixedA = fixedValues[slotOffset + i] - fixedMean;
+      scanMem.movingA = movingValues[slotOffset + i] - movingMean;
+      scanMem.sFixedFixed = windowSums[SumFixed2 * sliceLength + i] - fixedMean * sumFixed - fixedMean * sumFixed +
+                            count * fixedMean * fixedMean;
+      scanMem.sMovingMoving = windowSums[SumMoving2 * sliceLength + i] - movingMean * sumMoving -
+                              movingMean * sumMoving + count * movingMean * movingMean;
+      scanMem.sFixedMoving = windowSums[SumFixedMoving * sliceLength + i] - movingMean * sumFixed -
+                             fixedMean * sumMoving + count * movingMean * fixedMean;
+
+      if (this->GetComputeDerivative())
+      {
+        this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(virtualIndex, scanMem.virtualPoint);
+        if (this->m_ANTSAssociate->GetGradientSourceIncludesMoving())
+        {
+          MovingImagePixelType movingImageValue;
+          this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(
+            scanMem.virtualPoint, scanMem.mappedMovingPoint, movingImageValue);
+          this->m_ANTSAssociate->ComputeMovingImageGradientAtPoint(scanMem.mappedMovingPoint,
+                                                                   scanMem.movingImageGradient);
+        }
+      }
+      this->ComputeMovingTransformDerivative(
+        scanIt, scanMem, scanParameters, localDerivativeResult, metricValueResult, threadId);
+
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+      metricValueSum -= metricValueResult;
+      if (this->GetComputeDerivative())
+      {
+        this->StorePointDerivativeResult(virtualIndex, threadId);
+      }
+    }
+  }
+
+  /* Store metric value result for this thread. */
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure = metricValueSum;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                             TImageToImageMetric,
+                                                                             TNeighborhoodCorrelationMetric>::
+  BoxSumAlongAxis(InternalComputationValueType *              buffer,
+                  const typename ImageRegionType::SizeType &  bufferSize,
+                  const unsigned int                          axis,
+                  const SizeValueType                         radius,
+                  std::vector<InternalComputationValueType> & workBuffer)
+{
+  // The lines along the axis are processed together, by blocks of `stride` contiguous values, so that the inner
+  // loops run over contiguous memory.
+  const SizeValueType length = bufferSize[axis];
+  SizeValueType       stride = 1;
+  for (unsigned int i = 0; i < axis; ++i)
+  {
+    stride *= bufferSize[i];
+  }
+  SizeValueType numberOfBlocks = 1;
+  for (unsigned int i = axis + 1; i < ImageRegionType::ImageDimension; ++i)
+  {
+    numberOfBlocks *= bufferSize[i];
+  }
+
+  workBuffer.resize((length + 1) * stride);
+  InternalComputationValueType * const values = workBuffer.data();
+  InternalComputationValueType * const runningSum = values + length * stride;
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    InternalComputationValueType * const blockBuffer = buffer + block * length * stride;
+    std::copy_n(blockBuffer, length * stride, values);
+
+    std::fill_n(runningSum, stride, InternalComputationValueType{});
+    for (SizeValueType j = 0; j < std::min(radius + 1, length); ++j)
+    {
+      for (SizeValueType k = 0; k < stride; ++k)
+      {
+        runningSum[k] += values[j * stride + k];
+      }
+    }
+    for (SizeValueType j = 0; j < length; ++j)
+    {
+      if (j > radius)
+      {
+        const InternalComputationValueType * const leaving = values + (j - radius - 1) * stride;
+        for (SizeValueType k = 0; k < stride; ++k)
+        {
+          runningSum[k] -= leaving[k];
+        }
+      }
+      if (j > 0 && j + radius < length)
+      {
+        const InternalComputationValueType * const entering = values + (j + radius) * stride;
+        for (SizeValueType k = 0; k < stride; ++k)
+        {
+          runningSum[k] += entering[k];
+        }
+      }
+      std::copy_n(runningSum, stride, blockBuffer + j * stride);
+    }
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
 void
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -538,6 +804,12 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   {
     const MovingImageGradientType movingImageGradient = scanMem.movingImageGradient;
 
+    /* Use a pre-allocated jacobian object for efficiency. It is computed first, as it also determines the parameters
+     * of the local derivatives with sparse derivative accumulation. */
+    const NumberOfParametersType numberOfLocalDerivatives =
+      this->ComputeMovingTransformJacobian(scanMem.virtualPoint, threadId);
+    const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+
     if (!(sFixedFixed > NumericTraits<LocalRealType>::epsilon() &&
           sMovingMoving > NumericTraits<LocalRealType>::epsilon()))
     {
@@ -551,20 +823,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
                           (fixedI - sFixedMoving / sMovingMoving * movingI) * movingImageGradient[qq];
     }
 
-    /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      scanMem.virtualPoint, jacobian, jacobianPositional);
-
-    const NumberOfParametersType numberOfLocalParameters =
-      this->m_Associate->GetMovingTransform()->GetNumberOfLocalParameters();
-
-    for (NumberOfParametersType par = 0; par < numberOfLocalParameters; ++par)
+    for (NumberOfParametersType par = 0; par < numberOfLocalDerivatives; ++par)
     {
       deriv[par] = DerivativeValueType{};
       for (ImageDimensionType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
@@ -92,6 +92,12 @@ protected:
                DerivativeType &                localDerivativeReturn,
                const ThreadIdType              threadId) const override;
 
+  bool
+  SupportsVirtualPointBatches() const override
+  {
+    return true;
+  }
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
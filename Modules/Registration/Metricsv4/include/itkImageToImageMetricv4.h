@@ -516,10 +516,10 @@ public:
   /** Set number of work units to use. This the maximum number of work units to use
    * when multithreaded.  The actual number of work units used (may be less than
    * this value) can be obtained with \c GetNumberOfWorkUnitsUsed. */
-  virtual void
-  SetMaximumNumberOfWorkUnits(const ThreadIdType number);
-  virtual ThreadIdType
-  GetMaximumNumberOfWorkUnits() const;
+  void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType number) override;
+  ThreadIdType
+  GetMaximumNumberOfWorkUnits() const override;
 
 #if !defined(ITK_LEGACY_REMOVE)
   /** Get number of threads to used in the most recent
@@ -598,6 +598,22 @@ public:
   itkSetMacro(FloatingPointCorrectionResolution, DerivativeValueType);
   itkGetConstMacro(FloatingPointCorrectionResolution, DerivativeValueType);
 
+  /** Set/Get the option to accumulate the derivatives of each point only for
+   * the parameters with local support at the point, e.g. the coefficients of
+   * the support region of a BSplineTransform, instead of for all the
+   * parameters. False by default. It only applies to transforms that are not
+   * displacement fields, and to the metrics whose threaders support it
+   * (MeanSquares, JointHistogramMutualInformation and
+   * ANTSNeighborhoodCorrelation), and is ignored otherwise.
+   * Each thread then accumulates into pages of parameters allocated when
+   * first touched, rather than into a full-length derivative, and the pages
+   * are reduced in parallel. With high-dimensional transforms, this saves
+   * both the per-thread memory and the serial reduction over all parameters.
+   * \sa Transform::ComputeSparseJacobianWithRespectToParameters */
+  itkSetMacro(UseSparseDerivativeAccumulation, bool);
+  itkGetConstMacro(UseSparseDerivativeAccumulation, bool);
+  itkBooleanMacro(UseSparseDerivativeAccumulation);
+
   /* Initialize the metric before calling GetValue or GetDerivative.
    * Derived classes must call this Superclass version if they override
    * this to perform their own initialization.
@@ -694,6 +710,13 @@ protected:
                                   MovingImagePointType &   mappedMovingPoint,
                                   MovingImagePixelType &   mappedMovingPixelValue) const;
 
+  /** Evaluate a point of the MovingImage domain, that the moving transform mapped from the VirtualImage domain.
+   * The point is checked against the mask and the buffer as by \c TransformAndEvaluateMovingPoint, which calls this
+   * method after transforming the point. */
+  bool
+  EvaluateMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                      MovingImagePixelType &       mappedMovingPixelValue) const;
+
   /** Compute image derivatives for a Fixed point. */
   virtual void
   ComputeFixedImageGradientAtPoint(const FixedImagePointType & mappedPoint, FixedImageGradientType & gradient) const;
@@ -798,6 +821,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, with the same images, masks, sampled
+   * point sets and settings. The interpolators, gradient filters and
+   * gradient calculators are shared, as they are not modified during the
+   * evaluation of the metric. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   /** Map the fixed point set samples to the virtual domain */
   void
@@ -859,6 +889,7 @@ private:
 
   bool                m_UseFloatingPointCorrection{};
   DerivativeValueType m_FloatingPointCorrectionResolution{};
+  bool                m_UseSparseDerivativeAccumulation{ false };
 
   MetricTraits m_MetricTraits{};
 
@@ -348,9 +348,6 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
                                   MovingImagePointType &   mappedMovingPoint,
                                   MovingImagePixelType &   mappedMovingPixelValue) const
 {
-  bool pointIsValid = true;
-  mappedMovingPixelValue = MovingImagePixelType{};
-
   // map the point into moving space
 
   // Before transforming points, we should convert their types from the ImagePointType (aka Point<double, dim>)
@@ -364,6 +361,22 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   localMappedMovingPoint = this->m_MovingTransform->TransformPoint(localVirtualPoint);
   mappedMovingPoint.CastFrom(localMappedMovingPoint);
 
+  return this->EvaluateMovingPoint(mappedMovingPoint, mappedMovingPixelValue);
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+bool
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  EvaluateMovingPoint(const MovingImagePointType & mappedMovingPoint,
+                      MovingImagePixelType &       mappedMovingPixelValue) const
+{
+  bool pointIsValid = true;
+  mappedMovingPixelValue = MovingImagePixelType{};
+
   // check against the mask if one is assigned
   if (this->m_MovingImageMask)
   {
@@ -527,13 +540,17 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   SetMaximumNumberOfWorkUnits(const ThreadIdType number)
 {
-  if (number != this->m_SparseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads())
+  // The maximum number of threads of a new threader may already be the requested one, while its number of work
+  // units is not, so both are checked.
+  if (number != this->m_SparseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads() ||
+      number != this->m_SparseGetValueAndDerivativeThreader->GetNumberOfWorkUnits())
   {
     this->m_SparseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(number);
     this->m_SparseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(number);
     this->Modified();
   }
-  if (number != this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads())
+  if (number != this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads() ||
+      number != this->m_DenseGetValueAndDerivativeThreader->GetNumberOfWorkUnits())
   {
     this->m_DenseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(number);
     this->m_DenseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(number);
@@ -649,6 +666,55 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   return region.GetNumberOfPixels();
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+typename LightObject::Pointer
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetFixedImage(this->m_FixedImage);
+  rval->SetMovingImage(this->m_MovingImage);
+  rval->SetFixedInterpolator(this->m_FixedInterpolator);
+  rval->SetMovingInterpolator(this->m_MovingInterpolator);
+  rval->SetFixedImageMask(this->m_FixedImageMask);
+  rval->SetMovingImageMask(this->m_MovingImageMask);
+  rval->SetFixedSampledPointSet(this->m_FixedSampledPointSet);
+  rval->SetUseSampledPointSet(this->m_UseSampledPointSet);
+  if (this->m_UseVirtualSampledPointSet)
+  {
+    rval->SetVirtualSampledPointSet(this->m_VirtualSampledPointSet);
+  }
+  rval->SetUseVirtualSampledPointSet(this->m_UseVirtualSampledPointSet);
+  rval->SetFixedImageGradientFilter(this->m_FixedImageGradientFilter);
+  rval->SetMovingImageGradientFilter(this->m_MovingImageGradientFilter);
+  rval->SetFixedImageGradientCalculator(this->m_FixedImageGradientCalculator);
+  rval->SetMovingImageGradientCalculator(this->m_MovingImageGradientCalculator);
+  rval->SetUseFixedImageGradientFilter(this->m_UseFixedImageGradientFilter);
+  rval->SetUseMovingImageGradientFilter(this->m_UseMovingImageGradientFilter);
+  rval->SetUseFloatingPointCorrection(this->m_UseFloatingPointCorrection);
+  rval->SetFloatingPointCorrectionResolution(this->m_FloatingPointCorrectionResolution);
+  rval->SetUseSparseDerivativeAccumulation(this->m_UseSparseDerivativeAccumulation);
+  rval->m_SparseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(
+    this->m_SparseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads());
+  rval->m_SparseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(
+    this->m_SparseGetValueAndDerivativeThreader->GetNumberOfWorkUnits());
+  rval->m_DenseGetValueAndDerivativeThreader->SetMaximumNumberOfThreads(
+    this->m_DenseGetValueAndDerivativeThreader->GetMaximumNumberOfThreads());
+  rval->m_DenseGetValueAndDerivativeThreader->SetNumberOfWorkUnits(
+    this->m_DenseGetValueAndDerivativeThreader->GetNumberOfWorkUnits());
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -666,6 +732,7 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
      << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+  itkPrintSelfBooleanMacro(UseSparseDerivativeAccumulation);
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
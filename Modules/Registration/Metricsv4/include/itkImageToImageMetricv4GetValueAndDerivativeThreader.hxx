@@ -20,6 +20,9 @@
 
 #include "itkImageRegionConstIteratorWithIndex.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace itk
 {
 
@@ -31,12 +34,33 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<
 {
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
   using IteratorType = ImageRegionConstIteratorWithIndex<VirtualImageType>;
-  VirtualPointType virtualPoint;
-  for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
+  if (this->SupportsVirtualPointBatches())
+  {
+    // Process the points by lines of the subregion.
+    const SizeValueType           lineLength = imageSubRegion.GetSize(0);
+    std::vector<VirtualIndexType> virtualIndices(lineLength);
+    std::vector<VirtualPointType> virtualPoints(lineLength);
+    SizeValueType                 numberOfPoints = 0;
+    for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
+    {
+      virtualIndices[numberOfPoints] = it.GetIndex();
+      virtualImage->TransformIndexToPhysicalPoint(virtualIndices[numberOfPoints], virtualPoints[numberOfPoints]);
+      if (++numberOfPoints == lineLength)
+      {
+        this->ProcessVirtualPoints(virtualIndices.data(), virtualPoints.data(), numberOfPoints, threadId);
+        numberOfPoints = 0;
+      }
+    }
+  }
+  else
   {
-    const VirtualIndexType & virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    VirtualPointType virtualPoint;
+    for (IteratorType it(virtualImage, imageSubRegion); !it.IsAtEnd(); ++it)
+    {
+      const VirtualIndexType & virtualIndex = it.GetIndex();
+      virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
+      this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    }
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -53,11 +77,32 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   const ElementIdentifierType                   begin = indexSubRange[0];
   const ElementIdentifierType                   end = indexSubRange[1];
   const typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
-  for (ElementIdentifierType i = begin; i <= end; ++i)
+  if (this->SupportsVirtualPointBatches())
+  {
+    // Process the points by batches of consecutive points.
+    constexpr SizeValueType       batchSize = 256;
+    std::vector<VirtualIndexType> virtualIndices(batchSize);
+    std::vector<VirtualPointType> virtualPoints(batchSize);
+    for (ElementIdentifierType batchBegin = begin; batchBegin <= end; batchBegin += batchSize)
+    {
+      const auto numberOfPoints =
+        static_cast<SizeValueType>(std::min<ElementIdentifierType>(batchSize, end - batchBegin + 1));
+      for (SizeValueType j = 0; j < numberOfPoints; ++j)
+      {
+        virtualPoints[j] = virtualSampledPointSet->GetPoint(batchBegin + j);
+        virtualIndices[j] = virtualImage->TransformPhysicalPointToIndex(virtualPoints[j]);
+      }
+      this->ProcessVirtualPoints(virtualIndices.data(), virtualPoints.data(), numberOfPoints, threadId);
+    }
+  }
+  else
   {
-    const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
-    const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
-    this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    for (ElementIdentifierType i = begin; i <= end; ++i)
+    {
+      const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
+      const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+      this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
+    }
   }
   // Finalize per thread actions
   this->m_Associate->FinalizeThread(threadId);
@@ -22,6 +22,7 @@
 #include "itkCompensatedSummation.h"
 
 #include <memory> // For unique_ptr.
+#include <vector>
 
 namespace itk
 {
@@ -122,6 +123,27 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** Whether the points may be processed in batches by \c ProcessVirtualPoints,
+   * rather than one by one by \c ProcessVirtualPoint. Derived classes that
+   * only override \c ProcessPoint may return true, so that the moving
+   * transform maps the points of a batch by a single call to
+   * Transform::TransformPoints. False by default, as derived classes that
+   * override \c ProcessVirtualPoint would be bypassed. */
+  virtual bool
+  SupportsVirtualPointBatches() const
+  {
+    return false;
+  }
+
+  /** Process a batch of virtual points, like \c ProcessVirtualPoint does for
+   * each of them, except that the moving transform maps all the points first.
+   * Used by the threaders when \c SupportsVirtualPointBatches is true. */
+  void
+  ProcessVirtualPoints(const VirtualIndexType * virtualIndices,
+                       const VirtualPointType * virtualPoints,
+                       SizeValueType            numberOfPoints,
+                       const ThreadIdType       threadId);
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -170,6 +192,28 @@ protected:
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Whether the derived class computes the local derivatives from
+   * ComputeMovingTransformJacobian, and stores them with
+   * StorePointDerivativeResult, as required by the sparse derivative
+   * accumulation of the metric. False by default. */
+  virtual bool
+  SupportsSparseDerivativeAccumulation() const
+  {
+    return false;
+  }
+
+  /** Compute the jacobian of the moving transform with respect to the
+   * parameters at a virtual point, into the MovingTransformJacobian of the
+   * thread, and return the number of its columns, i.e. of the local
+   * derivatives to compute. With sparse derivative accumulation, the columns
+   * are those of the parameters with local support at the point only, and the
+   * parameters are kept for StorePointDerivativeResult. */
+  NumberOfParametersType
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const;
+
+  /** Number of consecutive parameters per page of the sparse derivative accumulation. */
+  static constexpr NumberOfParametersType SparseDerivativePageSize = 1024;
+
   struct GetValueAndDerivativePerThreadStruct
   {
     /** Intermediary threaded metric value storage. */
@@ -186,6 +230,12 @@ protected:
      * classes for efficiency. */
     JacobianType MovingTransformJacobian;
     JacobianType MovingTransformJacobianPositional;
+    /** The parameters of the columns of MovingTransformJacobian, with sparse derivative accumulation. */
+    std::vector<typename MovingTransformType::NumberOfParametersType> SparseParameterIndices;
+    /** Intermediary threaded derivative storage with sparse derivative accumulation: the pages of
+     * SparseDerivativePageSize parameters, allocated when the derivative of a point first has one of their
+     * parameters. */
+    std::vector<std::unique_ptr<CompensatedDerivativeValueType[]>> SparseCompensatedDerivatives;
   };
 
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
@@ -200,6 +250,18 @@ protected:
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType m_CachedNumberOfParameters{};
   mutable NumberOfParametersType m_CachedNumberOfLocalParameters{};
+
+  /** Whether the derivatives are accumulated sparsely, during the current evaluation. */
+  bool m_UseSparseDerivativeAccumulation{ false };
+
+private:
+  /** Implements \c ProcessVirtualPoint, and \c ProcessVirtualPoints when
+   * the moving point is already mapped, i.e. \c precomputedMovingPoint is not null. */
+  bool
+  ProcessVirtualPointImpl(const VirtualIndexType &     virtualIndex,
+                          const VirtualPointType &     virtualPoint,
+                          const MovingImagePointType * precomputedMovingPoint,
+                          const ThreadIdType           threadId);
 };
 
 } // end namespace itk
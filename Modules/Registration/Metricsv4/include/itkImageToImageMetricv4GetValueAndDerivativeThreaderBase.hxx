@@ -21,6 +21,8 @@
 #include "itkNumericTraits.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -43,6 +45,10 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   // Cache some values
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
+  this->m_UseSparseDerivativeAccumulation =
+    this->m_Associate->GetUseSparseDerivativeAccumulation() && this->SupportsSparseDerivativeAccumulation() &&
+    this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+      MovingTransformType::TransformCategoryEnum::DisplacementField;
 
   /* Per-thread results */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
@@ -53,6 +59,15 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   {
     for (ThreadIdType i = 0; i < numWorkUnitsUsed; ++i)
     {
+      if (this->m_UseSparseDerivativeAccumulation)
+      {
+        /* The local derivatives and the jacobian are sized for each point by
+         * ComputeMovingTransformJacobian, and the pages of derivatives are
+         * allocated by StorePointDerivativeResult, when first used. */
+        this->m_GetValueAndDerivativePerThreadVariables[i].SparseCompensatedDerivatives.resize(
+          (this->m_CachedNumberOfParameters + SparseDerivativePageSize - 1) / SparseDerivativePageSize);
+        continue;
+      }
       /* Allocate intermediary per-thread storage used to get results from
        * derived classes */
       this->m_GetValueAndDerivativePerThreadVariables[i].LocalDerivatives.SetSize(
@@ -96,7 +111,8 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
     if (this->m_Associate->GetComputeDerivative())
     {
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
-          MovingTransformType::TransformCategoryEnum::DisplacementField)
+            MovingTransformType::TransformCategoryEnum::DisplacementField &&
+          !this->m_UseSparseDerivativeAccumulation)
       {
         /* Be sure to init to 0 here, because the threader may not use
          * all the threads if the region is better split into fewer
@@ -128,8 +144,49 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   /* For global transforms, sum the derivatives from each region. */
   if (this->m_Associate->GetComputeDerivative())
   {
-    if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
-        MovingTransformType::TransformCategoryEnum::DisplacementField)
+    if (this->m_UseSparseDerivativeAccumulation)
+    {
+      /* Sum the pages concurrently. The derivatives of a page are summed in
+       * the order of the threads, as in the dense case, so that the result
+       * does not depend on the scheduling. */
+      const SizeValueType numberOfPages =
+        this->m_GetValueAndDerivativePerThreadVariables[0].SparseCompensatedDerivatives.size();
+      this->GetMultiThreader()->ParallelizeArray(
+        0,
+        numberOfPages,
+        [this, numWorkUnitsUsed](SizeValueType page) {
+          std::vector<const CompensatedDerivativeValueType *> threadPages;
+          for (ThreadIdType i = 0; i < numWorkUnitsUsed; ++i)
+          {
+            const auto & threadPage =
+              this->m_GetValueAndDerivativePerThreadVariables[i].SparseCompensatedDerivatives[page];
+            if (threadPage)
+            {
+              threadPages.push_back(threadPage.get());
+            }
+          }
+          if (threadPages.empty())
+          {
+            return;
+          }
+          const NumberOfParametersType firstParameter = page * SparseDerivativePageSize;
+          const NumberOfParametersType pageSize =
+            std::min(SparseDerivativePageSize, this->m_CachedNumberOfParameters - firstParameter);
+          for (NumberOfParametersType p = 0; p < pageSize; ++p)
+          {
+            CompensatedDerivativeValueType sum;
+            sum.ResetToZero();
+            for (const CompensatedDerivativeValueType * threadPage : threadPages)
+            {
+              sum += threadPage[p].GetSum();
+            }
+            (*(this->m_Associate->m_DerivativeResult))[firstParameter + p] += sum.GetSum();
+          }
+        },
+        nullptr);
+    }
+    else if (this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+             MovingTransformType::TransformCategoryEnum::DisplacementField)
     {
       for (NumberOfParametersType p = 0; p < this->m_Associate->GetNumberOfParameters(); ++p)
       {
@@ -177,6 +234,55 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   const VirtualIndexType & virtualIndex,
   const VirtualPointType & virtualPoint,
   const ThreadIdType       threadId)
+{
+  return this->ProcessVirtualPointImpl(virtualIndex, virtualPoint, nullptr, threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::ProcessVirtualPoints(
+  const VirtualIndexType * virtualIndices,
+  const VirtualPointType * virtualPoints,
+  SizeValueType            numberOfPoints,
+  const ThreadIdType       threadId)
+{
+  // Before transforming points, we should convert their types from the ImagePointType (aka Point<double, dim>)
+  // to TransformPointType (aka Point<ScalarType, dim>).
+  std::vector<typename MovingTransformType::InputPointType> localVirtualPoints(numberOfPoints);
+  std::vector<MovingOutputPointType>                        localMappedMovingPoints(numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    localVirtualPoints[i].CastFrom(virtualPoints[i]);
+  }
+
+  try
+  {
+    this->m_Associate->m_MovingTransform->TransformPoints(
+      localVirtualPoints.data(), localMappedMovingPoints.data(), numberOfPoints);
+  }
+  catch (const ExceptionObject & exc)
+  {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+  }
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    MovingImagePointType mappedMovingPoint;
+    mappedMovingPoint.CastFrom(localMappedMovingPoints[i]);
+    this->ProcessVirtualPointImpl(virtualIndices[i], virtualPoints[i], &mappedMovingPoint, threadId);
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ProcessVirtualPointImpl(const VirtualIndexType &     virtualIndex,
+                          const VirtualPointType &     virtualPoint,
+                          const MovingImagePointType * precomputedMovingPoint,
+                          const ThreadIdType           threadId)
 {
   FixedImagePointType     mappedFixedPoint;
   FixedImagePixelType     mappedFixedPixelValue;
@@ -215,8 +321,16 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
 
   try
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+    if (precomputedMovingPoint)
+    {
+      mappedMovingPoint = *precomputedMovingPoint;
+      pointIsValid = this->m_Associate->EvaluateMovingPoint(mappedMovingPoint, mappedMovingPixelValue);
+    }
+    else
+    {
+      pointIsValid =
+        this->m_Associate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, mappedMovingPixelValue);
+    }
     if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
         this->m_Associate->GetGradientSourceIncludesMoving())
     {
@@ -281,10 +395,15 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
       MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
     /* Global support */
+    /* With sparse derivative accumulation, the local derivatives are those of the parameters with local support. */
+    const NumberOfParametersType numberOfDerivatives =
+      this->m_UseSparseDerivativeAccumulation
+        ? this->m_GetValueAndDerivativePerThreadVariables[threadId].SparseParameterIndices.size()
+        : this->m_CachedNumberOfParameters;
     if (this->m_Associate->GetUseFloatingPointCorrection())
     {
       const DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
-      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+      for (NumberOfParametersType p = 0; p < numberOfDerivatives; ++p)
       {
         auto test = static_cast<intmax_t>(
           this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] * correctionResolution);
@@ -292,6 +411,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
           static_cast<DerivativeValueType>(test / correctionResolution);
       }
     }
+    if (this->m_UseSparseDerivativeAccumulation)
+    {
+      AlignedGetValueAndDerivativePerThreadStruct & threadVariables =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId];
+      for (NumberOfParametersType i = 0; i < numberOfDerivatives; ++i)
+      {
+        const NumberOfParametersType parameter = threadVariables.SparseParameterIndices[i];
+        auto & page = threadVariables.SparseCompensatedDerivatives[parameter / SparseDerivativePageSize];
+        if (!page)
+        {
+          page = std::make_unique<CompensatedDerivativeValueType[]>(SparseDerivativePageSize);
+        }
+        page[parameter % SparseDerivativePageSize] += threadVariables.LocalDerivatives[i];
+      }
+      return;
+    }
     for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
     {
       this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
@@ -326,6 +461,32 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+auto
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  -> NumberOfParametersType
+{
+  AlignedGetValueAndDerivativePerThreadStruct & threadVariables =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  if (this->m_UseSparseDerivativeAccumulation)
+  {
+    this->m_Associate->GetMovingTransform()->ComputeSparseJacobianWithRespectToParameters(
+      virtualPoint, threadVariables.MovingTransformJacobian, threadVariables.SparseParameterIndices);
+    const NumberOfParametersType numberOfDerivatives = threadVariables.SparseParameterIndices.size();
+    if (threadVariables.LocalDerivatives.Size() < numberOfDerivatives)
+    {
+      threadVariables.LocalDerivatives.SetSize(numberOfDerivatives);
+    }
+    return numberOfDerivatives;
+  }
+
+  /** For dense transforms, this returns identity */
+  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
+    virtualPoint, threadVariables.MovingTransformJacobian, threadVariables.MovingTransformJacobianPositional);
+  return this->m_CachedNumberOfLocalParameters;
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 bool
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::GetComputeDerivative()
@@ -103,6 +103,18 @@ protected:
                DerivativeType &                localDerivativeReturn,
                const ThreadIdType              threadId) const override;
 
+  bool
+  SupportsSparseDerivativeAccumulation() const override
+  {
+    return true;
+  }
+
+  bool
+  SupportsVirtualPointBatches() const override
+  {
+    return true;
+  }
+
   inline InternalComputationValueType
   ComputeFixedImageMarginalPDFDerivative(const MarginalPDFPointType & margPDFpoint, const ThreadIdType threadId) const;
 
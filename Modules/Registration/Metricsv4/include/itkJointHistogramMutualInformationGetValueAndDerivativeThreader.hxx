@@ -156,16 +156,10 @@ JointHistogramMutualInformationGetValueAndDerivativeThreader<
   }
 
   /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  const NumberOfParametersType numberOfLocalDerivatives = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+  const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_JointAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (NumberOfParametersType par = 0; par < this->GetCachedNumberOfLocalParameters(); ++par)
+  for (NumberOfParametersType par = 0; par < numberOfLocalDerivatives; ++par)
   {
     InternalComputationValueType sum{};
     for (SizeValueType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
@@ -204,6 +204,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, including its settings. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   /** Count of the number of valid histogram points. */
   SizeValueType m_JointHistogramTotalCount{ 0 };
 
@@ -65,10 +65,14 @@ namespace itk
  * \warning Local-support transforms are not yet supported. If used,
  * an exception is thrown during Initialize().
  *
- * \note The per-iteration post-processing code is not multi-threaded, but could be
- * readily be made so for a small performance gain.
- * See GetValueCommonAfterThreadedExecution(), GetValueAndDerivative()
- * and threader::AfterThreadedExecution().
+ * The joint PDFs, fixed image marginal PDFs and (for global transforms)
+ * joint PDF derivatives accumulated by each work unit are merged by a
+ * parallel pairwise (tree) reduction, in GetValueCommonAfterThreadedExecution().
+ * The rest of the per-iteration post-processing code is not multi-threaded.
+ *
+ * When the fixed image, fixed transform and sampling do not change between
+ * iterations, SetUseFixedSampleCache(true) avoids mapping and interpolating
+ * the fixed image at every sample in every iteration.
  *
  * The algorithm and much of the code was copied from the previous
  * Mattes MI metric, i.e. itkMattesMutualInformationImageToImageMetric.
@@ -145,6 +149,15 @@ public:
   itkSetClampMacro(NumberOfHistogramBins, SizeValueType, 5, NumericTraits<SizeValueType>::max());
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
 
+  /** Set/Get whether the Parzen window index of the fixed image value at each sample is computed once, by the
+   * first evaluation after Initialize(), and reused by the following evaluations, instead of transforming and
+   * interpolating the fixed image at every sample, in every evaluation. The cache is refilled when the fixed image,
+   * the fixed transform, the fixed interpolator, the fixed image mask or the sampled point set is modified, so this
+   * must not be used with a fixed transform that may change without its MTime being updated. Off by default. */
+  itkSetMacro(UseFixedSampleCache, bool);
+  itkGetConstMacro(UseFixedSampleCache, bool);
+  itkBooleanMacro(UseFixedSampleCache);
+
   void
   Initialize() override;
 
@@ -211,6 +224,10 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, including its settings. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
   using JointPDFIndexType = typename JointPDFType::IndexType;
   using JointPDFValueType = typename JointPDFType::PixelType;
   using JointPDFRegionType = typename JointPDFType::RegionType;
@@ -232,6 +249,10 @@ protected:
   OffsetValueType
   ComputeSingleFixedImageParzenWindowIndex(const FixedImagePixelType & value) const;
 
+  /** The latest MTime of the inputs that determine the fixed image value at each sample. */
+  ModifiedTimeType
+  GetFixedSampleCacheInputsMTime() const;
+
   /** Variables to define the marginal and joint histograms. */
   SizeValueType m_NumberOfHistogramBins{ 50 };
   PDFValueType  m_MovingImageNormalizedMin{};
@@ -351,6 +372,19 @@ protected:
   std::mutex                                m_JointPDFDerivativesLock{};
   typename JointPDFDerivativesType::Pointer m_JointPDFDerivatives{};
 
+  /** The joint PDF derivatives of each work unit, for global transforms, the first one being m_JointPDFDerivatives.
+   * Empty when the work units share m_JointPDFDerivatives through m_ThreaderDerivativeManager instead, because the
+   * number of elements of the copies would exceed MaximumThreaderJointPDFDerivativesSize. */
+  std::vector<typename JointPDFDerivativesType::Pointer> m_ThreaderJointPDFDerivatives{};
+
+  static constexpr SizeValueType MaximumThreaderJointPDFDerivativesSize = SizeValueType{ 1 } << 24;
+
+  /** The fixed sample cache: the fixed image Parzen window index of each sample, -1 for a sample whose fixed point
+   * is not valid, and the MTime of the inputs it was filled from, 0 when it is not valid. */
+  bool                         m_UseFixedSampleCache{ false };
+  std::vector<OffsetValueType> m_FixedSampleParzenWindowIndices{};
+  ModifiedTimeType             m_FixedSampleCacheMTime{ 0 };
+
   PDFValueType m_JointPDFSum{};
 
   /** Store the per-point local derivative result by parzen window bin.
@@ -19,6 +19,7 @@
 #define itkMattesMutualInformationImageToImageMetricv4_hxx
 
 #include "itkCompensatedSummation.h"
+#include <algorithm>
 #include <mutex>
 
 namespace itk
@@ -266,6 +267,10 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   itkDebugMacro("FixedImageBinSize: " << this->m_FixedImageBinSize);
   itkDebugMacro("MovingImageBinSize; " << this->m_MovingImageBinSize);
 
+  // The Parzen window indices depend on the bin sizes.
+  this->m_FixedSampleParzenWindowIndices.clear();
+  this->m_FixedSampleCacheMTime = 0;
+
   /* Porting note: the rest of the initialization that was performed
    * in MattesMutualImageToImageMetric::Initialize
    * is now performed in the threader BeforeThreadedExecution method */
@@ -283,7 +288,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && this->m_ThreaderJointPDFDerivatives.empty())
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -462,19 +467,48 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   const SizeValueType       numberOfVoxels = this->m_NumberOfHistogramBins * this->m_NumberOfHistogramBins;
   JointPDFValueType * const pdfPtrStart = this->m_ThreaderJointPDF[0]->GetBufferPointer();
 
-  for (unsigned int t = 1; t < localNumberOfWorkUnitsUsed; ++t)
+  const SizeValueType numberOfDerivativeElements =
+    this->m_ThreaderJointPDFDerivatives.empty() ? 0 : numberOfVoxels * this->GetNumberOfLocalParameters();
+
+  // Merge the per work unit partial results pairwise, into the first work unit: at each step, work unit t adds
+  // those of work unit t + stride, for each t that is a multiple of 2 * stride. The pairs of a step are merged
+  // concurrently, so that the merge takes log2(localNumberOfWorkUnitsUsed) steps, instead of
+  // localNumberOfWorkUnitsUsed - 1 serial ones.
+  MultiThreaderBase * const multiThreader = this->m_UseSampledPointSet
+                                              ? this->m_SparseGetValueAndDerivativeThreader->GetMultiThreader()
+                                              : this->m_DenseGetValueAndDerivativeThreader->GetMultiThreader();
+  for (ThreadIdType stride = 1; stride < localNumberOfWorkUnitsUsed; stride *= 2)
   {
-    JointPDFValueType *             pdfPtr = pdfPtrStart;
-    const JointPDFValueType *       tPdfPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer();
-    const JointPDFValueType * const tPdfPtrEnd = tPdfPtr + numberOfVoxels;
-    while (tPdfPtr < tPdfPtrEnd)
-    {
-      *(pdfPtr++) += *(tPdfPtr++);
-    }
-    for (SizeValueType i = 0; i < this->m_NumberOfHistogramBins; ++i)
-    {
-      this->m_ThreaderFixedImageMarginalPDF[0][i] += this->m_ThreaderFixedImageMarginalPDF[t][i];
-    }
+    const SizeValueType numberOfPairs = (localNumberOfWorkUnitsUsed - stride + 2 * stride - 1) / (2 * stride);
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfPairs,
+      [this, stride, numberOfVoxels, numberOfDerivativeElements](SizeValueType pair) {
+        const SizeValueType t = 2 * stride * pair;
+
+        JointPDFValueType *             pdfPtr = this->m_ThreaderJointPDF[t]->GetBufferPointer();
+        const JointPDFValueType *       tPdfPtr = this->m_ThreaderJointPDF[t + stride]->GetBufferPointer();
+        const JointPDFValueType * const tPdfPtrEnd = tPdfPtr + numberOfVoxels;
+        while (tPdfPtr < tPdfPtrEnd)
+        {
+          *(pdfPtr++) += *(tPdfPtr++);
+        }
+        for (SizeValueType i = 0; i < this->m_NumberOfHistogramBins; ++i)
+        {
+          this->m_ThreaderFixedImageMarginalPDF[t][i] += this->m_ThreaderFixedImageMarginalPDF[t + stride][i];
+        }
+        if (numberOfDerivativeElements > 0)
+        {
+          JointPDFDerivativesValueType * derivativePtr = this->m_ThreaderJointPDFDerivatives[t]->GetBufferPointer();
+          const JointPDFDerivativesValueType * tDerivativePtr =
+            this->m_ThreaderJointPDFDerivatives[t + stride]->GetBufferPointer();
+          for (SizeValueType i = 0; i < numberOfDerivativeElements; ++i)
+          {
+            derivativePtr[i] += tDerivativePtr[i];
+          }
+        }
+      },
+      nullptr);
   }
 
   // Sum of this threads domain into the this->m_JointPDFSum that covers that part of the domain.
@@ -488,6 +522,30 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 }
 
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+typename LightObject::Pointer
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::InternalClone() const
+{
+  typename LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  rval->SetNumberOfHistogramBins(this->m_NumberOfHistogramBins);
+  rval->SetUseFixedSampleCache(this->m_UseFixedSampleCache);
+  return loPtr;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -501,6 +559,34 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseFixedSampleCache);
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+ModifiedTimeType
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetFixedSampleCacheInputsMTime() const
+{
+  ModifiedTimeType mtime = this->m_FixedImage->GetMTime();
+  mtime = std::max(mtime, this->m_FixedTransform->GetMTime());
+  mtime = std::max(mtime, this->m_FixedInterpolator->GetMTime());
+  if (this->m_FixedImageMask)
+  {
+    mtime = std::max(mtime, this->m_FixedImageMask->GetMTime());
+  }
+  if (this->m_UseSampledPointSet)
+  {
+    mtime = std::max(mtime, this->m_VirtualSampledPointSet->GetMTime());
+  }
+  return mtime;
 }
 
 template <typename TFixedImage,
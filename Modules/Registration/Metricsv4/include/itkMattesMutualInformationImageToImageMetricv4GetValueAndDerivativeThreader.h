@@ -52,6 +52,7 @@ public:
   using typename Superclass::AssociateType;
 
   using ImageToImageMetricv4Type = typename Superclass::ImageToImageMetricv4Type;
+  using typename Superclass::VirtualImageType;
   using typename Superclass::VirtualPointType;
   using typename Superclass::VirtualIndexType;
   using typename Superclass::FixedImagePointType;
@@ -97,6 +98,12 @@ protected:
   void
   AfterThreadedExecution() override;
 
+  /** Processes the points of the subdomain like the superclass, except when the fixed sample cache of the metric
+   * is used: the fixed image Parzen window index of each sample is then read from the cache instead of being
+   * computed from the fixed image, or computed and stored in the cache, when it is being filled. */
+  void
+  ThreadedExecution(const DomainType & domain, const ThreadIdType threadId) override;
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -121,9 +128,32 @@ protected:
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
 private:
+  /** Processes a virtual point, identified by sampleId in the fixed sample cache. */
+  void
+  ProcessVirtualPointUsingFixedSampleCache(const SizeValueType      sampleId,
+                                           const VirtualIndexType & virtualIndex,
+                                           const VirtualPointType & virtualPoint,
+                                           const ThreadIdType       threadId);
+
+  /** Adds the contribution of a point to the joint PDF and its derivatives, given the Parzen window index of its
+   * fixed image value. */
+  void
+  ProcessPointWithFixedParzenWindowIndex(const VirtualIndexType &        virtualIndex,
+                                         const VirtualPointType &        virtualPoint,
+                                         const OffsetValueType           fixedImageParzenWindowIndex,
+                                         const MovingImagePixelType &    movingImageValue,
+                                         const MovingImageGradientType & movingImageGradient,
+                                         const ThreadIdType              threadId) const;
+
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate{};
+
+  /** Whether the current evaluation fills the fixed sample cache of the metric, or reads it, and the MTime of the
+   * inputs of the cache it is filled from. */
+  bool             m_FillFixedSampleCache{ false };
+  bool             m_ReadFixedSampleCache{ false };
+  ModifiedTimeType m_FixedSampleCacheInputsMTime{ 0 };
 };
 
 } // end namespace itk
@@ -18,6 +18,8 @@
 #ifndef itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkMattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -134,6 +136,7 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+    this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.clear();
   }
 
   if (this->m_MattesAssociate->GetComputeDerivative() && this->m_MattesAssociate->HasLocalSupport())
@@ -143,6 +146,7 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     this->m_MattesAssociate->m_JointPdfIndex1DArray.assign(this->m_MattesAssociate->GetNumberOfParameters(), 0);
     // Don't need this with local-support
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+    this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.clear();
     // This always has four entries because the parzen window size is fixed.
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.resize(4);
     // The first container cannot point to the existing derivative result
@@ -189,27 +193,170 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       // Initialize to zero for accumulation
       this->m_MattesAssociate->m_JointPDFDerivatives->FillBuffer(0.0F);
     }
-    if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+
+    // Each work unit accumulates into its own joint PDF derivatives, the first one being m_JointPDFDerivatives, and
+    // these are merged after the threaded execution. When the per work unit copies would take too much memory, the
+    // work units instead share m_JointPDFDerivatives, through buffers that are reduced into it under a lock.
+    auto & threaderJointPDFDerivatives = this->m_MattesAssociate->m_ThreaderJointPDFDerivatives;
+    if ((localNumberOfWorkUnitsUsed - 1) * jointPDFDerivativesRegion.GetNumberOfPixels() <=
+        TMattesMutualInformationMetric::MaximumThreaderJointPDFDerivativesSize)
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      threaderJointPDFDerivatives.resize(localNumberOfWorkUnitsUsed);
+      threaderJointPDFDerivatives[0] = this->m_MattesAssociate->m_JointPDFDerivatives;
+      for (ThreadIdType workUnitID = 1; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        if (threaderJointPDFDerivatives[workUnitID].IsNull() ||
+            (threaderJointPDFDerivatives[workUnitID]->GetBufferedRegion() != jointPDFDerivativesRegion))
+        {
+          threaderJointPDFDerivatives[workUnitID] = JointPDFDerivativesType::New();
+          threaderJointPDFDerivatives[workUnitID]->SetRegions(jointPDFDerivativesRegion);
+          threaderJointPDFDerivatives[workUnitID]->AllocateInitialized();
+        }
+        else
+        {
+          threaderJointPDFDerivatives[workUnitID]->FillBuffer(0.0F);
+        }
+      }
     }
-    for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+    else
+    {
+      threaderJointPDFDerivatives.clear();
+      if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      }
+      for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
+          // A heuristic that assumes memory for 2x size of
+          // m_JointPDFDerivative efficient and easy to make, so
+          // split it across all the threads.  A work unit of at least 400 is needed
+          // when the thread size approaches the number of histograms so that the
+          // there is enough work to be done between thread lockings.
+          std::max<size_t>(500,
+                           this->m_MattesAssociate->m_NumberOfHistogramBins *
+                             this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
+          this->GetCachedNumberOfLocalParameters(),
+          // Need address of the lock
+          &this->m_MattesAssociate->m_JointPDFDerivativesLock,
+          this->m_MattesAssociate->m_JointPDFDerivatives);
+      }
+    }
+  }
+
+  // The fixed sample cache is filled by the first evaluation after it has been invalidated, and read by the
+  // following ones.
+  this->m_FillFixedSampleCache = false;
+  this->m_ReadFixedSampleCache = false;
+  if (this->m_MattesAssociate->m_UseFixedSampleCache)
+  {
+    const SizeValueType numberOfSamples = this->m_MattesAssociate->GetUseSampledPointSet()
+                                            ? this->m_MattesAssociate->GetVirtualSampledPointSet()->GetNumberOfPoints()
+                                            : this->m_MattesAssociate->GetVirtualRegion().GetNumberOfPixels();
+    this->m_FixedSampleCacheInputsMTime = this->m_MattesAssociate->GetFixedSampleCacheInputsMTime();
+    if (this->m_MattesAssociate->m_FixedSampleParzenWindowIndices.size() == numberOfSamples &&
+        this->m_MattesAssociate->m_FixedSampleCacheMTime == this->m_FixedSampleCacheInputsMTime)
+    {
+      this->m_ReadFixedSampleCache = true;
+    }
+    else
+    {
+      // Only marked as valid once completely filled, by AfterThreadedExecution.
+      this->m_MattesAssociate->m_FixedSampleParzenWindowIndices.resize(numberOfSamples);
+      this->m_MattesAssociate->m_FixedSampleCacheMTime = 0;
+      this->m_FillFixedSampleCache = true;
+    }
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMattesMutualInformationMetric>::ThreadedExecution(const DomainType & domain, const ThreadIdType threadId)
+{
+  if (!this->m_FillFixedSampleCache && !this->m_ReadFixedSampleCache)
+  {
+    Superclass::ThreadedExecution(domain, threadId);
+    return;
+  }
+
+  const typename VirtualImageType::ConstPointer virtualImage = this->m_MattesAssociate->GetVirtualImage();
+  if constexpr (std::is_same_v<TDomainPartitioner, ThreadedIndexedContainerPartitioner>)
+  {
+    // The samples are identified by their index in the virtual sampled point set.
+    const typename TImageToImageMetric::VirtualPointSetType::ConstPointer virtualSampledPointSet =
+      this->m_MattesAssociate->GetVirtualSampledPointSet();
+    const auto begin = static_cast<SizeValueType>(domain[0]);
+    const auto end = static_cast<SizeValueType>(domain[1]);
+    for (SizeValueType i = begin; i <= end; ++i)
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
-        // A heuristic that assumes memory for 2x size of
-        // m_JointPDFDerivative efficient and easy to make, so
-        // split it across all the threads.  A work unit of at least 400 is needed
-        // when the thread size approaches the number of histograms so that the
-        // there is enough work to be done between thread lockings.
-        std::max<size_t>(500,
-                         this->m_MattesAssociate->m_NumberOfHistogramBins *
-                           this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
-        this->GetCachedNumberOfLocalParameters(),
-        // Need address of the lock
-        &this->m_MattesAssociate->m_JointPDFDerivativesLock,
-        this->m_MattesAssociate->m_JointPDFDerivatives);
+      const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
+      const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+      this->ProcessVirtualPointUsingFixedSampleCache(i, virtualIndex, virtualPoint, threadId);
     }
   }
+  else
+  {
+    // The samples are identified by their offset in the virtual region.
+    const auto &     virtualRegion = this->m_MattesAssociate->GetVirtualRegion();
+    VirtualPointType virtualPoint;
+    for (ImageRegionConstIteratorWithIndex<VirtualImageType> it(virtualImage, domain); !it.IsAtEnd(); ++it)
+    {
+      const VirtualIndexType & virtualIndex = it.GetIndex();
+      SizeValueType            sampleId = 0;
+      for (unsigned int d = VirtualImageType::ImageDimension; d > 0; --d)
+      {
+        sampleId = sampleId * virtualRegion.GetSize(d - 1) + (virtualIndex[d - 1] - virtualRegion.GetIndex(d - 1));
+      }
+      virtualImage->TransformIndexToPhysicalPoint(virtualIndex, virtualPoint);
+      this->ProcessVirtualPointUsingFixedSampleCache(sampleId, virtualIndex, virtualPoint, threadId);
+    }
+  }
+  // Finalize per thread actions
+  this->m_MattesAssociate->FinalizeThread(threadId);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  ProcessVirtualPointUsingFixedSampleCache(const SizeValueType      sampleId,
+                                           const VirtualIndexType & virtualIndex,
+                                           const VirtualPointType & virtualPoint,
+                                           const ThreadIdType       threadId)
+{
+  // A negative index marks a sample whose fixed point is not valid.
+  OffsetValueType & fixedImageParzenWindowIndex = this->m_MattesAssociate->m_FixedSampleParzenWindowIndices[sampleId];
+  if (this->m_FillFixedSampleCache)
+  {
+    FixedImagePointType mappedFixedPoint;
+    FixedImagePixelType fixedImageValue;
+    fixedImageParzenWindowIndex =
+      this->m_MattesAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue)
+        ? this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue)
+        : -1;
+  }
+  if (fixedImageParzenWindowIndex < 0)
+  {
+    return;
+  }
+
+  MovingImagePointType    mappedMovingPoint;
+  MovingImagePixelType    movingImageValue;
+  MovingImageGradientType movingImageGradient;
+  if (!this->m_MattesAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue))
+  {
+    return;
+  }
+  if (this->m_MattesAssociate->GetComputeDerivative())
+  {
+    this->m_MattesAssociate->ComputeMovingImageGradientAtPoint(mappedMovingPoint, movingImageGradient);
+  }
+  this->ProcessPointWithFixedParzenWindowIndex(
+    virtualIndex, virtualPoint, fixedImageParzenWindowIndex, movingImageValue, movingImageGradient, threadId);
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
@@ -228,6 +375,27 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
                                                 MeasureType &,
                                                 DerivativeType &,
                                                 const ThreadIdType threadId) const
+{
+  const OffsetValueType fixedImageParzenWindowIndex =
+    this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
+  this->ProcessPointWithFixedParzenWindowIndex(
+    virtualIndex, virtualPoint, fixedImageParzenWindowIndex, movingImageValue, movingImageGradient, threadId);
+
+  // Return false to avoid the storage of results in parent class.
+  return false;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  ProcessPointWithFixedParzenWindowIndex(const VirtualIndexType &        virtualIndex,
+                                         const VirtualPointType &        virtualPoint,
+                                         const OffsetValueType           fixedImageParzenWindowIndex,
+                                         const MovingImagePixelType &    movingImageValue,
+                                         const MovingImageGradientType & movingImageGradient,
+                                         const ThreadIdType              threadId) const
 {
   const bool doComputeDerivative = this->m_MattesAssociate->GetComputeDerivative();
   /**
@@ -237,11 +405,11 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
    */
   if (movingImageValue < this->m_MattesAssociate->m_MovingImageTrueMin)
   {
-    return false;
+    return;
   }
   if (movingImageValue > this->m_MattesAssociate->m_MovingImageTrueMax)
   {
-    return false;
+    return;
   }
 
   // Determine parzen window arguments (see eqn 6 of Mattes paper [2]).
@@ -266,9 +434,6 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   OffsetValueType       pdfMovingIndex = static_cast<OffsetValueType>(movingImageParzenWindowIndex) - 1;
   const OffsetValueType pdfMovingIndexMax = static_cast<OffsetValueType>(movingImageParzenWindowIndex) + 2;
 
-  const OffsetValueType fixedImageParzenWindowIndex =
-    this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
-
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -326,6 +491,7 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   const bool transformIsDisplacement = this->m_MattesAssociate->m_MovingTransform->GetTransformCategory() ==
                                        MovingTransformType::TransformCategoryEnum::DisplacementField;
+  const bool useThreaderJointPDFDerivatives = !this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.empty();
   while (pdfMovingIndex <= pdfMovingIndexMax)
   {
     const auto val = CubicBSplineFunctionType::FastEvaluate(movingImageParzenWindowArg);
@@ -356,21 +522,41 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
           (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[2]) +
           (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
-        PDFValueType * derivativeContributionPtr =
-          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
-        for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
-             ++mu)
+        if (useThreaderJointPDFDerivatives)
         {
-          PDFValueType innerProduct = 0.0;
-          for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+          PDFValueType * derivativePtr =
+            this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[threadId]->GetBufferPointer() + ThisIndexOffset;
+          for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
+               ++mu)
           {
-            innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            *(derivativePtr) += innerProduct * cubicBSplineDerivativeValue;
+            ++derivativePtr;
           }
-
-          *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
-          ++derivativeContributionPtr;
         }
-        this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        else
+        {
+          PDFValueType * derivativeContributionPtr =
+            this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
+          for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
+               ++mu)
+          {
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
+            ++derivativeContributionPtr;
+          }
+          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        }
       }
     }
 
@@ -379,11 +565,8 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     ++movingParzenBin;
   }
 
-  // have to do this here since we're returning false
+  // have to do this here since ProcessPoint returns false
   this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
-
-  // Return false to avoid the storage of results in parent class.
-  return false;
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
@@ -428,6 +611,11 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_GetValueAndDerivativePerThreadVariables[workUnitID].NumberOfValidPoints;
   }
 
+  if (this->m_FillFixedSampleCache)
+  {
+    this->m_MattesAssociate->m_FixedSampleCacheMTime = this->m_FixedSampleCacheInputsMTime;
+  }
+
   /* Porting: This code is from
    * MattesMutualInformationImageToImageMetric::GetValueAndDerivativeThreadPostProcess */
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
@@ -81,6 +81,18 @@ protected:
                MeasureType &                   metricValueReturn,
                DerivativeType &                localDerivativeReturn,
                const ThreadIdType              threadId) const override;
+
+  bool
+  SupportsSparseDerivativeAccumulation() const override
+  {
+    return true;
+  }
+
+  bool
+  SupportsVirtualPointBatches() const override
+  {
+    return true;
+  }
 };
 
 } // end namespace itk
@@ -211,6 +211,13 @@ public:
   bool
   SupportsArbitraryVirtualDomainSamples() const override;
 
+  /** Set the maximum number of work units of each of the component metrics,
+   * and get the largest one. */
+  void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType number) override;
+  ThreadIdType
+  GetMaximumNumberOfWorkUnits() const override;
+
   using typename Superclass::MetricCategoryType;
 
   /** Get metric category */
@@ -226,6 +233,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Returns a copy of this metric, with clones of the component metrics,
+   * which share a clone of the moving transform. */
+  typename LightObject::Pointer
+  InternalClone() const override;
+
 private:
   MetricQueueType              m_MetricQueue{};
   WeightsArrayType             m_MetricWeights{};
@@ -20,6 +20,8 @@
 
 #include "itkCompositeTransform.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -394,6 +396,76 @@ ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TI
   return true;
 }
 
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TInternalComputationValueType>
+void
+ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::
+  SetMaximumNumberOfWorkUnits(const ThreadIdType number)
+{
+  for (const auto & metric : this->m_MetricQueue)
+  {
+    metric->SetMaximumNumberOfWorkUnits(number);
+  }
+}
+
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TInternalComputationValueType>
+ThreadIdType
+ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::
+  GetMaximumNumberOfWorkUnits() const
+{
+  ThreadIdType number = 1;
+  for (const auto & metric : this->m_MetricQueue)
+  {
+    number = std::max(number, metric->GetMaximumNumberOfWorkUnits());
+  }
+  return number;
+}
+
+template <unsigned int TFixedDimension,
+          unsigned int TMovingDimension,
+          typename TVirtualImage,
+          typename TInternalComputationValueType>
+typename LightObject::Pointer
+ObjectToObjectMultiMetricv4<TFixedDimension, TMovingDimension, TVirtualImage, TInternalComputationValueType>::
+  InternalClone() const
+{
+  typename LightObject::Pointer loPtr = this->CreateAnother();
+
+  const typename Self::Pointer rval = dynamic_cast<Self *>(loPtr.GetPointer());
+  if (rval.IsNull())
+  {
+    itkExceptionMacro("downcast to type " << this->GetNameOfClass() << " failed.");
+  }
+  for (const auto & metric : this->m_MetricQueue)
+  {
+    const typename LightObject::Pointer metricClone = metric->Clone();
+    auto * const                        clonedMetric = dynamic_cast<MetricType *>(metricClone.GetPointer());
+    if (clonedMetric == nullptr)
+    {
+      itkExceptionMacro("Clone of the component metric " << metric->GetNameOfClass() << " failed.");
+    }
+    rval->AddMetric(clonedMetric);
+  }
+  rval->SetMetricWeights(this->m_MetricWeights);
+  if (rval->GetNumberOfMetrics() > 0)
+  {
+    if (this->m_MovingTransform)
+    {
+      rval->SetMovingTransform(this->m_MovingTransform->Clone());
+    }
+    if (this->m_FixedTransform)
+    {
+      rval->SetFixedTransform(this->m_FixedTransform);
+    }
+  }
+  return loPtr;
+}
+
 template <unsigned int TFixedDimension,
           unsigned int TMovingDimension,
           typename TVirtualImage,
@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTranslationTransform.h"
+
+#include <cmath>
+
+namespace
+{
+template <unsigned int VDimension>
+typename itk::Image<double, VDimension>::Pointer
+MakeImage(const typename itk::Image<double, VDimension>::SizeType & size, double shift)
+{
+  using ImageType = itk::Image<double, VDimension>;
+  const auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double value = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      const double x = it.GetIndex()[d] - shift;
+      value += std::sin(0.37 * (d + 1) * x) + 0.01 * x * x;
+    }
+    it.Set(value);
+  }
+  return image;
+}
+
+template <typename TMetric>
+void
+ExpectSameValueAndDerivative(TMetric * scanningMetric, TMetric * boxFilterMetric)
+{
+  typename TMetric::MeasureType    expectedValue;
+  typename TMetric::DerivativeType expectedDerivative;
+  scanningMetric->GetValueAndDerivative(expectedValue, expectedDerivative);
+
+  typename TMetric::MeasureType    value;
+  typename TMetric::DerivativeType derivative;
+  boxFilterMetric->GetValueAndDerivative(value, derivative);
+
+  EXPECT_EQ(boxFilterMetric->GetNumberOfValidPoints(), scanningMetric->GetNumberOfValidPoints());
+  // The images have double pixels, as the scanning window computes the squares and products of the pixel values in the
+  // pixel type.
+  EXPECT_NEAR(value, expectedValue, 1e-9 * std::abs(expectedValue));
+  ASSERT_EQ(derivative.size(), expectedDerivative.size());
+  double maximumDerivative = 0.0;
+  for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+  {
+    maximumDerivative = std::max(maximumDerivative, std::abs(expectedDerivative[i]));
+  }
+  EXPECT_GT(maximumDerivative, 0.0);
+  for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+  {
+    EXPECT_NEAR(derivative[i], expectedDerivative[i], 1e-9 * maximumDerivative) << i;
+  }
+}
+} // namespace
+
+
+TEST(ANTSNeighborhoodCorrelationImageToImageMetricv4, SeparableBoxFilterIsOffByDefault)
+{
+  using ImageType = itk::Image<double, 2>;
+  using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  EXPECT_FALSE(MetricType::New()->GetUseSeparableBoxFilter());
+}
+
+
+TEST(ANTSNeighborhoodCorrelationImageToImageMetricv4, SeparableBoxFilterMatchesScanningWindowWithGlobalTransform)
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image<double, Dimension>;
+  using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  using TransformType = itk::TranslationTransform<double, Dimension>;
+
+  const auto fixedImage = MakeImage<Dimension>({ { 17, 13, 11 } }, 0.0);
+  const auto movingImage = MakeImage<Dimension>({ { 17, 13, 11 } }, 0.6);
+
+  for (const unsigned int radius : { 1, 2, 4 })
+  {
+    MetricType::Pointer metrics[2];
+    for (const bool useSeparableBoxFilter : { false, true })
+    {
+      auto transform = TransformType::New();
+      auto parameters = transform->GetParameters();
+      parameters[0] = 1.3;
+      parameters[2] = -0.7;
+      transform->SetParameters(parameters);
+
+      auto metric = MetricType::New();
+      metric->SetFixedImage(fixedImage);
+      metric->SetMovingImage(movingImage);
+      metric->SetMovingTransform(transform);
+      MetricType::RadiusType metricRadius;
+      metricRadius.Fill(radius);
+      metricRadius[1] = radius + 1;
+      metric->SetRadius(metricRadius);
+      metric->SetMaximumNumberOfWorkUnits(4);
+      metric->SetUseSeparableBoxFilter(useSeparableBoxFilter);
+      metric->Initialize();
+      metrics[useSeparableBoxFilter] = metric;
+    }
+    SCOPED_TRACE(radius);
+    ExpectSameValueAndDerivative(metrics[0].GetPointer(), metrics[1].GetPointer());
+    EXPECT_NEAR(metrics[1]->GetValue(), metrics[0]->GetValue(), 1e-9 * std::abs(metrics[0]->GetValue()));
+  }
+}
+
+
+TEST(ANTSNeighborhoodCorrelationImageToImageMetricv4, SeparableBoxFilterMatchesScanningWindowWithDisplacementField)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<double, Dimension>;
+  using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  using TransformType = itk::DisplacementFieldTransform<double, Dimension>;
+  using FieldType = TransformType::DisplacementFieldType;
+
+  const auto fixedImage = MakeImage<Dimension>({ { 31, 23 } }, 0.0);
+  const auto movingImage = MakeImage<Dimension>({ { 31, 23 } }, 1.2);
+
+  MetricType::Pointer metrics[2];
+  for (const bool useSeparableBoxFilter : { false, true })
+  {
+    auto field = FieldType::New();
+    field->SetRegions(fixedImage->GetLargestPossibleRegion());
+    field->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, field->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      FieldType::PixelType displacement;
+      displacement[0] = 0.5 * std::sin(0.2 * it.GetIndex()[1]);
+      displacement[1] = 0.3 * std::cos(0.3 * it.GetIndex()[0]);
+      it.Set(displacement);
+    }
+    auto transform = TransformType::New();
+    transform->SetDisplacementField(field);
+
+    auto metric = MetricType::New();
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    metric->SetMovingTransform(transform);
+    metric->SetMaximumNumberOfWorkUnits(3);
+    metric->SetUseSeparableBoxFilter(useSeparableBoxFilter);
+    metric->Initialize();
+    metrics[useSeparableBoxFilter] = metric;
+  }
+  ExpectSameValueAndDerivative(metrics[0].GetPointer(), metrics[1].GetPointer());
+}
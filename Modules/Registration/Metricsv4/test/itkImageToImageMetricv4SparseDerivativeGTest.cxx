@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+
+#include <cmath>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+ImageType::Pointer
+MakeImage(double centerX, double centerY)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 45, 38 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - centerX;
+    const double y = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / 150.0) + std::sin(0.3 * x) + 0.1 * y);
+  }
+  return image;
+}
+
+TransformType::Pointer
+MakeTransform(const ImageType * image)
+{
+  auto transform = TransformType::New();
+  transform->SetTransformDomainOrigin(image->GetOrigin());
+  transform->SetTransformDomainPhysicalDimensions(itk::MakeVector(44.0, 37.0));
+  transform->SetTransformDomainMeshSize(itk::MakeSize(6, 5));
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.4 * std::sin(0.7 * i);
+  }
+  transform->SetParameters(parameters);
+  return transform;
+}
+
+template <typename TMetric>
+void
+ExpectSparseDerivativeAccumulationGivesSameResults()
+{
+  const auto fixedImage = MakeImage(22.0, 19.0);
+  const auto movingImage = MakeImage(24.5, 17.5);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+  {
+    SCOPED_TRACE(numberOfWorkUnits);
+    typename TMetric::Pointer metrics[2];
+    for (const bool useSparseDerivativeAccumulation : { false, true })
+    {
+      auto metric = TMetric::New();
+      metric->SetFixedImage(fixedImage);
+      metric->SetMovingImage(movingImage);
+      metric->SetMovingTransform(MakeTransform(fixedImage));
+      metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+      metric->SetUseSparseDerivativeAccumulation(useSparseDerivativeAccumulation);
+      metric->Initialize();
+      metrics[useSparseDerivativeAccumulation] = metric;
+    }
+
+    typename TMetric::MeasureType    expectedValue;
+    typename TMetric::DerivativeType expectedDerivative;
+    metrics[0]->GetValueAndDerivative(expectedValue, expectedDerivative);
+
+    typename TMetric::MeasureType    value;
+    typename TMetric::DerivativeType derivative;
+    metrics[1]->GetValueAndDerivative(value, derivative);
+
+    EXPECT_EQ(metrics[1]->GetNumberOfValidPoints(), metrics[0]->GetNumberOfValidPoints());
+    EXPECT_NEAR(value, expectedValue, 1e-12 * std::abs(expectedValue));
+    ASSERT_EQ(derivative.size(), expectedDerivative.size());
+    double maximumDerivative = 0.0;
+    for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+    {
+      maximumDerivative = std::max(maximumDerivative, std::abs(expectedDerivative[i]));
+    }
+    EXPECT_GT(maximumDerivative, 0.0);
+    for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+    {
+      // The sparse accumulation does not add the zero derivatives, which only changes the rounding.
+      EXPECT_NEAR(derivative[i], expectedDerivative[i], 1e-12 * maximumDerivative) << i;
+    }
+  }
+}
+} // namespace
+
+
+TEST(ImageToImageMetricv4, SparseDerivativeAccumulationIsOffByDefault)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  EXPECT_FALSE(MetricType::New()->GetUseSparseDerivativeAccumulation());
+}
+
+
+TEST(ImageToImageMetricv4, SparseDerivativeAccumulationWithMeanSquares)
+{
+  ExpectSparseDerivativeAccumulationGivesSameResults<itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>>();
+}
+
+
+TEST(ImageToImageMetricv4, SparseDerivativeAccumulationWithJointHistogramMutualInformation)
+{
+  ExpectSparseDerivativeAccumulationGivesSameResults<
+    itk::JointHistogramMutualInformationImageToImageMetricv4<ImageType, ImageType>>();
+}
+
+
+TEST(ImageToImageMetricv4, SparseDerivativeAccumulationWithANTSNeighborhoodCorrelation)
+{
+  ExpectSparseDerivativeAccumulationGivesSameResults<
+    itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>>();
+}
+
+
+TEST(ImageToImageMetricv4, SparseDerivativeAccumulationIsIgnoredByMattesMutualInformation)
+{
+  ExpectSparseDerivativeAccumulationGivesSameResults<
+    itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>>();
+}
@@ -0,0 +1,205 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <cmath>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+using TransformType = itk::AffineTransform<double, 2>;
+
+ImageType::Pointer
+MakeImage(double centerX, double centerY)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 48, 40 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - centerX;
+    const double y = it.GetIndex()[1] - centerY;
+    it.Set(static_cast<float>(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0) + 0.1 * (x + y)));
+  }
+  return image;
+}
+
+MetricType::Pointer
+MakeMetric(const ImageType * fixedImage, const ImageType * movingImage, bool useSampledPointSet)
+{
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetNumberOfHistogramBins(20);
+  metric->SetMovingTransform(TransformType::New());
+  metric->SetMaximumNumberOfWorkUnits(5);
+
+  if (useSampledPointSet)
+  {
+    auto pointSet = MetricType::FixedSampledPointSetType::New();
+    pointSet->Initialize();
+    MetricType::FixedSampledPointSetType::PointIdentifier pointId = 0;
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(const_cast<ImageType *>(fixedImage),
+                                                          fixedImage->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if ((it.GetIndex()[0] + 3 * it.GetIndex()[1]) % 4 == 0)
+      {
+        ImageType::PointType point;
+        fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+        pointSet->SetPoint(pointId++, point);
+      }
+    }
+    metric->SetFixedSampledPointSet(pointSet);
+    metric->SetUseSampledPointSet(true);
+  }
+  metric->Initialize();
+  return metric;
+}
+
+void
+ExpectSameValueAndDerivative(MetricType * expected, MetricType * actual)
+{
+  MetricType::MeasureType    expectedValue;
+  MetricType::DerivativeType expectedDerivative;
+  expected->GetValueAndDerivative(expectedValue, expectedDerivative);
+
+  MetricType::MeasureType    actualValue;
+  MetricType::DerivativeType actualDerivative;
+  actual->GetValueAndDerivative(actualValue, actualDerivative);
+
+  EXPECT_EQ(actual->GetNumberOfValidPoints(), expected->GetNumberOfValidPoints());
+  EXPECT_DOUBLE_EQ(actualValue, expectedValue);
+  ASSERT_EQ(actualDerivative.size(), expectedDerivative.size());
+  for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+  {
+    EXPECT_NEAR(actualDerivative[i], expectedDerivative[i], 1e-12 * (1.0 + std::abs(expectedDerivative[i]))) << i;
+  }
+  EXPECT_DOUBLE_EQ(actual->GetValue(), expected->GetValue());
+}
+
+void
+Translate(MetricType * metric, double x, double y)
+{
+  auto parameters = metric->GetMovingTransform()->GetParameters();
+  parameters[4] = x;
+  parameters[5] = y;
+  metric->SetParameters(parameters);
+}
+} // namespace
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, FixedSampleCacheIsOffByDefault)
+{
+  EXPECT_FALSE(MetricType::New()->GetUseFixedSampleCache());
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, FixedSampleCacheGivesSameResults)
+{
+  const auto fixedImage = MakeImage(22.0, 20.0);
+  const auto movingImage = MakeImage(25.0, 18.5);
+
+  for (const bool useSampledPointSet : { false, true })
+  {
+    SCOPED_TRACE(useSampledPointSet ? "sparse" : "dense");
+    const auto uncachedMetric = MakeMetric(fixedImage, movingImage, useSampledPointSet);
+    const auto cachedMetric = MakeMetric(fixedImage, movingImage, useSampledPointSet);
+    cachedMetric->UseFixedSampleCacheOn();
+
+    // The first evaluation fills the cache, the following ones read it.
+    for (const double translation : { 0.0, 1.5, 2.75 })
+    {
+      Translate(uncachedMetric, translation, -0.5 * translation);
+      Translate(cachedMetric, translation, -0.5 * translation);
+      ExpectSameValueAndDerivative(uncachedMetric, cachedMetric);
+    }
+
+    // Modifying the fixed image invalidates the cache.
+    fixedImage->SetPixel({ { 22, 20 } }, fixedImage->GetPixel({ { 22, 20 } }) + 50.0F);
+    fixedImage->Modified();
+    ExpectSameValueAndDerivative(uncachedMetric, cachedMetric);
+  }
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, ResultsDoNotDependOnNumberOfWorkUnits)
+{
+  const auto fixedImage = MakeImage(22.0, 20.0);
+  const auto movingImage = MakeImage(23.5, 21.0);
+
+  const auto singleWorkUnitMetric = MakeMetric(fixedImage, movingImage, false);
+  singleWorkUnitMetric->SetMaximumNumberOfWorkUnits(1);
+  MetricType::MeasureType    expectedValue;
+  MetricType::DerivativeType expectedDerivative;
+  singleWorkUnitMetric->GetValueAndDerivative(expectedValue, expectedDerivative);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 3, 7, 16 })
+  {
+    const auto metric = MakeMetric(fixedImage, movingImage, false);
+    metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+
+    EXPECT_NEAR(value, expectedValue, 1e-12) << numberOfWorkUnits;
+    for (unsigned int i = 0; i < expectedDerivative.size(); ++i)
+    {
+      EXPECT_NEAR(derivative[i], expectedDerivative[i], 1e-9 * (1.0 + std::abs(expectedDerivative[i])))
+        << numberOfWorkUnits << ' ' << i;
+    }
+  }
+}
+
+
+TEST(MattesMutualInformationImageToImageMetricv4, CloneGivesSameResults)
+{
+  const auto fixedImage = MakeImage(22.0, 20.0);
+  const auto movingImage = MakeImage(25.0, 18.5);
+
+  for (const bool useSampledPointSet : { false, true })
+  {
+    SCOPED_TRACE(useSampledPointSet ? "sparse" : "dense");
+    const auto metric = MakeMetric(fixedImage, movingImage, useSampledPointSet);
+    metric->UseFixedSampleCacheOn();
+    Translate(metric, 1.5, -0.75);
+
+    const MetricType::Pointer clone = metric->Clone();
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(clone->GetNumberOfHistogramBins(), metric->GetNumberOfHistogramBins());
+    EXPECT_EQ(clone->GetUseFixedSampleCache(), metric->GetUseFixedSampleCache());
+    EXPECT_EQ(clone->GetUseSampledPointSet(), metric->GetUseSampledPointSet());
+    EXPECT_EQ(clone->GetMaximumNumberOfWorkUnits(), metric->GetMaximumNumberOfWorkUnits());
+    EXPECT_EQ(clone->GetFixedImage(), metric->GetFixedImage());
+    EXPECT_EQ(clone->GetMovingImage(), metric->GetMovingImage());
+    clone->Initialize();
+    ExpectSameValueAndDerivative(metric, clone);
+
+    // The clone has its own moving transform.
+    EXPECT_NE(clone->GetMovingTransform(), metric->GetMovingTransform());
+    Translate(clone, 0.5, 0.25);
+    EXPECT_EQ(metric->GetMovingTransform()->GetParameters()[4], 1.5);
+  }
+}
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBatchImageRegistrationMethodv4_h
+#define itkBatchImageRegistrationMethodv4_h
+
+#include "itkImageRegistrationPyramidCache.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class BatchImageRegistrationMethodv4
+ * \brief Runs many registrations to the same fixed images concurrently.
+ *
+ * Atlas building and cohort studies register many moving images to a single
+ * fixed template. This class runs a batch of such registrations, given as
+ * registration methods that are fully configured (images, metric, optimizer,
+ * levels, transform), in two ways that are more efficient than updating them
+ * one after the other:
+ *
+ *   \li The registrations share an ImageRegistrationPyramidCache, so that
+ *       the smoothed fixed images, the shrunk virtual domain and the metric
+ *       sample points of each level are only computed once.  The sample
+ *       points are only shared by registrations with the same random seed
+ *       (see ImageRegistrationMethodv4::MetricSamplingReinitializeSeed()).
+ *   \li Up to MaximumNumberOfConcurrentRegistrations registrations run at
+ *       the same time, each with an equal share of the NumberOfWorkUnits.
+ *       Many small registrations scale better this way than a single
+ *       registration with all the work units.
+ *
+ * The number of work units of each registration method, of its image
+ * metrics and of its optimizer are set by Update().  The results are
+ * obtained from the registration methods, as if each had been updated.
+ *
+ * \tparam TRegistrationMethod An ImageRegistrationMethodv4 or a subclass.
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TRegistrationMethod>
+class ITK_TEMPLATE_EXPORT BatchImageRegistrationMethodv4 : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BatchImageRegistrationMethodv4);
+
+  /** Standard class type aliases. */
+  using Self = BatchImageRegistrationMethodv4;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(BatchImageRegistrationMethodv4);
+
+  using RegistrationMethodType = TRegistrationMethod;
+  using RegistrationMethodPointer = typename RegistrationMethodType::Pointer;
+  using RegistrationMethodsContainerType = std::vector<RegistrationMethodPointer>;
+
+  using PyramidCacheType = ImageRegistrationPyramidCache;
+
+  /** Add a registration method to the batch. */
+  void
+  AddRegistrationMethod(RegistrationMethodType * registrationMethod);
+
+  /** Get the registration method with the specified index. */
+  RegistrationMethodType *
+  GetRegistrationMethod(SizeValueType index) const;
+
+  /** Get the number of registration methods of the batch. */
+  SizeValueType
+  GetNumberOfRegistrationMethods() const
+  {
+    return static_cast<SizeValueType>(m_RegistrationMethods.size());
+  }
+
+  /** Remove all the registration methods from the batch. */
+  void
+  ClearRegistrationMethods();
+
+  /** Set/Get the number of work units shared by the registrations.
+   * Defaults to the global default number of threads. */
+  itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfWorkUnits, ThreadIdType);
+
+  /** Set/Get the maximum number of registrations that run concurrently.  By default, it is only
+   * limited by the number of work units. */
+  itkSetClampMacro(MaximumNumberOfConcurrentRegistrations, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(MaximumNumberOfConcurrentRegistrations, SizeValueType);
+
+  /** Set/Get the cache shared by the registrations.  A new cache is created by the constructor, and
+   * kept across updates, so that a batch may be extended with more moving images. */
+  itkSetObjectMacro(PyramidCache, PyramidCacheType);
+  itkGetModifiableObjectMacro(PyramidCache, PyramidCacheType);
+
+  /** Run all the registrations.  If registrations throw exceptions, the other registrations still
+   * run, and the exception of the first of them is thrown afterwards. */
+  virtual void
+  Update();
+
+protected:
+  BatchImageRegistrationMethodv4();
+  ~BatchImageRegistrationMethodv4() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Set the number of work units of a registration method, of its metric and of its optimizer. */
+  virtual void
+  SetNumberOfWorkUnitsOfRegistrationMethod(RegistrationMethodType * registrationMethod,
+                                           ThreadIdType             numberOfWorkUnits) const;
+
+private:
+  RegistrationMethodsContainerType m_RegistrationMethods{};
+  ThreadIdType                     m_NumberOfWorkUnits{};
+  SizeValueType                    m_MaximumNumberOfConcurrentRegistrations{ NumericTraits<SizeValueType>::max() };
+  PyramidCacheType::Pointer        m_PyramidCache{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBatchImageRegistrationMethodv4.hxx"
+#endif
+
+#endif
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBatchImageRegistrationMethodv4_hxx
+#define itkBatchImageRegistrationMethodv4_hxx
+
+#include "itkParallelizeOnDedicatedThreads.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TRegistrationMethod>
+BatchImageRegistrationMethodv4<TRegistrationMethod>::BatchImageRegistrationMethodv4()
+  : m_NumberOfWorkUnits(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+  , m_PyramidCache(PyramidCacheType::New())
+{}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::AddRegistrationMethod(RegistrationMethodType * registrationMethod)
+{
+  if (!registrationMethod)
+  {
+    itkExceptionMacro("The registration method is null.");
+  }
+  this->m_RegistrationMethods.push_back(registrationMethod);
+  this->Modified();
+}
+
+template <typename TRegistrationMethod>
+auto
+BatchImageRegistrationMethodv4<TRegistrationMethod>::GetRegistrationMethod(SizeValueType index) const
+  -> RegistrationMethodType *
+{
+  if (index >= this->m_RegistrationMethods.size())
+  {
+    itkExceptionMacro("Requesting registration method " << index << " of " << this->m_RegistrationMethods.size()
+                                                        << " registration methods.");
+  }
+  return this->m_RegistrationMethods[index];
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::ClearRegistrationMethods()
+{
+  if (!this->m_RegistrationMethods.empty())
+  {
+    this->m_RegistrationMethods.clear();
+    this->Modified();
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::Update()
+{
+  const SizeValueType numberOfRegistrations = this->m_RegistrationMethods.size();
+  if (numberOfRegistrations == 0)
+  {
+    return;
+  }
+
+  const SizeValueType numberOfConcurrentRegistrations =
+    std::min({ numberOfRegistrations,
+               this->m_MaximumNumberOfConcurrentRegistrations,
+               static_cast<SizeValueType>(this->m_NumberOfWorkUnits) });
+  const auto numberOfWorkUnitsPerRegistration = static_cast<ThreadIdType>(
+    std::max<SizeValueType>(1, this->m_NumberOfWorkUnits / numberOfConcurrentRegistrations));
+
+  for (const auto & registrationMethod : this->m_RegistrationMethods)
+  {
+    registrationMethod->SetPyramidCache(this->m_PyramidCache);
+    this->SetNumberOfWorkUnitsOfRegistrationMethod(registrationMethod, numberOfWorkUnitsPerRegistration);
+  }
+
+  const auto exceptions = ParallelizeOnDedicatedThreads(
+    numberOfRegistrations, numberOfConcurrentRegistrations, [this](SizeValueType i, SizeValueType) {
+      this->m_RegistrationMethods[i]->Update();
+    });
+
+  for (const auto & exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::SetNumberOfWorkUnitsOfRegistrationMethod(
+  RegistrationMethodType * registrationMethod,
+  ThreadIdType             numberOfWorkUnits) const
+{
+  registrationMethod->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+  if (auto * metric = registrationMethod->GetModifiableMetric())
+  {
+    metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+  }
+
+  if (auto * optimizer = registrationMethod->GetModifiableOptimizer())
+  {
+    optimizer->SetNumberOfWorkUnits(numberOfWorkUnits);
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfRegistrationMethods: " << this->m_RegistrationMethods.size() << std::endl;
+  os << indent << "NumberOfWorkUnits: " << this->m_NumberOfWorkUnits << std::endl;
+  os << indent << "MaximumNumberOfConcurrentRegistrations: " << this->m_MaximumNumberOfConcurrentRegistrations
+     << std::endl;
+  itkPrintSelfObjectMacro(PyramidCache);
+}
+
+} // end namespace itk
+
+#endif
@@ -26,6 +26,7 @@
 #include "itkObjectToObjectMultiMetricv4.h"
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkImageToImageMetricv4.h"
+#include "itkImageRegistrationPyramidCache.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
 #include "itkIdentityTransform.h"
@@ -223,6 +224,8 @@ public:
 
   using MetricSamplePointSetType = typename ImageMetricType::FixedSampledPointSetType;
 
+  using PyramidCacheType = ImageRegistrationPyramidCache;
+
   /** Set/get the fixed images. */
   virtual void
   SetFixedImage(const FixedImageType * image)
@@ -432,6 +435,26 @@ public:
   itkGetConstMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits, bool);
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
 
+  /**
+   * Set/Get a cache for the smoothed fixed images, the shrunk virtual domain and the metric
+   * sample points of each level (null by default).  The stages of a multi-stage registration,
+   * and registrations of different moving images to the same fixed images, with the same
+   * levels, may share a cache to compute these once.  The sample points are only shared by
+   * registrations with the same random seed.
+   */
+  itkSetObjectMacro(PyramidCache, PyramidCacheType);
+  itkGetModifiableObjectMacro(PyramidCache, PyramidCacheType);
+
+  /**
+   * Set/Get whether the smoothed moving images are cached too, when a pyramid cache is set
+   * (false by default).  Enable it for the stages of a multi-stage registration, which share
+   * their moving images, but not for batches of many moving images, whose smoothed images
+   * would all be kept in memory.
+   */
+  itkSetMacro(CacheMovingImagePyramid, bool);
+  itkGetConstMacro(CacheMovingImagePyramid, bool);
+  itkBooleanMacro(CacheMovingImagePyramid);
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -579,6 +602,9 @@ private:
 
   bool m_InitializeCenterOfLinearOutputTransform{};
 
+  PyramidCacheType::Pointer m_PyramidCache{};
+  bool                      m_CacheMovingImagePyramid{ false };
+
   // helper function to create the right kind of concrete transform
   template <typename TTransform>
   static void
@@ -461,12 +461,35 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   typename VirtualImageType::Pointer currentLevelVirtualDomainImage = nullptr;
   if (this->m_VirtualDomainImage.IsNotNull())
   {
-    auto shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactors(this->m_ShrinkFactorsPerLevel[level]);
-    shrinkFilter->SetInput(this->m_VirtualDomainImage);
-
-    currentLevelVirtualDomainImage = shrinkFilter->GetOutput();
-    currentLevelVirtualDomainImage->Update();
+    const auto shrinkVirtualDomainImage = [this, level]() -> VirtualImagePointer {
+      auto shrinkFilter = ShrinkFilterType::New();
+      shrinkFilter->SetShrinkFactors(this->m_ShrinkFactorsPerLevel[level]);
+      shrinkFilter->SetInput(this->m_VirtualDomainImage);
+      shrinkFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+      VirtualImagePointer shrunkImage = shrinkFilter->GetOutput();
+      shrunkImage->Update();
+      shrunkImage->DisconnectPipeline();
+      return shrunkImage;
+    };
+
+    if (this->m_PyramidCache)
+    {
+      // Only the geometry of the virtual domain image is used, so it identifies the shrunk image.
+      PyramidCacheType::KeyType key;
+      key.m_Name = "VirtualDomainImage";
+      PyramidCacheType::AppendImageInformation(*this->m_VirtualDomainImage, key.m_Parameters);
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        key.m_Parameters.push_back(static_cast<double>(this->m_ShrinkFactorsPerLevel[level][d]));
+      }
+      const auto cachedImage = this->m_PyramidCache->GetOrCompute(key, shrinkVirtualDomainImage);
+      currentLevelVirtualDomainImage = static_cast<VirtualImageType *>(cachedImage.GetPointer());
+    }
+    else
+    {
+      currentLevelVirtualDomainImage = shrinkVirtualDomainImage();
+    }
   }
   else
   {
@@ -608,7 +631,6 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       if (this->m_SmoothingSigmasPerLevel[level] > 0)
       {
         using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
-        auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
         typename FixedImageSmoothingFilterType::SigmaArrayType fixedImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -620,15 +642,35 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             fixedImageSigmaArray[i] *= fixedSpacing[i];
           }
         }
-        fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
-        fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
 
-        this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
-        fixedImageSmoothingFilter->Update();
-        fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        const auto smoothFixedImage = [this, n, &fixedImageSigmaArray]() -> FixedImagePointer {
+          auto fixedImageSmoothingFilter = FixedImageSmoothingFilterType::New();
+          fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
+          fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
+          fixedImageSmoothingFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+          FixedImagePointer fixedSmoothImage = fixedImageSmoothingFilter->GetOutput();
+          fixedImageSmoothingFilter->Update();
+          fixedSmoothImage->DisconnectPipeline();
+          return fixedSmoothImage;
+        };
+
+        if (this->m_PyramidCache)
+        {
+          PyramidCacheType::KeyType key;
+          key.m_Name = "SmoothedFixedImage";
+          key.m_Source = this->GetFixedImage(n);
+          key.m_SourceTime = this->GetFixedImage(n)->GetMTime();
+          key.m_Parameters.assign(fixedImageSigmaArray.Begin(), fixedImageSigmaArray.End());
+          const auto cachedImage = this->m_PyramidCache->GetOrCompute(key, smoothFixedImage);
+          this->m_FixedSmoothImages[n] = static_cast<FixedImageType *>(cachedImage.GetPointer());
+        }
+        else
+        {
+          this->m_FixedSmoothImages[n] = smoothFixedImage();
+        }
 
         using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
-        auto movingImageSmoothingFilter = MovingImageSmoothingFilterType::New();
         typename MovingImageSmoothingFilterType::SigmaArrayType movingImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -640,12 +682,33 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             movingImageSigmaArray[i] *= movingSpacing[i];
           }
         }
-        movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
-        movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
 
-        this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
-        movingImageSmoothingFilter->Update();
-        movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        const auto smoothMovingImage = [this, n, &movingImageSigmaArray]() -> MovingImagePointer {
+          auto movingImageSmoothingFilter = MovingImageSmoothingFilterType::New();
+          movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
+          movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
+          movingImageSmoothingFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+          MovingImagePointer movingSmoothImage = movingImageSmoothingFilter->GetOutput();
+          movingImageSmoothingFilter->Update();
+          movingSmoothImage->DisconnectPipeline();
+          return movingSmoothImage;
+        };
+
+        if (this->m_PyramidCache && this->m_CacheMovingImagePyramid)
+        {
+          PyramidCacheType::KeyType key;
+          key.m_Name = "SmoothedMovingImage";
+          key.m_Source = this->GetMovingImage(n);
+          key.m_SourceTime = this->GetMovingImage(n)->GetMTime();
+          key.m_Parameters.assign(movingImageSigmaArray.Begin(), movingImageSigmaArray.End());
+          const auto cachedImage = this->m_PyramidCache->GetOrCompute(key, smoothMovingImage);
+          this->m_MovingSmoothImages[n] = static_cast<MovingImageType *>(cachedImage.GetPointer());
+        }
+        else
+        {
+          this->m_MovingSmoothImages[n] = smoothMovingImage();
+        }
       }
       else
       {
@@ -935,43 +998,89 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
 
   for (SizeValueType n = 0; n < numberOfLocalMetrics; ++n)
   {
-    auto samplePointSet = MetricSamplePointSetType::New();
-
-    using SamplePointType = typename MetricSamplePointSetType::PointType;
-
-    using RandomizerType = Statistics::MersenneTwisterRandomVariateGenerator;
-    auto randomizer = RandomizerType::New();
-    if (m_ReseedIterator)
-    {
-      randomizer->SetSeed();
-    }
-    else
+    // The seeds of the randomizer and, for random sampling, of the iterator.
+    const int randomizerSeed = m_CurrentRandomSeed;
+    const int iteratorSeed = m_CurrentRandomSeed + 1;
+    if (!m_ReseedIterator)
     {
-      randomizer->SetSeed(m_CurrentRandomSeed++);
+      m_CurrentRandomSeed += (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::RANDOM) ? 2 : 1;
     }
 
+    const auto drawSamplePoints = [this, virtualImage, fixedMaskImage, &virtualDomainRegion, &oneThirdVirtualSpacing,
+                                   randomizerSeed, iteratorSeed]() -> typename MetricSamplePointSetType::Pointer {
+      auto samplePointSet = MetricSamplePointSetType::New();
 
-    unsigned long index = 0;
+      using SamplePointType = typename MetricSamplePointSetType::PointType;
 
-    switch (this->m_MetricSamplingStrategy)
-    {
-      case MetricSamplingStrategyEnum::REGULAR:
+      using RandomizerType = Statistics::MersenneTwisterRandomVariateGenerator;
+      auto randomizer = RandomizerType::New();
+      if (m_ReseedIterator)
+      {
+        randomizer->SetSeed();
+      }
+      else
+      {
+        randomizer->SetSeed(randomizerSeed);
+      }
+
+
+      unsigned long index = 0;
+
+      switch (this->m_MetricSamplingStrategy)
       {
-        const auto sampleCount =
-          static_cast<unsigned long>(std::ceil(1.0 / this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]));
-        unsigned long count =
-          sampleCount; // Start at sampleCount to keep behavior backwards identical, using first element.
-        ImageRegionConstIteratorWithIndex<VirtualDomainImageType> It(virtualImage, virtualDomainRegion);
-        for (It.GoToBegin(); !It.IsAtEnd(); ++It)
+        case MetricSamplingStrategyEnum::REGULAR:
         {
-          if (count == sampleCount)
+          const auto sampleCount =
+            static_cast<unsigned long>(std::ceil(1.0 / this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]));
+          unsigned long count =
+            sampleCount; // Start at sampleCount to keep behavior backwards identical, using first element.
+          ImageRegionConstIteratorWithIndex<VirtualDomainImageType> It(virtualImage, virtualDomainRegion);
+          for (It.GoToBegin(); !It.IsAtEnd(); ++It)
+          {
+            if (count == sampleCount)
+            {
+              count = 0; // Reset counter
+              SamplePointType point;
+              virtualImage->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+
+              // randomly perturb the point within a voxel (approximately)
+              for (SizeValueType d = 0; d < ImageDimension; ++d)
+              {
+                point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
+              }
+              if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
+              {
+                samplePointSet->SetPoint(index, point);
+                ++index;
+              }
+            }
+            ++count;
+          }
+          break;
+        }
+        case MetricSamplingStrategyEnum::RANDOM:
+        {
+          const unsigned long totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
+          const auto          sampleCount =
+            static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) *
+                                       this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]);
+          ImageRandomConstIteratorWithIndex<VirtualDomainImageType> ItR(virtualImage, virtualDomainRegion);
+          if (m_ReseedIterator)
+          {
+            ItR.ReinitializeSeed();
+          }
+          else
+          {
+            ItR.ReinitializeSeed(iteratorSeed);
+          }
+          ItR.SetNumberOfSamples(sampleCount);
+          for (ItR.GoToBegin(); !ItR.IsAtEnd(); ++ItR)
           {
-            count = 0; // Reset counter
             SamplePointType point;
-            virtualImage->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+            virtualImage->TransformIndexToPhysicalPoint(ItR.GetIndex(), point);
 
             // randomly perturb the point within a voxel (approximately)
-            for (SizeValueType d = 0; d < ImageDimension; ++d)
+            for (unsigned int d = 0; d < ImageDimension; ++d)
             {
               point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
             }
@@ -981,48 +1090,36 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
               ++index;
             }
           }
-          ++count;
-        }
-        break;
-      }
-      case MetricSamplingStrategyEnum::RANDOM:
-      {
-        const unsigned long totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
-        const auto          sampleCount =
-          static_cast<unsigned long>(static_cast<float>(totalVirtualDomainVoxels) *
-                                     this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]);
-        ImageRandomConstIteratorWithIndex<VirtualDomainImageType> ItR(virtualImage, virtualDomainRegion);
-        if (m_ReseedIterator)
-        {
-          ItR.ReinitializeSeed();
-        }
-        else
-        {
-          ItR.ReinitializeSeed(m_CurrentRandomSeed++);
+          break;
         }
-        ItR.SetNumberOfSamples(sampleCount);
-        for (ItR.GoToBegin(); !ItR.IsAtEnd(); ++ItR)
+        default:
         {
-          SamplePointType point;
-          virtualImage->TransformIndexToPhysicalPoint(ItR.GetIndex(), point);
-
-          // randomly perturb the point within a voxel (approximately)
-          for (unsigned int d = 0; d < ImageDimension; ++d)
-          {
-            point[d] += randomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
-          }
-          if (!fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point))
-          {
-            samplePointSet->SetPoint(index, point);
-            ++index;
-          }
+          itkExceptionMacro("Invalid sampling strategy requested.");
         }
-        break;
       }
-      default:
+      return samplePointSet;
+    };
+
+    typename MetricSamplePointSetType::Pointer samplePointSet;
+    if (this->m_PyramidCache && !m_ReseedIterator)
+    {
+      PyramidCacheType::KeyType key;
+      key.m_Name = "MetricSamplePointSet";
+      if (fixedMaskImage)
       {
-        itkExceptionMacro("Invalid sampling strategy requested.");
+        key.m_Source = fixedMaskImage;
+        key.m_SourceTime = fixedMaskImage->GetMTime();
       }
+      PyramidCacheType::AppendImageInformation(*virtualImage, key.m_Parameters);
+      key.m_Parameters.push_back(static_cast<double>(this->m_MetricSamplingStrategy));
+      key.m_Parameters.push_back(this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]);
+      key.m_Parameters.push_back(static_cast<double>(randomizerSeed));
+      const auto cachedPointSet = this->m_PyramidCache->GetOrCompute(key, drawSamplePoints);
+      samplePointSet = static_cast<MetricSamplePointSetType *>(cachedPointSet.GetPointer());
+    }
+    else
+    {
+      samplePointSet = drawSamplePoints();
     }
 
     if (multiMetric)
@@ -1198,6 +1295,9 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   itkPrintSelfBooleanMacro(InPlace);
 
   itkPrintSelfBooleanMacro(InitializeCenterOfLinearOutputTransform);
+
+  itkPrintSelfObjectMacro(PyramidCache);
+  itkPrintSelfBooleanMacro(CacheMovingImagePyramid);
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TTransform, typename TVirtualImage, typename TPointSet>
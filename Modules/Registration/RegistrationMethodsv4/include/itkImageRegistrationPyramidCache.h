@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_h
+#define itkImageRegistrationPyramidCache_h
+
+#include "itkImageBase.h"
+#include "ITKRegistrationMethodsv4Export.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageRegistrationPyramidCache
+ * \brief Shares the smoothed and shrunk data of the levels of registrations.
+ *
+ * At each level, ImageRegistrationMethodv4 smooths the fixed and moving
+ * images, shrinks the virtual domain and, when the metric is sampled, draws
+ * the sample points. The stages of a multi-stage registration (e.g. rigid,
+ * then affine, then deformable) typically use the same shrink factors and
+ * smoothing sigmas, and registrations of many moving images to the same fixed
+ * images (e.g. when building an atlas) share the fixed-side data. By sharing an
+ * instance of this class, such registrations compute this data once.
+ *
+ * A data object is identified by a name, the object it is computed from (if
+ * any) along with the modification time of that object, and the parameters of
+ * the computation. When the source of a data object is modified, the data
+ * computed from the previous version of the source is evicted as soon as the
+ * new version is requested. The cache is thread safe: when several
+ * registrations request the same data concurrently, one of them computes it
+ * while the others wait for the result.
+ *
+ * The cache keeps the cached data objects, and the objects they are computed
+ * from, alive until they are evicted: when a newer version of their source is
+ * requested, when more than MaximumNumberOfDataObjects are cached (the least
+ * recently used ones are evicted first), or by Clear(). A registration that
+ * still uses an evicted data object keeps it alive until it is done with it.
+ * Call Clear(), or release the cache, once the registrations that share it
+ * are done, to free the memory of its data objects.
+ *
+ * \sa ImageRegistrationMethodv4::SetPyramidCache()
+ * \sa BatchImageRegistrationMethodv4
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+class ITKRegistrationMethodsv4_EXPORT ImageRegistrationPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegistrationPyramidCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegistrationPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegistrationPyramidCache);
+
+  /** Identifies a cached data object. The source is held by the cache, so that its address is not reused while the
+   * data computed from it is cached. */
+  struct KeyType
+  {
+    std::string          m_Name{};
+    Object::ConstPointer m_Source{};
+    ModifiedTimeType     m_SourceTime{};
+    std::vector<double>  m_Parameters{};
+
+    bool
+    operator<(const KeyType & other) const;
+  };
+
+  using ComputeFunctionType = std::function<DataObject::Pointer()>;
+
+  /** Returns the data object with the specified key, calling the compute function when it is not cached yet. Data
+   * objects with the same name, source and parameters, but computed from an older version of the source, are evicted.
+   */
+  DataObject::Pointer
+  GetOrCompute(const KeyType & key, const ComputeFunctionType & compute);
+
+  /** Appends the origin, spacing, direction and largest possible region of an image to the parameters of a key, for
+   * data that only depends on the geometry of the image. */
+  template <unsigned int VImageDimension>
+  static void
+  AppendImageInformation(const ImageBase<VImageDimension> & image, std::vector<double> & parameters)
+  {
+    for (unsigned int i = 0; i < VImageDimension; ++i)
+    {
+      parameters.push_back(image.GetOrigin()[i]);
+      parameters.push_back(image.GetSpacing()[i]);
+      parameters.push_back(static_cast<double>(image.GetLargestPossibleRegion().GetIndex()[i]));
+      parameters.push_back(static_cast<double>(image.GetLargestPossibleRegion().GetSize()[i]));
+      for (unsigned int j = 0; j < VImageDimension; ++j)
+      {
+        parameters.push_back(image.GetDirection()[i][j]);
+      }
+    }
+  }
+
+  /** Returns the number of cached data objects. */
+  SizeValueType
+  GetNumberOfDataObjects() const;
+
+  /** Set/Get the maximum number of cached data objects. When a new data
+   * object exceeds it, the least recently used ones are evicted. Defaults to
+   * 100, which covers the levels of many stages, for both the fixed and the
+   * moving images. */
+  void
+  SetMaximumNumberOfDataObjects(SizeValueType maximumNumberOfDataObjects);
+  itkGetConstMacro(MaximumNumberOfDataObjects, SizeValueType);
+
+  /** Removes all the cached data objects. Must not be called while a registration uses the cache. */
+  void
+  Clear();
+
+protected:
+  ImageRegistrationPyramidCache() = default;
+  ~ImageRegistrationPyramidCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct Entry
+  {
+    std::once_flag      m_Computed{};
+    DataObject::Pointer m_Data{};
+    uint64_t            m_LastUse{};
+  };
+
+  /** Evicts the least recently used entries, except keptEntry, until at most MaximumNumberOfDataObjects are left. The
+   * mutex must be locked. */
+  void
+  EvictLeastRecentlyUsedEntries(const Entry * keptEntry);
+
+  mutable std::mutex                        m_Mutex{};
+  std::map<KeyType, std::shared_ptr<Entry>> m_Entries{};
+  SizeValueType                             m_MaximumNumberOfDataObjects{ 100 };
+  uint64_t                                  m_NumberOfUses{};
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegistrationPyramidCache.h"
+
+#include <tuple>
+
+namespace itk
+{
+bool
+ImageRegistrationPyramidCache::KeyType::operator<(const KeyType & other) const
+{
+  const Object * const source = m_Source.GetPointer();
+  const Object * const otherSource = other.m_Source.GetPointer();
+  return std::tie(m_Name, source, m_SourceTime, m_Parameters) <
+         std::tie(other.m_Name, otherSource, other.m_SourceTime, other.m_Parameters);
+}
+
+DataObject::Pointer
+ImageRegistrationPyramidCache::GetOrCompute(const KeyType & key, const ComputeFunctionType & compute)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    auto &                            slot = m_Entries[key];
+    if (!slot)
+    {
+      slot = std::make_shared<Entry>();
+
+      // Evict the data computed from older versions of the source, which are sorted next to the new key.
+      if (key.m_Source)
+      {
+        for (auto it = m_Entries.lower_bound(KeyType{ key.m_Name, key.m_Source, 0, {} });
+             it != m_Entries.end() && it->first.m_Name == key.m_Name && it->first.m_Source == key.m_Source;)
+        {
+          if (it->first.m_SourceTime != key.m_SourceTime && it->first.m_Parameters == key.m_Parameters)
+          {
+            it = m_Entries.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+      }
+    }
+    slot->m_LastUse = ++m_NumberOfUses;
+    entry = slot;
+    this->EvictLeastRecentlyUsedEntries(entry.get());
+  }
+
+  // The entry is shared with the map, so that the computation can run without holding the lock, even if the entry
+  // gets evicted meanwhile. If it throws, the next request computes the data again.
+  std::call_once(entry->m_Computed, [&entry, &compute] { entry->m_Data = compute(); });
+  return entry->m_Data;
+}
+
+SizeValueType
+ImageRegistrationPyramidCache::GetNumberOfDataObjects() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_Entries.size());
+}
+
+void
+ImageRegistrationPyramidCache::SetMaximumNumberOfDataObjects(SizeValueType maximumNumberOfDataObjects)
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_MaximumNumberOfDataObjects == maximumNumberOfDataObjects)
+    {
+      return;
+    }
+    m_MaximumNumberOfDataObjects = maximumNumberOfDataObjects;
+    this->EvictLeastRecentlyUsedEntries(nullptr);
+  }
+  this->Modified();
+}
+
+void
+ImageRegistrationPyramidCache::EvictLeastRecentlyUsedEntries(const Entry * keptEntry)
+{
+  while (m_Entries.size() > m_MaximumNumberOfDataObjects)
+  {
+    auto leastRecentlyUsed = m_Entries.end();
+    for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+      if (it->second.get() != keptEntry &&
+          (leastRecentlyUsed == m_Entries.end() || it->second->m_LastUse < leastRecentlyUsed->second->m_LastUse))
+      {
+        leastRecentlyUsed = it;
+      }
+    }
+    if (leastRecentlyUsed == m_Entries.end())
+    {
+      return;
+    }
+    m_Entries.erase(leastRecentlyUsed);
+  }
+}
+
+void
+ImageRegistrationPyramidCache::Clear()
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.clear();
+  }
+  this->Modified();
+}
+
+void
+ImageRegistrationPyramidCache::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfDataObjects: " << this->GetNumberOfDataObjects() << std::endl;
+  os << indent << "MaximumNumberOfDataObjects: " << m_MaximumNumberOfDataObjects << std::endl;
+}
+} // end namespace itk
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBatchImageRegistrationMethodv4.h"
+#include "itkImageRegistrationMethodv4.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegularStepGradientDescentOptimizerv4.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/*
+ * Registers translated copies of an image to it, with and without a batch, and checks that the batch gives the same
+ * transforms, while computing the fixed-side data of each level once.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+ImageType::Pointer
+MakeImage(double shiftX, double shiftY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 64, 56 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 30.0 - shiftX;
+    const double y = it.GetIndex()[1] - 26.0 - shiftY;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0) +
+           20.0 * std::exp(-((x - 12.0) * (x - 12.0) + y * y) / 50.0));
+  }
+  return image;
+}
+
+RegistrationType::Pointer
+MakeRegistration(const ImageType * fixedImage, const ImageType * movingImage)
+{
+  auto metric = MetricType::New();
+
+  auto optimizer = itk::RegularStepGradientDescentOptimizerv4<double>::New();
+  optimizer->SetLearningRate(2.0);
+  optimizer->SetMinimumStepLength(1e-4);
+  optimizer->SetRelaxationFactor(0.5);
+  optimizer->SetNumberOfIterations(100);
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(2);
+  RegistrationType::ShrinkFactorsArrayType shrinkFactors(2);
+  shrinkFactors[0] = 2;
+  shrinkFactors[1] = 1;
+  registration->SetShrinkFactorsPerLevel(shrinkFactors);
+  RegistrationType::SmoothingSigmasArrayType smoothingSigmas(2);
+  smoothingSigmas[0] = 1.0;
+  smoothingSigmas[1] = 0.0;
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  registration->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::REGULAR);
+  registration->SetMetricSamplingPercentage(0.5);
+  registration->MetricSamplingReinitializeSeed(121212);
+  return registration;
+}
+} // namespace
+
+int
+itkBatchImageRegistrationMethodv4Test(int, char *[])
+{
+  using BatchType = itk::BatchImageRegistrationMethodv4<RegistrationType>;
+  auto batch = BatchType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(batch, BatchImageRegistrationMethodv4, Object);
+
+  ITK_TEST_EXPECT_TRUE(batch->GetPyramidCache() != nullptr);
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfWorkUnits(), itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+
+  constexpr itk::ThreadIdType numberOfWorkUnits = 6;
+  batch->SetNumberOfWorkUnits(numberOfWorkUnits);
+  ITK_TEST_SET_GET_VALUE(numberOfWorkUnits, batch->GetNumberOfWorkUnits());
+
+  constexpr itk::SizeValueType maximumNumberOfConcurrentRegistrations = 3;
+  batch->SetMaximumNumberOfConcurrentRegistrations(maximumNumberOfConcurrentRegistrations);
+  ITK_TEST_SET_GET_VALUE(maximumNumberOfConcurrentRegistrations, batch->GetMaximumNumberOfConcurrentRegistrations());
+
+  ITK_TRY_EXPECT_EXCEPTION(batch->AddRegistrationMethod(nullptr));
+
+  const auto fixedImage = MakeImage(0.0, 0.0);
+
+  constexpr unsigned int numberOfMovingImages = 5;
+  constexpr double       shifts[numberOfMovingImages][Dimension] = {
+    { 2.0, -1.0 }, { -1.5, 2.0 }, { 3.0, 1.0 }, { 0.5, -2.5 }, { -2.0, -0.5 }
+  };
+
+  std::vector<RegistrationType::Pointer> expectedRegistrations;
+  for (const auto & shift : shifts)
+  {
+    const auto movingImage = MakeImage(shift[0], shift[1]);
+    batch->AddRegistrationMethod(MakeRegistration(fixedImage, movingImage));
+
+    // The batch shares the work units between the concurrent registrations.
+    auto expectedRegistration = MakeRegistration(fixedImage, movingImage);
+    expectedRegistration->SetNumberOfWorkUnits(numberOfWorkUnits / maximumNumberOfConcurrentRegistrations);
+    dynamic_cast<MetricType *>(expectedRegistration->GetModifiableMetric())
+      ->SetMaximumNumberOfWorkUnits(numberOfWorkUnits / maximumNumberOfConcurrentRegistrations);
+    expectedRegistration->GetModifiableOptimizer()->SetNumberOfWorkUnits(numberOfWorkUnits /
+                                                                         maximumNumberOfConcurrentRegistrations);
+    ITK_TRY_EXPECT_NO_EXCEPTION(expectedRegistration->Update());
+    expectedRegistrations.push_back(expectedRegistration);
+  }
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfRegistrationMethods(), numberOfMovingImages);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(batch->Update());
+
+  // Each of the two levels has a virtual domain image and sample points, and the first one a smoothed fixed image.
+  ITK_TEST_EXPECT_EQUAL(batch->GetPyramidCache()->GetNumberOfDataObjects(), 5);
+
+  for (unsigned int i = 0; i < numberOfMovingImages; ++i)
+  {
+    const auto & parameters = batch->GetRegistrationMethod(i)->GetTransform()->GetParameters();
+    const auto & expectedParameters = expectedRegistrations[i]->GetTransform()->GetParameters();
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      if (std::abs(parameters[d] - expectedParameters[d]) > 1e-10)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Registration " << i << " of the batch gives " << parameters << " instead of "
+                  << expectedParameters << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (std::abs(parameters[d] - shifts[i][d]) > 0.01)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Registration " << i << " gives " << parameters << ", the moving image is shifted by ("
+                  << shifts[i][0] << ", " << shifts[i][1] << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Running the batch again reuses the cached data.
+  ITK_TRY_EXPECT_NO_EXCEPTION(batch->Update());
+  ITK_TEST_EXPECT_EQUAL(batch->GetPyramidCache()->GetNumberOfDataObjects(), 5);
+
+  // Modifying the fixed image replaces its smoothed image.
+  fixedImage->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(batch->Update());
+  ITK_TEST_EXPECT_EQUAL(batch->GetPyramidCache()->GetNumberOfDataObjects(), 5);
+
+  batch->ClearRegistrationMethods();
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfRegistrationMethods(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
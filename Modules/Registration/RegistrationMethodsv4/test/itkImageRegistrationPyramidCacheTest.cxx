@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegistrationPyramidCache.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegularStepGradientDescentOptimizerv4.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/*
+ * Runs a two-stage registration with and without a pyramid cache, and checks that the stages give the same transforms
+ * when sharing the cache, while the second stage reuses the smoothed images, virtual domains and sample points of the
+ * first one.
+ */
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType>;
+using PyramidCacheType = itk::ImageRegistrationPyramidCache;
+
+ImageType::Pointer
+MakeImage(double shiftX, double shiftY)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 60, 64 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - 28.0 - shiftX;
+    const double y = it.GetIndex()[1] - 30.0 - shiftY;
+    it.Set(100.0 * std::exp(-(2.0 * x * x + y * y) / 200.0) +
+           30.0 * std::exp(-(x * x + (y - 10.0) * (y - 10.0)) / 40.0));
+  }
+  return image;
+}
+
+RegistrationType::Pointer
+MakeStage(const ImageType *        fixedImage,
+          const ImageType *        movingImage,
+          const RegistrationType * previousStage,
+          double                   learningRate,
+          PyramidCacheType *       pyramidCache)
+{
+  auto optimizer = itk::RegularStepGradientDescentOptimizerv4<double>::New();
+  optimizer->SetLearningRate(learningRate);
+  optimizer->SetMinimumStepLength(1e-4);
+  optimizer->SetRelaxationFactor(0.5);
+  optimizer->SetNumberOfIterations(100);
+
+  auto stage = RegistrationType::New();
+  stage->SetFixedImage(fixedImage);
+  stage->SetMovingImage(movingImage);
+  stage->SetMetric(itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>::New());
+  stage->SetOptimizer(optimizer);
+  if (previousStage)
+  {
+    stage->SetMovingInitialTransform(previousStage->GetOutput()->Get());
+  }
+  stage->SetNumberOfLevels(2);
+  RegistrationType::ShrinkFactorsArrayType shrinkFactors(2);
+  shrinkFactors[0] = 2;
+  shrinkFactors[1] = 1;
+  stage->SetShrinkFactorsPerLevel(shrinkFactors);
+  RegistrationType::SmoothingSigmasArrayType smoothingSigmas(2);
+  smoothingSigmas[0] = 1.5;
+  smoothingSigmas[1] = 0.0;
+  stage->SetSmoothingSigmasPerLevel(smoothingSigmas);
+  stage->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::REGULAR);
+  stage->SetMetricSamplingPercentage(0.5);
+  stage->MetricSamplingReinitializeSeed(343434);
+  stage->SetPyramidCache(pyramidCache);
+  stage->SetCacheMovingImagePyramid(pyramidCache != nullptr);
+  return stage;
+}
+
+bool
+ParametersAreEqual(const RegistrationType * stage, const RegistrationType * expectedStage)
+{
+  const auto & parameters = stage->GetTransform()->GetParameters();
+  const auto & expectedParameters = expectedStage->GetTransform()->GetParameters();
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    if (std::abs(parameters[d] - expectedParameters[d]) > 1e-10)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The stage gives " << parameters << " with the cache, and " << expectedParameters << " without it"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageRegistrationPyramidCacheTest(int, char *[])
+{
+  auto pyramidCache = PyramidCacheType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(pyramidCache, ImageRegistrationPyramidCache, Object);
+
+  // The data of a key is computed once, and evicted when its source is modified.
+  const auto   source = ImageType::New();
+  unsigned int numberOfComputations = 0;
+  const auto   compute = [&numberOfComputations]() -> itk::DataObject::Pointer {
+    ++numberOfComputations;
+    return ImageType::New();
+  };
+  PyramidCacheType::KeyType key{ "Data", source.GetPointer(), source->GetMTime(), { 1.0 } };
+  const auto                data = pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetOrCompute(key, compute), data);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 1);
+
+  key.m_Parameters = { 2.0 };
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 2);
+
+  source->Modified();
+  key.m_SourceTime = source->GetMTime();
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 3);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 2);
+
+  // Beyond the maximum number of data objects, the least recently used ones are evicted.
+  ITK_TEST_SET_GET_VALUE(100, pyramidCache->GetMaximumNumberOfDataObjects());
+  pyramidCache->SetMaximumNumberOfDataObjects(2);
+  ITK_TEST_SET_GET_VALUE(2, pyramidCache->GetMaximumNumberOfDataObjects());
+  auto otherKey = key;
+  otherKey.m_Parameters = { 3.0 };
+  pyramidCache->GetOrCompute(otherKey, compute);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 2);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 4);
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 4);
+  key.m_Parameters = { 1.0 };
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 5);
+  key.m_Parameters = { 2.0 };
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 5);
+  pyramidCache->SetMaximumNumberOfDataObjects(1);
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 1);
+  pyramidCache->GetOrCompute(key, compute);
+  ITK_TEST_EXPECT_EQUAL(numberOfComputations, 5);
+  pyramidCache->SetMaximumNumberOfDataObjects(100);
+
+  pyramidCache->Clear();
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 0);
+
+  // A coarse stage followed by a fine stage, with the same levels.
+  const auto fixedImage = MakeImage(0.0, 0.0);
+  const auto movingImage = MakeImage(2.5, -1.5);
+
+  const auto expectedStage1 = MakeStage(fixedImage, movingImage, nullptr, 2.0, nullptr);
+  ITK_TRY_EXPECT_NO_EXCEPTION(expectedStage1->Update());
+  const auto expectedStage2 = MakeStage(fixedImage, movingImage, expectedStage1, 0.25, nullptr);
+  ITK_TRY_EXPECT_NO_EXCEPTION(expectedStage2->Update());
+
+  const auto stage1 = MakeStage(fixedImage, movingImage, nullptr, 2.0, pyramidCache);
+  ITK_TEST_SET_GET_BOOLEAN(stage1, CacheMovingImagePyramid, true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(stage1->Update());
+
+  // Each of the two levels has a virtual domain image and sample points, and the first one smoothed images.
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 6);
+
+  const auto stage2 = MakeStage(fixedImage, movingImage, stage1, 0.25, pyramidCache);
+  ITK_TRY_EXPECT_NO_EXCEPTION(stage2->Update());
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 6);
+
+  if (!ParametersAreEqual(stage1, expectedStage1) || !ParametersAreEqual(stage2, expectedStage2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the moving image replaces its smoothed image.
+  movingImage->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(stage1->Update());
+  ITK_TEST_EXPECT_EQUAL(pyramidCache->GetNumberOfDataObjects(), 6);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}